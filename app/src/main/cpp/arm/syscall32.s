@@ -12,4 +12,6 @@ raw_syscall:
         LDMIA           R12, {R3-R6}
         SVC             0
         LDMFD           SP!, {R4-R7}
-        mov             pc, lr
\ No newline at end of file
+        mov             pc, lr
+
+    .section .note.GNU-stack,"",%progbits
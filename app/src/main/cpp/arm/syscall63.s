@@ -11,4 +11,6 @@ raw_syscall:
         MOV             X4, X5
         MOV             X5, X6
         SVC             0
-        RET
\ No newline at end of file
+        RET
+
+    .section .note.GNU-stack,"",%progbits
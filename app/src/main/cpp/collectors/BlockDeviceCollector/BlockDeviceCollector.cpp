@@ -0,0 +1,157 @@
+#include "../../include/BlockDeviceCollector.h"
+#include "../../include/DirentScanner.h"
+#include "../../include/IoBackend.h"
+#include "../../include/Logger.h"
+#include "../../include/private/ScopedFd.h"
+#include "../../include/FieldDefinitions.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// 虚拟块设备没有硬件标识
+constexpr const char* kVirtualPrefixes[] = {"loop", "ram", "dm-", "zram"};
+
+// device/ 下的身份属性：eMMC/SD 提供 cid、csd、name、serial，SCSI（UFS）提供 vendor、model、rev
+constexpr const char* kDeviceAttributes[] = {"cid", "csd", "name", "serial", "vendor", "model", "rev"};
+
+// UFS主机控制器（device/../../.. 即 scsi_device -> target -> host -> ufshc）上的描述符
+constexpr const char* kUfsAttributes[] = {
+    "string_descriptors/manufacturer_name",
+    "string_descriptors/product_name",
+    "string_descriptors/serial_number",
+    "string_descriptors/product_revision",
+    "device_descriptor/manufacturer_id",
+    "device_descriptor/manufacturing_date",
+    "device_descriptor/specification_version",
+    "health_descriptor/life_time_estimation_a",
+};
+
+bool isVirtualDevice(const char* name) {
+    for (const char* prefix : kVirtualPrefixes) {
+        if (strncmp(name, prefix, strlen(prefix)) == 0) return true;
+    }
+    return false;
+}
+
+// 读取单个sysfs属性，去掉末尾的换行和空白；不存在或为空时返回false
+template <typename Io>
+bool readAttribute(int dirfd, const char* name, std::string* value) {
+    ScopedFd fd(Io::openAt(dirfd, name, O_RDONLY | O_CLOEXEC));
+    if (fd.get() < 0) return false;
+
+    char buffer[512];
+    ssize_t bytes;
+    do {
+        bytes = Io::pread(fd.get(), buffer, sizeof(buffer), 0);
+    } while (bytes < 0 && errno == EINTR);
+    if (bytes <= 0) return false;
+
+    std::string_view text(buffer, static_cast<size_t>(bytes));
+    size_t end = text.find_last_not_of(" \t\r\n");
+    if (end == std::string_view::npos) return false;
+    value->assign(text.data(), end + 1);
+    // 字符串描述符可能带有内嵌的NUL填充
+    value->erase(std::remove(value->begin(), value->end(), '\0'), value->end());
+    return !value->empty();
+}
+
+template <typename Io>
+void appendAttribute(int dirfd, const char* name, const char* label, std::string* out) {
+    std::string value;
+    if (readAttribute<Io>(dirfd, name, &value)) {
+        *out += label;
+        *out += ": ";
+        *out += value;
+        *out += '\n';
+    }
+}
+
+struct UfsHost {
+    dev_t dev;
+    ino_t ino;
+    std::string record;
+};
+
+template <typename Io>
+std::string collectWith(const char* sysBlockPath, size_t* deviceCount) {
+    ScopedFd blockDir(Io::openAt(AT_FDCWD, sysBlockPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (blockDir.get() < 0) {
+        LOGE("BlockDeviceCollector", "Failed to open %s, errno: %d", sysBlockPath, errno);
+        return "Unable to retrieve: cannot open " + std::string(sysBlockPath) + "\n";
+    }
+
+    // 一次getdents64遍历；/sys/block下都是符号链接，不按d_type过滤
+    std::vector<std::string> names;
+    dirent_scan::forEachEntry<Io>(blockDir.get(), [&names](const char* name, unsigned char) {
+        if (!isVirtualDevice(name)) names.emplace_back(name);
+        return true;
+    });
+    std::sort(names.begin(), names.end());
+
+    // 同一UFS控制器下的多个LU（sda..sdh）共享描述符，只读一次
+    std::vector<UfsHost> ufsHosts;
+    std::string result;
+    for (const std::string& name : names) {
+        ScopedFd deviceDir(Io::openAt(blockDir.get(), name.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (deviceDir.get() < 0) continue;
+
+        result += "--- " + name + " ---\n";
+        appendAttribute<Io>(deviceDir.get(), "size", "size", &result);
+
+        ScopedFd hwDir(Io::openAt(deviceDir.get(), "device", O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (hwDir.get() >= 0) {
+            for (const char* attribute : kDeviceAttributes) {
+                appendAttribute<Io>(hwDir.get(), attribute, attribute, &result);
+            }
+
+            ScopedFd hostDir(Io::openAt(hwDir.get(), "../../..", O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+            struct stat64 hostStat;
+            if (hostDir.get() >= 0 && Io::fstat(hostDir.get(), &hostStat) == 0) {
+                auto cached = std::find_if(ufsHosts.begin(), ufsHosts.end(), [&hostStat](const UfsHost& host) {
+                    return host.dev == hostStat.st_dev && host.ino == hostStat.st_ino;
+                });
+                if (cached == ufsHosts.end()) {
+                    UfsHost host{hostStat.st_dev, hostStat.st_ino, std::string()};
+                    for (const char* attribute : kUfsAttributes) {
+                        std::string label = "ufs_" + std::string(strchr(attribute, '/') + 1);
+                        appendAttribute<Io>(hostDir.get(), attribute, label.c_str(), &host.record);
+                    }
+                    ufsHosts.push_back(std::move(host));
+                    cached = ufsHosts.end() - 1;
+                }
+                result += cached->record;
+            }
+        }
+        result += "\n";
+        ++*deviceCount;
+    }
+    return result;
+}
+
+} // namespace
+
+std::string BlockDeviceCollector::collect() {
+    std::string result = "=== " + std::string(kBlockDevicesTitle) + " ===\n";
+    auto start = std::chrono::steady_clock::now();
+
+    size_t devices = 0;
+    if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+        result += collectWith<RawSyscallIo>(m_sysBlockPath, &devices);
+    } else {
+        result += collectWith<LibcIo>(m_sysBlockPath, &devices);
+    }
+    if (devices == 0) result += "No physical block devices found\n\n";
+
+    long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGI("BlockDeviceCollector", "Collected %zu block devices in %lldus", devices, elapsedUs);
+    return result;
+}
+
+std::string BlockDeviceCollector::getCollectorName() const {
+    return "BlockDeviceCollector";
+}
@@ -1,5 +1,7 @@
 #include "../../include/CommonCollector.h"
 #include "../../include/Logger.h"
+#include "../../include/SectionCache.h"
+#include "../../include/FieldDefinitions.h"
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fstream>
@@ -10,7 +12,7 @@ CommonCollector::CommonCollector(JNIEnv* env) : m_env(env) {
 }
 
 std::string CommonCollector::collect() {
-    std::string result = "=== Common Device Information Collection ===\n\n";
+    std::string result = "=== " + std::string(kCommonDeviceTitle) + " ===\n\n";
     
     try {
         result += collectDeviceInfo();
@@ -30,22 +32,27 @@ std::string CommonCollector::getCollectorName() const {
 }
 
 std::string CommonCollector::collectDeviceInfo() {
-    std::string result = "=== Device Information ===\n\n";
+    std::string result = "=== " + std::string(kDeviceInfoTitle) + " ===\n\n";
+    
+    // 键与FieldStore的字段目录共用FieldDefinitions.h中的常量
+    auto field = [&result](const char* key, const std::string& value) {
+        result += std::string(key) + ": " + value + "\n";
+    };
     
     try {
-        result += "Device Model: " + getDeviceModel() + "\n";
-        result += "Device Brand: " + getDeviceBrand() + "\n";
-        result += "Android Version: " + getAndroidVersion() + "\n";
-        result += "API Level: " + getApiLevel() + "\n";
-        result += "Manufacturer: " + getJavaProperty(m_env, "ro.product.manufacturer") + "\n";
-        result += "Product Name: " + getJavaProperty(m_env, "ro.product.name") + "\n";
-        result += "Device Name: " + getJavaProperty(m_env, "ro.product.device") + "\n";
-        result += "Build Fingerprint: " + getJavaProperty(m_env, "ro.build.fingerprint") + "\n";
-        result += "Build ID: " + getJavaProperty(m_env, "ro.build.id") + "\n";
-        result += "Build Type: " + getJavaProperty(m_env, "ro.build.type") + "\n";
-        result += "Build Tags: " + getJavaProperty(m_env, "ro.build.tags") + "\n";
-        result += "Build Date: " + getJavaProperty(m_env, "ro.build.date") + "\n";
-        result += "Security Patch: " + getJavaProperty(m_env, "ro.build.version.security_patch") + "\n";
+        field(kDeviceModelKey, getDeviceModel());
+        field(kDeviceBrandKey, getDeviceBrand());
+        field(kAndroidVersionKey, getAndroidVersion());
+        field(kApiLevelKey, getApiLevel());
+        field(kManufacturerKey, getJavaProperty(m_env, "ro.product.manufacturer"));
+        field(kProductNameKey, getJavaProperty(m_env, "ro.product.name"));
+        field(kDeviceNameKey, getJavaProperty(m_env, "ro.product.device"));
+        field(kBuildFingerprintKey, getJavaProperty(m_env, "ro.build.fingerprint"));
+        field(kBuildIdKey, getJavaProperty(m_env, "ro.build.id"));
+        field(kBuildTypeKey, getJavaProperty(m_env, "ro.build.type"));
+        field(kBuildTagsKey, getJavaProperty(m_env, "ro.build.tags"));
+        field(kBuildDateKey, getJavaProperty(m_env, "ro.build.date"));
+        field(kSecurityPatchKey, getJavaProperty(m_env, "ro.build.version.security_patch"));
         
     } catch (const std::exception& e) {
         LOGE("CommonCollector", "Exception in collectDeviceInfo: %s", e.what());
@@ -93,7 +100,7 @@ std::string CommonCollector::collectHardwareInfo() {
     std::string result = "=== Hardware Information ===\n\n";
     
     try {
-        result += getCpuInfo();
+        result += SectionCache::instance().getOrCollect(SECTION_CPU_INFO, [this]() { return getCpuInfo(); });
         result += getMemoryInfo();
         result += getStorageInfo();
         
@@ -153,7 +160,7 @@ std::string CommonCollector::getApiLevel() {
 }
 
 std::string CommonCollector::getCpuInfo() {
-    std::string result = "=== CPU Information ===\n";
+    std::string result = "=== " + std::string(kCpuInfoTitle) + " ===\n";
     
     try {
         if (fileExists("/proc/cpuinfo")) {
@@ -0,0 +1,140 @@
+#include "../../include/ElfBuildIdCollector.h"
+#include "../../include/DirentScanner.h"
+#include "../../include/ElfBuildId.h"
+#include "../../include/HashUtils.h"
+#include "../../include/IoBackend.h"
+#include "../../include/Logger.h"
+#include "../../include/WorkStealingPool.h"
+#include "../../include/FieldDefinitions.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace {
+
+// 32位库在纯64位设备上不存在，不存在的文件不输出
+constexpr const char* kDefaultLibraries[] = {
+    "/apex/com.android.runtime/lib64/bionic/libc.so",
+    "/apex/com.android.runtime/lib/bionic/libc.so",
+    "/apex/com.android.runtime/bin/linker64",
+    "/apex/com.android.art/lib64/libart.so",
+    "/system/lib64/libandroid_runtime.so",
+    "/system/lib/libandroid_runtime.so",
+    "/system/lib64/libbinder.so",
+    "/system/lib64/libhwui.so",
+    "/vendor/lib64/hw/",
+};
+
+struct Library {
+    explicit Library(std::string libraryPath) : path(std::move(libraryPath)) {}
+
+    std::string path;
+    elf_build_id::Status status = elf_build_id::Status::NOT_FOUND;
+    elf_build_id::Result result;
+};
+
+// 展开目录项，目录内按名称排序保证输出稳定
+template <typename Io>
+std::vector<Library> expandLibraries(const std::vector<std::string>& entries) {
+    std::vector<Library> libraries;
+    for (const std::string& entry : entries) {
+        if (entry.empty() || entry.back() != '/') {
+            libraries.emplace_back(entry);
+            continue;
+        }
+
+        ScopedFd dir(Io::openAt(AT_FDCWD, entry.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (dir.get() < 0) continue;
+        std::vector<std::string> names;
+        dirent_scan::forEachEntry<Io>(dir.get(), [&names](const char* name, unsigned char type) {
+            size_t length = strlen(name);
+            if (type != DT_DIR && length > 3 && strcmp(name + length - 3, ".so") == 0) names.emplace_back(name);
+            return true;
+        });
+        std::sort(names.begin(), names.end());
+        for (const std::string& name : names) {
+            libraries.emplace_back(entry + name);
+        }
+    }
+    return libraries;
+}
+
+template <typename Io>
+std::vector<Library> readBuildIds(const std::vector<std::string>& entries) {
+    std::vector<Library> libraries = expandLibraries<Io>(entries);
+
+    // 每个库一个任务，各自写入自己的槽位
+    std::vector<WorkStealingPool::Task> tasks;
+    for (Library& library : libraries) {
+        tasks.emplace_back([&library](unsigned) {
+            library.status = elf_build_id::read<Io>(AT_FDCWD, library.path.c_str(), &library.result);
+        });
+    }
+    WorkStealingPool::shared().runAndWait(std::move(tasks));
+    return libraries;
+}
+
+} // namespace
+
+ElfBuildIdCollector::ElfBuildIdCollector()
+    : m_libraries(std::begin(kDefaultLibraries), std::end(kDefaultLibraries)) {}
+
+std::string ElfBuildIdCollector::collect() {
+    std::string result = "=== " + std::string(kElfBuildIdsTitle) + " ===\n";
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<Library> libraries;
+    try {
+        if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+            libraries = readBuildIds<RawSyscallIo>(m_libraries);
+        } else {
+            libraries = readBuildIds<LibcIo>(m_libraries);
+        }
+    } catch (const std::exception& e) {
+        LOGE("ElfBuildIdCollector", "Build-id scan failed: %s", e.what());
+        return result + "Unable to retrieve: " + std::string(e.what()) + "\n\n";
+    }
+
+    uint64_t digest = kFnvOffsetBasis;
+    size_t found = 0;
+    size_t ioErrors = 0;
+    size_t bytesRead = 0;
+    for (const Library& library : libraries) {
+        bytesRead += library.result.bytesRead;
+        if (library.status == elf_build_id::Status::NOT_FOUND) continue;
+        // 单个库的问题只标记该条目；"Unable to retrieve"留给整个分区失败，否则分区永远不会被缓存
+        if (library.status != elf_build_id::Status::OK) {
+            if (library.status == elf_build_id::Status::IO_ERROR) ++ioErrors;
+            result += library.path + ": status: " + elf_build_id::statusName(library.status) + "\n";
+            continue;
+        }
+        result += library.path + ": " + library.result.buildId + " (elf" + (library.result.is64 ? "64" : "32") +
+                  (library.result.bigEndian ? "-be" : "-le") + ")\n";
+        digest = fnv1a64(library.path.data(), library.path.size(), digest);
+        digest = fnv1a64(library.result.buildId.data(), library.result.buildId.size(), digest);
+        ++found;
+    }
+
+    if (found == 0 && ioErrors > 0) {
+        // 一个都没读出来且有I/O错误，整个分区按失败处理，下次重试
+        return result + "Unable to retrieve: I/O error reading " + std::to_string(ioErrors) + " libraries\n\n";
+    }
+    if (found == 0) {
+        result += "No build-id notes found\n\n";
+    } else {
+        char line[64];
+        snprintf(line, sizeof(line), "build_id_digest: %016" PRIx64 "\n\n", mix64(digest));
+        result += line;
+    }
+
+    long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGI("ElfBuildIdCollector", "Read %zu build-ids (%zu bytes mapped/read) in %lldus", found, bytesRead,
+         elapsedUs);
+    return result;
+}
+
+std::string ElfBuildIdCollector::getCollectorName() const {
+    return "ElfBuildIdCollector";
+}
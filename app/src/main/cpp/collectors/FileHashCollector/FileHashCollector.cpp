@@ -0,0 +1,60 @@
+#include "../../include/FileHashCollector.h"
+#include "../../include/ContentHash.h"
+#include "../../include/IoBackend.h"
+#include "../../include/Logger.h"
+#include "../../include/FieldDefinitions.h"
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+constexpr const char* kDefaultFiles[] = {
+    "/system/framework/framework.jar",
+    "/system/framework/framework-res.apk",
+    "/system/etc/vintf/manifest.xml",
+    "/vendor/etc/vintf/manifest.xml",
+};
+
+} // namespace
+
+FileHashCollector::FileHashCollector()
+    : m_files(std::begin(kDefaultFiles), std::end(kDefaultFiles)) {}
+
+std::string FileHashCollector::collect() {
+    std::string result = "=== " + std::string(kFileHashesTitle) + " ===\n";
+    auto start = std::chrono::steady_clock::now();
+
+    WorkStealingPool& pool = WorkStealingPool::shared();
+    bool raw = activeIoBackend() == IoBackendType::RAW_SYSCALL;
+    uint64_t totalBytes = 0;
+    for (const std::string& path : m_files) {
+        content_hash::Result hash;
+        bool ok;
+        try {
+            ok = raw ? content_hash::hashFile<RawSyscallIo>(path.c_str(), pool, &hash)
+                     : content_hash::hashFile<LibcIo>(path.c_str(), pool, &hash);
+        } catch (const std::exception& e) {
+            LOGE("FileHashCollector", "Hashing %s failed: %s", path.c_str(), e.what());
+            result += path + ": Unable to retrieve: " + std::string(e.what()) + "\n";
+            continue;
+        }
+        if (!ok) {
+            if (errno == ENOENT) continue;
+            result += path + ": Unable to retrieve: " + std::string(strerror(errno)) + "\n";
+            continue;
+        }
+        totalBytes += hash.size;
+        result += path + ": blake3 " + hash.blake3 + ", size " + std::to_string(hash.size) + "\n";
+    }
+    result += "\n";
+
+    long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGI("FileHashCollector", "Hashed %llu bytes with %s on %u workers in %lldus",
+         static_cast<unsigned long long>(totalBytes), Blake3Hasher::kernelName(), pool.workerCount(), elapsedUs);
+    return result;
+}
+
+std::string FileHashCollector::getCollectorName() const {
+    return "FileHashCollector";
+}
@@ -0,0 +1,99 @@
+#include "../../include/KernelConfigCollector.h"
+#include "../../include/KernelConfigScanner.h"
+#include "../../include/IoBackend.h"
+#include "../../include/Logger.h"
+#include "../../include/private/ScopedFd.h"
+#include "../../include/FieldDefinitions.h"
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace {
+
+// 区分内核构建、调试/注入能力和加固选项
+constexpr const char* kDefaultOptions[] = {
+    "CONFIG_LOCALVERSION",
+    "CONFIG_CC_VERSION_TEXT",
+    "CONFIG_CMDLINE",
+    "CONFIG_NR_CPUS",
+    "CONFIG_HZ",
+    "CONFIG_ARM64_VA_BITS",
+    "CONFIG_ARM64_PAGE_SHIFT",
+    "CONFIG_MODULES",
+    "CONFIG_MODULE_SIG_FORCE",
+    "CONFIG_KALLSYMS_ALL",
+    "CONFIG_KPROBES",
+    "CONFIG_FTRACE",
+    "CONFIG_DEBUG_FS",
+    "CONFIG_KASAN",
+    "CONFIG_SECURITY_SELINUX_DEVELOP",
+    "CONFIG_CFI_CLANG",
+    "CONFIG_SHADOW_CALL_STACK",
+    "CONFIG_LTO_CLANG_THIN",
+};
+
+// unavailable表示文件不存在或无权读取：重启前不会变化，作为正常结果缓存而不是每次重试
+template <typename Io>
+bool scanWith(const char* path, KernelConfigScanner* scanner, std::string* error, bool* unavailable) {
+    ScopedFd fd(Io::openAt(AT_FDCWD, path, O_RDONLY | O_CLOEXEC));
+    if (fd.get() < 0) {
+        *unavailable = errno == ENOENT || errno == EACCES || errno == EPERM;
+        *error = errno == ENOENT ? "kernel built without CONFIG_IKCONFIG_PROC"
+                 : *unavailable  ? "permission denied"
+                                 : "cannot open " + std::string(path);
+        return false;
+    }
+    return scanner->scanGzip([&fd](void* buffer, size_t size) {
+        ssize_t bytes;
+        do {
+            bytes = Io::read(fd.get(), buffer, size);
+        } while (bytes < 0 && errno == EINTR);
+        return bytes;
+    }, error);
+}
+
+} // namespace
+
+KernelConfigCollector::KernelConfigCollector()
+    : m_path("/proc/config.gz"), m_options(std::begin(kDefaultOptions), std::end(kDefaultOptions)) {}
+
+std::string KernelConfigCollector::collect() {
+    std::string result = "=== " + std::string(kKernelConfigTitle) + " ===\n";
+    auto start = std::chrono::steady_clock::now();
+
+    KernelConfigScanner scanner(m_options);
+    std::string error;
+    bool unavailable = false;
+    bool ok = activeIoBackend() == IoBackendType::RAW_SYSCALL
+                      ? scanWith<RawSyscallIo>(m_path, &scanner, &error, &unavailable)
+                      : scanWith<LibcIo>(m_path, &scanner, &error, &unavailable);
+    if (!ok) {
+        LOGW("KernelConfigCollector", "Failed to scan %s: %s", m_path, error.c_str());
+        if (unavailable) return result + "status: unavailable (" + error + ")\n\n";
+        return result + "Unable to retrieve: " + error + "\n\n";
+    }
+
+    const KernelConfigScanner::Summary& summary = scanner.summary();
+    if (!summary.header.empty()) result += "header: " + summary.header + "\n";
+    for (const auto& option : summary.selected) {
+        result += option.first + ": " + (option.second.empty() ? "absent" : option.second) + "\n";
+    }
+    result += "options: builtin " + std::to_string(summary.builtin) + ", modules " +
+              std::to_string(summary.modules) + ", valued " + std::to_string(summary.valued) + ", not_set " +
+              std::to_string(summary.notSet) + "\n";
+
+    char digest[64];
+    snprintf(digest, sizeof(digest), "enabled_digest: %016" PRIx64 "\n\n", summary.enabledDigest);
+    result += digest;
+
+    long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGI("KernelConfigCollector", "Scanned %" PRIu64 " bytes of kernel config in %lldus",
+         summary.uncompressedBytes, elapsedUs);
+    return result;
+}
+
+std::string KernelConfigCollector::getCollectorName() const {
+    return "KernelConfigCollector";
+}
@@ -0,0 +1,132 @@
+#include "../../include/MapsCollector.h"
+#include "../../include/MapsScanner.h"
+#include "../../include/HashUtils.h"
+#include "../../include/IoBackend.h"
+#include "../../include/Logger.h"
+#include "../../include/private/ScopedFd.h"
+#include "../../include/FieldDefinitions.h"
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <string_view>
+
+namespace {
+
+// 系统分区和已安装应用的代码路径，其余位置的可执行映射视为不可信
+constexpr std::string_view kTrustedPrefixes[] = {
+    "/system/", "/system_ext/", "/product/", "/vendor/", "/odm/", "/apex/", "/data/app/", "/data/dalvik-cache/",
+};
+
+// 常见注入/hook框架在映射路径中留下的特征
+constexpr std::string_view kInjectionMarkers[] = {
+    "frida", "gadget", "xposed", "lsposed", "edxp", "substrate", "riru", "zygisk", "magisk",
+};
+
+bool isTrustedPath(std::string_view path) {
+    for (std::string_view prefix : kTrustedPrefixes) {
+        if (path.compare(0, prefix.size(), prefix) == 0) return true;
+    }
+    return false;
+}
+
+const char* injectionMarker(std::string_view path) {
+    for (std::string_view marker : kInjectionMarkers) {
+        if (path.find(marker) != std::string_view::npos) return marker.data();
+    }
+    return nullptr;
+}
+
+template <typename Io>
+bool scanWith(const char* path, MapsScanner* scanner) {
+    ScopedFd fd(Io::openAt(AT_FDCWD, path, O_RDONLY | O_CLOEXEC));
+    if (fd.get() < 0) return false;
+    return scanner->scan([&fd](void* buffer, size_t size) {
+        ssize_t bytes;
+        do {
+            bytes = Io::read(fd.get(), buffer, size);
+        } while (bytes < 0 && errno == EINTR);
+        return bytes;
+    });
+}
+
+std::string permissionString(uint8_t permissions) {
+    std::string text = "---p";
+    if (permissions & MapsScanner::PERM_READ) text[0] = 'r';
+    if (permissions & MapsScanner::PERM_WRITE) text[1] = 'w';
+    if (permissions & MapsScanner::PERM_EXEC) text[2] = 'x';
+    if (permissions & MapsScanner::PERM_SHARED) text[3] = 's';
+    return text;
+}
+
+} // namespace
+
+std::string MapsCollector::collect() {
+    std::string result = "=== " + std::string(kMemoryMapsTitle) + " ===\n";
+    auto start = std::chrono::steady_clock::now();
+
+    // 扫描器的缓冲区和路径表在同一线程的多次收集之间复用
+    thread_local MapsScanner scanner;
+    bool ok = activeIoBackend() == IoBackendType::RAW_SYSCALL ? scanWith<RawSyscallIo>(m_path, &scanner)
+                                                              : scanWith<LibcIo>(m_path, &scanner);
+    if (!ok) {
+        LOGW("MapsCollector", "Failed to read %s: errno %d", m_path, errno);
+        return result + "Unable to retrieve: cannot read " + m_path + "\n\n";
+    }
+
+    const MapsScanner::Summary& summary = scanner.summary();
+    std::string codeObjects;
+    std::string suspicious;
+    uint32_t codeCount = 0;
+    uint32_t untrustedExec = 0;
+    uint64_t librarySetDigest = 0;
+    char line[512];
+    for (const MapsScanner::Object& object : scanner.objects()) {
+        std::string_view path = scanner.path(object);
+        const char* marker = injectionMarker(path);
+        if (marker != nullptr) {
+            snprintf(line, sizeof(line), "injection_marker: %s (%.*s)\n", marker,
+                     static_cast<int>(path.size()), path.data());
+            suspicious += line;
+        }
+        if (!MapsScanner::isCodeObject(object, path)) continue;
+
+        ++codeCount;
+        // 只按路径求和，与加载顺序和ASLR地址无关
+        librarySetDigest += mix64(fnv1a64(path.data(), path.size()));
+        snprintf(line, sizeof(line), "%.*s %" PRIx64 "-%" PRIx64 " %s %u%s\n", static_cast<int>(path.size()),
+                 path.data(), object.low, object.high, permissionString(object.permissions).c_str(),
+                 object.mappings, object.deleted ? " (deleted)" : "");
+        codeObjects += line;
+        if (!isTrustedPath(path)) {
+            ++untrustedExec;
+            snprintf(line, sizeof(line), "untrusted_exec: %.*s\n", static_cast<int>(path.size()), path.data());
+            suspicious += line;
+        }
+    }
+
+    result += "mappings: " + std::to_string(summary.mappings) + ", objects " +
+              std::to_string(scanner.objects().size()) + ", code_objects " + std::to_string(codeCount) +
+              ", mapped_bytes " + std::to_string(summary.mappedBytes) + "\n";
+    result += "anonymous_exec: " + std::to_string(summary.anonymousExec) + ", rwx " +
+              std::to_string(summary.writableExec) + ", deleted_exec " + std::to_string(summary.deletedExec) +
+              ", memfd_exec " + std::to_string(summary.memfdExec) + ", untrusted_exec " +
+              std::to_string(untrustedExec) + "\n";
+    if (summary.malformed > 0) result += "malformed_lines: " + std::to_string(summary.malformed) + "\n";
+    result += codeObjects;
+    result += suspicious;
+
+    char digest[64];
+    snprintf(digest, sizeof(digest), "library_set_digest: %016" PRIx64 "\n\n", librarySetDigest);
+    result += digest;
+
+    long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGI("MapsCollector", "Scanned %u mappings (%zu objects) in %lldus", summary.mappings,
+         scanner.objects().size(), elapsedUs);
+    return result;
+}
+
+std::string MapsCollector::getCollectorName() const {
+    return "MapsCollector";
+}
@@ -0,0 +1,109 @@
+#include "../../include/MediaManifestCollector.h"
+#include "../../include/DirentScanner.h"
+#include "../../include/FileReader.h"
+#include "../../include/IoBackend.h"
+#include "../../include/Logger.h"
+#include "../../include/MediaManifest.h"
+#include "../../include/WorkStealingPool.h"
+#include "../../include/XmlTokenizer.h"
+#include "../../include/FieldDefinitions.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+struct ManifestDirectory {
+    const char* path;
+    const char* prefix;     // 文件名前缀，空表示目录下所有 .xml
+};
+
+// 编解码器清单在vendor/odm（厂商硬件编解码器）和system（软件编解码器）下，特性声明分布在各分区
+constexpr ManifestDirectory kDirectories[] = {
+    {"/vendor/etc/", "media_codecs"},
+    {"/odm/etc/", "media_codecs"},
+    {"/system/etc/", "media_codecs"},
+    {"/system/etc/permissions/", ""},
+    {"/vendor/etc/permissions/", ""},
+    {"/odm/etc/permissions/", ""},
+    {"/product/etc/permissions/", ""},
+};
+
+template <typename Io>
+std::vector<std::string> listManifests() {
+    std::vector<std::string> paths;
+    for (const ManifestDirectory& directory : kDirectories) {
+        ScopedFd dir(Io::openAt(AT_FDCWD, directory.path, O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+        if (dir.get() < 0) continue;
+        size_t prefixLength = strlen(directory.prefix);
+        std::vector<std::string> names;
+        dirent_scan::forEachEntry<Io>(dir.get(), [&](const char* name, unsigned char type) {
+            size_t length = strlen(name);
+            if (type != DT_DIR && length > prefixLength + 4 && strncmp(name, directory.prefix, prefixLength) == 0 &&
+                strcmp(name + length - 4, ".xml") == 0) {
+                names.emplace_back(name);
+            }
+            return true;
+        });
+        std::sort(names.begin(), names.end());
+        for (const std::string& name : names) paths.push_back(directory.path + name);
+    }
+    return paths;
+}
+
+template <typename Io>
+bool readManifest(const char* path, std::string* out) {
+    return file_reader::readAll<Io>(path, out) == file_reader::Status::OK;
+}
+
+template <typename Io>
+media_manifest::Summary scanManifests() {
+    return media_manifest::scanFiles(listManifests<Io>(), readManifest<Io>, WorkStealingPool::shared());
+}
+
+} // namespace
+
+MediaManifestCollector::MediaManifestCollector() {}
+
+std::string MediaManifestCollector::collect() {
+    std::string result = "=== " + std::string(kMediaManifestsTitle) + " ===\n";
+    auto start = std::chrono::steady_clock::now();
+
+    media_manifest::Summary summary;
+    try {
+        summary = activeIoBackend() == IoBackendType::RAW_SYSCALL ? scanManifests<RawSyscallIo>()
+                                                                  : scanManifests<LibcIo>();
+    } catch (const std::exception& e) {
+        LOGE("MediaManifestCollector", "Manifest scan failed: %s", e.what());
+        return result + "Unable to retrieve: " + std::string(e.what()) + "\n\n";
+    }
+    if (summary.files == 0) return result + "Unable to retrieve: no readable manifests\n\n";
+
+    result += "files: " + std::to_string(summary.files) + ", bytes " + std::to_string(summary.bytes) +
+              ", malformed " + std::to_string(summary.malformedFiles) + "\n";
+    result += "codecs: decoders " + std::to_string(summary.decoders) + ", encoders " +
+              std::to_string(summary.encoders) + "\n";
+    result += "features: " + std::to_string(summary.features) + ", unavailable " +
+              std::to_string(summary.unavailable) + "\n";
+    result += "manifest_digest: " + summary.digest + "\n";
+    result += "feature_digest: " + summary.featureDigest + "\n";
+    // 编解码器只计入摘要；特性列表较短，逐条输出
+    for (const std::string& entry : summary.entries) {
+        if (entry.compare(0, 8, "feature ") == 0) {
+            result += "feature: " + entry.substr(8) + "\n";
+        } else if (entry.compare(0, 12, "unavailable ") == 0) {
+            result += "unavailable: " + entry.substr(12) + "\n";
+        }
+    }
+    result += "\n";
+
+    long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGI("MediaManifestCollector", "Scanned %u manifests (%llu bytes, %s) in %lldus", summary.files,
+         static_cast<unsigned long long>(summary.bytes), xml::kernelName(), elapsedUs);
+    return result;
+}
+
+std::string MediaManifestCollector::getCollectorName() const {
+    return "MediaManifestCollector";
+}
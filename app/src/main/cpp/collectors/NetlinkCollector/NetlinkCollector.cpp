@@ -0,0 +1,48 @@
+#include "../../include/NetlinkCollector.h"
+#include "../../include/Logger.h"
+#include "../../include/FieldDefinitions.h"
+#include "ifaddrs.h"
+#include <linux/if_packet.h>
+#include <netdb.h>
+#include <cstdio>
+
+std::string NetlinkCollector::collect() {
+    std::string result = "=== " + std::string(kNetlinkTitle) + " ===\n";
+
+    struct ifaddrs* ifap = nullptr;
+    if (myGetifaddrs(&ifap) != 0) {
+        LOGE("NetlinkCollector", "myGetifaddrs failed, errno: %d", errno);
+        return result + "Unable to retrieve: netlink dump failed\n\n";
+    }
+
+    for (struct ifaddrs* ifa = ifap; ifa != nullptr; ifa = ifa->ifa_next) {
+        if (ifa->ifa_addr == nullptr || ifa->ifa_name == nullptr) continue;
+
+        sa_family_t family = ifa->ifa_addr->sa_family;
+        if (family == AF_PACKET) {
+            auto* sll = reinterpret_cast<struct sockaddr_ll*>(ifa->ifa_addr);
+            char mac[18];
+            snprintf(mac, sizeof(mac), "%02X:%02X:%02X:%02X:%02X:%02X",
+                     sll->sll_addr[0], sll->sll_addr[1], sll->sll_addr[2],
+                     sll->sll_addr[3], sll->sll_addr[4], sll->sll_addr[5]);
+            result += std::string(ifa->ifa_name) + " MAC: " + mac + "\n";
+        } else if (family == AF_INET || family == AF_INET6) {
+            char host[NI_MAXHOST];
+            socklen_t len = (family == AF_INET) ? sizeof(struct sockaddr_in) : sizeof(struct sockaddr_in6);
+            int ret = getnameinfo(ifa->ifa_addr, len, host, NI_MAXHOST, nullptr, 0, NI_NUMERICHOST);
+            if (ret != 0) {
+                LOGE("NetlinkCollector", "getnameinfo() failed: %s", gai_strerror(ret));
+                continue;
+            }
+            result += std::string(ifa->ifa_name) + (family == AF_INET ? " IPv4: " : " IPv6: ") + host + "\n";
+        }
+    }
+    freeifaddrs(ifap);
+
+    result += "\n";
+    return result;
+}
+
+std::string NetlinkCollector::getCollectorName() const {
+    return "NetlinkCollector";
+}
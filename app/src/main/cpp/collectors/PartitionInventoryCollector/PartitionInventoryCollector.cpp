@@ -0,0 +1,78 @@
+#include "../../include/PartitionInventoryCollector.h"
+#include "../../include/PartitionInventory.h"
+#include "../../include/IoBackend.h"
+#include "../../include/Logger.h"
+#include "../../include/FieldDefinitions.h"
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace {
+
+constexpr const char* kDefaultRoots[] = {
+    "/system/framework",
+    "/system/lib64",
+    "/system/bin",
+    "/vendor/lib64",
+    "/apex",
+};
+
+std::string hex64(uint64_t value) {
+    char buffer[17];
+    snprintf(buffer, sizeof(buffer), "%016" PRIx64, value);
+    return buffer;
+}
+
+} // namespace
+
+PartitionInventoryCollector::PartitionInventoryCollector()
+    : m_roots(std::begin(kDefaultRoots), std::end(kDefaultRoots)) {}
+
+std::string PartitionInventoryCollector::collect() {
+    std::string result = "=== " + std::string(kPartitionInventoryTitle) + " ===\n";
+    auto start = std::chrono::steady_clock::now();
+
+    WorkStealingPool& pool = WorkStealingPool::shared();
+    std::vector<partition_inventory::RootResult> roots;
+    try {
+        if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+            roots = partition_inventory::scan<RawSyscallIo>(m_roots, pool);
+        } else {
+            roots = partition_inventory::scan<LibcIo>(m_roots, pool);
+        }
+    } catch (const std::exception& e) {
+        LOGE("PartitionInventoryCollector", "Inventory scan failed: %s", e.what());
+        return result + "Unable to retrieve: " + std::string(e.what()) + "\n\n";
+    }
+
+    uint64_t entries = 0;
+    size_t present = 0;
+    for (const partition_inventory::RootResult& root : roots) {
+        // 根目录不存在（如32位vendor镜像没有/vendor/lib64）是设备的正常状态，不算分区失败
+        if (!root.present) {
+            result += root.path + ": absent\n";
+            continue;
+        }
+        ++present;
+        entries += root.entries;
+        result += root.path + ": entries " + std::to_string(root.entries) + ", dirs " +
+                  std::to_string(root.directories) + ", bytes " + std::to_string(root.totalBytes) +
+                  ", digest " + hex64(root.digest);
+        if (root.errors > 0) result += ", errors " + std::to_string(root.errors);
+        result += "\n";
+    }
+    if (present == 0) {
+        return result + "Unable to retrieve: no readable roots\n\n";
+    }
+    result += "inventory_digest: " + hex64(partition_inventory::combinedDigest(roots)) + "\n\n";
+
+    long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGI("PartitionInventoryCollector", "Hashed %" PRIu64 " entries on %u workers in %lldus", entries,
+         pool.workerCount(), elapsedUs);
+    return result;
+}
+
+std::string PartitionInventoryCollector::getCollectorName() const {
+    return "PartitionInventoryCollector";
+}
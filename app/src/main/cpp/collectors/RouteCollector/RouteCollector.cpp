@@ -0,0 +1,85 @@
+#include "../../include/RouteCollector.h"
+#include "../../include/RouteSnapshot.h"
+#include "../../include/HashUtils.h"
+#include "../../include/Logger.h"
+#include "../../include/FieldDefinitions.h"
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+
+namespace {
+
+std::string routeLine(const route_snapshot::Snapshot& snapshot, const route_snapshot::Route& route) {
+    std::string line = route.destinationLength == 0 ? "default"
+                                                    : route_snapshot::formatAddress(route.destination) + "/" +
+                                                              std::to_string(route.destinationLength);
+    if (!route.gateway.empty()) line += " via " + route_snapshot::formatAddress(route.gateway);
+    if (route.outputInterface > 0) line += " dev " + route_snapshot::interfaceName(snapshot, route.outputInterface);
+    line += " table " + std::to_string(route.table);
+    if (route.priority != 0) line += " metric " + std::to_string(route.priority);
+    return line;
+}
+
+} // namespace
+
+std::string RouteCollector::collect() {
+    std::string result = "=== " + std::string(kRoutesTitle) + " ===\n";
+    auto start = std::chrono::steady_clock::now();
+
+    netlink::Socket socket;
+    route_snapshot::Snapshot snapshot;
+    if (!route_snapshot::collect(socket, &snapshot)) {
+        LOGE("RouteCollector", "Route dump failed, errno: %d", socket.error());
+        return result + "Unable to retrieve: route dump failed (errno " + std::to_string(socket.error()) + ")\n\n";
+    }
+
+    std::string defaults;
+    std::string routes;
+    uint32_t ipv4 = 0;
+    uint32_t ipv6 = 0;
+    uint64_t digest = 0;
+    for (const route_snapshot::Route& route : snapshot.routes) {
+        // local表是本机地址和广播路由，其余单播路由才描述网络拓扑
+        if (route.table == RT_TABLE_LOCAL || route.type != RTN_UNICAST) continue;
+        std::string line = routeLine(snapshot, route);
+        ++(route.family == AF_INET ? ipv4 : ipv6);
+        // 与转储顺序无关
+        digest += mix64(fnv1a64(line.data(), line.size()));
+        routes += "route: " + line + "\n";
+
+        if (!route_snapshot::isDefaultRoute(route)) continue;
+        defaults += std::string(route.family == AF_INET ? "default_ipv4: " : "default_ipv6: ") + line + "\n";
+        const route_snapshot::Neighbor* router = route_snapshot::gatewayNeighbor(snapshot, route);
+        if (router != nullptr && router->linkLayerLength > 0) {
+            std::string mac = route_snapshot::formatLinkLayer(*router);
+            defaults += "gateway_mac: " + route_snapshot::formatAddress(router->address) + " " + mac + " (" +
+                        route_snapshot::neighborStateName(router->state) + ")\n";
+            digest += mix64(fnv1a64(mac.data(), mac.size()));
+        }
+    }
+
+    result += defaults.empty() ? "default_route: none\n" : defaults;
+    if (snapshot.neighborError != 0) {
+        result += "gateway_mac: Unable to retrieve: neighbor dump denied (errno " +
+                  std::to_string(snapshot.neighborError) + ")\n";
+    }
+    result += routes;
+    result += "routes: ipv4 " + std::to_string(ipv4) + ", ipv6 " + std::to_string(ipv6) + ", neighbors " +
+              std::to_string(snapshot.neighbors.size()) + "\n";
+    if (snapshot.interrupted) result += "dump_interrupted: true\n";
+
+    char line[64];
+    snprintf(line, sizeof(line), "route_digest: %016" PRIx64 "\n\n", digest);
+    result += line;
+
+    long long elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    LOGI("RouteCollector", "Dumped %zu routes, %zu neighbors (%u messages, %" PRIu64 " bytes) in %lldus",
+         snapshot.routes.size(), snapshot.neighbors.size(), socket.stats().messages, socket.stats().bytes,
+         elapsedUs);
+    return result;
+}
+
+std::string RouteCollector::getCollectorName() const {
+    return "RouteCollector";
+}
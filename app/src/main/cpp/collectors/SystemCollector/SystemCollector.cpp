@@ -1,8 +1,14 @@
 #include "../../include/SystemCollector.h"
 #include "../../include/Logger.h"
+#include "../../include/SectionCache.h"
+#include "../../include/FileSignatureCache.h"
+#include "../../include/IoBackend.h"
+#include "../../include/FieldDefinitions.h"
+#include "../../include/KeyPropertyFilter.h"
 #include <sys/statfs.h>
 #include <cstdio>
 #include <cstdlib>
+#include <cstring>
 #include <media/NdkMediaDrm.h>
 #include <unistd.h>
 #include <fcntl.h>
@@ -12,6 +18,7 @@
 #include <sstream>
 #include <sys/utsname.h>
 #include <algorithm>
+#include <chrono>
 
 SystemCollector::SystemCollector(JNIEnv* env) : m_env(env) {
 }
@@ -21,7 +28,7 @@ std::string SystemCollector::collect() {
     
     try {
         result += collectFileSystemInfo();
-        result += collectDrmId();
+        result += SectionCache::instance().getOrCollect(SECTION_DRM_ID, [this]() { return collectDrmId(); });
         result += collectKernelFilesInfo();
         result += collectSystemFilesInfo();
     } catch (const std::exception& e) {
@@ -37,7 +44,7 @@ std::string SystemCollector::getCollectorName() const {
 }
 
 std::string SystemCollector::collectFileSystemInfo() {
-    std::string result = "=== File System Information ===\n\n";
+    std::string result = "=== " + std::string(kFileSystemTitle) + " ===\n\n";
     
     // Method 1: Using Java StatFs
     try {
@@ -72,22 +79,13 @@ std::string SystemCollector::collectFileSystemInfo() {
     
     // Method 2: Using stat command
     result += "stat command output:\n";
-    char buffer[1024];
-    FILE *fp = popen("stat -f /storage/emulated/0", "r");
-    if (fp != nullptr) {
-        while (fgets(buffer, sizeof(buffer), fp) != nullptr) {
-            result += buffer;
-        }
-        pclose(fp);
-    } else {
-        result += "Failed to execute stat command\n";
-    }
+    result += executeCommand("stat -f /storage/emulated/0");
     result += "\n";
     
     // Method 3: Using statfs64 system call
     result += "statfs64 system call:\n";
     struct statfs64 buf = {};
-    if (statfs64("/storage/emulated/0", &buf) == 0) {
+    if (statFileSystem("/storage/emulated/0", &buf) == 0) {
         result += "File System Type: " + std::to_string(buf.f_type) + "\n";
         result += "Block Size: " + std::to_string(buf.f_bsize) + "\n";
         result += "Total Blocks: " + std::to_string(buf.f_blocks) + "\n";
@@ -105,7 +103,7 @@ std::string SystemCollector::collectFileSystemInfo() {
 }
 
 std::string SystemCollector::collectDrmId() {
-    std::string result = "\n=== DRM ID Information ===\n\n";
+    std::string result = "\n=== " + std::string(kDrmIdTitle) + " ===\n\n";
     
     LOGI("SystemCollector", "Starting DRM ID retrieval...");
     
@@ -159,39 +157,40 @@ std::string SystemCollector::collectDrmId() {
 }
 
 std::string SystemCollector::collectKernelFilesInfo() {
-    std::string result = "\n=== Kernel Files Information ===\n\n";
+    std::string result = "\n=== " + std::string(kKernelFilesTitle) + " ===\n\n";
     
     LOGI("SystemCollector", "Starting kernel files info retrieval...");
     
     try {
-        result += collectBuildPropFiles();
+        result += SectionCache::instance().getOrCollect(SECTION_BUILD_PROP, [this]() { return collectBuildPropFiles(); });
+        // 内核配置（/proc/config.gz）是独立分区，普通应用通常无权读取，不嵌套在这里
         
         // 添加其他重要的系统文件
-        std::vector<std::string> other_files = {
-            "/proc/version",
-            "/proc/cpuinfo",
-            "/proc/meminfo",
-            "/system/etc/prop.default"
-        };
+        std::vector<std::string> other_files(std::begin(kOtherSystemFiles), std::end(kOtherSystemFiles));
         
         result += "=== Other System Files ===\n";
-        for (const auto& filepath : other_files) {
+        // 一次性stat所有路径，签名未变化的文件直接复用上次的结果
+        std::vector<std::string> sections = FileSignatureCache::instance().getOrComputeBatch(
+                other_files, [](const std::string& filepath, bool exists) {
             LOGI("SystemCollector", "Reading file: %s", filepath.c_str());
             
-            if (fileExists(filepath.c_str())) {
-                std::string content = readFile(filepath.c_str());
-                result += "--- " + filepath + " ---\n";
-                if (content.length() > 1000) {
-                    // 截取前1000个字符
-                    result += content.substr(0, 1000) + "...\n";
-                } else {
-                    result += content + "\n";
-                }
-                result += "\n";
+            std::string section = "--- " + filepath + " ---\n";
+            if (!exists) {
+                return section + "File does not exist\n\n";
+            }
+            
+            // 只读取前kOtherSystemFilePrefix个字符
+            bool truncated = false;
+            std::string content = readFilePrefix(filepath.c_str(), kOtherSystemFilePrefix, &truncated);
+            if (truncated) {
+                section += content + "...\n";
             } else {
-                result += "--- " + filepath + " ---\n";
-                result += "File does not exist\n\n";
+                section += content + "\n";
             }
+            return section + "\n";
+        });
+        for (const auto& section : sections) {
+            result += section;
         }
         
         LOGI("SystemCollector", "Kernel files info retrieval completed");
@@ -207,13 +206,15 @@ std::string SystemCollector::collectKernelFilesInfo() {
 }
 
 std::string SystemCollector::collectSystemFilesInfo() {
-    std::string result = "\n=== System Files Information (Important Device Fingerprints) ===\n\n";
+    std::string result = "\n=== " + std::string(kSystemFilesTitle) + " ===\n\n";
     
     LOGI("SystemCollector", "Starting system files info retrieval...");
     
     try {
         result += collectSystemFiles();
-        result += getUnameInfo();
+        // 块设备、分区清单、ELF build-id、媒体清单是独立分区（各有自己的预算），不嵌套在这里：
+        // 它们的耗时不能拖累boot_id等标识字段
+        result += SectionCache::instance().getOrCollect(SECTION_UNAME, [this]() { return getUnameInfo(); });
         result += collectAdditionalSystemInfo();
         
         LOGI("SystemCollector", "System files info retrieval completed");
@@ -228,73 +229,22 @@ std::string SystemCollector::collectSystemFilesInfo() {
     }
 }
 
-std::string SystemCollector::parseBuildProp(const std::string& content, const std::string& filepath) {
+std::string SystemCollector::parseBuildProp(const std::string& filepath) {
     std::string result = "=== " + filepath + " ===\n";
     
-    if (content.empty()) {
+    // 所有关键属性都已找到时不再读取文件剩余部分
+    KeyPropertyFilter filter;
+    long bytes = readFileLines(filepath.c_str(), [&filter](std::string_view line) { return filter.onLine(line); });
+    
+    if (bytes <= 0) {
         result += "File is empty or could not be read\n\n";
         return result;
     }
     
-    // 关键属性列表
-    std::vector<std::string> key_properties = {
-        "ro.build.fingerprint",
-        "ro.build.display.id",
-        "ro.build.version.release",
-        "ro.build.version.sdk",
-        "ro.build.version.codename",
-        "ro.build.version.incremental",
-        "ro.build.date",
-        "ro.build.date.utc",
-        "ro.build.type",
-        "ro.build.user",
-        "ro.build.host",
-        "ro.build.tags",
-        "ro.product.model",
-        "ro.product.brand",
-        "ro.product.name",
-        "ro.product.device",
-        "ro.product.manufacturer",
-        "ro.product.cpu.abi",
-        "ro.product.cpu.abilist",
-        "ro.product.locale",
-        "ro.board.platform",
-        "ro.build.id",
-        "ro.build.version.security_patch",
-        "ro.build.version.base_os",
-        "ro.build.version.preview_sdk",
-        "ro.build.version.min_supported_target_sdk"
-    };
-    
-    std::istringstream stream(content);
-    std::string line;
-    std::vector<std::string> found_properties;
-    
-    while (std::getline(stream, line)) {
-        // 跳过注释和空行
-        if (line.empty() || line[0] == '#') continue;
-        
-        size_t pos = line.find('=');
-        if (pos != std::string::npos) {
-            std::string key = line.substr(0, pos);
-            std::string value = line.substr(pos + 1);
-            
-            // 检查是否是关键属性
-            for (const auto& prop : key_properties) {
-                if (key == prop) {
-                    found_properties.push_back(key + "=" + value);
-                    break;
-                }
-            }
-        }
-    }
-    
-    if (found_properties.empty()) {
+    if (filter.found().empty()) {
         result += "No key properties found\n";
     } else {
-        for (const auto& prop : found_properties) {
-            result += prop + "\n";
-        }
+        result += filter.found();
     }
     
     result += "\n";
@@ -302,18 +252,18 @@ std::string SystemCollector::parseBuildProp(const std::string& content, const st
 }
 
 std::string SystemCollector::getUnameInfo() {
-    std::string result = "=== uname system call (Android 11+ fallback) ===\n";
+    std::string result = "=== " + std::string(kUnameTitle) + " ===\n";
     
     try {
         struct utsname buff;
-        int ret = uname(&buff);
+        int ret = getUname(&buff);
         
         if (ret == 0) {
             result += "sysname: " + std::string(buff.sysname) + "\n";
             result += "nodename: " + std::string(buff.nodename) + "\n";
-            result += "release: " + std::string(buff.release) + "\n";
-            result += "version: " + std::string(buff.version) + "\n";
-            result += "machine: " + std::string(buff.machine) + "\n";
+            result += std::string(kUnameReleaseKey) + ": " + std::string(buff.release) + "\n";
+            result += std::string(kUnameVersionKey) + ": " + std::string(buff.version) + "\n";
+            result += std::string(kUnameMachineKey) + ": " + std::string(buff.machine) + "\n";
             result += "domainname: " + std::string(buff.domainname) + "\n";
         } else {
             result += "uname system call failed, errno: " + std::to_string(errno) + "\n";
@@ -330,23 +280,20 @@ std::string SystemCollector::collectBuildPropFiles() {
     std::string result;
     
     // 四个主要的build.prop文件路径
-    std::vector<std::string> build_prop_files = {
-        "/system/build.prop",
-        "/odm/etc/build.prop", 
-        "/product/build.prop",
-        "/vendor/build.prop"
-    };
+    std::vector<std::string> build_prop_files(std::begin(kBuildPropFiles), std::end(kBuildPropFiles));
     
-    for (const auto& filepath : build_prop_files) {
+    // 分区文件只会在OTA后变化，签名不变时跳过读取和解析
+    std::vector<std::string> sections = FileSignatureCache::instance().getOrComputeBatch(
+            build_prop_files, [this](const std::string& filepath, bool exists) {
         LOGI("SystemCollector", "Reading file: %s", filepath.c_str());
         
-        if (fileExists(filepath.c_str())) {
-            std::string content = readFile(filepath.c_str());
-            result += parseBuildProp(content, filepath);
-        } else {
-            result += "=== " + filepath + " ===\n";
-            result += "File does not exist\n\n";
+        if (!exists) {
+            return "=== " + filepath + " ===\n" + "File does not exist\n\n";
         }
+        return parseBuildProp(filepath);
+    });
+    for (const auto& section : sections) {
+        result += section;
     }
     
     return result;
@@ -356,22 +303,13 @@ std::string SystemCollector::collectSystemFiles() {
     std::string result;
     
     // 重要的系统文件列表
-    std::vector<std::string> system_files = {
-        "/proc/sys/kernel/random/boot_id",
-        "/proc/sys/kernel/random/uuid", 
-        "/sys/block/mmcblk0/device/cid",
-        "/sys/devices/soc0/serial_number",
-        "/proc/misc",
-        "/proc/version"
-    };
-    
-    for (const auto& filepath : system_files) {
-        LOGI("SystemCollector", "Reading system file: %s", filepath.c_str());
+    for (const char* filepath : kSystemIdentifierFiles) {
+        LOGI("SystemCollector", "Reading system file: %s", filepath);
         
-        result += "=== " + filepath + " ===\n";
+        result += "=== " + std::string(filepath) + " ===\n";
         
-        if (fileExists(filepath.c_str())) {
-            std::string content = readFile(filepath.c_str());
+        if (fileExists(filepath)) {
+            std::string content = readFile(filepath);
             if (content.empty() || content.find("Unable to read") != std::string::npos) {
                 result += "File exists but could not be read\n";
             } else {
@@ -379,7 +317,7 @@ std::string SystemCollector::collectSystemFiles() {
                 std::string clean_content = content;
                 clean_content.erase(std::remove(clean_content.begin(), clean_content.end(), '\n'), clean_content.end());
                 clean_content.erase(std::remove(clean_content.begin(), clean_content.end(), '\r'), clean_content.end());
-                result += "Content: " + clean_content + "\n";
+                result += std::string(kIdentifierContentKey) + ": " + clean_content + "\n";
             }
         } else {
             result += "File does not exist\n";
@@ -394,30 +332,72 @@ std::string SystemCollector::collectAdditionalSystemInfo() {
     std::string result = "=== Additional System Information ===\n";
     
     // 添加一些额外的系统信息文件
-    std::vector<std::string> additional_files = {
-        "/proc/cmdline",
-        "/proc/cpuinfo",
-        "/proc/meminfo",
-        "/sys/class/dmi/id/product_uuid",
-        "/sys/class/dmi/id/board_serial",
-        "/sys/class/dmi/id/chassis_serial"
-    };
+    std::vector<std::string> additional_files(std::begin(kAdditionalSystemFiles), std::end(kAdditionalSystemFiles));
     
-    for (const auto& filepath : additional_files) {
+    std::vector<std::string> sections = FileSignatureCache::instance().getOrComputeBatch(
+            additional_files, [](const std::string& filepath, bool exists) {
+        if (!exists) {
+            return std::string();
+        }
+        
         LOGI("SystemCollector", "Reading additional file: %s", filepath.c_str());
+        // 只读取前kAdditionalSystemFilePrefix个字符
+        bool truncated = false;
+        std::string content = readFilePrefix(filepath.c_str(), kAdditionalSystemFilePrefix, &truncated);
+        std::string section = "--- " + filepath + " ---\n";
+        if (truncated) {
+            section += content + "...\n";
+        } else {
+            section += content + "\n";
+        }
+        return section + "\n";
+    });
+    for (const auto& section : sections) {
+        result += section;
+    }
+    
+    return result;
+}
+
+std::string SystemCollector::benchmarkIoBackends(int iterations) {
+    std::string result = "=== I/O Backend Benchmark ===\n";
+    
+    // 与各收集方法读取的文件一致的完整扫描列表，直接取自FieldDefinitions.h，多个方法都读的文件只计一次
+    std::vector<const char*> sweep_files;
+    auto addSweepFiles = [&sweep_files](const char* const* begin, const char* const* end) {
+        for (const char* const* it = begin; it != end; ++it) {
+            bool seen = std::any_of(sweep_files.begin(), sweep_files.end(),
+                                    [it](const char* path) { return strcmp(path, *it) == 0; });
+            if (!seen) sweep_files.push_back(*it);
+        }
+    };
+    addSweepFiles(std::begin(kBuildPropFiles), std::end(kBuildPropFiles));
+    addSweepFiles(std::begin(kOtherSystemFiles), std::end(kOtherSystemFiles));
+    addSweepFiles(std::begin(kSystemIdentifierFiles), std::end(kSystemIdentifierFiles));
+    addSweepFiles(std::begin(kAdditionalSystemFiles), std::end(kAdditionalSystemFiles));
+    
+    IoBackendType previous = activeIoBackend();
+    for (IoBackendType type : {IoBackendType::LIBC, IoBackendType::RAW_SYSCALL}) {
+        setActiveIoBackend(type);
         
-        if (fileExists(filepath.c_str())) {
-            std::string content = readFile(filepath.c_str());
-            result += "--- " + filepath + " ---\n";
-            if (content.length() > 500) {
-                // 截取前500个字符
-                result += content.substr(0, 500) + "...\n";
-            } else {
-                result += content + "\n";
+        size_t bytes = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            for (const char* filepath : sweep_files) {
+                if (fileExists(filepath)) {
+                    bytes += readFile(filepath).size();
+                }
             }
-            result += "\n";
         }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count();
+        
+        result += std::string(ioBackendName(type)) + ": " + std::to_string(elapsed) + " us total, " +
+                  std::to_string(iterations > 0 ? elapsed / iterations : 0) + " us/sweep, " +
+                  std::to_string(bytes) + " bytes\n";
     }
+    setActiveIoBackend(previous);
     
+    result += "\n";
     return result;
 }
@@ -0,0 +1,53 @@
+#ifndef ASYNC_COLLECTOR_H
+#define ASYNC_COLLECTOR_H
+
+#include "FingerprintSections.h"
+#include <jni.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * 非阻塞收集接口
+ * collectAsync(mask, callback) 把请求放到NativeExecutor排队，
+ * 完成后通过缓存的jmethodID回调 FingerprintCallback.onFingerprintResult
+ */
+class AsyncCollector {
+public:
+    // 与Kotlin侧 FingerprintCallback 中的常量保持一致
+    enum Status {
+        STATUS_OK = 0,
+        STATUS_CANCELLED = 1,
+        STATUS_DEADLINE_EXCEEDED = 2,
+    };
+
+    static AsyncCollector& instance();
+
+    // JNI_OnLoad中调用，缓存回调接口的方法ID
+    static bool cacheCallbackMethod(JNIEnv* env);
+
+    // deadlineMs <= 0 表示不限时，等待完整结果；返回请求ID
+    int submit(JNIEnv* env, uint32_t mask, jlong deadlineMs, jobject callback);
+    bool cancel(int requestId);
+
+private:
+    struct Request {
+        int id;
+        uint32_t mask;
+        std::chrono::steady_clock::time_point deadline;    // 不限时为 DeadlineRunner::kNoDeadline
+        std::atomic<bool> cancelled{false};
+        jobject callback;  // global ref
+    };
+
+    AsyncCollector() = default;
+    void run(JNIEnv* env, const std::shared_ptr<Request>& request);
+    void deliver(JNIEnv* env, const std::shared_ptr<Request>& request, Status status, const std::string& result);
+
+    std::mutex m_mutex;
+    std::unordered_map<int, std::shared_ptr<Request>> m_pending;
+    std::atomic<int> m_nextId{1};
+};
+
+#endif // ASYNC_COLLECTOR_H
@@ -1,9 +1,14 @@
 #ifndef BASE_COLLECTOR_H
 #define BASE_COLLECTOR_H
 
+#include <functional>
 #include <string>
+#include <string_view>
 #include <jni.h>
 
+struct statfs64;
+struct utsname;
+
 class BaseCollector {
 public:
     virtual ~BaseCollector() = default;
@@ -16,8 +21,17 @@ public:
 protected:
     static bool fileExists(const char* filepath);
     static std::string readFile(const char* filepath);
+    // 只按pread分块读取前maxBytes字节；truncated表示文件在maxBytes之后还有内容
+    static std::string readFilePrefix(const char* filepath, size_t maxBytes, bool* truncated = nullptr);
+    // 分块读取并逐行回调（不含换行符），onLine返回false时不再读取剩余内容
+    // 返回已读取的字节数，打开或读取失败返回-1
+    static long readFileLines(const char* filepath, const std::function<bool(std::string_view)>& onLine);
+    static int statFileSystem(const char* path, struct statfs64* buffer);
+    static int getUname(struct utsname* buffer);
     static std::string base64Encode(const uint8_t* data, size_t length);
-    static std::string executeCommand(const char* command);
+    // 超过timeoutMs时杀掉子进程，返回已读到的输出并追加 partial/timeout 标记
+    static std::string executeCommand(const char* command, int timeoutMs = kCommandTimeoutMs);
+    static constexpr int kCommandTimeoutMs = 500;
     
     // JNI相关工具方法
     static std::string getJavaProperty(JNIEnv* env, const std::string& propertyName);
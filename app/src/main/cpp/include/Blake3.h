@@ -0,0 +1,64 @@
+#ifndef BLAKE3_H
+#define BLAKE3_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class WorkStealingPool;
+
+/**
+ * BLAKE3 哈希（默认模式，32字节输出）
+ * 输入按1KB分块，块的链值两两合并成二叉树，因此对齐的子树可以独立并行计算。
+ * SSE2/NEON下一次压缩4个块（每个向量通道一个块），其他平台使用逐块的标量实现。
+ * 不依赖Android头文件，主机工具也可复用。
+ */
+class Blake3Hasher {
+public:
+    static constexpr size_t kOutLen = 32;
+    static constexpr size_t kBlockLen = 64;
+    static constexpr size_t kChunkLen = 1024;
+    // 并行任务粒度：128个块组成的完整子树
+    static constexpr size_t kGranuleChunks = 128;
+    static constexpr size_t kGranuleBytes = kGranuleChunks * kChunkLen;
+
+    Blake3Hasher();
+
+    void update(const void* data, size_t length);
+
+    // 把granules个完整粒度的数据分给线程池并行计算子树，结果与update()相同
+    // 调用方保证之后还有输入（最后一个块必须留给update()，它可能是根节点）
+    void updateGranules(const uint8_t* data, size_t granules, WorkStealingPool& pool);
+
+    void finalize(uint8_t out[kOutLen]) const;
+    std::string finalizeHex() const;
+
+    // 一次性哈希内存中的数据，超过一个粒度时使用线程池
+    static void hash(const void* data, size_t length, uint8_t out[kOutLen]);
+    static void hashParallel(const void* data, size_t length, WorkStealingPool& pool, uint8_t out[kOutLen]);
+
+    // 当前使用的压缩实现："sse2x4"、"neonx4" 或 "portable"
+    static const char* kernelName();
+    // 基准测试用：强制使用标量实现
+    static void setPortableOnly(bool portableOnly);
+
+private:
+    struct ChunkState {
+        uint32_t cv[8];
+        uint64_t counter;
+        uint8_t block[kBlockLen];
+        uint8_t blockLen;
+        uint8_t blocksCompressed;
+    };
+
+    void resetChunk(uint64_t counter);
+    void updateChunk(const uint8_t* data, size_t length);
+    void addChunkChainingValue(const uint32_t cv[8], uint64_t totalUnits);
+    void commitFullChunks(const uint8_t* data, size_t chunks);
+
+    uint32_t m_cvStack[54][8];
+    uint8_t m_stackLength = 0;
+    ChunkState m_chunk;
+};
+
+#endif // BLAKE3_H
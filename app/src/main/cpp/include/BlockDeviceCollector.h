@@ -0,0 +1,24 @@
+#ifndef BLOCK_DEVICE_COLLECTOR_H
+#define BLOCK_DEVICE_COLLECTOR_H
+
+#include "BaseCollector.h"
+
+/**
+ * 枚举 /sys/block 下的所有物理块设备（eMMC、UFS、NVMe），跳过loop/ram/dm/zram
+ * 每个设备输出一条 "--- 设备名 ---" 记录：size、device/下的cid/csd/name/serial/vendor/model/rev，
+ * UFS设备另外输出主机控制器上的字符串描述符和设备描述符（ufs_前缀）
+ * 所有读取都相对于已打开的目录fd（openat），一次getdents64完成枚举
+ */
+class BlockDeviceCollector : public BaseCollector {
+public:
+    explicit BlockDeviceCollector(const char* sysBlockPath = "/sys/block") : m_sysBlockPath(sysBlockPath) {}
+    virtual ~BlockDeviceCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+
+private:
+    const char* m_sysBlockPath;
+};
+
+#endif // BLOCK_DEVICE_COLLECTOR_H
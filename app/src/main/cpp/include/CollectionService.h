@@ -0,0 +1,37 @@
+#ifndef COLLECTION_SERVICE_H
+#define COLLECTION_SERVICE_H
+
+#include "FingerprintSections.h"
+#include "SingleFlight.h"
+#include <memory>
+#include <string>
+
+/**
+ * 线程安全的分区收集入口
+ * 同一分区的并发请求合并为一次收集，所有调用者拿到同一份结果（single-flight）。
+ * 收集器（及其m_env）只在发起收集的线程上创建和使用，等待者不接触JNIEnv，
+ * 因此可以从任意已附加到JVM的线程调用。不可变分区的结果另由SectionCache缓存。
+ */
+class CollectionService {
+public:
+    using Flight = SingleFlight<int, std::string>::Call;
+
+    static CollectionService& instance();
+
+    // 同步收集：没有进行中的收集时用调用者的env在当前线程收集，否则等待其结果
+    std::string collect(FingerprintSection section, JNIEnv* env);
+
+    // 返回该分区进行中的收集，没有则在新线程上启动（按需附加到JVM）
+    std::shared_ptr<Flight> collectAsync(FingerprintSection section);
+
+    uint64_t coalescedCount() const { return m_flights.coalescedCount(); }
+
+private:
+    CollectionService() = default;
+
+    static std::string collectNow(FingerprintSection section, JNIEnv* env);
+
+    SingleFlight<int, std::string> m_flights;
+};
+
+#endif // COLLECTION_SERVICE_H
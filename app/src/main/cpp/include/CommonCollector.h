@@ -18,6 +18,10 @@ public:
     std::string collectHardwareInfo();
     std::string collectAppInfo();
     
+    // 不可变分区，供SectionCache预热
+    std::string getCpuInfo();
+    std::string getMemoryInfo();
+    
 private:
     JNIEnv* m_env;
     
@@ -26,8 +30,6 @@ private:
     std::string getDeviceBrand();
     std::string getAndroidVersion();
     std::string getApiLevel();
-    std::string getCpuInfo();
-    std::string getMemoryInfo();
     std::string getStorageInfo();
 };
 
@@ -0,0 +1,86 @@
+#ifndef CONTENT_HASH_H
+#define CONTENT_HASH_H
+
+#include "Blake3.h"
+#include "WorkStealingPool.h"
+#include "private/ScopedFd.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <string>
+
+/**
+ * 大文件的BLAKE3内容哈希
+ * 文件按固定窗口依次mmap（MADV_SEQUENTIAL），窗口内的完整粒度由线程池并行计算子树，
+ * 用完立即munmap；无论文件多大，映射的内存不超过一个窗口。
+ * 不经过readFile()，没有整文件的vector/string拷贝。
+ * 用于只读分区上的文件：映射期间文件被截断会触发SIGBUS。
+ * Io为IoBackend中的LibcIo或RawSyscallIo
+ */
+namespace content_hash {
+
+// 必须是粒度的整数倍（也就是页大小的整数倍）
+constexpr size_t kWindowBytes = 32 * 1024 * 1024;
+static_assert(kWindowBytes % Blake3Hasher::kGranuleBytes == 0, "window must hold whole granules");
+
+struct Result {
+    std::string blake3;
+    uint64_t size = 0;
+};
+
+namespace detail {
+
+template <typename Io>
+bool hashRange(int fd, uint64_t offset, size_t length, Blake3Hasher* hasher, WorkStealingPool* pool) {
+    if (length == 0) return true;
+    void* address = Io::mmap(length, PROT_READ, MAP_PRIVATE, fd, static_cast<off64_t>(offset));
+    if (address == MAP_FAILED) return false;
+    Io::madvise(address, length, MADV_SEQUENTIAL);
+
+    const uint8_t* data = static_cast<const uint8_t*>(address);
+    if (pool != nullptr) {
+        hasher->updateGranules(data, length / Blake3Hasher::kGranuleBytes, *pool);
+    } else {
+        hasher->update(data, length);
+    }
+    Io::munmap(address, length);
+    return true;
+}
+
+} // namespace detail
+
+// 失败时返回false，errno为失败原因
+template <typename Io>
+bool hashFile(const char* path, WorkStealingPool& pool, Result* result) {
+    ScopedFd fd(Io::openAt(AT_FDCWD, path, O_RDONLY | O_CLOEXEC));
+    if (fd.get() < 0) return false;
+
+    struct stat64 st;
+    if (Io::fstat(fd.get(), &st) != 0) return false;
+    if (!S_ISREG(st.st_mode)) {
+        errno = EINVAL;
+        return false;
+    }
+    uint64_t size = static_cast<uint64_t>(st.st_size);
+
+    // 最后一个字节所在的粒度留给串行部分，它包含根节点
+    uint64_t granuleBytes = size == 0 ? 0 : (size - 1) / Blake3Hasher::kGranuleBytes * Blake3Hasher::kGranuleBytes;
+    Blake3Hasher hasher;
+    for (uint64_t offset = 0; offset < granuleBytes; offset += kWindowBytes) {
+        size_t length = static_cast<size_t>(std::min<uint64_t>(kWindowBytes, granuleBytes - offset));
+        if (!detail::hashRange<Io>(fd.get(), offset, length, &hasher, &pool)) return false;
+    }
+    if (!detail::hashRange<Io>(fd.get(), granuleBytes, static_cast<size_t>(size - granuleBytes), &hasher, nullptr)) {
+        return false;
+    }
+
+    result->blake3 = hasher.finalizeHex();
+    result->size = size;
+    return true;
+}
+
+} // namespace content_hash
+
+#endif // CONTENT_HASH_H
@@ -0,0 +1,60 @@
+#ifndef DEADLINE_RUNNER_H
+#define DEADLINE_RUNNER_H
+
+#include "FingerprintSections.h"
+#include "private/DeadlineWait.h"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * 带截止时间的分区收集
+ * 每个分区在独立线程上收集，调用者最多等到 min(请求截止时间, 启动时间 + 分区预算)。
+ * 截止时间为kNoDeadline时不限时，等到每个分区收集完成，分区预算也不生效。
+ * 超时的分区在输出中标记为 partial/timeout（沿用分区自己的标题），其余分区按时返回；
+ * 被放弃的线程继续运行，完成后结果仍会写入SectionCache，下次请求直接复用。
+ * 收集线程由CollectionService启动，同一分区同一时刻最多一个，后来的请求加入正在进行的收集。
+ */
+class DeadlineRunner {
+public:
+    using Clock = deadline_wait::Clock;
+
+    static DeadlineRunner& instance();
+
+    // 并行收集，按给定顺序返回每个分区的结果；timedOutMask返回超时分区的掩码
+    // cancelled置位后不再等待（最多延迟kCancelPollInterval），未完成分区的结果为空
+    std::vector<std::string> run(const std::vector<FingerprintSection>& sections, Clock::time_point deadline,
+                                 uint32_t* timedOutMask = nullptr, const std::atomic<bool>* cancelled = nullptr);
+
+    // 同run，结果按顺序拼接
+    std::string collect(const std::vector<FingerprintSection>& sections, Clock::time_point deadline,
+                        uint32_t* timedOutMask = nullptr, const std::atomic<bool>* cancelled = nullptr);
+
+    // 单个分区允许的最长收集时间
+    static std::chrono::milliseconds sectionBudget(FingerprintSection section);
+
+    uint64_t overrunCount(FingerprintSection section) const;
+
+    // 每个分区一行：名称、预算、超时次数
+    std::string overrunReport() const;
+
+    // 同步JNI入口（登录路径）的整体截止时间
+    static constexpr std::chrono::milliseconds kDefaultDeadline{2500};
+
+    // 不限时
+    static constexpr Clock::time_point kNoDeadline = deadline_wait::kNoDeadline;
+
+    // 等待期间检查取消标志的间隔
+    static constexpr std::chrono::milliseconds kCancelPollInterval = deadline_wait::kCancelPollInterval;
+
+private:
+    DeadlineRunner() = default;
+
+    // 超时分区的占位输出，标题与分区正常输出一致
+    static std::string timeoutPlaceholder(FingerprintSection section, long long waitedMs);
+
+    std::atomic<uint64_t> m_overruns[SECTION_COUNT] = {};
+};
+
+#endif // DEADLINE_RUNNER_H
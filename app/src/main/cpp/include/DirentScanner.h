@@ -0,0 +1,48 @@
+#ifndef DIRENT_SCANNER_H
+#define DIRENT_SCANNER_H
+
+#include <dirent.h>
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+/**
+ * 用getdents64直接遍历已打开的目录fd，不经过opendir/readdir的DIR*分配
+ * Io为IoBackend中的LibcIo或RawSyscallIo（主机工具可提供只含getdents64的同名接口）
+ * fn(name, d_type) 对每个条目调用一次，跳过 "." 和 ".."；返回false时提前结束
+ * 返回遍历是否成功完成
+ */
+namespace dirent_scan {
+
+// 内核返回的 linux_dirent64 布局
+struct LinuxDirent64 {
+    uint64_t d_ino;
+    int64_t d_off;
+    unsigned short d_reclen;
+    unsigned char d_type;
+    char d_name[];
+};
+
+constexpr size_t kBufferSize = 16 * 1024;
+
+template <typename Io, typename Fn>
+bool forEachEntry(int dirfd, Fn&& fn) {
+    alignas(8) char buffer[kBufferSize];
+    while (true) {
+        ssize_t bytes = Io::getdents64(dirfd, buffer, sizeof(buffer));
+        if (bytes < 0) return false;
+        if (bytes == 0) return true;
+
+        for (ssize_t offset = 0; offset < bytes;) {
+            const auto* entry = reinterpret_cast<const LinuxDirent64*>(buffer + offset);
+            offset += entry->d_reclen;
+            const char* name = entry->d_name;
+            if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) continue;
+            if (!fn(name, entry->d_type)) return true;
+        }
+    }
+}
+
+} // namespace dirent_scan
+
+#endif // DIRENT_SCANNER_H
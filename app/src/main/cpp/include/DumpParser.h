@@ -0,0 +1,70 @@
+#ifndef DUMP_PARSER_H
+#define DUMP_PARSER_H
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * 收集器文本输出的零分配解析器
+ *
+ * 识别的格式：
+ *   "=== 分区 ===" / "--- 路径 ---"  分区标题
+ *   "key=value"                      build.prop属性
+ *   "Key: value" / "key\t: value"    普通字段、cpuinfo、meminfo
+ *   其他非空行                        key为空，value为整行
+ *
+ * visit(section, key, value) 收到的都是指向输入缓冲区的视图
+ */
+namespace dump {
+
+inline std::string_view trim(std::string_view s) {
+    size_t begin = 0;
+    size_t end = s.size();
+    while (begin < end && (s[begin] == ' ' || s[begin] == '\t' || s[begin] == '\r')) ++begin;
+    while (end > begin && (s[end - 1] == ' ' || s[end - 1] == '\t' || s[end - 1] == '\r')) --end;
+    return s.substr(begin, end - begin);
+}
+
+// 返回标题文本，不是标题行时返回空视图
+inline std::string_view headerOf(std::string_view line) {
+    if (line.size() >= 7 &&
+        ((line.compare(0, 4, "=== ") == 0 && line.compare(line.size() - 4, 4, " ===") == 0) ||
+         (line.compare(0, 4, "--- ") == 0 && line.compare(line.size() - 4, 4, " ---") == 0))) {
+        return trim(line.substr(4, line.size() - 8));
+    }
+    return {};
+}
+
+template <typename Visitor>
+void forEachField(const char* data, size_t size, Visitor&& visit) {
+    std::string_view text(data, size);
+    std::string_view section;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string_view::npos) eol = text.size();
+        std::string_view line = trim(text.substr(pos, eol - pos));
+        pos = eol + 1;
+
+        if (line.empty()) continue;
+
+        std::string_view header = headerOf(line);
+        if (!header.empty()) {
+            section = header;
+            continue;
+        }
+
+        // 以最先出现的 '=' 或 ':' 作为分隔符
+        size_t sep = line.find_first_of("=:");
+        if (sep == std::string_view::npos || sep == 0) {
+            visit(section, std::string_view(), line);
+        } else {
+            visit(section, trim(line.substr(0, sep)), trim(line.substr(sep + 1)));
+        }
+    }
+}
+
+} // namespace dump
+
+#endif // DUMP_PARSER_H
@@ -0,0 +1,237 @@
+#ifndef ELF_BUILD_ID_H
+#define ELF_BUILD_ID_H
+
+#include "private/ScopedFd.h"
+#include <elf.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/**
+ * 读取ELF文件的 NT_GNU_BUILD_ID
+ * 只映射ELF头和程序头表（通常在第一页内），找到PT_NOTE段后只读取该范围；
+ * 注释段已经落在映射范围内时不再额外读取。支持32/64位和大小端，不加载也不哈希整个文件。
+ * Io为IoBackend中的LibcIo或RawSyscallIo
+ */
+namespace elf_build_id {
+
+enum class Status {
+    OK,
+    NOT_FOUND,      // 文件不存在
+    NOT_ELF,        // 不是ELF或头部损坏
+    NO_BUILD_ID,    // 没有GNU build-id注释
+    IO_ERROR,
+};
+
+struct Result {
+    std::string buildId;    // 小写十六进制
+    bool is64 = false;
+    bool bigEndian = false;
+    uint16_t machine = 0;
+    size_t bytesRead = 0;   // 映射加读取的字节数
+};
+
+constexpr size_t kHeaderMapSize = 4096;
+// 程序头表或单个注释段超过这个大小视为损坏
+constexpr size_t kMaxHeaderBytes = 64 * 1024;
+constexpr size_t kMaxNoteBytes = 4096;
+
+namespace detail {
+
+// 按文件字节序读取字段，不要求对齐
+class FieldReader {
+public:
+    FieldReader(const uint8_t* data, size_t size, bool swap) : m_data(data), m_size(size), m_swap(swap) {}
+
+    bool has(size_t offset, size_t length) const { return offset <= m_size && length <= m_size - offset; }
+
+    uint16_t u16(size_t offset) const { return load<uint16_t>(offset); }
+    uint32_t u32(size_t offset) const { return load<uint32_t>(offset); }
+    uint64_t u64(size_t offset) const { return load<uint64_t>(offset); }
+
+    const uint8_t* data() const { return m_data; }
+
+private:
+    template <typename T>
+    T load(size_t offset) const {
+        T value;
+        memcpy(&value, m_data + offset, sizeof(T));
+        if (!m_swap) return value;
+        if (sizeof(T) == 2) return static_cast<T>(__builtin_bswap16(static_cast<uint16_t>(value)));
+        if (sizeof(T) == 4) return static_cast<T>(__builtin_bswap32(static_cast<uint32_t>(value)));
+        return static_cast<T>(__builtin_bswap64(static_cast<uint64_t>(value)));
+    }
+
+    const uint8_t* m_data;
+    size_t m_size;
+    bool m_swap;
+};
+
+template <typename Io>
+class Mapping {
+public:
+    ~Mapping() { reset(); }
+
+    bool map(int fd, size_t length) {
+        reset();
+        void* address = Io::mmap(length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) return false;
+        m_address = static_cast<const uint8_t*>(address);
+        m_length = length;
+        return true;
+    }
+
+    void reset() {
+        if (m_address != nullptr) Io::munmap(const_cast<uint8_t*>(m_address), m_length);
+        m_address = nullptr;
+        m_length = 0;
+    }
+
+    const uint8_t* data() const { return m_address; }
+    size_t length() const { return m_length; }
+
+private:
+    const uint8_t* m_address = nullptr;
+    size_t m_length = 0;
+};
+
+// 在一个注释段中查找 name == "GNU" 且 type == NT_GNU_BUILD_ID 的条目
+inline bool findBuildId(const FieldReader& notes, size_t size, uint64_t align, std::string* hex) {
+    size_t alignment = align == 8 ? 8 : 4;
+    auto alignUp = [alignment](size_t value) { return (value + alignment - 1) & ~(alignment - 1); };
+
+    size_t offset = 0;
+    while (notes.has(offset, 12)) {
+        uint32_t nameSize = notes.u32(offset);
+        uint32_t descSize = notes.u32(offset + 4);
+        uint32_t type = notes.u32(offset + 8);
+        size_t nameOffset = offset + 12;
+        if (nameSize > size || descSize > size) return false;
+        // 对齐是相对注释开头的：8字节对齐时 "GNU\0" 之后不补齐，描述从偏移16开始
+        size_t descOffset = alignUp(nameOffset + nameSize);
+        if (!notes.has(descOffset, descSize)) return false;
+
+        if (type == NT_GNU_BUILD_ID && nameSize == 4 && memcmp(notes.data() + nameOffset, "GNU", 4) == 0 &&
+            descSize > 0) {
+            static const char kDigits[] = "0123456789abcdef";
+            hex->clear();
+            for (uint32_t i = 0; i < descSize; ++i) {
+                uint8_t byte = notes.data()[descOffset + i];
+                *hex += kDigits[byte >> 4];
+                *hex += kDigits[byte & 0x0f];
+            }
+            return true;
+        }
+        offset = alignUp(descOffset + descSize);
+    }
+    return false;
+}
+
+template <typename Io>
+ssize_t preadFully(int fd, void* buffer, size_t count, off64_t offset) {
+    ssize_t bytes;
+    do {
+        bytes = Io::pread(fd, buffer, count, offset);
+    } while (bytes < 0 && errno == EINTR);
+    return bytes;
+}
+
+} // namespace detail
+
+template <typename Io>
+Status read(int dirfd, const char* path, Result* result) {
+    ScopedFd fd(Io::openAt(dirfd, path, O_RDONLY | O_CLOEXEC));
+    if (fd.get() < 0) return errno == ENOENT ? Status::NOT_FOUND : Status::IO_ERROR;
+
+    struct stat64 st;
+    if (Io::fstat(fd.get(), &st) != 0) return Status::IO_ERROR;
+    if (!S_ISREG(st.st_mode) || st.st_size < static_cast<off64_t>(EI_NIDENT)) return Status::NOT_ELF;
+    size_t fileSize = static_cast<size_t>(st.st_size);
+
+    detail::Mapping<Io> mapping;
+    if (!mapping.map(fd.get(), fileSize < kHeaderMapSize ? fileSize : kHeaderMapSize)) return Status::IO_ERROR;
+    result->bytesRead = mapping.length();
+
+    const uint8_t* ident = mapping.data();
+    if (memcmp(ident, ELFMAG, SELFMAG) != 0) return Status::NOT_ELF;
+    if (ident[EI_CLASS] != ELFCLASS32 && ident[EI_CLASS] != ELFCLASS64) return Status::NOT_ELF;
+    if (ident[EI_DATA] != ELFDATA2LSB && ident[EI_DATA] != ELFDATA2MSB) return Status::NOT_ELF;
+
+    bool is64 = ident[EI_CLASS] == ELFCLASS64;
+    bool bigEndian = ident[EI_DATA] == ELFDATA2MSB;
+    bool swap = bigEndian != (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__);
+    size_t headerSize = is64 ? sizeof(Elf64_Ehdr) : sizeof(Elf32_Ehdr);
+    detail::FieldReader header(mapping.data(), mapping.length(), swap);
+    if (!header.has(0, headerSize)) return Status::NOT_ELF;
+
+    result->is64 = is64;
+    result->bigEndian = bigEndian;
+    result->machine = header.u16(offsetof(Elf64_Ehdr, e_machine));
+
+    uint64_t phoff = is64 ? header.u64(offsetof(Elf64_Ehdr, e_phoff)) : header.u32(offsetof(Elf32_Ehdr, e_phoff));
+    size_t phentsize = header.u16(is64 ? offsetof(Elf64_Ehdr, e_phentsize) : offsetof(Elf32_Ehdr, e_phentsize));
+    size_t phnum = header.u16(is64 ? offsetof(Elf64_Ehdr, e_phnum) : offsetof(Elf32_Ehdr, e_phnum));
+    size_t minEntry = is64 ? sizeof(Elf64_Phdr) : sizeof(Elf32_Phdr);
+    if (phnum == 0 || phnum == PN_XNUM || phentsize < minEntry) return Status::NOT_ELF;
+
+    // 程序头表不在第一页内时扩大映射（仍只覆盖文件开头到表末尾）
+    uint64_t tableEnd = phoff + static_cast<uint64_t>(phnum) * phentsize;
+    if (tableEnd > fileSize || tableEnd > kMaxHeaderBytes) return Status::NOT_ELF;
+    if (tableEnd > mapping.length()) {
+        if (!mapping.map(fd.get(), static_cast<size_t>(tableEnd))) return Status::IO_ERROR;
+        result->bytesRead = mapping.length();
+    }
+    detail::FieldReader table(mapping.data(), mapping.length(), swap);
+
+    uint8_t noteBuffer[kMaxNoteBytes];
+    for (size_t i = 0; i < phnum; ++i) {
+        size_t entry = static_cast<size_t>(phoff) + i * phentsize;
+        if (table.u32(entry) != PT_NOTE) continue;
+
+        uint64_t offset = is64 ? table.u64(entry + offsetof(Elf64_Phdr, p_offset))
+                               : table.u32(entry + offsetof(Elf32_Phdr, p_offset));
+        uint64_t size = is64 ? table.u64(entry + offsetof(Elf64_Phdr, p_filesz))
+                             : table.u32(entry + offsetof(Elf32_Phdr, p_filesz));
+        uint64_t align = is64 ? table.u64(entry + offsetof(Elf64_Phdr, p_align))
+                              : table.u32(entry + offsetof(Elf32_Phdr, p_align));
+        if (size == 0 || size > kMaxNoteBytes || offset > fileSize || size > fileSize - offset) continue;
+
+        // 注释段一般紧跟在程序头之后，已在映射范围内就直接解析
+        const uint8_t* notes;
+        if (offset + size <= mapping.length()) {
+            notes = mapping.data() + offset;
+        } else {
+            ssize_t bytes = detail::preadFully<Io>(fd.get(), noteBuffer, static_cast<size_t>(size),
+                                                   static_cast<off64_t>(offset));
+            if (bytes != static_cast<ssize_t>(size)) return Status::IO_ERROR;
+            result->bytesRead += static_cast<size_t>(bytes);
+            notes = noteBuffer;
+        }
+
+        if (detail::findBuildId(detail::FieldReader(notes, static_cast<size_t>(size), swap),
+                                static_cast<size_t>(size), align, &result->buildId)) {
+            return Status::OK;
+        }
+    }
+    return Status::NO_BUILD_ID;
+}
+
+inline const char* statusName(Status status) {
+    switch (status) {
+        case Status::OK:          return "ok";
+        case Status::NOT_FOUND:   return "not found";
+        case Status::NOT_ELF:     return "not an ELF file";
+        case Status::NO_BUILD_ID: return "no build-id note";
+        case Status::IO_ERROR:    return "I/O error";
+    }
+    return "unknown";
+}
+
+} // namespace elf_build_id
+
+#endif // ELF_BUILD_ID_H
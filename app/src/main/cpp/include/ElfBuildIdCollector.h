@@ -0,0 +1,27 @@
+#ifndef ELF_BUILD_ID_COLLECTOR_H
+#define ELF_BUILD_ID_COLLECTOR_H
+
+#include "BaseCollector.h"
+#include <string>
+#include <vector>
+
+/**
+ * 核心系统库的ELF build-id（libc、libart、libandroid_runtime、vendor HAL等）
+ * 每个库只映射ELF头和程序头、读取PT_NOTE段，总I/O只有几KB，却能唯一标识OTA/ROM构建
+ * 列表中以 '/' 结尾的项表示目录，展开为其中所有 .so 文件（不递归）
+ * 各库由共享的工作窃取线程池并行读取，输出按列表顺序排列
+ */
+class ElfBuildIdCollector : public BaseCollector {
+public:
+    ElfBuildIdCollector();
+    explicit ElfBuildIdCollector(std::vector<std::string> libraries) : m_libraries(std::move(libraries)) {}
+    virtual ~ElfBuildIdCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+
+private:
+    std::vector<std::string> m_libraries;
+};
+
+#endif // ELF_BUILD_ID_COLLECTOR_H
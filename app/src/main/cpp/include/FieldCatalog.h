@@ -0,0 +1,85 @@
+#ifndef FIELD_CATALOG_H
+#define FIELD_CATALOG_H
+
+#include "DumpParser.h"
+#include "FieldDefinitions.h"
+#include "SectionIds.h"
+#include <cstdint>
+#include <string_view>
+
+// 可随机访问的字段编号，稠密排列（与Kotlin侧FingerprintField常量保持一致）
+enum FieldId : int32_t {
+    FIELD_BUILD_FINGERPRINT = 0,
+    FIELD_DEVICE_MODEL,
+    FIELD_DEVICE_BRAND,
+    FIELD_MANUFACTURER,
+    FIELD_PRODUCT_NAME,
+    FIELD_DEVICE_NAME,
+    FIELD_ANDROID_VERSION,
+    FIELD_API_LEVEL,
+    FIELD_BUILD_ID,
+    FIELD_BUILD_TYPE,
+    FIELD_BUILD_TAGS,
+    FIELD_SECURITY_PATCH,
+    FIELD_BUILD_INCREMENTAL,
+    FIELD_KERNEL_RELEASE,
+    FIELD_KERNEL_VERSION,
+    FIELD_MACHINE,
+    FIELD_BOOT_ID,
+    FIELD_SOC_SERIAL,
+    FIELD_COUNT,
+};
+
+// 字段来源：所在分区、输出中的标题（不含 === ===）和键
+// 标题和键都取自FieldDefinitions.h中收集器输出时使用的同一组常量
+struct FieldSource {
+    const char* name;
+    FingerprintSection section;
+    const char* header;
+    const char* key;
+};
+
+// 按FieldId顺序排列；不依赖JNI，主机工具用它校验DumpParser能从收集器格式的文本中找到每个字段
+inline constexpr FieldSource kFieldSources[FIELD_COUNT] = {
+    {"build_fingerprint", SECTION_COMMON_DEVICE, kDeviceInfoTitle, kBuildFingerprintKey},
+    {"device_model",      SECTION_COMMON_DEVICE, kDeviceInfoTitle, kDeviceModelKey},
+    {"device_brand",      SECTION_COMMON_DEVICE, kDeviceInfoTitle, kDeviceBrandKey},
+    {"manufacturer",      SECTION_COMMON_DEVICE, kDeviceInfoTitle, kManufacturerKey},
+    {"product_name",      SECTION_COMMON_DEVICE, kDeviceInfoTitle, kProductNameKey},
+    {"device_name",       SECTION_COMMON_DEVICE, kDeviceInfoTitle, kDeviceNameKey},
+    {"android_version",   SECTION_COMMON_DEVICE, kDeviceInfoTitle, kAndroidVersionKey},
+    {"api_level",         SECTION_COMMON_DEVICE, kDeviceInfoTitle, kApiLevelKey},
+    {"build_id",          SECTION_COMMON_DEVICE, kDeviceInfoTitle, kBuildIdKey},
+    {"build_type",        SECTION_COMMON_DEVICE, kDeviceInfoTitle, kBuildTypeKey},
+    {"build_tags",        SECTION_COMMON_DEVICE, kDeviceInfoTitle, kBuildTagsKey},
+    {"security_patch",    SECTION_COMMON_DEVICE, kDeviceInfoTitle, kSecurityPatchKey},
+    {"build_incremental", SECTION_BUILD_PROP,    kBuildPropFiles[0], "ro.build.version.incremental"},
+    {"kernel_release",    SECTION_UNAME,         kUnameTitle, kUnameReleaseKey},
+    {"kernel_version",    SECTION_UNAME,         kUnameTitle, kUnameVersionKey},
+    {"machine",           SECTION_UNAME,         kUnameTitle, kUnameMachineKey},
+    {"boot_id",           SECTION_SYSTEM_FILES,  kSystemIdentifierFiles[0], kIdentifierContentKey},
+    {"soc_serial",        SECTION_SYSTEM_FILES,  kSystemIdentifierFiles[2], kIdentifierContentKey},
+};
+
+inline const char* fieldName(FieldId id) {
+    if (id < 0 || id >= FIELD_COUNT) return "unknown";
+    return kFieldSources[id].name;
+}
+
+// 在section的收集器输出中查找该分区的目录字段，对每个找到的字段调用visit(FieldId, value)
+// 标题和键都要匹配，同一字段只取第一次出现的值；value指向text
+template <typename Visitor>
+void forEachCatalogField(FingerprintSection section, std::string_view text, Visitor&& visit) {
+    bool found[FIELD_COUNT] = {};
+    dump::forEachField(text.data(), text.size(),
+                       [&](std::string_view header, std::string_view key, std::string_view value) {
+        for (int i = 0; i < FIELD_COUNT; ++i) {
+            const FieldSource& source = kFieldSources[i];
+            if (found[i] || source.section != section || key != source.key || header != source.header) continue;
+            found[i] = true;
+            visit(static_cast<FieldId>(i), value);
+        }
+    });
+}
+
+#endif // FIELD_CATALOG_H
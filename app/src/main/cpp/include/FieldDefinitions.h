@@ -0,0 +1,130 @@
+#ifndef FIELD_DEFINITIONS_H
+#define FIELD_DEFINITIONS_H
+
+#include <cstddef>
+#include <iterator>
+
+/**
+ * 收集器读取的文件与字段定义
+ * 设备端收集器和主机端工具（tools/）共用同一份列表，保证分区名和字段名一致
+ * 不依赖Android头文件
+ */
+
+// getAllDeviceFingerprintNative 输出的首行标题，主机工具以它作为一条记录的边界
+inline constexpr const char kDumpTitle[] = "Comprehensive Device Fingerprint Collection";
+
+// 各分区输出的 "=== 标题 ===" 中的标题；DeadlineRunner的超时占位和FieldStore的字段定位都依赖它们
+// build_prop分区没有总标题，每个文件以 "=== 路径 ===" 开头
+inline constexpr const char kFileSystemTitle[] = "File System Information";
+inline constexpr const char kDrmIdTitle[] = "DRM ID Information";
+inline constexpr const char kKernelFilesTitle[] = "Kernel Files Information";
+inline constexpr const char kSystemFilesTitle[] = "System Files Information (Important Device Fingerprints)";
+inline constexpr const char kUnameTitle[] = "uname system call (Android 11+ fallback)";
+inline constexpr const char kCommonDeviceTitle[] = "Common Device Information Collection";
+inline constexpr const char kCpuInfoTitle[] = "CPU Information";
+inline constexpr const char kNetlinkTitle[] = "Network Interfaces (netlink)";
+inline constexpr const char kBlockDevicesTitle[] = "Block Devices";
+inline constexpr const char kPartitionInventoryTitle[] = "Partition Inventory";
+inline constexpr const char kElfBuildIdsTitle[] = "ELF Build IDs";
+inline constexpr const char kFileHashesTitle[] = "File Content Hashes";
+inline constexpr const char kKernelConfigTitle[] = "Kernel Config";
+inline constexpr const char kMemoryMapsTitle[] = "Memory Maps";
+inline constexpr const char kRoutesTitle[] = "Routes";
+inline constexpr const char kMediaManifestsTitle[] = "Media Codecs and Features";
+
+// CommonCollector::collectDeviceInfo 的小节标题和 "键: 值" 行的键
+inline constexpr const char kDeviceInfoTitle[] = "Device Information";
+inline constexpr const char kDeviceModelKey[] = "Device Model";
+inline constexpr const char kDeviceBrandKey[] = "Device Brand";
+inline constexpr const char kAndroidVersionKey[] = "Android Version";
+inline constexpr const char kApiLevelKey[] = "API Level";
+inline constexpr const char kManufacturerKey[] = "Manufacturer";
+inline constexpr const char kProductNameKey[] = "Product Name";
+inline constexpr const char kDeviceNameKey[] = "Device Name";
+inline constexpr const char kBuildFingerprintKey[] = "Build Fingerprint";
+inline constexpr const char kBuildIdKey[] = "Build ID";
+inline constexpr const char kBuildTypeKey[] = "Build Type";
+inline constexpr const char kBuildTagsKey[] = "Build Tags";
+inline constexpr const char kBuildDateKey[] = "Build Date";
+inline constexpr const char kSecurityPatchKey[] = "Security Patch";
+
+// getUnameInfo 输出的键（struct utsname 的字段名）
+inline constexpr const char kUnameReleaseKey[] = "release";
+inline constexpr const char kUnameVersionKey[] = "version";
+inline constexpr const char kUnameMachineKey[] = "machine";
+
+// 四个主要的build.prop文件，同时也是parseBuildProp输出的分区名
+inline constexpr const char* kBuildPropFiles[] = {
+    "/system/build.prop",
+    "/odm/etc/build.prop",
+    "/product/build.prop",
+    "/vendor/build.prop"
+};
+
+// parseBuildProp 提取的关键属性
+inline constexpr const char* kKeyBuildProperties[] = {
+    "ro.build.fingerprint",
+    "ro.build.display.id",
+    "ro.build.version.release",
+    "ro.build.version.sdk",
+    "ro.build.version.codename",
+    "ro.build.version.incremental",
+    "ro.build.date",
+    "ro.build.date.utc",
+    "ro.build.type",
+    "ro.build.user",
+    "ro.build.host",
+    "ro.build.tags",
+    "ro.product.model",
+    "ro.product.brand",
+    "ro.product.name",
+    "ro.product.device",
+    "ro.product.manufacturer",
+    "ro.product.cpu.abi",
+    "ro.product.cpu.abilist",
+    "ro.product.locale",
+    "ro.board.platform",
+    "ro.build.id",
+    "ro.build.version.security_patch",
+    "ro.build.version.base_os",
+    "ro.build.version.preview_sdk",
+    "ro.build.version.min_supported_target_sdk"
+};
+
+inline constexpr size_t kKeyBuildPropertyCount = std::size(kKeyBuildProperties);
+
+// collectSystemFiles 读取的标识文件，输出为 "=== 路径 ===" + "Content: 值"
+inline constexpr const char* kSystemIdentifierFiles[] = {
+    "/proc/sys/kernel/random/boot_id",
+    "/proc/sys/kernel/random/uuid",
+    "/sys/devices/soc0/serial_number",
+    "/proc/misc",
+    "/proc/version"
+};
+
+// collectKernelFilesInfo 在 "=== Other System Files ===" 下读取的文件，每个只读前kOtherSystemFilePrefix字节
+inline constexpr const char* kOtherSystemFiles[] = {
+    "/proc/version",
+    "/proc/cpuinfo",
+    "/proc/meminfo",
+    "/system/etc/prop.default"
+};
+
+inline constexpr size_t kOtherSystemFilePrefix = 1000;
+
+// collectAdditionalSystemInfo 读取的文件，不存在时不输出，每个只读前kAdditionalSystemFilePrefix字节
+inline constexpr const char* kAdditionalSystemFiles[] = {
+    "/proc/cmdline",
+    "/proc/cpuinfo",
+    "/proc/meminfo",
+    "/sys/class/dmi/id/product_uuid",
+    "/sys/class/dmi/id/board_serial",
+    "/sys/class/dmi/id/chassis_serial"
+};
+
+inline constexpr size_t kAdditionalSystemFilePrefix = 500;
+
+// collectSystemFiles 中文件内容行的键
+inline constexpr const char kIdentifierContentKey[] = "Content";
+
+#endif // FIELD_DEFINITIONS_H
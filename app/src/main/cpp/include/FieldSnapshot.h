@@ -0,0 +1,49 @@
+#ifndef FIELD_SNAPSHOT_H
+#define FIELD_SNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// 字段表项：值存放在连续的arena中
+struct FieldEntry {
+    uint64_t id;
+    uint32_t offset;
+    uint32_t length;
+};
+
+/**
+ * 结构化指纹快照
+ * 按字段ID排序的 (id, offset, length) 数组 + 一块连续的字符串arena
+ * 字段ID是 "分区/键" 路径的FNV-1a哈希，重复的键（如每个核心的cpuinfo）追加出现序号
+ */
+class FieldSnapshot {
+public:
+    static uint64_t fieldId(std::string_view section, std::string_view key, uint32_t occurrence = 0);
+
+    // 解析收集器的文本输出（parseBuildProp、getCpuInfo、getMemoryInfo等）
+    static FieldSnapshot fromDump(std::string_view text);
+
+    void add(uint64_t id, std::string_view value);
+
+    // 按ID排序并去重（保留先加入的值），查找和比较前必须调用
+    void finalize();
+
+    bool find(uint64_t id, std::string_view* value) const;
+    std::string_view valueAt(size_t index) const;
+
+    const std::vector<FieldEntry>& entries() const { return m_entries; }
+    size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    // 二进制格式：magic + varint数量 + (fixed64 id, varint长度, 值)*
+    std::string serialize() const;
+    static bool deserialize(const char* data, size_t size, FieldSnapshot* out);
+
+private:
+    std::vector<FieldEntry> m_entries;
+    std::string m_arena;
+};
+
+#endif // FIELD_SNAPSHOT_H
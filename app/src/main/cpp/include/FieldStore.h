@@ -0,0 +1,50 @@
+#ifndef FIELD_STORE_H
+#define FIELD_STORE_H
+
+#include "FingerprintSections.h"
+#include "FieldCatalog.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * 单字段随机访问
+ * 每个字段编号对应 (分区, 标题, 键)，值存放在一块连续的arena中，按编号直接索引 (offset, length)。
+ * 字段所在的分区第一次被访问时通过CollectionService收集（不可变分区命中SectionCache），
+ * 解析一次后该分区的所有目录字段一起写入；之后的访问不再收集也不再解析文本。
+ * 值在进程内只物化一次，目录中只放进程存活期间不会变化的字段。
+ */
+class FieldStore {
+public:
+    static FieldStore& instance();
+
+    // 字段不存在（分区收集失败或输出中没有该键）时返回false
+    bool get(FieldId id, JNIEnv* env, std::string* value);
+
+    // 先收集所有涉及的分区，再在一次加锁中取出全部值；present[i]表示第i个字段是否存在
+    std::vector<std::string> getAll(const std::vector<FieldId>& ids, JNIEnv* env, std::vector<bool>* present);
+
+    // 已物化的分区掩码
+    uint32_t loadedMask() const { return m_loaded.load(std::memory_order_acquire); }
+
+private:
+    FieldStore() = default;
+
+    struct Slot {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+        bool present = false;
+    };
+
+    // 收集并解析mask中尚未物化的分区
+    void materialize(uint32_t mask, JNIEnv* env);
+
+    std::mutex m_mutex;
+    std::atomic<uint32_t> m_loaded{0};
+    Slot m_slots[FIELD_COUNT];
+    std::string m_arena;
+};
+
+#endif // FIELD_STORE_H
@@ -0,0 +1,26 @@
+#ifndef FILE_HASH_COLLECTOR_H
+#define FILE_HASH_COLLECTOR_H
+
+#include "BaseCollector.h"
+#include <string>
+#include <vector>
+
+/**
+ * 大型系统文件的BLAKE3内容哈希（framework.jar、VINTF清单等），用于高可信度校验
+ * 每个文件分窗口mmap并由共享线程池并行计算树哈希，内存占用与文件大小无关
+ * 成本远高于其他分区，不包含在默认指纹中，也不参与启动预热，按需通过分区掩码请求
+ */
+class FileHashCollector : public BaseCollector {
+public:
+    FileHashCollector();
+    explicit FileHashCollector(std::vector<std::string> files) : m_files(std::move(files)) {}
+    virtual ~FileHashCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+
+private:
+    std::vector<std::string> m_files;
+};
+
+#endif // FILE_HASH_COLLECTOR_H
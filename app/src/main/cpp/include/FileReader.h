@@ -0,0 +1,162 @@
+#ifndef FILE_READER_H
+#define FILE_READER_H
+
+#include "private/ScopedFd.h"
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <time.h>
+#include <cerrno>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * BaseCollector 读文件的循环
+ * Io为IoBackend中的LibcIo/RawSyscallIo，主机工具可以换成注入延迟和错误的装饰器。
+ * 失败时返回状态并保留errno，日志和错误文本由调用方生成。
+ * 短读一律继续读到EOF；open和read遇到EINTR立即重试；EAGAIN（部分sysfs驱动忙时返回）退避后最多重试kMaxAgainRetries次。
+ */
+namespace file_reader {
+
+enum class Status {
+    OK,
+    OPEN_FAILED,
+    STAT_FAILED,
+    READ_FAILED,
+};
+
+constexpr int kMaxAgainRetries = 5;
+constexpr long kAgainBackoffNs = 1000 * 1000;
+
+namespace detail {
+
+// 返回true表示应当重试；EAGAIN连续出现超过上限时放弃
+inline bool shouldRetry(int error, int* againRetries) {
+    if (error == EINTR) return true;
+    if (error != EAGAIN || *againRetries >= kMaxAgainRetries) return false;
+    ++*againRetries;
+    timespec backoff = {0, kAgainBackoffNs};
+    nanosleep(&backoff, nullptr);
+    return true;
+}
+
+// 打开FUSE上的文件可能被信号打断
+template <typename Io>
+int openRetrying(const char* path) {
+    int fd;
+    do {
+        fd = Io::openAt(AT_FDCWD, path, O_RDONLY | O_CLOEXEC);
+    } while (fd == -1 && errno == EINTR);
+    return fd;
+}
+
+template <typename Io>
+ssize_t readRetrying(int fd, void* buffer, size_t count) {
+    int againRetries = 0;
+    while (true) {
+        ssize_t bytes = Io::read(fd, buffer, count);
+        if (bytes >= 0 || !shouldRetry(errno, &againRetries)) return bytes;
+    }
+}
+
+template <typename Io>
+ssize_t preadRetrying(int fd, void* buffer, size_t count, off64_t offset) {
+    int againRetries = 0;
+    while (true) {
+        ssize_t bytes = Io::pread(fd, buffer, count, offset);
+        if (bytes >= 0 || !shouldRetry(errno, &againRetries)) return bytes;
+    }
+}
+
+} // namespace detail
+
+// 整个文件读到out；procfs/sysfs报告的大小不可信，一直读到EOF，缓冲区不够时翻倍
+template <typename Io>
+Status readAll(const char* path, std::string* out) {
+    ScopedFd fd(detail::openRetrying<Io>(path));
+    if (fd.get() == -1) return Status::OPEN_FAILED;
+
+    struct stat64 st;
+    if (Io::fstat(fd.get(), &st) == -1) return Status::STAT_FAILED;
+
+    out->resize(st.st_size > 0 ? static_cast<size_t>(st.st_size) : 4096);
+    size_t total = 0;
+    while (true) {
+        if (total == out->size()) out->resize(out->size() * 2);
+        ssize_t bytes = detail::readRetrying<Io>(fd.get(), &(*out)[total], out->size() - total);
+        if (bytes == -1) return Status::READ_FAILED;
+        if (bytes == 0) break;
+        total += static_cast<size_t>(bytes);
+    }
+    out->resize(total);
+    return Status::OK;
+}
+
+// 只按pread分块读取前maxBytes字节；truncated表示文件在maxBytes之后还有内容
+template <typename Io>
+Status readPrefix(const char* path, size_t maxBytes, std::string* out, bool* truncated) {
+    if (truncated != nullptr) *truncated = false;
+    ScopedFd fd(detail::openRetrying<Io>(path));
+    if (fd.get() == -1) return Status::OPEN_FAILED;
+
+    // 多读1字节用来判断是否截断；procfs每次最多返回一页，需要循环
+    out->assign(maxBytes + 1, '\0');
+    size_t total = 0;
+    while (total < out->size()) {
+        ssize_t bytes = detail::preadRetrying<Io>(fd.get(), &(*out)[total], out->size() - total,
+                                                  static_cast<off64_t>(total));
+        if (bytes == -1) return Status::READ_FAILED;
+        if (bytes == 0) break;
+        total += static_cast<size_t>(bytes);
+    }
+    if (total > maxBytes) {
+        total = maxBytes;
+        if (truncated != nullptr) *truncated = true;
+    }
+    out->resize(total);
+    return Status::OK;
+}
+
+// 分块读取并逐行回调（不含换行符），onLine返回false时不再读取剩余内容
+// 返回已读取的字节数，失败返回-1并在status中给出原因
+template <typename Io>
+long readLines(const char* path, const std::function<bool(std::string_view)>& onLine, Status* status) {
+    *status = Status::OK;
+    ScopedFd fd(detail::openRetrying<Io>(path));
+    if (fd.get() == -1) {
+        *status = Status::OPEN_FAILED;
+        return -1;
+    }
+
+    constexpr size_t kChunkSize = 4096;
+    std::string buffer;
+    size_t offset = 0;
+    while (true) {
+        // buffer中只保留上一块末尾不完整的行
+        size_t kept = buffer.size();
+        buffer.resize(kept + kChunkSize);
+        ssize_t bytes = detail::preadRetrying<Io>(fd.get(), &buffer[kept], kChunkSize, static_cast<off64_t>(offset));
+        if (bytes == -1) {
+            *status = Status::READ_FAILED;
+            return -1;
+        }
+        buffer.resize(kept + static_cast<size_t>(bytes));
+        offset += static_cast<size_t>(bytes);
+
+        std::string_view pending(buffer);
+        size_t newline;
+        while ((newline = pending.find('\n')) != std::string_view::npos) {
+            if (!onLine(pending.substr(0, newline))) return static_cast<long>(offset);
+            pending.remove_prefix(newline + 1);
+        }
+        if (bytes == 0) {
+            if (!pending.empty()) onLine(pending);
+            return static_cast<long>(offset);
+        }
+        buffer.erase(0, buffer.size() - pending.size());
+    }
+}
+
+} // namespace file_reader
+
+#endif // FILE_READER_H
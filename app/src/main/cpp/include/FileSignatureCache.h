@@ -0,0 +1,65 @@
+#ifndef FILE_SIGNATURE_CACHE_H
+#define FILE_SIGNATURE_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// statx得到的文件签名，任一字段变化都视为文件已修改
+struct FileSignature {
+    bool exists;
+    uint64_t ino;
+    uint64_t dev;
+    uint64_t size;
+    int64_t mtimeSec;
+    uint32_t mtimeNsec;
+    // 没有STATX_CHANGE_COOKIE时用ctime代替，inode任何变化都会更新它
+    int64_t ctimeSec;
+    uint32_t ctimeNsec;
+
+    bool operator==(const FileSignature& other) const;
+    bool operator!=(const FileSignature& other) const { return !(*this == other); }
+};
+
+/**
+ * 按文件签名缓存解析结果
+ * 之后的调用只做一次statx，签名不变时直接复用上次的解析结果
+ * procfs/sysfs等伪文件的statx信息不反映内容变化，总是重新读取
+ */
+class FileSignatureCache {
+public:
+    static FileSignatureCache& instance();
+
+    static FileSignature statSignature(const char* path);
+
+    // 对一组路径依次statx，结果与paths一一对应
+    static std::vector<FileSignature> statBatch(const std::vector<std::string>& paths);
+
+    static bool isPseudoFile(const std::string& path, const FileSignature& signature);
+
+    // compute(exists) 负责读取并解析文件，签名未变化时不会被调用
+    std::string getOrCompute(const std::string& path, const std::function<std::string(bool exists)>& compute);
+
+    // 批量版本：先一次性stat所有路径，再只读取发生变化的文件
+    std::vector<std::string> getOrComputeBatch(
+            const std::vector<std::string>& paths,
+            const std::function<std::string(const std::string& path, bool exists)>& compute);
+
+private:
+    struct Entry {
+        FileSignature signature;
+        std::string parsed;
+    };
+
+    FileSignatureCache() = default;
+    std::string lookupOrCompute(const std::string& path, const FileSignature& signature,
+                                const std::function<std::string(bool exists)>& compute);
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+};
+
+#endif // FILE_SIGNATURE_CACHE_H
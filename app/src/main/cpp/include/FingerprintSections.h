@@ -0,0 +1,22 @@
+#ifndef FINGERPRINT_SECTIONS_H
+#define FINGERPRINT_SECTIONS_H
+
+#include "SectionIds.h"
+#include <string>
+#include <jni.h>
+
+// 分区位序号，用于索引按分区排列的数组
+int sectionIndex(FingerprintSection section);
+FingerprintSection sectionAt(int index);
+const char* sectionName(FingerprintSection section);
+// 分区输出的 "=== 标题 ===" 中的标题；build_prop没有总标题，返回nullptr
+const char* sectionTitle(FingerprintSection section);
+
+// 直接调用对应收集器收集单个分区（不经过缓存）
+// env可以为空，此时依赖Java层的分区会返回 "Unable to retrieve"
+std::string collectSection(FingerprintSection section, JNIEnv* env);
+
+// 剖析模式：绕过缓存把mask中的每个分区收集iterations次，返回每个分区的计数器表格或JSON
+std::string profileSections(uint32_t mask, int iterations, JNIEnv* env, bool json);
+
+#endif // FINGERPRINT_SECTIONS_H
@@ -0,0 +1,160 @@
+#ifndef IO_BACKEND_H
+#define IO_BACKEND_H
+
+#include "RawSyscall.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <sys/types.h>
+#include <sys/utsname.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * 文件I/O后端
+ *
+ * 两种实现提供相同的静态内联接口，BaseCollector按当前后端为每个文件
+ * 选择一次模板实例，读循环内部没有虚函数调用：
+ *   LibcIo        - 普通libc调用
+ *   RawSyscallIo  - 通过inlineSyscall/raw_syscall直接发起系统调用
+ */
+enum class IoBackendType {
+    LIBC = 0,
+    RAW_SYSCALL = 1,
+};
+
+IoBackendType activeIoBackend();
+void setActiveIoBackend(IoBackendType type);
+const char* ioBackendName(IoBackendType type);
+
+struct LibcIo {
+    static int openAt(int dirfd, const char* path, int flags, mode_t mode = 0) {
+        return ::openat(dirfd, path, flags, mode);
+    }
+    static ssize_t read(int fd, void* buffer, size_t count) {
+        return ::read(fd, buffer, count);
+    }
+    static ssize_t pread(int fd, void* buffer, size_t count, off64_t offset) {
+        return ::pread64(fd, buffer, count, offset);
+    }
+    static int fstat(int fd, struct stat64* st) {
+        return ::fstat64(fd, st);
+    }
+    static int fstatAt(int dirfd, const char* path, struct stat64* st, int flags) {
+        return ::fstatat64(dirfd, path, st, flags);
+    }
+    static int close(int fd) {
+        return ::close(fd);
+    }
+    static int access(const char* path) {
+        return ::faccessat(AT_FDCWD, path, F_OK, 0);
+    }
+    static int statfs(const char* path, struct statfs64* buffer) {
+        return ::statfs64(path, buffer);
+    }
+    static int uname(struct utsname* buffer) {
+        return ::uname(buffer);
+    }
+    static void* mmap(size_t length, int prot, int flags, int fd, off64_t offset) {
+        return ::mmap64(nullptr, length, prot, flags, fd, offset);
+    }
+    static int munmap(void* address, size_t length) {
+        return ::munmap(address, length);
+    }
+    static int madvise(void* address, size_t length, int advice) {
+        return ::madvise(address, length, advice);
+    }
+    // bionic在API 34之前没有导出getdents64包装函数
+    static ssize_t getdents64(int fd, void* buffer, size_t size) {
+        return ::syscall(__NR_getdents64, fd, buffer, size);
+    }
+};
+
+struct RawSyscallIo {
+    static int openAt(int dirfd, const char* path, int flags, mode_t mode = 0) {
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_openat, dirfd, reinterpret_cast<long>(path),
+                                                            flags | O_LARGEFILE, mode)));
+    }
+    static ssize_t read(int fd, void* buffer, size_t count) {
+        return syscallResult(inlineSyscall(__NR_read, fd, reinterpret_cast<long>(buffer),
+                                           static_cast<long>(count)));
+    }
+    static ssize_t pread(int fd, void* buffer, size_t count, off64_t offset) {
+#if defined(__LP64__)
+        return syscallResult(inlineSyscall(__NR_pread64, fd, reinterpret_cast<long>(buffer),
+                                           static_cast<long>(count), static_cast<long>(offset)));
+#elif defined(__arm__)
+        // ARM EABI要求64位参数放在偶数寄存器对，第4个参数位补0
+        return syscallResult(inlineSyscall(__NR_pread64, fd, reinterpret_cast<long>(buffer),
+                                           static_cast<long>(count), 0,
+                                           static_cast<long>(offset & 0xffffffff),
+                                           static_cast<long>(offset >> 32)));
+#else
+        return syscallResult(inlineSyscall(__NR_pread64, fd, reinterpret_cast<long>(buffer),
+                                           static_cast<long>(count),
+                                           static_cast<long>(offset & 0xffffffff),
+                                           static_cast<long>(offset >> 32)));
+#endif
+    }
+    static int fstat(int fd, struct stat64* st) {
+#if defined(__LP64__)
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_fstat, fd, reinterpret_cast<long>(st))));
+#else
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_fstat64, fd, reinterpret_cast<long>(st))));
+#endif
+    }
+    static int fstatAt(int dirfd, const char* path, struct stat64* st, int flags) {
+#if defined(__LP64__)
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_newfstatat, dirfd, reinterpret_cast<long>(path),
+                                                            reinterpret_cast<long>(st), flags)));
+#else
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_fstatat64, dirfd, reinterpret_cast<long>(path),
+                                                            reinterpret_cast<long>(st), flags)));
+#endif
+    }
+    static int close(int fd) {
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_close, fd)));
+    }
+    static int access(const char* path) {
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_faccessat, AT_FDCWD,
+                                                            reinterpret_cast<long>(path), F_OK)));
+    }
+    static int statfs(const char* path, struct statfs64* buffer) {
+#if defined(__LP64__)
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_statfs, reinterpret_cast<long>(path),
+                                                            reinterpret_cast<long>(buffer))));
+#else
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_statfs64, reinterpret_cast<long>(path),
+                                                            sizeof(struct statfs64),
+                                                            reinterpret_cast<long>(buffer))));
+#endif
+    }
+    static int uname(struct utsname* buffer) {
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_uname, reinterpret_cast<long>(buffer))));
+    }
+    static void* mmap(size_t length, int prot, int flags, int fd, off64_t offset) {
+#if defined(__LP64__)
+        long result = syscallResult(inlineSyscall(__NR_mmap, 0, static_cast<long>(length), prot, flags, fd,
+                                                  static_cast<long>(offset)));
+#else
+        // mmap2的偏移以4096字节为单位
+        long result = syscallResult(inlineSyscall(__NR_mmap2, 0, static_cast<long>(length), prot, flags, fd,
+                                                  static_cast<long>(offset >> 12)));
+#endif
+        return result == -1 ? MAP_FAILED : reinterpret_cast<void*>(result);
+    }
+    static int munmap(void* address, size_t length) {
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_munmap, reinterpret_cast<long>(address),
+                                                            static_cast<long>(length))));
+    }
+    static int madvise(void* address, size_t length, int advice) {
+        return static_cast<int>(syscallResult(inlineSyscall(__NR_madvise, reinterpret_cast<long>(address),
+                                                            static_cast<long>(length), advice)));
+    }
+    static ssize_t getdents64(int fd, void* buffer, size_t size) {
+        return syscallResult(inlineSyscall(__NR_getdents64, fd, reinterpret_cast<long>(buffer),
+                                           static_cast<long>(size)));
+    }
+};
+
+#endif // IO_BACKEND_H
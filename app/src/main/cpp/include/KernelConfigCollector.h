@@ -0,0 +1,27 @@
+#ifndef KERNEL_CONFIG_COLLECTOR_H
+#define KERNEL_CONFIG_COLLECTOR_H
+
+#include "BaseCollector.h"
+#include <string>
+#include <vector>
+
+/**
+ * 内核配置：流式解压 /proc/config.gz（CONFIG_IKCONFIG_PROC），不生成完整的解压文本
+ * 输出选定选项的值、各类选项计数和所有启用选项的摘要
+ */
+class KernelConfigCollector : public BaseCollector {
+public:
+    KernelConfigCollector();
+    KernelConfigCollector(const char* path, std::vector<std::string> options)
+        : m_path(path), m_options(std::move(options)) {}
+    virtual ~KernelConfigCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+
+private:
+    const char* m_path;
+    std::vector<std::string> m_options;
+};
+
+#endif // KERNEL_CONFIG_COLLECTOR_H
@@ -0,0 +1,66 @@
+#ifndef KERNEL_CONFIG_SCANNER_H
+#define KERNEL_CONFIG_SCANNER_H
+
+#include <sys/types.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * 内核配置（/proc/config.gz）的流式解析
+ * gzip流解压到固定大小的窗口中，每得到完整的一行就立即解析，解压后的文本从不整体存在内存里；
+ * 输入缓冲和窗口各4KB，与配置文件大小（通常150-250KB）无关。
+ * 提取指定的CONFIG_*选项值，并对所有启用的选项（=y、=m、字符串/数值）按文件顺序计算摘要。
+ * 超过窗口长度的行无法完整保留，计入overlong后跳过（scanText()按同样规则处理，两条路径结果一致）。
+ * 不依赖Android头文件，主机工具也可复用。
+ */
+class KernelConfigScanner {
+public:
+    static constexpr size_t kInputBufferSize = 4096;
+    static constexpr size_t kWindowSize = 4096;
+
+    struct Summary {
+        // 第三行注释，如 "Linux/arm64 5.10.198 Kernel Configuration"
+        std::string header;
+        uint32_t builtin = 0;       // =y
+        uint32_t modules = 0;       // =m
+        uint32_t valued = 0;        // 字符串或数值
+        uint32_t notSet = 0;        // "# CONFIG_X is not set"
+        uint32_t overlong = 0;
+        uint64_t uncompressedBytes = 0;
+        uint64_t enabledDigest = 0;
+        // 按请求顺序：值，"n"（is not set）或空串（未出现）
+        std::vector<std::pair<std::string, std::string>> selected;
+    };
+
+    // 读取回调：返回读到的字节数，0表示结束，-1表示错误
+    using ReadFn = std::function<ssize_t(void* buffer, size_t size)>;
+
+    // options为要提取的完整选项名（带CONFIG_前缀）
+    explicit KernelConfigScanner(std::vector<std::string> options = {});
+
+    // 流式解压并解析gzip（或zlib）数据，支持多个连续的gzip成员；失败时error说明原因
+    bool scanGzip(const ReadFn& read, std::string* error);
+
+    // 解析已解压的文本（主机端基准和对照用）
+    void scanText(std::string_view text);
+
+    const Summary& summary() const { return m_summary; }
+
+private:
+    void reset();
+    void consumeLine(std::string_view line);
+    void finish();
+
+    std::vector<std::string> m_options;
+    std::unordered_map<std::string_view, size_t> m_optionIndex;
+    Summary m_summary;
+    uint64_t m_digest = 0;
+    uint32_t m_lineNumber = 0;
+};
+
+#endif // KERNEL_CONFIG_SCANNER_H
@@ -0,0 +1,47 @@
+#ifndef KEY_PROPERTY_FILTER_H
+#define KEY_PROPERTY_FILTER_H
+
+#include "FieldDefinitions.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * parseBuildProp 的逐行过滤：只保留 kKeyBuildProperties 中的属性行
+ * 不依赖JNI，主机上的延迟基准用同一份实现读取夹具中的build.prop
+ */
+class KeyPropertyFilter {
+public:
+    static_assert(kKeyBuildPropertyCount <= 32, "matched mask is 32 bits");
+
+    // 返回false表示所有关键属性都已找到，不必再读文件剩余部分
+    bool onLine(std::string_view line) {
+        // 跳过注释和空行
+        if (line.empty() || line[0] == '#') return true;
+
+        size_t pos = line.find('=');
+        if (pos != std::string_view::npos) {
+            std::string_view key = line.substr(0, pos);
+            for (size_t i = 0; i < kKeyBuildPropertyCount; ++i) {
+                if (key == kKeyBuildProperties[i]) {
+                    m_found.append(line.data(), line.size());
+                    m_found += '\n';
+                    m_matched |= 1u << i;
+                    break;
+                }
+            }
+        }
+        return m_matched != kAllMatched;
+    }
+
+    // 按文件中出现的顺序，每行以换行结尾
+    const std::string& found() const { return m_found; }
+
+private:
+    static constexpr uint32_t kAllMatched = static_cast<uint32_t>((uint64_t{1} << kKeyBuildPropertyCount) - 1);
+
+    std::string m_found;
+    uint32_t m_matched = 0;
+};
+
+#endif // KEY_PROPERTY_FILTER_H
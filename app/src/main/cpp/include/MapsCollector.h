@@ -0,0 +1,25 @@
+#ifndef MAPS_COLLECTOR_H
+#define MAPS_COLLECTOR_H
+
+#include "BaseCollector.h"
+#include <string>
+
+/**
+ * 进程内存映射：单遍扫描 /proc/self/maps
+ * 输出已加载代码对象（地址范围、权限、映射数）、可疑映射计数和已加载库集合的摘要
+ * 映射随运行时加载而变化，不能作为不可变分区缓存
+ */
+class MapsCollector : public BaseCollector {
+public:
+    MapsCollector() : m_path("/proc/self/maps") {}
+    explicit MapsCollector(const char* path) : m_path(path) {}
+    virtual ~MapsCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+
+private:
+    const char* m_path;
+};
+
+#endif // MAPS_COLLECTOR_H
@@ -0,0 +1,87 @@
+#ifndef MAPS_SCANNER_H
+#define MAPS_SCANNER_H
+
+#include <sys/types.h>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * /proc/<pid>/maps 单遍扫描
+ * 循环read直到EOF（不依赖文件大小，读取期间映射变化也不会截断），在可复用的缓冲区中逐行解析；
+ * 地址用查表的十六进制解析器，行尾的 '\n' 作为哨兵，数字循环里没有边界检查。
+ * 路径驻留在小型开放寻址哈希表中，同一文件的多个映射聚合成一个对象（地址范围、权限并集、映射数）。
+ * 扫描器对象可复用：缓冲区、路径存储和哈希表在多次扫描之间保留容量。
+ * 不依赖Android头文件，主机工具也可复用。
+ */
+class MapsScanner {
+public:
+    static constexpr size_t kReadSize = 64 * 1024;
+
+    enum Permission : uint8_t {
+        PERM_READ = 1 << 0,
+        PERM_WRITE = 1 << 1,
+        PERM_EXEC = 1 << 2,
+        PERM_SHARED = 1 << 3,
+    };
+
+    // 按路径聚合的映射（文件或 [heap] 之类的伪路径）
+    struct Object {
+        uint32_t pathOffset;
+        uint32_t pathLength;
+        uint64_t low;
+        uint64_t high;
+        uint64_t bytes;
+        uint32_t mappings;
+        uint8_t permissions;    // 所有映射的权限并集
+        uint8_t deleted;        // 路径带 " (deleted)" 后缀（已从路径中去掉）
+    };
+
+    struct Summary {
+        uint32_t mappings = 0;
+        uint32_t malformed = 0;
+        uint64_t mappedBytes = 0;
+        uint32_t anonymousExec = 0;     // 没有文件的可执行映射（不含 [vdso] 等内核映射）
+        uint32_t writableExec = 0;      // rwx映射
+        uint32_t deletedExec = 0;       // 已删除文件的可执行映射
+        uint32_t memfdExec = 0;         // memfd可执行映射（不含ART的JIT代码缓存）
+    };
+
+    // 读取回调：返回读到的字节数，0表示EOF，-1表示错误
+    using ReadFn = std::function<ssize_t(void* buffer, size_t size)>;
+
+    bool scan(const ReadFn& read);
+    void scanText(std::string_view text);
+
+    const Summary& summary() const { return m_summary; }
+    const std::vector<Object>& objects() const { return m_objects; }
+    std::string_view path(const Object& object) const {
+        return std::string_view(m_paths.data() + object.pathOffset, object.pathLength);
+    }
+
+    // 至少有一个可执行映射的文件：已加载的库、可执行文件、oat/odex
+    static bool isCodeObject(const Object& object, std::string_view path);
+
+private:
+    void reset();
+    void parseLine(const char* line, const char* end);
+    uint32_t intern(std::string_view path);
+    void grow();
+
+    struct Slot {
+        uint64_t hash;
+        uint32_t object;    // 对象序号 + 1，0表示空槽
+    };
+
+    std::vector<char> m_buffer;
+    std::string m_paths;
+    std::vector<Object> m_objects;
+    std::vector<Slot> m_slots;
+    // 同一文件的映射通常连续出现，先和上一行的路径比较
+    uint32_t m_lastObject = UINT32_MAX;
+    Summary m_summary;
+};
+
+#endif // MAPS_SCANNER_H
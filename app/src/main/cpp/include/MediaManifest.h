@@ -0,0 +1,56 @@
+#ifndef MEDIA_MANIFEST_H
+#define MEDIA_MANIFEST_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class WorkStealingPool;
+
+/**
+ * 媒体编解码器清单（media_codecs*.xml）和系统特性声明（permissions目录下的xml）的提取
+ * 每个文件用 XmlTokenizer 扫描一遍，得到如下条目：
+ *   "decoder <name> <mime>" / "encoder <name> <mime>"   <MediaCodec>，类型来自type属性或子元素<Type>
+ *   "feature <name>[=<version>]"                       <feature>
+ *   "unavailable <name>"                               <unavailable-feature>
+ * 多个文件的条目合并后排序去重，摘要是所有条目（以 '\n' 分隔）的BLAKE3。
+ * 不依赖Android头文件，主机工具也可复用。
+ */
+namespace media_manifest {
+
+struct FileResult {
+    std::vector<std::string> entries;
+    uint64_t bytes = 0;
+    bool loaded = false;        // 读取失败的文件不计入
+    bool malformed = false;     // 文档截断，已提取的条目仍然保留
+};
+
+struct Summary {
+    std::vector<std::string> entries;   // 排序去重后的全部条目
+    uint32_t files = 0;
+    uint32_t malformedFiles = 0;
+    uint64_t bytes = 0;
+    uint32_t decoders = 0;
+    uint32_t encoders = 0;
+    uint32_t features = 0;
+    uint32_t unavailable = 0;
+    std::string digest;                 // 全部条目
+    std::string featureDigest;          // 只含feature条目，与编解码器列表无关
+};
+
+// 扫描一个文件的内容，条目追加到result
+void scanText(std::string_view text, FileResult* result);
+
+// 读取回调：把path的内容读入out，失败返回false
+using ReadFn = bool (*)(const char* path, std::string* out);
+
+// 在线程池上并行读取和扫描，每个文件一个任务；读取失败的文件跳过
+Summary scanFiles(const std::vector<std::string>& paths, ReadFn read, WorkStealingPool& pool);
+
+// 合并各文件结果：排序、去重、计数、摘要
+Summary merge(std::vector<FileResult>& results);
+
+} // namespace media_manifest
+
+#endif // MEDIA_MANIFEST_H
@@ -0,0 +1,22 @@
+#ifndef MEDIA_MANIFEST_COLLECTOR_H
+#define MEDIA_MANIFEST_COLLECTOR_H
+
+#include "BaseCollector.h"
+#include <string>
+#include <vector>
+
+/**
+ * 媒体编解码器清单和系统特性声明
+ * 枚举各分区etc目录下的 media_codecs*.xml 和 permissions目录下的 .xml，由共享线程池每个文件一个任务并行扫描，
+ * 输出编解码器和特性计数、排序去重后的特性列表和两个BLAKE3摘要（全部条目、仅特性）
+ */
+class MediaManifestCollector : public BaseCollector {
+public:
+    MediaManifestCollector();
+    virtual ~MediaManifestCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+};
+
+#endif // MEDIA_MANIFEST_COLLECTOR_H
@@ -0,0 +1,38 @@
+#ifndef NATIVE_EXECUTOR_H
+#define NATIVE_EXECUTOR_H
+
+#include <jni.h>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+/**
+ * 固定大小的native工作线程池
+ * 每个工作线程启动时附加到JavaVM，任务直接拿到本线程的JNIEnv
+ * 并发请求在同一个队列中排队，不再为每个调用占用一个Java线程
+ */
+class NativeExecutor {
+public:
+    using Task = std::function<void(JNIEnv*)>;
+
+    static NativeExecutor& instance();
+
+    // JNI_OnLoad中保存JavaVM，工作线程据此附加
+    static void setJavaVM(JavaVM* vm);
+    static JavaVM* javaVM();
+
+    void submit(Task task);
+
+    static constexpr int kWorkerCount = 2;
+
+private:
+    NativeExecutor();
+    void workerLoop(int index);
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<Task> m_queue;
+};
+
+#endif // NATIVE_EXECUTOR_H
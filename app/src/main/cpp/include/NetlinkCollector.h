@@ -0,0 +1,16 @@
+#ifndef NETLINK_COLLECTOR_H
+#define NETLINK_COLLECTOR_H
+
+#include "BaseCollector.h"
+
+// 通过bionic netlink (myGetifaddrs) 收集网络接口的MAC和IP地址
+class NetlinkCollector : public BaseCollector {
+public:
+    NetlinkCollector() = default;
+    virtual ~NetlinkCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+};
+
+#endif // NETLINK_COLLECTOR_H
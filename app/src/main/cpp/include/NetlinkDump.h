@@ -0,0 +1,232 @@
+#ifndef NETLINK_DUMP_H
+#define NETLINK_DUMP_H
+
+#include "private/ScopedFd.h"
+#include <linux/neighbour.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * rtnetlink 转储引擎
+ * 同一个套接字上依次发送 RTM_GETLINK / RTM_GETADDR / RTM_GETROUTE / RTM_GETNEIGH 转储请求，
+ * 接收缓冲区复用，消息和属性都以指向缓冲区的视图交给回调，不复制负载。
+ * 属性访问器在编译期展开：只有模板参数中列出的 rta_type 才会调用处理函数，
+ * 处理函数通过 AttrType<T> 重载或 if constexpr 区分类型。
+ * 只依赖Linux头文件，主机工具可以直接对真实的rtnetlink运行。
+ */
+namespace netlink {
+
+// 指向接收缓冲区的属性负载
+struct Payload {
+    const uint8_t* data;
+    size_t size;
+
+    // 定长字段，负载不足时返回false（缓冲区中的属性不保证按T对齐）
+    template <typename T>
+    bool read(T* out) const {
+        if (size < sizeof(T)) return false;
+        memcpy(out, data, sizeof(T));
+        return true;
+    }
+
+    // 字符串属性，去掉结尾的NUL
+    std::string_view string() const {
+        size_t length = size;
+        while (length > 0 && data[length - 1] == '\0') --length;
+        return std::string_view(reinterpret_cast<const char*>(data), length);
+    }
+};
+
+template <uint16_t Type>
+using AttrType = std::integral_constant<uint16_t, Type>;
+
+// 消息类型对应的固定头部，消息长度不够时返回nullptr
+template <typename Header>
+const Header* messageHeader(const nlmsghdr* message) {
+    if (message->nlmsg_len < NLMSG_LENGTH(sizeof(Header))) return nullptr;
+    return static_cast<const Header*>(NLMSG_DATA(message));
+}
+
+namespace detail {
+
+template <uint16_t... Types, typename Fn>
+inline void dispatch(uint16_t type, const Payload& payload, Fn& fn) {
+    // 折叠成一串比较，未列出的类型直接跳过
+    static_cast<void>(((type == Types ? (fn(AttrType<Types>(), payload), true) : false) || ...));
+}
+
+} // namespace detail
+
+// 遍历消息固定头部Header之后的属性，fn(AttrType<T>, Payload) 只对Types中的类型调用
+template <typename Header, uint16_t... Types, typename Fn>
+void visitAttributes(const nlmsghdr* message, Fn&& fn) {
+    size_t offset = NLMSG_LENGTH(NLMSG_ALIGN(sizeof(Header)));
+    if (message->nlmsg_len < offset) return;
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(message);
+    size_t end = message->nlmsg_len;
+
+    while (end - offset >= sizeof(rtattr)) {
+        const rtattr* attribute = reinterpret_cast<const rtattr*>(base + offset);
+        size_t length = attribute->rta_len;
+        if (length < sizeof(rtattr) || length > end - offset) break;
+        // 嵌套/网络字节序标志位不参与类型匹配
+        uint16_t type = attribute->rta_type & NLA_TYPE_MASK;
+        Payload payload{base + offset + RTA_LENGTH(0), length - RTA_LENGTH(0)};
+        detail::dispatch<Types...>(type, payload, fn);
+        offset += RTA_ALIGN(length);
+    }
+}
+
+// 转储请求：netlink头加上对应消息类型的固定头部
+struct Request {
+    nlmsghdr header;
+    union {
+        ifinfomsg link;
+        ifaddrmsg address;
+        rtmsg route;
+        ndmsg neighbor;
+    } body;
+};
+
+namespace detail {
+
+template <typename Body>
+inline Request dumpRequest(uint16_t type) {
+    Request request;
+    memset(&request, 0, sizeof(request));
+    request.header.nlmsg_len = NLMSG_LENGTH(sizeof(Body));
+    request.header.nlmsg_type = type;
+    request.header.nlmsg_flags = NLM_F_REQUEST | NLM_F_DUMP;
+    return request;
+}
+
+} // namespace detail
+
+inline Request linkDump() {
+    Request request = detail::dumpRequest<ifinfomsg>(RTM_GETLINK);
+    request.body.link.ifi_family = AF_UNSPEC;
+    return request;
+}
+
+inline Request addressDump(uint8_t family = AF_UNSPEC) {
+    Request request = detail::dumpRequest<ifaddrmsg>(RTM_GETADDR);
+    request.body.address.ifa_family = family;
+    return request;
+}
+
+inline Request routeDump(uint8_t family = AF_UNSPEC) {
+    Request request = detail::dumpRequest<rtmsg>(RTM_GETROUTE);
+    request.body.route.rtm_family = family;
+    return request;
+}
+
+inline Request neighborDump(uint8_t family = AF_UNSPEC) {
+    Request request = detail::dumpRequest<ndmsg>(RTM_GETNEIGH);
+    request.body.neighbor.ndm_family = family;
+    return request;
+}
+
+/**
+ * NETLINK_ROUTE 套接字，一个实例上可以顺序执行多次转储
+ * 失败时返回false，error()给出errno（内核NLMSG_ERROR的错误码或系统调用错误）
+ */
+class Socket {
+public:
+    // 内核单个转储数据报不超过32KB（NLMSG_GOODSIZE上限），缓冲区不会截断消息
+    static constexpr size_t kBufferSize = 32 * 1024;
+
+    struct Stats {
+        uint32_t datagrams = 0;
+        uint32_t messages = 0;
+        uint64_t bytes = 0;
+    };
+
+    Socket() : m_fd(socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE)) {
+        m_error = m_fd.get() < 0 ? errno : 0;
+    }
+
+    bool valid() const { return m_fd.get() >= 0; }
+    int error() const { return m_error; }
+    // 最近一次转储期间表发生变化（NLM_F_DUMP_INTR），结果可能不一致
+    bool interrupted() const { return m_interrupted; }
+    const Stats& stats() const { return m_stats; }
+
+    // onMessage(const nlmsghdr*) 对每条数据消息调用，消息指针只在回调期间有效
+    template <typename Fn>
+    bool dump(Request request, Fn&& onMessage) {
+        if (!valid()) return false;
+        m_interrupted = false;
+        request.header.nlmsg_seq = ++m_sequence;
+        if (!sendRequest(request)) return false;
+
+        if (!m_buffer) m_buffer.reset(new uint8_t[kBufferSize]);
+        while (true) {
+            ssize_t bytes;
+            do {
+                bytes = recv(m_fd.get(), m_buffer.get(), kBufferSize, MSG_TRUNC);
+            } while (bytes < 0 && errno == EINTR);
+            if (bytes <= 0) return fail(bytes < 0 ? errno : EIO);
+            if (static_cast<size_t>(bytes) > kBufferSize) return fail(EMSGSIZE);
+            ++m_stats.datagrams;
+            m_stats.bytes += static_cast<uint64_t>(bytes);
+
+            // NLMSG_OK/NLMSG_NEXT按int计算剩余长度，最后一条消息对齐后可能为负
+            const nlmsghdr* message = reinterpret_cast<const nlmsghdr*>(m_buffer.get());
+            int remaining = static_cast<int>(bytes);
+            for (; NLMSG_OK(message, remaining); message = NLMSG_NEXT(message, remaining)) {
+                // 之前失败的转储可能遗留旧序号的消息
+                if (message->nlmsg_seq != request.header.nlmsg_seq) continue;
+                if (message->nlmsg_flags & NLM_F_DUMP_INTR) m_interrupted = true;
+
+                if (message->nlmsg_type == NLMSG_DONE) {
+                    // 较新的内核在DONE中附带转储的错误码
+                    int status = 0;
+                    if (message->nlmsg_len >= NLMSG_LENGTH(sizeof(int))) {
+                        memcpy(&status, NLMSG_DATA(message), sizeof(int));
+                    }
+                    return status < 0 ? fail(-status) : true;
+                }
+                if (message->nlmsg_type == NLMSG_ERROR) {
+                    const nlmsgerr* error = messageHeader<nlmsgerr>(message);
+                    return fail(error != nullptr && error->error < 0 ? -error->error : EIO);
+                }
+                ++m_stats.messages;
+                onMessage(message);
+            }
+        }
+    }
+
+private:
+    bool sendRequest(const Request& request) {
+        ssize_t bytes;
+        do {
+            bytes = send(m_fd.get(), &request, request.header.nlmsg_len, 0);
+        } while (bytes < 0 && errno == EINTR);
+        if (bytes != static_cast<ssize_t>(request.header.nlmsg_len)) return fail(bytes < 0 ? errno : EIO);
+        return true;
+    }
+
+    bool fail(int error) {
+        m_error = error;
+        return false;
+    }
+
+    ScopedFd m_fd;
+    std::unique_ptr<uint8_t[]> m_buffer;
+    uint32_t m_sequence = 0;
+    int m_error = 0;
+    bool m_interrupted = false;
+    Stats m_stats;
+};
+
+} // namespace netlink
+
+#endif // NETLINK_DUMP_H
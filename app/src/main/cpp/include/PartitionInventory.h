@@ -0,0 +1,142 @@
+#ifndef PARTITION_INVENTORY_H
+#define PARTITION_INVENTORY_H
+
+#include "DirentScanner.h"
+#include "HashUtils.h"
+#include "WorkStealingPool.h"
+#include "private/ScopedFd.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <vector>
+
+/**
+ * 分区清单摘要：递归遍历若干根目录，对每个条目的 (相对路径, 大小, mode) 求哈希
+ * 条目哈希按64位加法累加，结果与遍历顺序、线程划分无关；同一系统镜像总是得到同一摘要
+ * 每个子目录是线程池中的一个任务，每个worker有独立的累加器，结束后合并
+ * 目录用getdents64枚举，条目用相对于目录fd的fstatat（不跟随符号链接）
+ * Io为IoBackend中的LibcIo或RawSyscallIo；主机工具用LibcIo对任意目录树运行
+ */
+namespace partition_inventory {
+
+struct RootResult {
+    std::string path;
+    bool present = false;
+    uint64_t entries = 0;
+    uint64_t directories = 0;
+    uint64_t totalBytes = 0;
+    // 无法打开的子目录或无法stat的条目数，这些条目只按名称计入摘要
+    uint64_t errors = 0;
+    uint64_t digest = 0;
+};
+
+namespace detail {
+
+struct alignas(64) Accumulator {
+    uint64_t sum = 0;
+    uint64_t entries = 0;
+    uint64_t directories = 0;
+    uint64_t totalBytes = 0;
+    uint64_t errors = 0;
+};
+
+struct Walk {
+    WorkStealingPool* pool;
+    const std::vector<std::string>* roots;
+    // 按 worker * roots.size() + root 索引
+    std::vector<Accumulator> accumulators;
+};
+
+template <typename Io>
+void scanDirectory(Walk* walk, unsigned worker, size_t root, const std::string& relative) {
+    Accumulator& acc = walk->accumulators[worker * walk->roots->size() + root];
+
+    std::string path = (*walk->roots)[root] + relative;
+    // 根目录本身允许是符号链接，子目录已经用lstat确认过类型
+    int flags = O_RDONLY | O_DIRECTORY | O_CLOEXEC | (relative.empty() ? 0 : O_NOFOLLOW);
+    ScopedFd dir(Io::openAt(AT_FDCWD, path.c_str(), flags));
+    if (dir.get() < 0) {
+        ++acc.errors;
+        return;
+    }
+    ++acc.directories;
+
+    // 目录前缀只哈希一次，每个条目从这里继续
+    std::string prefix = relative + "/";
+    uint64_t prefixHash = fnv1a64(prefix.data(), prefix.size());
+
+    bool complete = dirent_scan::forEachEntry<Io>(dir.get(), [&](const char* name, unsigned char) {
+        uint64_t hash = fnv1a64(name, strlen(name), prefixHash);
+        struct stat64 st;
+        if (Io::fstatAt(dir.get(), name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+            uint64_t size = static_cast<uint64_t>(st.st_size);
+            uint32_t mode = static_cast<uint32_t>(st.st_mode);
+            hash = fnv1a64(&size, sizeof(size), hash);
+            hash = fnv1a64(&mode, sizeof(mode), hash);
+            if (S_ISDIR(st.st_mode)) {
+                std::string child = prefix + name;
+                walk->pool->spawn(worker, [walk, root, child](unsigned w) {
+                    scanDirectory<Io>(walk, w, root, child);
+                });
+            } else {
+                acc.totalBytes += size;
+            }
+        } else {
+            ++acc.errors;
+        }
+        acc.sum += mix64(hash);
+        ++acc.entries;
+        return true;
+    });
+    if (!complete) ++acc.errors;
+}
+
+} // namespace detail
+
+template <typename Io>
+std::vector<RootResult> scan(const std::vector<std::string>& roots, WorkStealingPool& pool) {
+    detail::Walk walk{&pool, &roots, std::vector<detail::Accumulator>(pool.workerCount() * roots.size())};
+
+    std::vector<WorkStealingPool::Task> tasks;
+    for (size_t root = 0; root < roots.size(); ++root) {
+        tasks.emplace_back([&walk, root](unsigned worker) {
+            detail::scanDirectory<Io>(&walk, worker, root, std::string());
+        });
+    }
+    pool.runAndWait(std::move(tasks));
+
+    std::vector<RootResult> results(roots.size());
+    for (size_t root = 0; root < roots.size(); ++root) {
+        RootResult& result = results[root];
+        result.path = roots[root];
+        uint64_t sum = 0;
+        for (unsigned worker = 0; worker < pool.workerCount(); ++worker) {
+            const detail::Accumulator& acc = walk.accumulators[worker * roots.size() + root];
+            sum += acc.sum;
+            result.entries += acc.entries;
+            result.directories += acc.directories;
+            result.totalBytes += acc.totalBytes;
+            result.errors += acc.errors;
+        }
+        // 根目录打不开时directories为0
+        result.present = result.directories > 0;
+        result.digest = mix64(sum ^ mix64(result.entries));
+    }
+    return results;
+}
+
+// 按根目录顺序合并各根的摘要
+inline uint64_t combinedDigest(const std::vector<RootResult>& results) {
+    uint64_t hash = kFnvOffsetBasis;
+    for (const RootResult& result : results) {
+        hash = fnv1a64(result.path.data(), result.path.size(), hash);
+        hash = fnv1a64(&result.digest, sizeof(result.digest), hash);
+    }
+    return mix64(hash);
+}
+
+} // namespace partition_inventory
+
+#endif // PARTITION_INVENTORY_H
@@ -0,0 +1,26 @@
+#ifndef PARTITION_INVENTORY_COLLECTOR_H
+#define PARTITION_INVENTORY_COLLECTOR_H
+
+#include "BaseCollector.h"
+#include <string>
+#include <vector>
+
+/**
+ * 系统分区清单摘要：/system/framework、/system/lib64、/system/bin、/vendor/lib64、/apex
+ * 下所有条目的 (相对路径, 大小, mode) 的顺序无关哈希，由共享的工作窃取线程池并行遍历
+ * 每个根目录输出一行条目数、目录数、字节数和摘要，最后输出合并摘要
+ */
+class PartitionInventoryCollector : public BaseCollector {
+public:
+    PartitionInventoryCollector();
+    explicit PartitionInventoryCollector(std::vector<std::string> roots) : m_roots(std::move(roots)) {}
+    virtual ~PartitionInventoryCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+
+private:
+    std::vector<std::string> m_roots;
+};
+
+#endif // PARTITION_INVENTORY_COLLECTOR_H
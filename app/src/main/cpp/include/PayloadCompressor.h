@@ -0,0 +1,60 @@
+#ifndef PAYLOAD_COMPRESSOR_H
+#define PAYLOAD_COMPRESSOR_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * 指纹文本的流式压缩（zlib + 预置字典）
+ *
+ * 单份指纹只有几KB，单独压缩时前面的分区标题、ro.*键名、每个核重复的cpuinfo行
+ * 都还没有可引用的历史；预置字典把这些常见内容放进滑动窗口，第一次出现就能引用。
+ * 输出是标准zlib流，头部带字典的adler32（FDICT），服务端据此选择对应字典解压。
+ * 字典由主机工具 fingerprint_dict train 从代表性的指纹文件训练，随APK作为asset发布。
+ */
+// APK assets 中的字典文件名
+inline constexpr const char kCompressionDictionaryAsset[] = "fingerprint.dict";
+
+class PayloadCompressor {
+public:
+    static constexpr int kDefaultLevel = 6;
+
+    // dictionary为空时不使用字典
+    explicit PayloadCompressor(std::shared_ptr<const std::string> dictionary = currentDictionary(),
+                               int level = kDefaultLevel);
+    ~PayloadCompressor();
+
+    PayloadCompressor(const PayloadCompressor&) = delete;
+    PayloadCompressor& operator=(const PayloadCompressor&) = delete;
+
+    // 收集器每产生一段输出就送入，压缩结果累积在内部缓冲区
+    bool append(std::string_view data);
+
+    // 结束压缩流并取出全部输出，失败时返回空串
+    std::string finish();
+
+    uint64_t inputBytes() const { return m_inputBytes; }
+
+    // 进程级字典（由JNI层从asset加载），空串表示清除
+    static void setDictionary(std::string dictionary);
+    static std::shared_ptr<const std::string> currentDictionary();
+
+    // 解压（服务端和基准测试使用）；流要求的字典与dictionary不符时返回false
+    static bool decompress(std::string_view compressed, const std::string* dictionary, std::string* output);
+
+    // zlib流头部记录的字典ID（adler32），没有字典时返回0
+    static uint32_t dictionaryId(const std::string& dictionary);
+
+private:
+    bool deflateChunk(std::string_view data, int flush);
+
+    struct Stream;
+    std::unique_ptr<Stream> m_stream;
+    std::string m_output;
+    uint64_t m_inputBytes = 0;
+    bool m_ok = false;
+};
+
+#endif // PAYLOAD_COMPRESSOR_H
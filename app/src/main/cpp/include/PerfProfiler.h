@@ -0,0 +1,109 @@
+#ifndef PERF_PROFILER_H
+#define PERF_PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * 性能计数器剖析（默认关闭）
+ * 用 perf_event_open 统计当前线程在一段代码中的指令数、周期、缓存未命中、分支预测失败、上下文切换和缺页。
+ * 不允许统计内核态时（perf_event_paranoid >= 2）退回只统计用户态；
+ * 完全不能使用perf（Android应用通常如此）时，上下文切换、缺页和CPU时间改用 getrusage(RUSAGE_THREAD) /
+ * CLOCK_THREAD_CPUTIME_ID，硬件计数器标记为不可用。
+ * 只统计调用线程，分区内部派发到线程池的工作不计入。
+ * 不依赖Android头文件，主机工具也可复用。
+ */
+enum PerfCounter {
+    PERF_INSTRUCTIONS,
+    PERF_CYCLES,
+    PERF_CACHE_MISSES,
+    PERF_BRANCH_MISSES,
+    PERF_CONTEXT_SWITCHES,
+    PERF_PAGE_FAULTS,
+    PERF_TASK_CLOCK,    // 线程CPU时间，纳秒
+    PERF_COUNTER_COUNT,
+};
+
+enum class PerfSource : uint8_t {
+    NONE,               // 不可用
+    PERF_EVENT,         // perf_event_open，包含内核态
+    PERF_EVENT_USER,    // perf_event_open，exclude_kernel
+    RUSAGE,             // getrusage / 线程CPU时钟
+};
+
+const char* perfCounterName(PerfCounter counter);
+const char* perfSourceName(PerfSource source);
+
+struct PerfSample {
+    uint64_t wallNs = 0;
+    uint64_t values[PERF_COUNTER_COUNT] = {};
+    PerfSource sources[PERF_COUNTER_COUNT] = {};
+};
+
+// 当前线程的一组计数器，构造时打开，start()/stop()之间计数；不能跨线程使用
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    void start();
+    PerfSample stop();
+
+    PerfSource source(PerfCounter counter) const { return m_sources[counter]; }
+
+private:
+    int m_fds[PERF_COUNTER_COUNT];
+    PerfSource m_sources[PERF_COUNTER_COUNT];
+    uint64_t m_fallbackStart[PERF_COUNTER_COUNT] = {};
+    uint64_t m_wallStart = 0;
+};
+
+// 按名称累计的剖析结果，输出为表格或JSON
+class PerfProfiler {
+public:
+    static PerfProfiler& instance();
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    bool enabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+    void record(const std::string& name, const PerfSample& sample);
+    void reset();
+
+    // 每行一个名称，数值为每次运行的平均值
+    std::string table() const;
+    // 各计数器的来源和每个名称的累计值，不可用的计数器为null
+    std::string json() const;
+
+    // 剖析关闭时只有一次原子读取
+    class Scope {
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        PerfCounters* m_counters = nullptr;
+    };
+
+private:
+    PerfProfiler() = default;
+
+    struct Entry {
+        std::string name;
+        uint64_t runs = 0;
+        PerfSample total;
+    };
+
+    std::atomic<bool> m_enabled{false};
+    mutable std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+};
+
+#endif // PERF_PROFILER_H
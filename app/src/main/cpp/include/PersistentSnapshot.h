@@ -0,0 +1,58 @@
+#ifndef PERSISTENT_SNAPSHOT_H
+#define PERSISTENT_SNAPSHOT_H
+
+#include "FingerprintSections.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * 应用files目录下的不可变分区快照文件
+ *
+ * 文件布局（本机字节序）：
+ *   SnapshotFileHeader
+ *   SnapshotSectionRecord * sectionCount
+ *   各分区文本，按记录中的offset/length定位
+ *
+ * 加载时只做一次mmap，分区文本直接在映射内存上使用，不做解析
+ * 每个分区带一个校验键（ro.build.fingerprint、build.prop的statx、boot_id等的哈希），
+ * 键不一致的分区视为失效，需要重新收集
+ */
+class PersistentSnapshot {
+public:
+    struct SectionBlob {
+        FingerprintSection section;
+        uint64_t key;
+        std::string text;
+    };
+
+    PersistentSnapshot() = default;
+    ~PersistentSnapshot();
+
+    PersistentSnapshot(const PersistentSnapshot&) = delete;
+    PersistentSnapshot& operator=(const PersistentSnapshot&) = delete;
+
+    // filesDir由Java层的Context.getFilesDir()传入，多用户、工作资料下的路径都正确
+    static std::string pathIn(const std::string& filesDir);
+
+    // 计算分区当前的校验键，廉价操作（系统属性、statx、boot_id）
+    static uint64_t validationKey(FingerprintSection section);
+
+    bool load(const std::string& path);
+    bool lookup(FingerprintSection section, uint64_t key, std::string_view* text) const;
+
+    // 写临时文件后rename，保证读者不会看到半个文件
+    static bool save(const std::string& path, const std::vector<SectionBlob>& blobs);
+
+    static constexpr uint32_t kMagic = 0x53535046;  // "FPSS"
+    static constexpr uint16_t kVersion = 1;
+
+private:
+    void unmap();
+
+    void* m_base = nullptr;
+    size_t m_size = 0;
+};
+
+#endif // PERSISTENT_SNAPSHOT_H
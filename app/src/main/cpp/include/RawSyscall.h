@@ -0,0 +1,55 @@
+#ifndef RAW_SYSCALL_H
+#define RAW_SYSCALL_H
+
+#include <sys/syscall.h>
+#include <cerrno>
+
+// arm/syscall63.s、arm/syscall32.s、x86/syscall64.s、x86/syscall32.s 中的实现
+// 直接陷入内核，不经过libc（也就不会被libc层的hook重定向）
+extern "C" long raw_syscall(long number, long arg1, long arg2, long arg3, long arg4, long arg5, long arg6);
+
+/**
+ * 可内联的系统调用
+ * arm64和x86_64直接内联svc/syscall指令，读循环中没有PLT/GOT跳转
+ * arm32（Thumb下r7是帧指针）和x86（ebx/ebp受PIC和帧指针占用）调用汇编中的raw_syscall
+ */
+static inline long inlineSyscall(long number, long arg1 = 0, long arg2 = 0, long arg3 = 0,
+                                 long arg4 = 0, long arg5 = 0, long arg6 = 0) {
+#if defined(__aarch64__)
+    register long x8 __asm__("x8") = number;
+    register long x0 __asm__("x0") = arg1;
+    register long x1 __asm__("x1") = arg2;
+    register long x2 __asm__("x2") = arg3;
+    register long x3 __asm__("x3") = arg4;
+    register long x4 __asm__("x4") = arg5;
+    register long x5 __asm__("x5") = arg6;
+    __asm__ volatile("svc #0"
+                     : "+r"(x0)
+                     : "r"(x8), "r"(x1), "r"(x2), "r"(x3), "r"(x4), "r"(x5)
+                     : "memory", "cc");
+    return x0;
+#elif defined(__x86_64__)
+    long result;
+    register long r10 __asm__("r10") = arg4;
+    register long r8 __asm__("r8") = arg5;
+    register long r9 __asm__("r9") = arg6;
+    __asm__ volatile("syscall"
+                     : "=a"(result)
+                     : "a"(number), "D"(arg1), "S"(arg2), "d"(arg3), "r"(r10), "r"(r8), "r"(r9)
+                     : "rcx", "r11", "memory", "cc");
+    return result;
+#else
+    return raw_syscall(number, arg1, arg2, arg3, arg4, arg5, arg6);
+#endif
+}
+
+// 内核返回 -4095..-1 表示错误，转换成libc的 -1 + errno 约定
+static inline long syscallResult(long result) {
+    if (result < 0 && result >= -4095) {
+        errno = static_cast<int>(-result);
+        return -1;
+    }
+    return result;
+}
+
+#endif // RAW_SYSCALL_H
@@ -0,0 +1,20 @@
+#ifndef ROUTE_COLLECTOR_H
+#define ROUTE_COLLECTOR_H
+
+#include "BaseCollector.h"
+
+/**
+ * 路由和默认网关：一个netlink会话内转储链路、路由和邻居表
+ * 输出默认路由、网关（路由器）MAC、非local表的路由和路由集合摘要
+ * 网络切换后会变化，不作为不可变分区缓存
+ */
+class RouteCollector : public BaseCollector {
+public:
+    RouteCollector() = default;
+    virtual ~RouteCollector() = default;
+
+    std::string collect() override;
+    std::string getCollectorName() const override;
+};
+
+#endif // ROUTE_COLLECTOR_H
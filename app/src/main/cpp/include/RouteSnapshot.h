@@ -0,0 +1,221 @@
+#ifndef ROUTE_SNAPSHOT_H
+#define ROUTE_SNAPSHOT_H
+
+#include "NetlinkDump.h"
+#include <arpa/inet.h>
+#include <net/if.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/**
+ * 路由表和邻居表快照：在一个netlink套接字上依次转储链路、路由和邻居
+ * 地址以原始字节保存，输出时才格式化。
+ * Android 11起 targetSdk>=30 的应用不能转储链路和邻居（SELinux拒绝），此时接口名退回 if_indextoname，
+ * 邻居表记录错误码，路由照常返回。
+ */
+namespace route_snapshot {
+
+struct Address {
+    uint8_t family = AF_UNSPEC;
+    uint8_t length = 0;
+    uint8_t bytes[16] = {};
+
+    bool empty() const { return length == 0; }
+    bool operator==(const Address& other) const {
+        return family == other.family && length == other.length && memcmp(bytes, other.bytes, length) == 0;
+    }
+};
+
+struct Link {
+    int index = 0;
+    std::string name;
+    unsigned flags = 0;
+};
+
+struct Route {
+    uint8_t family = AF_UNSPEC;
+    uint8_t destinationLength = 0;
+    uint8_t type = 0;
+    uint8_t protocol = 0;
+    uint8_t scope = 0;
+    uint32_t table = 0;
+    uint32_t priority = 0;
+    int outputInterface = 0;
+    Address destination;
+    Address gateway;
+};
+
+struct Neighbor {
+    int interface = 0;
+    uint16_t state = 0;
+    Address address;
+    uint8_t linkLayerLength = 0;
+    uint8_t linkLayer[16] = {};
+};
+
+struct Snapshot {
+    std::vector<Link> links;
+    std::vector<Route> routes;
+    std::vector<Neighbor> neighbors;
+    int linkError = 0;      // 链路转储被拒绝时的errno
+    int neighborError = 0;  // 邻居转储被拒绝时的errno
+    bool interrupted = false;
+};
+
+namespace detail {
+
+inline bool setAddress(uint8_t family, const netlink::Payload& payload, Address* address) {
+    size_t expected = family == AF_INET ? 4 : family == AF_INET6 ? 16 : 0;
+    if (expected == 0 || payload.size != expected) return false;
+    address->family = family;
+    address->length = static_cast<uint8_t>(expected);
+    memcpy(address->bytes, payload.data, expected);
+    return true;
+}
+
+inline void onLink(const nlmsghdr* message, Snapshot* snapshot) {
+    const ifinfomsg* info = netlink::messageHeader<ifinfomsg>(message);
+    if (info == nullptr) return;
+    Link link;
+    link.index = info->ifi_index;
+    link.flags = info->ifi_flags;
+    netlink::visitAttributes<ifinfomsg, IFLA_IFNAME>(message, [&link](auto, const netlink::Payload& payload) {
+        link.name.assign(payload.string());
+    });
+    snapshot->links.push_back(std::move(link));
+}
+
+inline void onRoute(const nlmsghdr* message, Snapshot* snapshot) {
+    const rtmsg* header = netlink::messageHeader<rtmsg>(message);
+    if (header == nullptr || (header->rtm_family != AF_INET && header->rtm_family != AF_INET6)) return;
+    // 路由缓存项（RTM_F_CLONED）不是配置的路由
+    if (header->rtm_flags & RTM_F_CLONED) return;
+
+    Route route;
+    route.family = header->rtm_family;
+    route.destinationLength = header->rtm_dst_len;
+    route.type = header->rtm_type;
+    route.protocol = header->rtm_protocol;
+    route.scope = header->rtm_scope;
+    route.table = header->rtm_table;
+    netlink::visitAttributes<rtmsg, RTA_DST, RTA_GATEWAY, RTA_OIF, RTA_PRIORITY, RTA_TABLE>(
+            message, [&route](auto type, const netlink::Payload& payload) {
+                if constexpr (decltype(type)::value == RTA_DST) {
+                    setAddress(route.family, payload, &route.destination);
+                } else if constexpr (decltype(type)::value == RTA_GATEWAY) {
+                    setAddress(route.family, payload, &route.gateway);
+                } else if constexpr (decltype(type)::value == RTA_OIF) {
+                    payload.read(&route.outputInterface);
+                } else if constexpr (decltype(type)::value == RTA_PRIORITY) {
+                    payload.read(&route.priority);
+                } else {
+                    // 表号超过255时只在RTA_TABLE中给出
+                    payload.read(&route.table);
+                }
+            });
+    snapshot->routes.push_back(route);
+}
+
+inline void onNeighbor(const nlmsghdr* message, Snapshot* snapshot) {
+    const ndmsg* header = netlink::messageHeader<ndmsg>(message);
+    if (header == nullptr || (header->ndm_family != AF_INET && header->ndm_family != AF_INET6)) return;
+
+    Neighbor neighbor;
+    neighbor.interface = header->ndm_ifindex;
+    neighbor.state = header->ndm_state;
+    netlink::visitAttributes<ndmsg, NDA_DST, NDA_LLADDR>(
+            message, [&neighbor, header](auto type, const netlink::Payload& payload) {
+                if constexpr (decltype(type)::value == NDA_DST) {
+                    setAddress(header->ndm_family, payload, &neighbor.address);
+                } else if (payload.size <= sizeof(neighbor.linkLayer)) {
+                    neighbor.linkLayerLength = static_cast<uint8_t>(payload.size);
+                    memcpy(neighbor.linkLayer, payload.data, payload.size);
+                }
+            });
+    if (!neighbor.address.empty()) snapshot->neighbors.push_back(neighbor);
+}
+
+} // namespace detail
+
+// 链路和邻居转储被拒绝不算失败；路由转储失败时返回false，errno见socket.error()
+inline bool collect(netlink::Socket& socket, Snapshot* snapshot) {
+    *snapshot = Snapshot();
+    if (!socket.dump(netlink::linkDump(), [snapshot](const nlmsghdr* message) {
+            detail::onLink(message, snapshot);
+        })) {
+        snapshot->linkError = socket.error();
+        snapshot->links.clear();
+    }
+    snapshot->interrupted |= socket.interrupted();
+
+    if (!socket.dump(netlink::routeDump(), [snapshot](const nlmsghdr* message) {
+            detail::onRoute(message, snapshot);
+        })) {
+        return false;
+    }
+    snapshot->interrupted |= socket.interrupted();
+
+    if (!socket.dump(netlink::neighborDump(), [snapshot](const nlmsghdr* message) {
+            detail::onNeighbor(message, snapshot);
+        })) {
+        snapshot->neighborError = socket.error();
+        snapshot->neighbors.clear();
+    }
+    snapshot->interrupted |= socket.interrupted();
+    return true;
+}
+
+inline std::string interfaceName(const Snapshot& snapshot, int index) {
+    for (const Link& link : snapshot.links) {
+        if (link.index == index) return link.name;
+    }
+    char name[IF_NAMESIZE];
+    if (index > 0 && if_indextoname(static_cast<unsigned>(index), name) != nullptr) return name;
+    return "if" + std::to_string(index);
+}
+
+inline std::string formatAddress(const Address& address) {
+    char text[INET6_ADDRSTRLEN];
+    if (address.empty() || inet_ntop(address.family, address.bytes, text, sizeof(text)) == nullptr) return "";
+    return text;
+}
+
+inline std::string formatLinkLayer(const Neighbor& neighbor) {
+    std::string text;
+    char byte[4];
+    for (uint8_t i = 0; i < neighbor.linkLayerLength; ++i) {
+        snprintf(byte, sizeof(byte), i == 0 ? "%02x" : ":%02x", neighbor.linkLayer[i]);
+        text += byte;
+    }
+    return text;
+}
+
+inline const char* neighborStateName(uint16_t state) {
+    if (state & NUD_PERMANENT) return "PERMANENT";
+    if (state & NUD_NOARP) return "NOARP";
+    if (state & NUD_REACHABLE) return "REACHABLE";
+    if (state & NUD_STALE) return "STALE";
+    if (state & NUD_DELAY) return "DELAY";
+    if (state & NUD_PROBE) return "PROBE";
+    if (state & NUD_FAILED) return "FAILED";
+    if (state & NUD_INCOMPLETE) return "INCOMPLETE";
+    return "NONE";
+}
+
+// 默认路由：目的前缀长度为0且带网关的单播路由（Android按网络分表，不一定在main表中）
+inline bool isDefaultRoute(const Route& route) {
+    return route.type == RTN_UNICAST && route.destinationLength == 0 && !route.gateway.empty();
+}
+
+// 网关在同一出接口上的邻居项，即路由器的MAC
+inline const Neighbor* gatewayNeighbor(const Snapshot& snapshot, const Route& route) {
+    for (const Neighbor& neighbor : snapshot.neighbors) {
+        if (neighbor.interface == route.outputInterface && neighbor.address == route.gateway) return &neighbor;
+    }
+    return nullptr;
+}
+
+} // namespace route_snapshot
+
+#endif // ROUTE_SNAPSHOT_H
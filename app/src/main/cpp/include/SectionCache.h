@@ -0,0 +1,71 @@
+#ifndef SECTION_CACHE_H
+#define SECTION_CACHE_H
+
+#include "FingerprintSections.h"
+#include "PersistentSnapshot.h"
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+
+/**
+ * 不可变分区的进程级缓存
+ * 库加载后可在后台线程预热，JNI调用直接拿到结果或在共享future上限时等待
+ * 设置快照目录后，校验键未变化的分区直接取自上次运行保存的mmap快照，不再重新收集
+ */
+class SectionCache {
+public:
+    static SectionCache& instance();
+
+    // 设置快照所在目录（应用的files目录）并映射已有快照；只有第一次调用生效
+    // 未设置时不读也不写快照
+    void setSnapshotDirectory(const std::string& directory);
+
+    // 在后台线程中依次收集SECTION_WARMUP_MASK中的分区（只会启动一次）
+    void startWarmup();
+
+    // 后台预取单个分区，已缓存或正在收集时直接返回
+    void prefetch(FingerprintSection section);
+
+    // 已完成则直接返回；正在收集则最多等待timeout，超时后在当前线程自行收集
+    // 失败的结果只返回给本次及正在等待的调用方，不缓存
+    // 可变分区不缓存，直接调用collector
+    std::string getOrCollect(FingerprintSection section,
+                             const std::function<std::string()>& collector,
+                             std::chrono::milliseconds timeout = kDefaultWaitTimeout);
+
+    // 分区已缓存完成时取出结果，不等待也不触发收集
+    bool peek(FingerprintSection section, std::string* result);
+
+    static constexpr std::chrono::milliseconds kDefaultWaitTimeout{2000};
+
+private:
+    SectionCache() = default;
+
+    // 返回true表示调用者负责填充该分区
+    bool claim(FingerprintSection section, std::shared_future<std::string>* future,
+               std::promise<std::string>* promise);
+
+    // 优先使用持久化快照，失效时调用collector重新收集
+    std::string fill(FingerprintSection section, const std::function<std::string()>& collector);
+
+    // 把结果交给等待者；失败的结果不缓存，清空槽位让下一次调用重新收集
+    void publish(FingerprintSection section, std::promise<std::string>* promise, const std::string& result);
+
+    // 所有不可变分区都收集过且有新收集成功的分区时写回快照（失败的分区不写入）
+    void persistIfComplete();
+
+    std::mutex m_mutex;
+    bool m_warmupStarted = false;
+    std::shared_future<std::string> m_futures[SECTION_COUNT];
+
+    std::mutex m_snapshotMutex;
+    std::string m_snapshotPath;
+    PersistentSnapshot m_snapshot;
+    uint64_t m_keys[SECTION_COUNT] = {};
+    bool m_attempted[SECTION_COUNT] = {};
+    bool m_dirty = false;
+};
+
+#endif // SECTION_CACHE_H
@@ -0,0 +1,55 @@
+#ifndef SECTION_IDS_H
+#define SECTION_IDS_H
+
+#include <cstdint>
+
+// 分区标识和掩码，不依赖JNI，主机工具也可使用；收集入口见 FingerprintSections.h
+
+// 指纹分区标识，按位组合成掩码（与Kotlin侧常量保持一致）
+enum FingerprintSection : uint32_t {
+    SECTION_BUILD_PROP    = 1u << 0,
+    SECTION_UNAME         = 1u << 1,
+    SECTION_CPU_INFO      = 1u << 2,
+    SECTION_DRM_ID        = 1u << 3,
+    SECTION_NETLINK       = 1u << 4,
+    SECTION_FILE_SYSTEM   = 1u << 5,
+    SECTION_KERNEL_FILES  = 1u << 6,
+    SECTION_SYSTEM_FILES  = 1u << 7,
+    SECTION_COMMON_DEVICE = 1u << 8,
+    SECTION_BLOCK_DEVICES = 1u << 9,
+    SECTION_PARTITION_INVENTORY = 1u << 10,
+    SECTION_ELF_BUILD_IDS = 1u << 11,
+    SECTION_FILE_HASHES = 1u << 12,
+    SECTION_KERNEL_CONFIG = 1u << 13,
+    SECTION_MEMORY_MAPS = 1u << 14,
+    SECTION_ROUTES = 1u << 15,
+    SECTION_MEDIA_MANIFESTS = 1u << 16,
+};
+
+constexpr int SECTION_COUNT = 17;
+
+// 重启或OTA之前不会变化的分区，结果可以缓存和持久化
+constexpr uint32_t SECTION_IMMUTABLE_MASK =
+        SECTION_BUILD_PROP | SECTION_UNAME | SECTION_CPU_INFO | SECTION_DRM_ID | SECTION_NETLINK |
+        SECTION_BLOCK_DEVICES | SECTION_PARTITION_INVENTORY | SECTION_ELF_BUILD_IDS | SECTION_KERNEL_CONFIG |
+        SECTION_MEDIA_MANIFESTS;
+
+// 库加载时预热的分区：只取几个文件读取/系统调用就能完成的；
+// 块设备、分区清单、ELF build-id、内核配置、媒体清单要遍历目录或解压，启动期间与应用争抢I/O，首次请求时再收集
+constexpr uint32_t SECTION_WARMUP_MASK =
+        SECTION_BUILD_PROP | SECTION_UNAME | SECTION_CPU_INFO | SECTION_DRM_ID | SECTION_NETLINK;
+
+static_assert((SECTION_WARMUP_MASK & ~SECTION_IMMUTABLE_MASK) == 0, "warm-up sections must be cacheable");
+
+constexpr uint32_t SECTION_ALL_MASK = (1u << SECTION_COUNT) - 1;
+
+inline bool isImmutableSection(FingerprintSection section) {
+    return (SECTION_IMMUTABLE_MASK & section) != 0;
+}
+
+// 需要调用Java层（StatFs/System.getProperty）的分区，收集线程必须附加到JVM
+inline bool sectionNeedsJni(FingerprintSection section) {
+    return section == SECTION_FILE_SYSTEM || section == SECTION_COMMON_DEVICE;
+}
+
+#endif // SECTION_IDS_H
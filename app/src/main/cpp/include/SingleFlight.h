@@ -0,0 +1,167 @@
+#ifndef SINGLE_FLIGHT_H
+#define SINGLE_FLIGHT_H
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * 一次性事件：set()之后所有等待者返回，之后的wait()立即返回
+ * 等待直接阻塞在futex上，不自旋；没有等待者时set()不进入内核
+ */
+class FutexEvent {
+public:
+    bool isSet() const {
+        return m_state.load(std::memory_order_acquire) == kSet;
+    }
+
+    void set() {
+        if (m_state.exchange(kSet, std::memory_order_release) == kWaiting) {
+            futex(FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr);
+        }
+    }
+
+    void wait() {
+        while (!prepareWait()) {
+            futex(FUTEX_WAIT_PRIVATE, kWaiting, nullptr);
+        }
+    }
+
+    // 超时返回false
+    bool waitUntil(std::chrono::steady_clock::time_point deadline) {
+        while (!prepareWait()) {
+            auto remaining = deadline - std::chrono::steady_clock::now();
+            if (remaining <= std::chrono::steady_clock::duration::zero()) return false;
+
+            auto seconds = std::chrono::duration_cast<std::chrono::seconds>(remaining);
+            struct timespec timeout = {
+                static_cast<time_t>(seconds.count()),
+                static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(remaining - seconds).count())
+            };
+            futex(FUTEX_WAIT_PRIVATE, kWaiting, &timeout);
+        }
+        return true;
+    }
+
+private:
+    static constexpr uint32_t kIdle = 0;
+    static constexpr uint32_t kWaiting = 1;
+    static constexpr uint32_t kSet = 2;
+
+    // 已触发返回true；否则把状态标记为有等待者，让set()负责唤醒
+    bool prepareWait() {
+        uint32_t state = m_state.load(std::memory_order_acquire);
+        if (state == kSet) return true;
+        if (state == kIdle) {
+            m_state.compare_exchange_strong(state, kWaiting, std::memory_order_acquire);
+            if (state == kSet) return true;
+        }
+        return false;
+    }
+
+    void futex(int op, uint32_t value, const struct timespec* timeout) {
+        // EINTR、EAGAIN（状态已变化）和超时都由调用方的循环重新检查状态
+        syscall(SYS_futex, reinterpret_cast<uint32_t*>(&m_state), op, value, timeout, nullptr, 0);
+    }
+
+    static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex word must be 32 bits");
+    std::atomic<uint32_t> m_state{kIdle};
+};
+
+/**
+ * 按键合并并发调用：同一键同一时刻只有一次计算，期间到达的调用者等待并共享结果
+ * 计算完成后该键从表中移除，下一次调用重新计算（缓存由调用方负责）
+ */
+template <typename Key, typename Value>
+class SingleFlight {
+public:
+    class Call {
+    public:
+        void wait() { m_done.wait(); }
+        bool waitUntil(std::chrono::steady_clock::time_point deadline) { return m_done.waitUntil(deadline); }
+        bool finished() const { return m_done.isSet(); }
+
+        // 只能在wait()返回true之后调用；计算抛出的异常在每个调用者处重新抛出
+        const Value& value() const {
+            if (m_error) std::rethrow_exception(m_error);
+            return m_value;
+        }
+
+    private:
+        friend class SingleFlight;
+        FutexEvent m_done;
+        Value m_value{};
+        std::exception_ptr m_error;
+    };
+
+    // 返回该键正在进行的调用；leader为true时调用者负责计算并调用finish()
+    std::shared_ptr<Call> join(const Key& key, bool* leader) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_calls.find(key);
+        if (it != m_calls.end()) {
+            *leader = false;
+            m_coalesced.fetch_add(1, std::memory_order_relaxed);
+            return it->second;
+        }
+        *leader = true;
+        auto call = std::make_shared<Call>();
+        m_calls.emplace(key, call);
+        return call;
+    }
+
+    void finish(const Key& key, const std::shared_ptr<Call>& call, Value value) {
+        call->m_value = std::move(value);
+        complete(key, call);
+    }
+
+    void fail(const Key& key, const std::shared_ptr<Call>& call, std::exception_ptr error) {
+        call->m_error = std::move(error);
+        complete(key, call);
+    }
+
+    // 同步形式：成为leader则在当前线程计算，否则等待leader的结果
+    template <typename Fn>
+    Value run(const Key& key, Fn&& fn) {
+        bool leader = false;
+        std::shared_ptr<Call> call = join(key, &leader);
+        if (leader) {
+            try {
+                finish(key, call, fn());
+            } catch (...) {
+                fail(key, call, std::current_exception());
+            }
+        } else {
+            call->wait();
+        }
+        return call->value();
+    }
+
+    // 加入已有调用而没有重复计算的次数
+    uint64_t coalescedCount() const { return m_coalesced.load(std::memory_order_relaxed); }
+
+private:
+    void complete(const Key& key, const std::shared_ptr<Call>& call) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_calls.find(key);
+            if (it != m_calls.end() && it->second == call) m_calls.erase(it);
+        }
+        call->m_done.set();
+    }
+
+    std::mutex m_mutex;
+    std::unordered_map<Key, std::shared_ptr<Call>> m_calls;
+    std::atomic<uint64_t> m_coalesced{0};
+};
+
+#endif // SINGLE_FLIGHT_H
@@ -0,0 +1,30 @@
+#ifndef SNAPSHOT_DIFF_H
+#define SNAPSHOT_DIFF_H
+
+#include "FieldSnapshot.h"
+#include <string>
+
+/**
+ * 字段级快照差分
+ * 两个快照都按字段ID排序，一次线性归并得到 新增/删除/修改 操作
+ *
+ * 增量格式：magic + varint操作数 + 操作*
+ *   操作 = 类型(1字节) + varint ID差值(相对上一个操作的ID) + [varint长度 + 值]
+ * 删除操作不带值，ID差值编码让稳定的字段表只占几个字节
+ */
+namespace snapshot_diff {
+
+enum Op : uint8_t {
+    OP_ADD = 1,
+    OP_REMOVE = 2,
+    OP_CHANGE = 3,
+};
+
+std::string encodeDelta(const FieldSnapshot& base, const FieldSnapshot& target);
+
+// 把增量应用到base上得到target，格式错误或与base不一致时返回false
+bool applyDelta(const FieldSnapshot& base, const char* delta, size_t size, FieldSnapshot* out);
+
+} // namespace snapshot_diff
+
+#endif // SNAPSHOT_DIFF_H
@@ -18,14 +18,20 @@ public:
     std::string collectKernelFilesInfo();
     std::string collectSystemFilesInfo();
     
+    // 不可变分区，供SectionCache预热
+    std::string getUnameInfo();
+    std::string collectBuildPropFiles();
+    std::string collectSystemFiles();
+    
+    // 用两种I/O后端分别扫描全部系统文件并计时
+    std::string benchmarkIoBackends(int iterations);
+    
 private:
     JNIEnv* m_env;
     
     // 辅助方法
-    std::string parseBuildProp(const std::string& content, const std::string& filepath);
-    std::string getUnameInfo();
-    std::string collectBuildPropFiles();
-    std::string collectSystemFiles();
+    // 流式解析，所有关键属性找到后提前停止读取
+    std::string parseBuildProp(const std::string& filepath);
     std::string collectAdditionalSystemInfo();
 };
 
@@ -0,0 +1,88 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * 工作窃取线程池，用于可递归拆分的任务（目录树遍历、分块哈希等）
+ * 每个工作线程有自己的双端队列：本线程从尾部取（LIFO，局部性好），
+ * 空闲线程从其他队列头部窃取（拿到的是较早派生、通常较大的任务）。
+ * 任务参数是执行它的worker序号（0..workerCount()-1），同一次runAndWait内可直接索引每线程的累加器而无需加锁。
+ * 多个线程可以同时调用runAndWait，各自的任务共享后台线程；每次调用有自己的完成计数和异常，
+ * 调用线程以0号worker身份只执行本次调用的任务。任务内部也可以再调用runAndWait。
+ * 不依赖Android头文件，主机工具也可复用。
+ */
+class WorkStealingPool {
+public:
+    using Task = std::function<void(unsigned worker)>;
+
+    // threads为后台线程数；调用runAndWait()的线程也作为一个worker参与
+    explicit WorkStealingPool(unsigned threads);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // 进程共享实例，后台线程数为 min(CPU核数 - 1, 3)
+    static WorkStealingPool& shared();
+
+    unsigned workerCount() const { return static_cast<unsigned>(m_queues.size()); }
+
+    // 只能在任务内部调用：把派生任务放入当前worker的队列，归属于该任务所在的runAndWait
+    void spawn(unsigned worker, Task task);
+
+    // 提交初始任务，等待它们及其派生的所有任务完成；任务抛出的第一个异常在这里重新抛出
+    void runAndWait(std::vector<Task> roots);
+
+    // 从其他队列窃取到任务的累计次数
+    uint64_t stealCount() const { return m_steals.load(std::memory_order_relaxed); }
+
+private:
+    // 一次runAndWait调用的状态，在调用线程的栈上
+    struct Run {
+        // 已提交但未执行完的任务数，包括派生任务
+        std::atomic<int64_t> pending{0};
+        // 仍在队列中的任务数，调用线程据此决定是否睡眠
+        std::atomic<int64_t> queued{0};
+        std::exception_ptr error;
+    };
+
+    struct Item {
+        Task task;
+        Run* run;
+    };
+
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::deque<Item> items;
+    };
+
+    void workerLoop(unsigned worker);
+    // only非空时只执行属于该调用的任务（runAndWait的调用线程）
+    bool tryRunOne(unsigned worker, Run* only);
+    void execute(unsigned worker, Item item);
+    void push(unsigned worker, Task task, Run* run);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    // 所有调用仍在队列中等待执行的任务数，空闲线程据此决定是否睡眠
+    std::atomic<int64_t> m_queued{0};
+    std::atomic<uint64_t> m_steals{0};
+
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCv;
+    std::atomic<unsigned> m_sleeping{0};
+    bool m_stop = false;
+};
+
+#endif // WORK_STEALING_POOL_H
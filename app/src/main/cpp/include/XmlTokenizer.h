@@ -0,0 +1,104 @@
+#ifndef XML_TOKENIZER_H
+#define XML_TOKENIZER_H
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * 零分配的SAX式XML标签扫描
+ * 只产生标签事件（开始、结束、自闭合），标签名和原始属性区都是指向输入的视图；文本内容、注释、
+ * 处理指令、CDATA和DOCTYPE被跳过。属性按需用attribute()从原始属性区中查找，值不做实体解码。
+ * 查找 '<'、引号和 '>' 的热循环在SSE2/NEON下每次比较16字节，其他平台逐字节。
+ * 只用于系统自带的清单文件（media_codecs、permissions），不做命名空间和合法性校验。
+ * 不依赖Android头文件，主机工具也可复用。
+ */
+namespace xml {
+
+enum class TagKind {
+    START,
+    END,
+    EMPTY,      // <tag ... />
+};
+
+struct Tag {
+    TagKind kind;
+    std::string_view name;
+    std::string_view attributes;    // 标签名之后、'>' 或 '/>' 之前的原始文本
+};
+
+// [p, end) 中第一个c的位置，没有时返回end
+const char* findByte(const char* p, const char* end, char c);
+// [p, end) 中第一个a、b或c的位置，没有时返回end
+const char* findAny(const char* p, const char* end, char a, char b, char c);
+
+// 当前使用的查找实现："sse2"、"neon" 或 "portable"
+const char* kernelName();
+// 基准测试用：强制使用逐字节实现
+void setPortableOnly(bool portableOnly);
+
+// 在原始属性区中查找name的值（单引号或双引号）
+bool attribute(std::string_view attributes, std::string_view name, std::string_view* value);
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// 对每个标签调用visit(const Tag&)；visit返回false时提前结束
+// 返回false表示文档在标签、注释或引号中间截断
+template <typename Visitor>
+bool forEachTag(std::string_view text, Visitor&& visit) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (true) {
+        p = findByte(p, end, '<');
+        if (p == end) return true;
+        if (end - p < 2) return false;
+
+        // 注释、CDATA、DOCTYPE、处理指令：跳到各自的结束标记
+        if (p[1] == '!' || p[1] == '?') {
+            std::string_view rest(p, static_cast<size_t>(end - p));
+            std::string_view terminator = rest.compare(0, 4, "<!--") == 0        ? "-->"
+                                          : rest.compare(0, 9, "<![CDATA[") == 0 ? "]]>"
+                                          : p[1] == '?'                          ? "?>"
+                                                                                 : ">";
+            size_t close = rest.find(terminator, 2);
+            if (close == std::string_view::npos) return false;
+            p += close + terminator.size();
+            continue;
+        }
+
+        Tag tag;
+        tag.kind = TagKind::START;
+        const char* nameStart = p + 1;
+        if (*nameStart == '/') {
+            tag.kind = TagKind::END;
+            ++nameStart;
+        }
+        const char* nameEnd = nameStart;
+        while (nameEnd < end && !isSpace(*nameEnd) && *nameEnd != '>' && *nameEnd != '/') ++nameEnd;
+        tag.name = std::string_view(nameStart, static_cast<size_t>(nameEnd - nameStart));
+
+        // 属性值中可能出现 '>'，跳过引号内的内容
+        const char* q = nameEnd;
+        while (true) {
+            q = findAny(q, end, '>', '"', '\'');
+            if (q == end) return false;
+            if (*q == '>') break;
+            q = findByte(q + 1, end, *q);
+            if (q == end) return false;
+            ++q;
+        }
+        const char* attributesEnd = q;
+        if (attributesEnd > nameEnd && attributesEnd[-1] == '/') {
+            --attributesEnd;
+            if (tag.kind == TagKind::START) tag.kind = TagKind::EMPTY;
+        }
+        tag.attributes = std::string_view(nameEnd, static_cast<size_t>(attributesEnd - nameEnd));
+        p = q + 1;
+        if (!tag.name.empty() && !visit(static_cast<const Tag&>(tag))) return true;
+    }
+}
+
+} // namespace xml
+
+#endif // XML_TOKENIZER_H
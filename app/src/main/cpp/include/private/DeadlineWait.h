@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../SectionIds.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+/**
+ * DeadlineRunner 等待单个分区的部分：分区预算、分区截止时间、带取消检查的等待
+ * 不依赖JNI，主机上的延迟基准（tools/latency）使用同一份实现
+ */
+namespace deadline_wait {
+
+using Clock = std::chrono::steady_clock;
+
+// 不限时
+constexpr Clock::time_point kNoDeadline = Clock::time_point::max();
+
+// 等待期间检查取消标志的间隔
+constexpr std::chrono::milliseconds kCancelPollInterval{20};
+
+// 单个分区允许的最长收集时间
+inline std::chrono::milliseconds sectionBudget(FingerprintSection section) {
+    switch (section) {
+        // MediaDrm首次创建要加载插件，stat命令要启动子进程
+        case SECTION_DRM_ID:        return std::chrono::milliseconds(1500);
+        case SECTION_FILE_SYSTEM:   return std::chrono::milliseconds(1000);
+        case SECTION_COMMON_DEVICE: return std::chrono::milliseconds(1000);
+        // 冷缓存时要从闪存读出几十MB
+        case SECTION_FILE_HASHES:   return std::chrono::milliseconds(1500);
+        // 遍历 /system、/vendor、/apex 约一万个条目
+        case SECTION_PARTITION_INVENTORY: return std::chrono::milliseconds(1500);
+        // 读取几十个库的ELF头和注释段、解析媒体XML
+        case SECTION_ELF_BUILD_IDS: return std::chrono::milliseconds(1000);
+        case SECTION_MEDIA_MANIFESTS: return std::chrono::milliseconds(1000);
+        default:                    return std::chrono::milliseconds(500);
+    }
+}
+
+// min(请求截止时间, 启动时间 + 分区预算)；不限时的请求分区预算也不生效
+inline Clock::time_point sectionDeadline(FingerprintSection section, Clock::time_point start,
+                                         Clock::time_point deadline) {
+    return deadline == kNoDeadline ? kNoDeadline : std::min(deadline, start + sectionBudget(section));
+}
+
+enum class Outcome {
+    DONE,
+    TIMED_OUT,
+    CANCELLED,
+};
+
+// Call为SingleFlight<...>::Call；cancelled非空时分段等待，每段之间检查取消标志
+template <typename Call>
+Outcome wait(Call& call, Clock::time_point deadline, const std::atomic<bool>* cancelled) {
+    if (cancelled == nullptr) {
+        if (deadline == kNoDeadline) {
+            call.wait();
+            return Outcome::DONE;
+        }
+        return call.waitUntil(deadline) ? Outcome::DONE : Outcome::TIMED_OUT;
+    }
+    while (true) {
+        if (cancelled->load()) return Outcome::CANCELLED;
+        Clock::time_point slice = std::min(deadline, Clock::now() + kCancelPollInterval);
+        if (call.waitUntil(slice)) return Outcome::DONE;
+        if (slice == deadline) return Outcome::TIMED_OUT;
+    }
+}
+
+} // namespace deadline_wait
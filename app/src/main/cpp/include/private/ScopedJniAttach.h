@@ -0,0 +1,42 @@
+#pragma once
+
+#include <jni.h>
+
+/**
+ * RAII helper that attaches the current native thread to the JavaVM
+ * Detaches on destruction only if this instance performed the attach
+ */
+class ScopedJniAttach {
+public:
+    ScopedJniAttach(JavaVM* vm, const char* threadName) : vm_(vm), env_(nullptr), attached_(false) {
+        if (vm_ == nullptr) return;
+
+        if (vm_->GetEnv(reinterpret_cast<void**>(&env_), JNI_VERSION_1_6) == JNI_OK) {
+            return;
+        }
+
+        JavaVMAttachArgs args = {JNI_VERSION_1_6, threadName, nullptr};
+        if (vm_->AttachCurrentThread(&env_, &args) == JNI_OK) {
+            attached_ = true;
+        } else {
+            env_ = nullptr;
+        }
+    }
+
+    ~ScopedJniAttach() {
+        if (attached_) {
+            vm_->DetachCurrentThread();
+        }
+    }
+
+    // Delete copy constructor and assignment
+    ScopedJniAttach(const ScopedJniAttach&) = delete;
+    ScopedJniAttach& operator=(const ScopedJniAttach&) = delete;
+
+    JNIEnv* env() const { return env_; }
+
+private:
+    JavaVM* vm_;
+    JNIEnv* env_;
+    bool attached_;
+};
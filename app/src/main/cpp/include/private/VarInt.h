@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * LEB128 varint encoding helpers for compact binary payloads
+ */
+inline void putVarint(std::string* out, uint64_t value) {
+    while (value >= 0x80) {
+        out->push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out->push_back(static_cast<char>(value));
+}
+
+// Returns false on truncated or overlong input
+inline bool getVarint(const char** cursor, const char* end, uint64_t* value) {
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64 && *cursor < end; shift += 7) {
+        uint8_t byte = static_cast<uint8_t>(*(*cursor)++);
+        result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void putFixed64(std::string* out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+        out->push_back(static_cast<char>(value >> (i * 8)));
+    }
+}
+
+inline bool getFixed64(const char** cursor, const char* end, uint64_t* value) {
+    if (end - *cursor < 8) return false;
+    uint64_t result = 0;
+    for (int i = 0; i < 8; ++i) {
+        result |= static_cast<uint64_t>(static_cast<uint8_t>((*cursor)[i])) << (i * 8);
+    }
+    *cursor += 8;
+    *value = result;
+    return true;
+}
@@ -27,146 +27,235 @@
  * SUCH DAMAGE.
  */
 
- #include <ifaddrs.h>
-
- #include <errno.h>
- #include <linux/if_packet.h>
- #include <net/if.h>
- #include <netinet/in.h>
- #include <stdint.h>
- #include <stdio.h>
- #include <stdlib.h>
- #include <string.h>
- #include <unistd.h>
- 
- //#include "private/ErrnoRestorer.h"
- 
- #include "bionic_netlink.h"
- 
- // The public ifaddrs struct is full of pointers. Rather than track several
- // different allocations, we use a maximally-sized structure with the public
- // part at offset 0, and pointers into its hidden tail.
- 
- static void __getifaddrs_callback(void* context, nlmsghdr* hdr) {
-   ifaddrs** out = reinterpret_cast<ifaddrs**>(context);
- 
-   //首先先判断消息类型是不是RTM_NEWLINK类型
-   if (hdr->nlmsg_type == RTM_NEWLINK) {
-       //LOGE ("开始执行正常 发现消息是 11111111");
- 
-     ifinfomsg* ifi = reinterpret_cast<ifinfomsg*>(NLMSG_DATA(hdr));
- 
-     // Create a new ifaddr entry, and set the interface index and flags.
-     // 创建一份新的进行拷贝和赋值
-     // 将两个**的封装成 ifaddrs_storage
-     ifaddrs_storage* new_addr = new ifaddrs_storage(out);
- 
-     new_addr->interface_index = ifi->ifi_index;
-     new_addr->ifa.ifa_flags = ifi->ifi_flags;
- 
-     // Go through the various bits of information and find the name.
-     rtattr* rta = IFLA_RTA(ifi);
-     size_t rta_len = IFLA_PAYLOAD(hdr);
-     while (RTA_OK(rta, rta_len)) {
-       if (rta->rta_type == IFLA_ADDRESS) {
-           if (RTA_PAYLOAD(rta) < sizeof(new_addr->addr)) {
-             new_addr->SetAddress(AF_PACKET, RTA_DATA(rta), RTA_PAYLOAD(rta));
-             new_addr->SetPacketAttributes(ifi->ifi_index, ifi->ifi_type, RTA_PAYLOAD(rta));
-           }
-       } else if (rta->rta_type == IFLA_BROADCAST) {
- 
-           if (RTA_PAYLOAD(rta) < sizeof(new_addr->ifa_ifu)) {
-             new_addr->SetBroadcastAddress(AF_PACKET, RTA_DATA(rta), RTA_PAYLOAD(rta));
-             new_addr->SetPacketAttributes(ifi->ifi_index, ifi->ifi_type, RTA_PAYLOAD(rta));
-           }
-       } else if (rta->rta_type == IFLA_IFNAME) {
- 
-           if (RTA_PAYLOAD(rta) < sizeof(new_addr->name)) {
-             memcpy(new_addr->name, RTA_DATA(rta), RTA_PAYLOAD(rta));
-             new_addr->ifa.ifa_name = new_addr->name;
-           }
-       }
-       rta = RTA_NEXT(rta, rta_len);
-     }
- 
- 
-   } else if (hdr->nlmsg_type == RTM_NEWADDR) {
- 
-     ifaddrmsg* msg = reinterpret_cast<ifaddrmsg*>(NLMSG_DATA(hdr));
- 
-     // We should already know about this from an RTM_NEWLINK message.
-     const ifaddrs_storage* addr = reinterpret_cast<const ifaddrs_storage*>(*out);
- 
-     while (addr != nullptr && addr->interface_index != static_cast<int>(msg->ifa_index)) {
-       addr = reinterpret_cast<const ifaddrs_storage*>(addr->ifa.ifa_next);
-     }
-     // If this is an unknown interface, ignore whatever we're being told about it.
-     if (addr == nullptr) return;
- 
-     // Create a new ifaddr entry and copy what we already know.
-     ifaddrs_storage* new_addr = new ifaddrs_storage(out);
- 
-     // We can just copy the name rather than look for IFA_LABEL.
-     strcpy(new_addr->name, addr->name);
- 
-     new_addr->ifa.ifa_name = new_addr->name;
- 
-     new_addr->ifa.ifa_flags = addr->ifa.ifa_flags;
-     new_addr->interface_index = addr->interface_index;
- 
-     // Go through the various bits of information and find the address
-     // and any broadcast/destination address.
-     rtattr* rta = IFA_RTA(msg);
-     size_t rta_len = IFA_PAYLOAD(hdr);
- 
- 
-     while (RTA_OK(rta, rta_len)) {
- 
-       if (rta->rta_type == IFA_ADDRESS) {
-         if (msg->ifa_family == AF_INET || msg->ifa_family == AF_INET6) {
-           new_addr->SetAddress(msg->ifa_family,RTA_DATA(rta) , RTA_PAYLOAD(rta));
-           new_addr->SetNetmask(msg->ifa_family, msg->ifa_prefixlen);
-         }
-       } else if (rta->rta_type == IFA_BROADCAST) {
-           if (msg->ifa_family == AF_INET) {
-           new_addr->SetBroadcastAddress(msg->ifa_family, RTA_DATA(rta), RTA_PAYLOAD(rta));
-         }
-       } else if (rta->rta_type == IFA_LOCAL) {
-           if (msg->ifa_family == AF_INET || msg->ifa_family == AF_INET6) {
-           new_addr->SetLocalAddress(msg->ifa_family, RTA_DATA(rta), RTA_PAYLOAD(rta));
-         }
-       }
-       rta = RTA_NEXT(rta, rta_len);
-     }
-   }
- }
- void freeifaddrs(ifaddrs* list) {
-   while (list != nullptr) {
-     ifaddrs* current = list;
-     list = list->ifa_next;
-     free(current);
-   }
- }
- int myGetifaddrs(ifaddrs** out) {
-   // We construct the result directly into `out`, so terminate the list.
-   *out = nullptr;
- 
-   // Open the netlink socket and ask for all the links and addresses.
-   NetlinkConnection nc;
-   bool okay = nc.SendRequest(RTM_GETLINK) && nc.ReadResponses(__getifaddrs_callback, out) &&
-           nc.SendRequest(RTM_GETADDR) && nc.ReadResponses(__getifaddrs_callback, out);
- 
-   if (!okay) {
-     //out = nullptr;
-     ifaddrs *pIfaddrs = *out;
-     if(pIfaddrs!= nullptr){
-       freeifaddrs(pIfaddrs);
-     }
-     // Ensure that callers crash if they forget to check for success.
-     *out = nullptr;
-     return -1;
-   }
- 
-   return 0;
- }
- 
\ No newline at end of file
+#include <ifaddrs.h>
+
+#include <errno.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <netinet/in.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "NetlinkDump.h"
+
+// The public ifaddrs struct is full of pointers. Rather than track several
+// different allocations, we use a maximally-sized structure with the public
+// part at offset 0, and pointers into its hidden tail.
+struct ifaddrs_storage {
+  // Must come first, so that `ifaddrs_storage` is-a `ifaddrs`.
+  ifaddrs ifa;
+
+  // The interface index, so we can match RTM_NEWADDR messages with
+  // earlier RTM_NEWLINK messages (to copy the interface flags).
+  int interface_index;
+
+  // Storage for the pointers in `ifa`.
+  sockaddr_storage addr;
+  sockaddr_storage netmask;
+  sockaddr_storage ifa_ifu;
+  char name[IFNAMSIZ + 1];
+
+  explicit ifaddrs_storage(ifaddrs** list) {
+    memset(this, 0, sizeof(*this));
+
+    // push_front onto `list`.
+    ifa.ifa_next = *list;
+    *list = reinterpret_cast<ifaddrs*>(this);
+  }
+
+  void SetAddress(int family, const void* data, size_t byteCount) {
+    // The kernel currently uses the order IFA_ADDRESS, IFA_LOCAL, IFA_BROADCAST
+    // in inet_fill_ifaddr, but let's not assume that will always be true...
+    if (ifa.ifa_addr == nullptr) {
+      // This is an IFA_ADDRESS and haven't seen an IFA_LOCAL yet, so assume this is the
+      // local address. SetLocalAddress will fix things if we later see an IFA_LOCAL.
+      ifa.ifa_addr = CopyAddress(family, data, byteCount, &addr);
+    } else {
+      // We already saw an IFA_LOCAL, which implies this is a destination address.
+      ifa.ifa_dstaddr = CopyAddress(family, data, byteCount, &ifa_ifu);
+    }
+  }
+
+  void SetBroadcastAddress(int family, const void* data, size_t byteCount) {
+    // We know that this is a broadcast address because we're only called for IFA_BROADCAST.
+    ifa.ifa_broadaddr = CopyAddress(family, data, byteCount, &ifa_ifu);
+  }
+
+  void SetLocalAddress(int family, const void* data, size_t byteCount) {
+    // The kernel source says "for point-to-point IFA_ADDRESS is DESTINATION address,
+    // local address is supplied in IFA_LOCAL attribute".
+    // So copy any existing IFA_ADDRESS into ifa_dstaddr...
+    if (ifa.ifa_addr != nullptr) {
+      ifa.ifa_dstaddr = reinterpret_cast<sockaddr*>(memcpy(&ifa_ifu, &addr, sizeof(addr)));
+    }
+    // ...and then put this IFA_LOCAL into ifa_addr.
+    ifa.ifa_addr = CopyAddress(family, data, byteCount, &addr);
+  }
+
+  // Netlink gives us the prefix length as a bit count. We need to turn
+  // that into a BSD-compatible netmask represented by a sockaddr*.
+  void SetNetmask(int family, size_t prefix_length) {
+    // ...and work out the netmask from the prefix length.
+    netmask.ss_family = family;
+    uint8_t* dst = SockaddrBytes(family, &netmask);
+    memset(dst, 0xff, prefix_length / 8);
+    if ((prefix_length % 8) != 0) {
+      dst[prefix_length / 8] = (0xff << (8 - (prefix_length % 8)));
+    }
+    ifa.ifa_netmask = reinterpret_cast<sockaddr*>(&netmask);
+  }
+
+  void SetPacketAttributes(int ifindex, unsigned short hatype, unsigned char halen) {
+    sockaddr_ll* sll = reinterpret_cast<sockaddr_ll*>(&addr);
+    sll->sll_ifindex = ifindex;
+    sll->sll_hatype = hatype;
+    sll->sll_halen = halen;
+  }
+
+ private:
+  sockaddr* CopyAddress(int family, const void* data, size_t byteCount, sockaddr_storage* ss) {
+    // Netlink gives us the address family in the header, and the
+    // sockaddr_in or sockaddr_in6 bytes as the payload. We need to
+    // stitch the two bits together into the sockaddr that's part of
+    // our portable interface.
+    ss->ss_family = family;
+    memcpy(SockaddrBytes(family, ss), data, byteCount);
+
+    // For IPv6 we might also have to set the scope id.
+    if (family == AF_INET6 && (IN6_IS_ADDR_LINKLOCAL(data) || IN6_IS_ADDR_MC_LINKLOCAL(data))) {
+      reinterpret_cast<sockaddr_in6*>(ss)->sin6_scope_id = interface_index;
+    }
+
+    return reinterpret_cast<sockaddr*>(ss);
+  }
+
+  // Returns a pointer to the first byte in the address data (which is
+  // stored in network byte order).
+  uint8_t* SockaddrBytes(int family, sockaddr_storage* ss) {
+    if (family == AF_INET) {
+      sockaddr_in* ss4 = reinterpret_cast<sockaddr_in*>(ss);
+      return reinterpret_cast<uint8_t*>(&ss4->sin_addr);
+    } else if (family == AF_INET6) {
+      sockaddr_in6* ss6 = reinterpret_cast<sockaddr_in6*>(ss);
+      return reinterpret_cast<uint8_t*>(&ss6->sin6_addr);
+    } else if (family == AF_PACKET) {
+      sockaddr_ll* sll = reinterpret_cast<sockaddr_ll*>(ss);
+      return reinterpret_cast<uint8_t*>(&sll->sll_addr);
+    }
+    return nullptr;
+  }
+};
+
+// 地址族对应的地址长度，用于校验属性负载
+static size_t __address_size(int family) {
+  return family == AF_INET ? sizeof(in_addr) : family == AF_INET6 ? sizeof(in6_addr) : 0;
+}
+
+static void __handle_link(ifaddrs** out, const nlmsghdr* hdr) {
+  const ifinfomsg* ifi = netlink::messageHeader<ifinfomsg>(hdr);
+  if (ifi == nullptr) return;
+
+  // Create a new ifaddr entry, and set the interface index and flags.
+  ifaddrs_storage* new_addr = new ifaddrs_storage(out);
+  new_addr->interface_index = ifi->ifi_index;
+  new_addr->ifa.ifa_flags = ifi->ifi_flags;
+
+  // Go through the various bits of information and find the name.
+  netlink::visitAttributes<ifinfomsg, IFLA_ADDRESS, IFLA_BROADCAST, IFLA_IFNAME>(
+      hdr, [new_addr, ifi](auto type, const netlink::Payload& payload) {
+        if constexpr (decltype(type)::value == IFLA_IFNAME) {
+          if (payload.size < sizeof(new_addr->name)) {
+            memcpy(new_addr->name, payload.data, payload.size);
+            new_addr->ifa.ifa_name = new_addr->name;
+          }
+        } else if constexpr (decltype(type)::value == IFLA_ADDRESS) {
+          if (payload.size < sizeof(new_addr->addr)) {
+            new_addr->SetAddress(AF_PACKET, payload.data, payload.size);
+            new_addr->SetPacketAttributes(ifi->ifi_index, ifi->ifi_type, payload.size);
+          }
+        } else {
+          if (payload.size < sizeof(new_addr->addr)) {
+            new_addr->SetBroadcastAddress(AF_PACKET, payload.data, payload.size);
+            new_addr->SetPacketAttributes(ifi->ifi_index, ifi->ifi_type, payload.size);
+          }
+        }
+      });
+}
+
+// 没有链路信息（链路转储被拒绝）时用地址消息中的索引查接口名
+static void __handle_addr(ifaddrs** out, const nlmsghdr* hdr, bool have_links) {
+  const ifaddrmsg* msg = netlink::messageHeader<ifaddrmsg>(hdr);
+  if (msg == nullptr) return;
+  size_t address_size = __address_size(msg->ifa_family);
+  if (address_size == 0) return;
+
+  // We should already know about this from an RTM_NEWLINK message.
+  const ifaddrs_storage* known = reinterpret_cast<const ifaddrs_storage*>(*out);
+  while (known != nullptr && known->interface_index != static_cast<int>(msg->ifa_index)) {
+    known = reinterpret_cast<const ifaddrs_storage*>(known->ifa.ifa_next);
+  }
+  char name[IF_NAMESIZE] = {};
+  if (known == nullptr) {
+    // If this is an unknown interface, ignore whatever we're being told about it.
+    if (have_links || if_indextoname(msg->ifa_index, name) == nullptr) return;
+  }
+
+  // Create a new ifaddr entry and copy what we already know.
+  ifaddrs_storage* new_addr = new ifaddrs_storage(out);
+  // We can just copy the name rather than look for IFA_LABEL.
+  strcpy(new_addr->name, known != nullptr ? known->name : name);
+  new_addr->ifa.ifa_name = new_addr->name;
+  new_addr->ifa.ifa_flags = known != nullptr ? known->ifa.ifa_flags : 0;
+  new_addr->interface_index = static_cast<int>(msg->ifa_index);
+
+  // Go through the various bits of information and find the address
+  // and any broadcast/destination address.
+  netlink::visitAttributes<ifaddrmsg, IFA_ADDRESS, IFA_BROADCAST, IFA_LOCAL>(
+      hdr, [new_addr, msg, address_size](auto type, const netlink::Payload& payload) {
+        if (payload.size != address_size) return;
+        if constexpr (decltype(type)::value == IFA_ADDRESS) {
+          new_addr->SetAddress(msg->ifa_family, payload.data, payload.size);
+          new_addr->SetNetmask(msg->ifa_family, msg->ifa_prefixlen);
+        } else if constexpr (decltype(type)::value == IFA_BROADCAST) {
+          if (msg->ifa_family == AF_INET) {
+            new_addr->SetBroadcastAddress(msg->ifa_family, payload.data, payload.size);
+          }
+        } else {
+          new_addr->SetLocalAddress(msg->ifa_family, payload.data, payload.size);
+        }
+      });
+}
+
+void freeifaddrs(ifaddrs* list) {
+  while (list != nullptr) {
+    ifaddrs* current = list;
+    list = list->ifa_next;
+    delete reinterpret_cast<ifaddrs_storage*>(current);
+  }
+}
+
+int myGetifaddrs(ifaddrs** out) {
+  // We construct the result directly into `out`, so terminate the list.
+  *out = nullptr;
+
+  // Open the netlink socket and ask for all the links and addresses.
+  // Android 11起普通应用的RTM_GETLINK会被拒绝，此时只返回地址（与bionic的处理一致）
+  netlink::Socket socket;
+  bool have_links = socket.dump(netlink::linkDump(), [out](const nlmsghdr* hdr) { __handle_link(out, hdr); });
+  if (!have_links) {
+    freeifaddrs(*out);
+    *out = nullptr;
+  }
+  bool okay = socket.dump(netlink::addressDump(),
+                          [out, have_links](const nlmsghdr* hdr) { __handle_addr(out, hdr, have_links); });
+
+  if (!okay) {
+    freeifaddrs(*out);
+    // Ensure that callers crash if they forget to check for success.
+    *out = nullptr;
+    errno = socket.error();
+    return -1;
+  }
+
+  return 0;
+}
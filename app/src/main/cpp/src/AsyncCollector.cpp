@@ -0,0 +1,115 @@
+#include "../include/AsyncCollector.h"
+#include "../include/NativeExecutor.h"
+#include "../include/DeadlineRunner.h"
+#include "../include/Logger.h"
+#include "../include/private/ScopedJniAttach.h"
+
+static jmethodID g_onResultMethod = nullptr;
+
+AsyncCollector& AsyncCollector::instance() {
+    static AsyncCollector collector;
+    return collector;
+}
+
+bool AsyncCollector::cacheCallbackMethod(JNIEnv* env) {
+    jclass callbackClass = env->FindClass("com/android/androiddevicefingerprint/FingerprintCallback");
+    if (callbackClass == nullptr) {
+        env->ExceptionClear();
+        LOGE("AsyncCollector", "Failed to find FingerprintCallback class");
+        return false;
+    }
+
+    // jmethodID在类卸载前一直有效，可以跨线程缓存
+    g_onResultMethod = env->GetMethodID(callbackClass, "onFingerprintResult", "(IILjava/lang/String;)V");
+    env->DeleteLocalRef(callbackClass);
+    if (g_onResultMethod == nullptr) {
+        env->ExceptionClear();
+        LOGE("AsyncCollector", "Failed to find onFingerprintResult method");
+        return false;
+    }
+    return true;
+}
+
+int AsyncCollector::submit(JNIEnv* env, uint32_t mask, jlong deadlineMs, jobject callback) {
+    auto request = std::make_shared<Request>();
+    request->id = m_nextId.fetch_add(1);
+    request->mask = mask & SECTION_ALL_MASK;
+    // 未指定截止时间的请求等待完整结果
+    request->deadline = deadlineMs > 0 ? DeadlineRunner::Clock::now() + std::chrono::milliseconds(deadlineMs)
+                                       : DeadlineRunner::kNoDeadline;
+    request->callback = env->NewGlobalRef(callback);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending[request->id] = request;
+    }
+
+    NativeExecutor::instance().submit([this, request](JNIEnv* workerEnv) {
+        run(workerEnv, request);
+    });
+
+    LOGI("AsyncCollector", "Queued request %d with mask 0x%x", request->id, request->mask);
+    return request->id;
+}
+
+bool AsyncCollector::cancel(int requestId) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_pending.find(requestId);
+    if (it == m_pending.end()) return false;
+
+    it->second->cancelled.store(true);
+    return true;
+}
+
+void AsyncCollector::run(JNIEnv* env, const std::shared_ptr<Request>& request) {
+    if (request->cancelled.load()) {
+        deliver(env, request, STATUS_CANCELLED, "");
+        return;
+    }
+
+    std::vector<FingerprintSection> sections;
+    for (int i = 0; i < SECTION_COUNT; ++i) {
+        FingerprintSection section = sectionAt(i);
+        if (request->mask & section) sections.push_back(section);
+    }
+
+    // 分区并行收集，每个分区受自身预算和请求截止时间约束；超时分区标记为 partial/timeout，其余照常返回
+    // 等待期间取消的请求立即结束，已启动的收集继续在后台完成并进入缓存
+    uint32_t timedOut = 0;
+    std::string result = DeadlineRunner::instance().collect(sections, request->deadline, &timedOut,
+                                                            &request->cancelled);
+    if (request->cancelled.load()) {
+        deliver(env, request, STATUS_CANCELLED, "");
+        return;
+    }
+    deliver(env, request, timedOut != 0 ? STATUS_DEADLINE_EXCEEDED : STATUS_OK, result);
+}
+
+void AsyncCollector::deliver(JNIEnv* env, const std::shared_ptr<Request>& request, Status status,
+                             const std::string& result) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pending.erase(request->id);
+    }
+
+    if (env == nullptr || g_onResultMethod == nullptr) {
+        LOGE("AsyncCollector", "Cannot deliver result for request %d", request->id);
+        // 无法回调也要释放submit()中创建的全局引用；当前线程未附加时临时附加
+        ScopedJniAttach attach(env == nullptr ? NativeExecutor::javaVM() : nullptr, "AsyncCollector");
+        JNIEnv* releaseEnv = env != nullptr ? env : attach.env();
+        if (releaseEnv != nullptr) releaseEnv->DeleteGlobalRef(request->callback);
+        return;
+    }
+
+    jstring resultStr = env->NewStringUTF(result.c_str());
+    env->CallVoidMethod(request->callback, g_onResultMethod, request->id, static_cast<jint>(status), resultStr);
+    if (env->ExceptionCheck()) {
+        LOGE("AsyncCollector", "Callback for request %d threw an exception", request->id);
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+    }
+
+    env->DeleteLocalRef(resultStr);
+    env->DeleteGlobalRef(request->callback);
+    LOGI("AsyncCollector", "Delivered request %d with status %d", request->id, status);
+}
@@ -1,61 +1,131 @@
 #include "../include/BaseCollector.h"
 #include "../include/Logger.h"
+#include "../include/IoBackend.h"
+#include "../include/FileReader.h"
+#include "../include/private/ScopedFd.h"
 #include <sys/stat.h>
+#include <sys/wait.h>
 #include <unistd.h>
+#include <poll.h>
+#include <spawn.h>
+#include <signal.h>
+#include <chrono>
 #include <fcntl.h>
 #include <cstdio>
 #include <cstdlib>
 #include <vector>
 #include <sstream>
+#include <atomic>
 
-bool BaseCollector::fileExists(const char* filepath) {
-    struct stat buffer;
-    return (stat(filepath, &buffer) == 0);
+static std::atomic<IoBackendType> g_ioBackend{IoBackendType::LIBC};
+
+IoBackendType activeIoBackend() {
+    return g_ioBackend.load(std::memory_order_relaxed);
 }
 
-std::string BaseCollector::readFile(const char* filepath) {
-    std::string result;
-    int fd = -1;
-    
+void setActiveIoBackend(IoBackendType type) {
+    g_ioBackend.store(type, std::memory_order_relaxed);
+    LOGI("BaseCollector", "I/O backend set to %s", ioBackendName(type));
+}
+
+const char* ioBackendName(IoBackendType type) {
+    return type == IoBackendType::RAW_SYSCALL ? "raw_syscall" : "libc";
+}
+
+template <typename Io>
+static std::string readFileWith(const char* filepath) {
     try {
-        // 使用open系统调用，避免SVC重定向
-        fd = open(filepath, O_RDONLY);
-        if (fd == -1) {
-            LOGE("BaseCollector", "Failed to open file: %s, errno: %d", filepath, errno);
-            return "Unable to read file: " + std::string(filepath);
-        }
-        
-        // 获取文件大小
-        struct stat file_stat;
-        if (fstat(fd, &file_stat) == -1) {
-            LOGE("BaseCollector", "Failed to get file stat: %s", filepath);
-            close(fd);
-            return "Unable to get file stat: " + std::string(filepath);
-        }
-        
-        // 读取文件内容
-        std::vector<char> buffer(file_stat.st_size + 1);
-        ssize_t bytes_read = read(fd, buffer.data(), file_stat.st_size);
-        
-        if (bytes_read == -1) {
-            LOGE("BaseCollector", "Failed to read file: %s, errno: %d", filepath, errno);
-            close(fd);
-            return "Unable to read file content: " + std::string(filepath);
+        std::string result;
+        switch (file_reader::readAll<Io>(filepath, &result)) {
+            case file_reader::Status::OK:
+                return result;
+            case file_reader::Status::OPEN_FAILED:
+                LOGE("BaseCollector", "Failed to open file: %s, errno: %d", filepath, errno);
+                return "Unable to read file: " + std::string(filepath);
+            case file_reader::Status::STAT_FAILED:
+                LOGE("BaseCollector", "Failed to get file stat: %s", filepath);
+                return "Unable to get file stat: " + std::string(filepath);
+            case file_reader::Status::READ_FAILED:
+                break;
         }
-        
-        buffer[bytes_read] = '\0';
-        result = std::string(buffer.data());
-        
-        close(fd);
-        return result;
-        
+        LOGE("BaseCollector", "Failed to read file: %s, errno: %d", filepath, errno);
+        return "Unable to read file content: " + std::string(filepath);
     } catch (const std::exception& e) {
-        if (fd != -1) close(fd);
         LOGE("BaseCollector", "Exception in readFile: %s", e.what());
         return "Exception reading file: " + std::string(filepath);
     }
 }
 
+template <typename Io>
+static std::string readFilePrefixWith(const char* filepath, size_t maxBytes, bool* truncated) {
+    std::string result;
+    file_reader::Status status = file_reader::readPrefix<Io>(filepath, maxBytes, &result, truncated);
+    if (status == file_reader::Status::OPEN_FAILED) {
+        LOGE("BaseCollector", "Failed to open file: %s, errno: %d", filepath, errno);
+        return "Unable to read file: " + std::string(filepath);
+    }
+    if (status != file_reader::Status::OK) {
+        LOGE("BaseCollector", "Failed to read file: %s, errno: %d", filepath, errno);
+        return "Unable to read file content: " + std::string(filepath);
+    }
+    return result;
+}
+
+template <typename Io>
+static long readFileLinesWith(const char* filepath, const std::function<bool(std::string_view)>& onLine) {
+    file_reader::Status status;
+    long bytes = file_reader::readLines<Io>(filepath, onLine, &status);
+    if (status == file_reader::Status::OPEN_FAILED) {
+        LOGE("BaseCollector", "Failed to open file: %s, errno: %d", filepath, errno);
+    } else if (status != file_reader::Status::OK) {
+        LOGE("BaseCollector", "Failed to read file: %s, errno: %d", filepath, errno);
+    }
+    return bytes;
+}
+
+std::string BaseCollector::readFilePrefix(const char* filepath, size_t maxBytes, bool* truncated) {
+    if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+        return readFilePrefixWith<RawSyscallIo>(filepath, maxBytes, truncated);
+    }
+    return readFilePrefixWith<LibcIo>(filepath, maxBytes, truncated);
+}
+
+long BaseCollector::readFileLines(const char* filepath, const std::function<bool(std::string_view)>& onLine) {
+    if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+        return readFileLinesWith<RawSyscallIo>(filepath, onLine);
+    }
+    return readFileLinesWith<LibcIo>(filepath, onLine);
+}
+
+bool BaseCollector::fileExists(const char* filepath) {
+    if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+        return RawSyscallIo::access(filepath) == 0;
+    }
+    return LibcIo::access(filepath) == 0;
+}
+
+std::string BaseCollector::readFile(const char* filepath) {
+    // 每个文件只分派一次，读循环内是内联调用
+    if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+        return readFileWith<RawSyscallIo>(filepath);
+    }
+    return readFileWith<LibcIo>(filepath);
+}
+
+int BaseCollector::statFileSystem(const char* path, struct statfs64* buffer) {
+    if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+        return RawSyscallIo::statfs(path, buffer);
+    }
+    return LibcIo::statfs(path, buffer);
+}
+
+int BaseCollector::getUname(struct utsname* buffer) {
+    if (activeIoBackend() == IoBackendType::RAW_SYSCALL) {
+        return RawSyscallIo::uname(buffer);
+    }
+    return LibcIo::uname(buffer);
+}
+
 std::string BaseCollector::base64Encode(const uint8_t* data, size_t length) {
     const char* chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
     std::string result;
@@ -73,19 +143,50 @@ std::string BaseCollector::base64Encode(const uint8_t* data, size_t length) {
     return result;
 }
 
-std::string BaseCollector::executeCommand(const char* command) {
+std::string BaseCollector::executeCommand(const char* command, int timeoutMs) {
+    // 不用popen：pclose会一直等待子进程退出，无法在超时后放弃
+    int pipeFds[2];
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        LOGE("BaseCollector", "Failed to execute command: %s", command);
+        return "Failed to execute command: " + std::string(command);
+    }
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_adddup2(&actions, pipeFds[1], STDOUT_FILENO);
+    const char* argv[] = {"sh", "-c", command, nullptr};
+    pid_t pid = -1;
+    int spawnResult = posix_spawn(&pid, "/system/bin/sh", &actions, nullptr, const_cast<char* const*>(argv), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    close(pipeFds[1]);
+    ScopedFd output(pipeFds[0]);
+    if (spawnResult != 0) {
+        LOGE("BaseCollector", "Failed to execute command: %s", command);
+        return "Failed to execute command: " + std::string(command);
+    }
+
     std::string result;
     char buffer[1024];
-    FILE *fp = popen(command, "r");
-    if (fp != nullptr) {
-        while (fgets(buffer, sizeof(buffer), fp) != nullptr) {
-            result += buffer;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    while (true) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+        struct pollfd pfd = {output.get(), POLLIN, 0};
+        int ready = remaining > 0 ? poll(&pfd, 1, static_cast<int>(remaining)) : 0;
+        if (ready < 0 && errno == EINTR) continue;
+        if (ready <= 0) {
+            kill(pid, SIGKILL);
+            LOGW("BaseCollector", "Command timed out after %dms: %s", timeoutMs, command);
+            result += "partial/timeout: command exceeded " + std::to_string(timeoutMs) + "ms\n";
+            break;
         }
-        pclose(fp);
-    } else {
-        LOGE("BaseCollector", "Failed to execute command: %s", command);
-        result = "Failed to execute command: " + std::string(command);
+        ssize_t n = read(output.get(), buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        result.append(buffer, static_cast<size_t>(n));
     }
+
+    while (waitpid(pid, nullptr, 0) < 0 && errno == EINTR) {}
     return result;
 }
 
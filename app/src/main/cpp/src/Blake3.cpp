@@ -0,0 +1,479 @@
+#include "../include/Blake3.h"
+#include "../include/WorkStealingPool.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#if (defined(__SSE2__) || defined(__ARM_NEON)) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define BLAKE3_SIMD 1
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#else
+#include <arm_neon.h>
+#endif
+#endif
+
+namespace {
+
+constexpr uint32_t kIv[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+constexpr uint8_t kChunkStart = 1 << 0;
+constexpr uint8_t kChunkEnd = 1 << 1;
+constexpr uint8_t kParent = 1 << 2;
+constexpr uint8_t kRoot = 1 << 3;
+
+constexpr size_t kBlocksPerChunk = Blake3Hasher::kChunkLen / Blake3Hasher::kBlockLen;
+
+// 每轮的消息字排列（第r行是对上一行再应用一次置换）
+constexpr uint8_t kSchedule[7][16] = {
+    {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+    {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+    {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+    {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+    {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+    {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+    {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13},
+};
+
+std::atomic<bool> g_portableOnly{false};
+
+using ChainingValue = std::array<uint32_t, 8>;
+
+inline uint32_t loadLe32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8 | static_cast<uint32_t>(p[2]) << 16 |
+           static_cast<uint32_t>(p[3]) << 24;
+}
+
+inline void storeLe32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+void loadBlockWords(const uint8_t* block, uint32_t words[16]) {
+    for (int i = 0; i < 16; ++i) {
+        words[i] = loadLe32(block + i * 4);
+    }
+}
+
+inline uint32_t rotr(uint32_t x, int n) {
+    return (x >> n) | (x << (32 - n));
+}
+
+inline void g(uint32_t* s, int a, int b, int c, int d, uint32_t x, uint32_t y) {
+    s[a] = s[a] + s[b] + x;
+    s[d] = rotr(s[d] ^ s[a], 16);
+    s[c] = s[c] + s[d];
+    s[b] = rotr(s[b] ^ s[c], 12);
+    s[a] = s[a] + s[b] + y;
+    s[d] = rotr(s[d] ^ s[a], 8);
+    s[c] = s[c] + s[d];
+    s[b] = rotr(s[b] ^ s[c], 7);
+}
+
+// 标量压缩函数，只输出前8个字（链值/32字节根输出）
+void compress(const uint32_t cv[8], const uint32_t m[16], uint64_t counter, uint32_t blockLen, uint32_t flags,
+              uint32_t out[8]) {
+    uint32_t s[16] = {
+        cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+        kIv[0], kIv[1], kIv[2], kIv[3],
+        static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), blockLen, flags,
+    };
+    for (const uint8_t* r : kSchedule) {
+        g(s, 0, 4, 8, 12, m[r[0]], m[r[1]]);
+        g(s, 1, 5, 9, 13, m[r[2]], m[r[3]]);
+        g(s, 2, 6, 10, 14, m[r[4]], m[r[5]]);
+        g(s, 3, 7, 11, 15, m[r[6]], m[r[7]]);
+        g(s, 0, 5, 10, 15, m[r[8]], m[r[9]]);
+        g(s, 1, 6, 11, 12, m[r[10]], m[r[11]]);
+        g(s, 2, 7, 8, 13, m[r[12]], m[r[13]]);
+        g(s, 3, 4, 9, 14, m[r[14]], m[r[15]]);
+    }
+    for (int i = 0; i < 8; ++i) {
+        out[i] = s[i] ^ s[i + 8];
+    }
+}
+
+void hashChunkPortable(const uint8_t* input, uint64_t counter, uint32_t out[8]) {
+    uint32_t cv[8];
+    memcpy(cv, kIv, sizeof(cv));
+    uint32_t words[16];
+    for (size_t block = 0; block < kBlocksPerChunk; ++block) {
+        loadBlockWords(input + block * Blake3Hasher::kBlockLen, words);
+        uint32_t flags = (block == 0 ? kChunkStart : 0) | (block == kBlocksPerChunk - 1 ? kChunkEnd : 0);
+        compress(cv, words, counter, Blake3Hasher::kBlockLen, flags, cv);
+    }
+    memcpy(out, cv, sizeof(cv));
+}
+
+void parentChainingValue(const uint32_t left[8], const uint32_t right[8], uint32_t flags, uint32_t out[8]) {
+    uint32_t block[16];
+    memcpy(block, left, 32);
+    memcpy(block + 8, right, 32);
+    compress(kIv, block, 0, Blake3Hasher::kBlockLen, kParent | flags, out);
+}
+
+#if defined(BLAKE3_SIMD)
+
+// 4通道向量：每个通道处理一个块的同一个字
+#if defined(__SSE2__)
+using Vec = __m128i;
+inline Vec add(Vec a, Vec b) { return _mm_add_epi32(a, b); }
+inline Vec xorv(Vec a, Vec b) { return _mm_xor_si128(a, b); }
+inline Vec splat(uint32_t x) { return _mm_set1_epi32(static_cast<int>(x)); }
+inline Vec loadu(const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline void storeu(uint32_t* p, Vec v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+template <int n>
+inline Vec rotrv(Vec x) { return _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n)); }
+inline Vec lanes(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    return _mm_setr_epi32(static_cast<int>(a), static_cast<int>(b), static_cast<int>(c), static_cast<int>(d));
+}
+inline void transpose(Vec& a, Vec& b, Vec& c, Vec& d) {
+    Vec ab01 = _mm_unpacklo_epi32(a, b);
+    Vec cd01 = _mm_unpacklo_epi32(c, d);
+    Vec ab23 = _mm_unpackhi_epi32(a, b);
+    Vec cd23 = _mm_unpackhi_epi32(c, d);
+    a = _mm_unpacklo_epi64(ab01, cd01);
+    b = _mm_unpackhi_epi64(ab01, cd01);
+    c = _mm_unpacklo_epi64(ab23, cd23);
+    d = _mm_unpackhi_epi64(ab23, cd23);
+}
+constexpr const char* kSimdKernelName = "sse2x4";
+#else
+using Vec = uint32x4_t;
+inline Vec add(Vec a, Vec b) { return vaddq_u32(a, b); }
+inline Vec xorv(Vec a, Vec b) { return veorq_u32(a, b); }
+inline Vec splat(uint32_t x) { return vdupq_n_u32(x); }
+inline Vec loadu(const uint8_t* p) { return vreinterpretq_u32_u8(vld1q_u8(p)); }
+inline void storeu(uint32_t* p, Vec v) { vst1q_u32(p, v); }
+template <int n>
+inline Vec rotrv(Vec x) { return vsriq_n_u32(vshlq_n_u32(x, 32 - n), x, n); }
+inline Vec lanes(uint32_t a, uint32_t b, uint32_t c, uint32_t d) {
+    const uint32_t values[4] = {a, b, c, d};
+    return vld1q_u32(values);
+}
+inline void transpose(Vec& a, Vec& b, Vec& c, Vec& d) {
+    uint32x4x2_t ab = vtrnq_u32(a, b);
+    uint32x4x2_t cd = vtrnq_u32(c, d);
+    a = vcombine_u32(vget_low_u32(ab.val[0]), vget_low_u32(cd.val[0]));
+    b = vcombine_u32(vget_low_u32(ab.val[1]), vget_low_u32(cd.val[1]));
+    c = vcombine_u32(vget_high_u32(ab.val[0]), vget_high_u32(cd.val[0]));
+    d = vcombine_u32(vget_high_u32(ab.val[1]), vget_high_u32(cd.val[1]));
+}
+constexpr const char* kSimdKernelName = "neonx4";
+#endif
+
+inline void gv(Vec* v, int a, int b, int c, int d, Vec x, Vec y) {
+    v[a] = add(add(v[a], v[b]), x);
+    v[d] = rotrv<16>(xorv(v[d], v[a]));
+    v[c] = add(v[c], v[d]);
+    v[b] = rotrv<12>(xorv(v[b], v[c]));
+    v[a] = add(add(v[a], v[b]), y);
+    v[d] = rotrv<8>(xorv(v[d], v[a]));
+    v[c] = add(v[c], v[d]);
+    v[b] = rotrv<7>(xorv(v[b], v[c]));
+}
+
+// 同时压缩4个相邻的完整块（计数器 counter..counter+3）
+void hashChunks4(const uint8_t* input, uint64_t counter, uint32_t out[4][8]) {
+    Vec h[8];
+    for (int i = 0; i < 8; ++i) {
+        h[i] = splat(kIv[i]);
+    }
+    Vec counterLow = lanes(static_cast<uint32_t>(counter), static_cast<uint32_t>(counter + 1),
+                           static_cast<uint32_t>(counter + 2), static_cast<uint32_t>(counter + 3));
+    Vec counterHigh = lanes(static_cast<uint32_t>(counter >> 32), static_cast<uint32_t>((counter + 1) >> 32),
+                            static_cast<uint32_t>((counter + 2) >> 32), static_cast<uint32_t>((counter + 3) >> 32));
+
+    for (size_t block = 0; block < kBlocksPerChunk; ++block) {
+        // 4个块的消息转置成 m[i] = 各通道的第i个字
+        Vec m[16];
+        for (int quarter = 0; quarter < 4; ++quarter) {
+            const uint8_t* base = input + block * Blake3Hasher::kBlockLen + quarter * 16;
+            Vec a = loadu(base);
+            Vec b = loadu(base + Blake3Hasher::kChunkLen);
+            Vec c = loadu(base + 2 * Blake3Hasher::kChunkLen);
+            Vec d = loadu(base + 3 * Blake3Hasher::kChunkLen);
+            transpose(a, b, c, d);
+            m[quarter * 4] = a;
+            m[quarter * 4 + 1] = b;
+            m[quarter * 4 + 2] = c;
+            m[quarter * 4 + 3] = d;
+        }
+
+        uint32_t flags = (block == 0 ? kChunkStart : 0) | (block == kBlocksPerChunk - 1 ? kChunkEnd : 0);
+        Vec v[16] = {
+            h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7],
+            splat(kIv[0]), splat(kIv[1]), splat(kIv[2]), splat(kIv[3]),
+            counterLow, counterHigh, splat(Blake3Hasher::kBlockLen), splat(flags),
+        };
+        for (const uint8_t* r : kSchedule) {
+            gv(v, 0, 4, 8, 12, m[r[0]], m[r[1]]);
+            gv(v, 1, 5, 9, 13, m[r[2]], m[r[3]]);
+            gv(v, 2, 6, 10, 14, m[r[4]], m[r[5]]);
+            gv(v, 3, 7, 11, 15, m[r[6]], m[r[7]]);
+            gv(v, 0, 5, 10, 15, m[r[8]], m[r[9]]);
+            gv(v, 1, 6, 11, 12, m[r[10]], m[r[11]]);
+            gv(v, 2, 7, 8, 13, m[r[12]], m[r[13]]);
+            gv(v, 3, 4, 9, 14, m[r[14]], m[r[15]]);
+        }
+        for (int i = 0; i < 8; ++i) {
+            h[i] = xorv(v[i], v[i + 8]);
+        }
+    }
+
+    // 转置回每个块的链值
+    transpose(h[0], h[1], h[2], h[3]);
+    transpose(h[4], h[5], h[6], h[7]);
+    for (int lane = 0; lane < 4; ++lane) {
+        storeu(out[lane], h[lane]);
+        storeu(out[lane] + 4, h[lane + 4]);
+    }
+}
+
+#endif // BLAKE3_SIMD
+
+// 计算count个相邻完整块的链值
+void hashFullChunks(const uint8_t* input, size_t count, uint64_t counter, uint32_t (*out)[8]) {
+    size_t done = 0;
+#if defined(BLAKE3_SIMD)
+    if (!g_portableOnly.load(std::memory_order_relaxed)) {
+        for (; done + 4 <= count; done += 4) {
+            hashChunks4(input + done * Blake3Hasher::kChunkLen, counter + done, out + done);
+        }
+    }
+#endif
+    for (; done < count; ++done) {
+        hashChunkPortable(input + done * Blake3Hasher::kChunkLen, counter + done, out[done]);
+    }
+}
+
+// 一个粒度（kGranuleChunks个块）组成的完整子树的链值，不是根节点
+void hashGranule(const uint8_t* input, uint64_t counter, uint32_t out[8]) {
+    constexpr size_t kBatch = 16;
+    uint32_t stack[8][8];
+    size_t depth = 0;
+    uint32_t cvs[kBatch][8];
+    for (size_t chunk = 0; chunk < Blake3Hasher::kGranuleChunks; chunk += kBatch) {
+        hashFullChunks(input + chunk * Blake3Hasher::kChunkLen, kBatch, counter + chunk, cvs);
+        for (size_t i = 0; i < kBatch; ++i) {
+            uint32_t* cv = cvs[i];
+            for (uint64_t total = chunk + i + 1; (total & 1) == 0; total >>= 1) {
+                parentChainingValue(stack[--depth], cv, 0, cv);
+            }
+            memcpy(stack[depth++], cv, 32);
+        }
+    }
+    memcpy(out, stack[0], 32);
+}
+
+// 尚未压缩的最后一个块（块或父节点），根节点时加ROOT标志
+struct Output {
+    uint32_t cv[8];
+    uint32_t block[16];
+    uint64_t counter;
+    uint32_t blockLen;
+    uint32_t flags;
+
+    void chainingValue(uint32_t out[8]) const { compress(cv, block, counter, blockLen, flags, out); }
+
+    void rootBytes(uint8_t out[Blake3Hasher::kOutLen]) const {
+        uint32_t words[8];
+        compress(cv, block, 0, blockLen, flags | kRoot, words);
+        for (int i = 0; i < 8; ++i) {
+            storeLe32(out + i * 4, words[i]);
+        }
+    }
+};
+
+// 块的最后一个分组，末尾补0
+Output chunkOutput(const uint32_t cv[8], const uint8_t* block, uint8_t blockLen, uint64_t counter,
+                   uint8_t blocksCompressed) {
+    Output output;
+    memcpy(output.cv, cv, sizeof(output.cv));
+    uint8_t padded[Blake3Hasher::kBlockLen] = {};
+    memcpy(padded, block, blockLen);
+    loadBlockWords(padded, output.block);
+    output.counter = counter;
+    output.blockLen = blockLen;
+    output.flags = kChunkEnd | (blocksCompressed == 0 ? kChunkStart : 0);
+    return output;
+}
+
+static_assert(Blake3Hasher::kGranuleChunks % 16 == 0, "granule must be a multiple of the batch size");
+static_assert((Blake3Hasher::kGranuleChunks & (Blake3Hasher::kGranuleChunks - 1)) == 0,
+              "granule must be a power of two chunks");
+
+} // namespace
+
+Blake3Hasher::Blake3Hasher() {
+    resetChunk(0);
+}
+
+void Blake3Hasher::resetChunk(uint64_t counter) {
+    memcpy(m_chunk.cv, kIv, sizeof(kIv));
+    m_chunk.counter = counter;
+    m_chunk.blockLen = 0;
+    m_chunk.blocksCompressed = 0;
+}
+
+void Blake3Hasher::updateChunk(const uint8_t* data, size_t length) {
+    while (length > 0) {
+        if (m_chunk.blockLen == kBlockLen) {
+            uint32_t words[16];
+            loadBlockWords(m_chunk.block, words);
+            compress(m_chunk.cv, words, m_chunk.counter, kBlockLen, m_chunk.blocksCompressed == 0 ? kChunkStart : 0,
+                     m_chunk.cv);
+            ++m_chunk.blocksCompressed;
+            m_chunk.blockLen = 0;
+        }
+        size_t take = std::min(length, kBlockLen - m_chunk.blockLen);
+        memcpy(m_chunk.block + m_chunk.blockLen, data, take);
+        m_chunk.blockLen = static_cast<uint8_t>(m_chunk.blockLen + take);
+        data += take;
+        length -= take;
+    }
+}
+
+void Blake3Hasher::addChunkChainingValue(const uint32_t cv[8], uint64_t totalUnits) {
+    // totalUnits的每个末尾0表示一棵已经完整的左子树，与新的右子树合并
+    uint32_t merged[8];
+    memcpy(merged, cv, sizeof(merged));
+    for (; (totalUnits & 1) == 0; totalUnits >>= 1) {
+        parentChainingValue(m_cvStack[--m_stackLength], merged, 0, merged);
+    }
+    memcpy(m_cvStack[m_stackLength++], merged, sizeof(merged));
+}
+
+void Blake3Hasher::commitFullChunks(const uint8_t* data, size_t chunks) {
+    constexpr size_t kBatch = 16;
+    uint32_t cvs[kBatch][8];
+    while (chunks > 0) {
+        size_t count = std::min(chunks, kBatch);
+        hashFullChunks(data, count, m_chunk.counter, cvs);
+        for (size_t i = 0; i < count; ++i) {
+            addChunkChainingValue(cvs[i], m_chunk.counter + 1);
+            resetChunk(m_chunk.counter + 1);
+        }
+        data += count * kChunkLen;
+        chunks -= count;
+    }
+}
+
+void Blake3Hasher::update(const void* data, size_t length) {
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+    while (length > 0) {
+        size_t chunkBytes = m_chunk.blocksCompressed * kBlockLen + m_chunk.blockLen;
+        // 当前块已满且后面还有输入，说明它不是根，可以提交
+        if (chunkBytes == kChunkLen) {
+            uint32_t cv[8];
+            chunkOutput(m_chunk.cv, m_chunk.block, m_chunk.blockLen, m_chunk.counter, m_chunk.blocksCompressed)
+                    .chainingValue(cv);
+            addChunkChainingValue(cv, m_chunk.counter + 1);
+            resetChunk(m_chunk.counter + 1);
+            chunkBytes = 0;
+        }
+        // 整块批量压缩，至少留一个字节给最后一个块
+        if (chunkBytes == 0 && length > kChunkLen) {
+            size_t chunks = (length - 1) / kChunkLen;
+            commitFullChunks(input, chunks);
+            input += chunks * kChunkLen;
+            length -= chunks * kChunkLen;
+            continue;
+        }
+        size_t take = std::min(length, kChunkLen - chunkBytes);
+        updateChunk(input, take);
+        input += take;
+        length -= take;
+    }
+}
+
+void Blake3Hasher::updateGranules(const uint8_t* data, size_t granules, WorkStealingPool& pool) {
+    if (granules == 0) return;
+
+    size_t chunkBytes = m_chunk.blocksCompressed * kBlockLen + m_chunk.blockLen;
+    if (chunkBytes != 0 || m_chunk.counter % kGranuleChunks != 0) {
+        // 未对齐到粒度边界（例如之前用update()输入了零散数据），退回串行
+        update(data, granules * kGranuleBytes);
+        return;
+    }
+
+    std::vector<ChainingValue> cvs(granules);
+    std::vector<WorkStealingPool::Task> tasks;
+    tasks.reserve(granules);
+    uint64_t base = m_chunk.counter;
+    for (size_t i = 0; i < granules; ++i) {
+        tasks.emplace_back([data, base, i, &cvs](unsigned) {
+            hashGranule(data + i * kGranuleBytes, base + i * kGranuleChunks, cvs[i].data());
+        });
+    }
+    pool.runAndWait(std::move(tasks));
+
+    // 粒度对齐时栈中都是不小于一个粒度的子树，可以按粒度为单位合并
+    for (size_t i = 0; i < granules; ++i) {
+        addChunkChainingValue(cvs[i].data(), base / kGranuleChunks + i + 1);
+    }
+    resetChunk(base + granules * kGranuleChunks);
+}
+
+void Blake3Hasher::finalize(uint8_t out[kOutLen]) const {
+    Output output = chunkOutput(m_chunk.cv, m_chunk.block, m_chunk.blockLen, m_chunk.counter,
+                                m_chunk.blocksCompressed);
+
+    for (size_t i = m_stackLength; i > 0; --i) {
+        uint32_t right[8];
+        output.chainingValue(right);
+        memcpy(output.cv, kIv, sizeof(kIv));
+        memcpy(output.block, m_cvStack[i - 1], 32);
+        memcpy(output.block + 8, right, 32);
+        output.counter = 0;
+        output.blockLen = kBlockLen;
+        output.flags = kParent;
+    }
+    output.rootBytes(out);
+}
+
+std::string Blake3Hasher::finalizeHex() const {
+    uint8_t digest[kOutLen];
+    finalize(digest);
+    static const char kDigits[] = "0123456789abcdef";
+    std::string hex;
+    hex.reserve(kOutLen * 2);
+    for (uint8_t byte : digest) {
+        hex += kDigits[byte >> 4];
+        hex += kDigits[byte & 0x0f];
+    }
+    return hex;
+}
+
+void Blake3Hasher::hash(const void* data, size_t length, uint8_t out[kOutLen]) {
+    Blake3Hasher hasher;
+    hasher.update(data, length);
+    hasher.finalize(out);
+}
+
+void Blake3Hasher::hashParallel(const void* data, size_t length, WorkStealingPool& pool, uint8_t out[kOutLen]) {
+    const uint8_t* input = static_cast<const uint8_t*>(data);
+    Blake3Hasher hasher;
+    // 最后一个字节所在的粒度留给串行部分，保证根节点由finalize()产生
+    size_t granules = length == 0 ? 0 : (length - 1) / kGranuleBytes;
+    hasher.updateGranules(input, granules, pool);
+    hasher.update(input + granules * kGranuleBytes, length - granules * kGranuleBytes);
+    hasher.finalize(out);
+}
+
+const char* Blake3Hasher::kernelName() {
+#if defined(BLAKE3_SIMD)
+    if (!g_portableOnly.load(std::memory_order_relaxed)) return kSimdKernelName;
+#endif
+    return "portable";
+}
+
+void Blake3Hasher::setPortableOnly(bool portableOnly) {
+    g_portableOnly.store(portableOnly, std::memory_order_relaxed);
+}
@@ -0,0 +1,41 @@
+#include "../include/CollectionService.h"
+#include "../include/NativeExecutor.h"
+#include "../include/SectionCache.h"
+#include "../include/Logger.h"
+#include "../include/private/ScopedJniAttach.h"
+#include <thread>
+
+CollectionService& CollectionService::instance() {
+    static CollectionService service;
+    return service;
+}
+
+std::string CollectionService::collectNow(FingerprintSection section, JNIEnv* env) {
+    return SectionCache::instance().getOrCollect(section, [section, env]() { return collectSection(section, env); });
+}
+
+std::string CollectionService::collect(FingerprintSection section, JNIEnv* env) {
+    // 已缓存的不可变分区不进入合并表
+    std::string cached;
+    if (SectionCache::instance().peek(section, &cached)) return cached;
+
+    return m_flights.run(sectionIndex(section), [section, env]() { return collectNow(section, env); });
+}
+
+std::shared_ptr<CollectionService::Flight> CollectionService::collectAsync(FingerprintSection section) {
+    int key = sectionIndex(section);
+    bool leader = false;
+    std::shared_ptr<Flight> flight = m_flights.join(key, &leader);
+    if (!leader) return flight;
+
+    std::thread([this, section, key, flight]() {
+        ScopedJniAttach attach(sectionNeedsJni(section) ? NativeExecutor::javaVM() : nullptr, sectionName(section));
+        try {
+            m_flights.finish(key, flight, collectNow(section, attach.env()));
+        } catch (...) {
+            LOGE("CollectionService", "Exception collecting %s", sectionName(section));
+            m_flights.fail(key, flight, std::current_exception());
+        }
+    }).detach();
+    return flight;
+}
@@ -0,0 +1,103 @@
+#include "../include/DeadlineRunner.h"
+#include "../include/CollectionService.h"
+#include "../include/SectionCache.h"
+#include "../include/FieldDefinitions.h"
+#include "../include/Logger.h"
+
+constexpr std::chrono::milliseconds DeadlineRunner::kDefaultDeadline;
+constexpr DeadlineRunner::Clock::time_point DeadlineRunner::kNoDeadline;
+constexpr std::chrono::milliseconds DeadlineRunner::kCancelPollInterval;
+
+DeadlineRunner& DeadlineRunner::instance() {
+    static DeadlineRunner runner;
+    return runner;
+}
+
+std::chrono::milliseconds DeadlineRunner::sectionBudget(FingerprintSection section) {
+    return deadline_wait::sectionBudget(section);
+}
+
+std::string DeadlineRunner::timeoutPlaceholder(FingerprintSection section, long long waitedMs) {
+    std::string note = "partial/timeout: not completed within " + std::to_string(waitedMs) + "ms\n";
+    const char* title = sectionTitle(section);
+    if (title != nullptr) {
+        return "\n=== " + std::string(title) + " ===\n\n" + note;
+    }
+    // build_prop：每个文件一段
+    std::string result;
+    for (const char* path : kBuildPropFiles) {
+        result += "=== " + std::string(path) + " ===\n" + note + "\n";
+    }
+    return result;
+}
+
+std::vector<std::string> DeadlineRunner::run(const std::vector<FingerprintSection>& sections,
+                                             Clock::time_point deadline, uint32_t* timedOutMask,
+                                             const std::atomic<bool>* cancelled) {
+    Clock::time_point start = Clock::now();
+    uint32_t timedOut = 0;
+
+    // 已缓存的分区直接取结果，其余分区全部先启动再依次等待
+    std::vector<std::string> results(sections.size());
+    std::vector<std::shared_ptr<CollectionService::Flight>> flights(sections.size());
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (!SectionCache::instance().peek(sections[i], &results[i])) {
+            flights[i] = CollectionService::instance().collectAsync(sections[i]);
+        }
+    }
+
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (!flights[i]) continue;
+
+        FingerprintSection section = sections[i];
+        deadline_wait::Outcome outcome =
+                deadline_wait::wait(*flights[i], deadline_wait::sectionDeadline(section, start, deadline), cancelled);
+        if (outcome == deadline_wait::Outcome::CANCELLED) {
+            if (timedOutMask != nullptr) *timedOutMask = timedOut;
+            return results;
+        }
+
+        if (outcome == deadline_wait::Outcome::DONE) {
+            try {
+                results[i] = flights[i]->value();
+            } catch (const std::exception& e) {
+                results[i] = "Unable to retrieve: " + std::string(e.what()) + "\n";
+            }
+            continue;
+        }
+
+        timedOut |= section;
+        uint64_t overruns = m_overruns[sectionIndex(section)].fetch_add(1, std::memory_order_relaxed) + 1;
+        long long waited = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count();
+        LOGW("DeadlineRunner", "Section %s timed out after %lldms (%llu overruns)", sectionName(section), waited,
+             static_cast<unsigned long long>(overruns));
+        results[i] = timeoutPlaceholder(section, waited);
+    }
+
+    if (timedOutMask != nullptr) *timedOutMask = timedOut;
+    return results;
+}
+
+std::string DeadlineRunner::collect(const std::vector<FingerprintSection>& sections, Clock::time_point deadline,
+                                    uint32_t* timedOutMask, const std::atomic<bool>* cancelled) {
+    std::string result;
+    for (const std::string& part : run(sections, deadline, timedOutMask, cancelled)) {
+        result += part;
+    }
+    return result;
+}
+
+uint64_t DeadlineRunner::overrunCount(FingerprintSection section) const {
+    return m_overruns[sectionIndex(section)].load(std::memory_order_relaxed);
+}
+
+std::string DeadlineRunner::overrunReport() const {
+    std::string result;
+    for (int i = 0; i < SECTION_COUNT; ++i) {
+        FingerprintSection section = sectionAt(i);
+        result += std::string(sectionName(section)) + ": budget " +
+                  std::to_string(sectionBudget(section).count()) + "ms, overruns " +
+                  std::to_string(overrunCount(section)) + "\n";
+    }
+    return result;
+}
@@ -0,0 +1,109 @@
+#include "../include/FieldSnapshot.h"
+#include "../include/DumpParser.h"
+#include "../include/HashUtils.h"
+#include "../include/private/VarInt.h"
+#include <algorithm>
+#include <unordered_map>
+
+static const char kSnapshotMagic[4] = {'F', 'S', 'N', '1'};
+
+uint64_t FieldSnapshot::fieldId(std::string_view section, std::string_view key, uint32_t occurrence) {
+    uint64_t hash = fnv1a64(section.data(), section.size());
+    hash = fnv1a64("/", 1, hash);
+    hash = fnv1a64(key.data(), key.size(), hash);
+    if (occurrence > 0) {
+        // 不分配内存地拼出 "#n"，主机工具会在解析热路径上调用
+        char suffix[12];
+        size_t length = sizeof(suffix);
+        do {
+            suffix[--length] = static_cast<char>('0' + occurrence % 10);
+            occurrence /= 10;
+        } while (occurrence > 0);
+        suffix[--length] = '#';
+        hash = fnv1a64(suffix + length, sizeof(suffix) - length, hash);
+    }
+    return hash;
+}
+
+FieldSnapshot FieldSnapshot::fromDump(std::string_view text) {
+    FieldSnapshot snapshot;
+    std::unordered_map<uint64_t, uint32_t> occurrences;
+
+    dump::forEachField(text.data(), text.size(),
+                       [&](std::string_view section, std::string_view key, std::string_view value) {
+        uint64_t baseId = fieldId(section, key);
+        uint32_t occurrence = occurrences[baseId]++;
+        snapshot.add(occurrence == 0 ? baseId : fieldId(section, key, occurrence), value);
+    });
+
+    snapshot.finalize();
+    return snapshot;
+}
+
+void FieldSnapshot::add(uint64_t id, std::string_view value) {
+    FieldEntry entry = {id, static_cast<uint32_t>(m_arena.size()), static_cast<uint32_t>(value.size())};
+    m_arena.append(value.data(), value.size());
+    m_entries.push_back(entry);
+}
+
+void FieldSnapshot::finalize() {
+    std::stable_sort(m_entries.begin(), m_entries.end(),
+                     [](const FieldEntry& a, const FieldEntry& b) { return a.id < b.id; });
+    m_entries.erase(std::unique(m_entries.begin(), m_entries.end(),
+                                [](const FieldEntry& a, const FieldEntry& b) { return a.id == b.id; }),
+                    m_entries.end());
+}
+
+bool FieldSnapshot::find(uint64_t id, std::string_view* value) const {
+    auto it = std::lower_bound(m_entries.begin(), m_entries.end(), id,
+                               [](const FieldEntry& entry, uint64_t key) { return entry.id < key; });
+    if (it == m_entries.end() || it->id != id) return false;
+
+    *value = valueAt(static_cast<size_t>(it - m_entries.begin()));
+    return true;
+}
+
+std::string_view FieldSnapshot::valueAt(size_t index) const {
+    const FieldEntry& entry = m_entries[index];
+    return std::string_view(m_arena.data() + entry.offset, entry.length);
+}
+
+std::string FieldSnapshot::serialize() const {
+    std::string out(kSnapshotMagic, sizeof(kSnapshotMagic));
+    putVarint(&out, m_entries.size());
+    for (size_t i = 0; i < m_entries.size(); ++i) {
+        std::string_view value = valueAt(i);
+        putFixed64(&out, m_entries[i].id);
+        putVarint(&out, value.size());
+        out.append(value.data(), value.size());
+    }
+    return out;
+}
+
+bool FieldSnapshot::deserialize(const char* data, size_t size, FieldSnapshot* out) {
+    const char* cursor = data;
+    const char* end = data + size;
+    if (size < sizeof(kSnapshotMagic) || !std::equal(kSnapshotMagic, kSnapshotMagic + 4, data)) {
+        return false;
+    }
+    cursor += sizeof(kSnapshotMagic);
+
+    uint64_t count = 0;
+    if (!getVarint(&cursor, end, &count)) return false;
+
+    FieldSnapshot snapshot;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t id = 0;
+        uint64_t length = 0;
+        if (!getFixed64(&cursor, end, &id) || !getVarint(&cursor, end, &length) ||
+            length > static_cast<uint64_t>(end - cursor)) {
+            return false;
+        }
+        snapshot.add(id, std::string_view(cursor, length));
+        cursor += length;
+    }
+
+    snapshot.finalize();
+    *out = std::move(snapshot);
+    return true;
+}
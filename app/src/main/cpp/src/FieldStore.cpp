@@ -0,0 +1,83 @@
+#include "../include/FieldStore.h"
+#include "../include/CollectionService.h"
+#include "../include/Logger.h"
+#include <string_view>
+
+FieldStore& FieldStore::instance() {
+    static FieldStore store;
+    return store;
+}
+
+void FieldStore::materialize(uint32_t mask, JNIEnv* env) {
+    mask &= ~m_loaded.load(std::memory_order_acquire);
+    while (mask != 0) {
+        FingerprintSection section = sectionAt(__builtin_ctz(mask));
+        mask &= mask - 1;
+
+        // 收集可能很慢，不持有锁；同一分区的并发请求由CollectionService合并
+        std::string text;
+        try {
+            text = CollectionService::instance().collect(section, env);
+        } catch (const std::exception& e) {
+            LOGE("FieldStore", "Exception collecting %s: %s", sectionName(section), e.what());
+            continue;
+        }
+
+        // 一次遍历找出该分区的所有目录字段，同一字段取第一次出现的值
+        std::string_view values[FIELD_COUNT];
+        bool found[FIELD_COUNT] = {};
+        bool any = false;
+        forEachCatalogField(section, text, [&](FieldId id, std::string_view value) {
+            values[id] = value;
+            found[id] = true;
+            any = true;
+        });
+
+        // 一个字段都没有（如env为空时依赖Java层的分区）不记为已物化，下次访问重新收集
+        if (!any) {
+            LOGW("FieldStore", "Section %s has none of its catalog fields", sectionName(section));
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_loaded.load(std::memory_order_relaxed) & section) continue;
+        for (int i = 0; i < FIELD_COUNT; ++i) {
+            if (kFieldSources[i].section != section || !found[i]) continue;
+            m_slots[i].offset = static_cast<uint32_t>(m_arena.size());
+            m_slots[i].length = static_cast<uint32_t>(values[i].size());
+            m_slots[i].present = true;
+            m_arena.append(values[i].data(), values[i].size());
+        }
+        m_loaded.fetch_or(section, std::memory_order_release);
+    }
+}
+
+bool FieldStore::get(FieldId id, JNIEnv* env, std::string* value) {
+    if (id < 0 || id >= FIELD_COUNT) return false;
+    materialize(kFieldSources[id].section, env);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const Slot& slot = m_slots[id];
+    if (!slot.present) return false;
+    value->assign(m_arena, slot.offset, slot.length);
+    return true;
+}
+
+std::vector<std::string> FieldStore::getAll(const std::vector<FieldId>& ids, JNIEnv* env, std::vector<bool>* present) {
+    uint32_t mask = 0;
+    for (FieldId id : ids) {
+        if (id >= 0 && id < FIELD_COUNT) mask |= kFieldSources[id].section;
+    }
+    materialize(mask, env);
+
+    std::vector<std::string> values(ids.size());
+    present->assign(ids.size(), false);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < ids.size(); ++i) {
+        FieldId id = ids[i];
+        if (id < 0 || id >= FIELD_COUNT || !m_slots[id].present) continue;
+        values[i].assign(m_arena, m_slots[id].offset, m_slots[id].length);
+        (*present)[i] = true;
+    }
+    return values;
+}
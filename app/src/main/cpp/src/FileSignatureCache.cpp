@@ -0,0 +1,88 @@
+#include "../include/FileSignatureCache.h"
+#include <sys/stat.h>
+#include <fcntl.h>
+
+bool FileSignature::operator==(const FileSignature& other) const {
+    return exists == other.exists && ino == other.ino && dev == other.dev && size == other.size &&
+           mtimeSec == other.mtimeSec && mtimeNsec == other.mtimeNsec &&
+           ctimeSec == other.ctimeSec && ctimeNsec == other.ctimeNsec;
+}
+
+FileSignatureCache& FileSignatureCache::instance() {
+    static FileSignatureCache cache;
+    return cache;
+}
+
+FileSignature FileSignatureCache::statSignature(const char* path) {
+    FileSignature signature = {};
+    struct statx stx = {};
+    unsigned int mask = STATX_INO | STATX_SIZE | STATX_MTIME | STATX_CTIME;
+    if (statx(AT_FDCWD, path, AT_STATX_DONT_SYNC, mask, &stx) != 0) {
+        return signature;
+    }
+
+    signature.exists = true;
+    signature.ino = stx.stx_ino;
+    signature.dev = (static_cast<uint64_t>(stx.stx_dev_major) << 32) | stx.stx_dev_minor;
+    signature.size = stx.stx_size;
+    signature.mtimeSec = stx.stx_mtime.tv_sec;
+    signature.mtimeNsec = stx.stx_mtime.tv_nsec;
+    signature.ctimeSec = stx.stx_ctime.tv_sec;
+    signature.ctimeNsec = stx.stx_ctime.tv_nsec;
+    return signature;
+}
+
+std::vector<FileSignature> FileSignatureCache::statBatch(const std::vector<std::string>& paths) {
+    std::vector<FileSignature> signatures;
+    signatures.reserve(paths.size());
+    for (const auto& path : paths) {
+        signatures.push_back(statSignature(path.c_str()));
+    }
+    return signatures;
+}
+
+bool FileSignatureCache::isPseudoFile(const std::string& path, const FileSignature& signature) {
+    // procfs报告的大小为0，sysfs属性固定报告页大小，mtime都不随内容变化
+    return signature.size == 0 || path.compare(0, 6, "/proc/") == 0 || path.compare(0, 5, "/sys/") == 0;
+}
+
+std::string FileSignatureCache::lookupOrCompute(const std::string& path, const FileSignature& signature,
+                                                const std::function<std::string(bool exists)>& compute) {
+    if (signature.exists && isPseudoFile(path, signature)) {
+        return compute(true);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_entries.find(path);
+        if (it != m_entries.end() && it->second.signature == signature) {
+            return it->second.parsed;
+        }
+    }
+
+    std::string parsed = compute(signature.exists);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries[path] = {signature, parsed};
+    return parsed;
+}
+
+std::string FileSignatureCache::getOrCompute(const std::string& path,
+                                             const std::function<std::string(bool exists)>& compute) {
+    return lookupOrCompute(path, statSignature(path.c_str()), compute);
+}
+
+std::vector<std::string> FileSignatureCache::getOrComputeBatch(
+        const std::vector<std::string>& paths,
+        const std::function<std::string(const std::string& path, bool exists)>& compute) {
+    std::vector<FileSignature> signatures = statBatch(paths);
+
+    std::vector<std::string> results;
+    results.reserve(paths.size());
+    for (size_t i = 0; i < paths.size(); ++i) {
+        const std::string& path = paths[i];
+        results.push_back(lookupOrCompute(path, signatures[i],
+                                          [&compute, &path](bool exists) { return compute(path, exists); }));
+    }
+    return results;
+}
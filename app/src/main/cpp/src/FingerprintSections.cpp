@@ -0,0 +1,116 @@
+#include "../include/FingerprintSections.h"
+#include "../include/SystemCollector.h"
+#include "../include/CommonCollector.h"
+#include "../include/NetlinkCollector.h"
+#include "../include/BlockDeviceCollector.h"
+#include "../include/PartitionInventoryCollector.h"
+#include "../include/ElfBuildIdCollector.h"
+#include "../include/FileHashCollector.h"
+#include "../include/KernelConfigCollector.h"
+#include "../include/MapsCollector.h"
+#include "../include/RouteCollector.h"
+#include "../include/MediaManifestCollector.h"
+#include "../include/PerfProfiler.h"
+#include "../include/FieldDefinitions.h"
+#include "../include/Logger.h"
+
+int sectionIndex(FingerprintSection section) {
+    return __builtin_ctz(static_cast<uint32_t>(section));
+}
+
+FingerprintSection sectionAt(int index) {
+    return static_cast<FingerprintSection>(1u << index);
+}
+
+const char* sectionName(FingerprintSection section) {
+    switch (section) {
+        case SECTION_BUILD_PROP:    return "build_prop";
+        case SECTION_UNAME:         return "uname";
+        case SECTION_CPU_INFO:      return "cpu_info";
+        case SECTION_DRM_ID:        return "drm_id";
+        case SECTION_NETLINK:       return "netlink";
+        case SECTION_FILE_SYSTEM:   return "file_system";
+        case SECTION_KERNEL_FILES:  return "kernel_files";
+        case SECTION_SYSTEM_FILES:  return "system_files";
+        case SECTION_COMMON_DEVICE: return "common_device";
+        case SECTION_BLOCK_DEVICES: return "block_devices";
+        case SECTION_PARTITION_INVENTORY: return "partition_inventory";
+        case SECTION_ELF_BUILD_IDS: return "elf_build_ids";
+        case SECTION_FILE_HASHES:   return "file_hashes";
+        case SECTION_KERNEL_CONFIG: return "kernel_config";
+        case SECTION_MEMORY_MAPS:   return "memory_maps";
+        case SECTION_ROUTES:        return "routes";
+        case SECTION_MEDIA_MANIFESTS: return "media_manifests";
+    }
+    return "unknown";
+}
+
+const char* sectionTitle(FingerprintSection section) {
+    switch (section) {
+        case SECTION_BUILD_PROP:    return nullptr;
+        case SECTION_UNAME:         return kUnameTitle;
+        case SECTION_CPU_INFO:      return kCpuInfoTitle;
+        case SECTION_DRM_ID:        return kDrmIdTitle;
+        case SECTION_NETLINK:       return kNetlinkTitle;
+        case SECTION_FILE_SYSTEM:   return kFileSystemTitle;
+        case SECTION_KERNEL_FILES:  return kKernelFilesTitle;
+        case SECTION_SYSTEM_FILES:  return kSystemFilesTitle;
+        case SECTION_COMMON_DEVICE: return kCommonDeviceTitle;
+        case SECTION_BLOCK_DEVICES: return kBlockDevicesTitle;
+        case SECTION_PARTITION_INVENTORY: return kPartitionInventoryTitle;
+        case SECTION_ELF_BUILD_IDS: return kElfBuildIdsTitle;
+        case SECTION_FILE_HASHES:   return kFileHashesTitle;
+        case SECTION_KERNEL_CONFIG: return kKernelConfigTitle;
+        case SECTION_MEMORY_MAPS:   return kMemoryMapsTitle;
+        case SECTION_ROUTES:        return kRoutesTitle;
+        case SECTION_MEDIA_MANIFESTS: return kMediaManifestsTitle;
+    }
+    return nullptr;
+}
+
+std::string collectSection(FingerprintSection section, JNIEnv* env) {
+    if (env == nullptr && sectionNeedsJni(section)) {
+        LOGW("FingerprintSections", "Section %s requires JNIEnv", sectionName(section));
+        return "Unable to retrieve: JNIEnv not available\n";
+    }
+
+    // 剖析模式下统计本线程收集该分区的硬件/软件计数器
+    PerfProfiler::Scope profile(sectionName(section));
+
+    switch (section) {
+        case SECTION_BUILD_PROP:    return SystemCollector(env).collectBuildPropFiles();
+        case SECTION_UNAME:         return SystemCollector(env).getUnameInfo();
+        case SECTION_CPU_INFO:      return CommonCollector(env).getCpuInfo();
+        case SECTION_DRM_ID:        return SystemCollector(env).collectDrmId();
+        case SECTION_NETLINK:       return NetlinkCollector().collect();
+        case SECTION_FILE_SYSTEM:   return SystemCollector(env).collectFileSystemInfo();
+        case SECTION_KERNEL_FILES:  return SystemCollector(env).collectKernelFilesInfo();
+        case SECTION_SYSTEM_FILES:  return SystemCollector(env).collectSystemFilesInfo();
+        case SECTION_COMMON_DEVICE: return CommonCollector(env).collect();
+        case SECTION_BLOCK_DEVICES: return BlockDeviceCollector().collect();
+        case SECTION_PARTITION_INVENTORY: return PartitionInventoryCollector().collect();
+        case SECTION_ELF_BUILD_IDS: return ElfBuildIdCollector().collect();
+        case SECTION_FILE_HASHES:   return FileHashCollector().collect();
+        case SECTION_KERNEL_CONFIG: return KernelConfigCollector().collect();
+        case SECTION_MEMORY_MAPS:   return MapsCollector().collect();
+        case SECTION_ROUTES:        return RouteCollector().collect();
+        case SECTION_MEDIA_MANIFESTS: return MediaManifestCollector().collect();
+    }
+    return "Unable to retrieve: Unknown section\n";
+}
+
+std::string profileSections(uint32_t mask, int iterations, JNIEnv* env, bool json) {
+    PerfProfiler& profiler = PerfProfiler::instance();
+    bool wasEnabled = profiler.enabled();
+    profiler.reset();
+    profiler.setEnabled(true);
+    for (int i = 0; i < SECTION_COUNT; ++i) {
+        FingerprintSection section = sectionAt(i);
+        if ((mask & section) == 0) continue;
+        for (int run = 0; run < iterations; ++run) {
+            collectSection(section, env);
+        }
+    }
+    profiler.setEnabled(wasEnabled);
+    return json ? profiler.json() : profiler.table();
+}
@@ -0,0 +1,195 @@
+#include "../include/KernelConfigScanner.h"
+#include "../include/HashUtils.h"
+#include <zlib.h>
+#include <cstring>
+
+namespace {
+
+constexpr std::string_view kConfigPrefix = "CONFIG_";
+constexpr std::string_view kNotSetPrefix = "# CONFIG_";
+constexpr std::string_view kNotSetSuffix = " is not set";
+
+} // namespace
+
+KernelConfigScanner::KernelConfigScanner(std::vector<std::string> options) : m_options(std::move(options)) {
+    // string_view指向m_options中的字符串，m_options构造后不再修改
+    for (size_t i = 0; i < m_options.size(); ++i) {
+        m_optionIndex.emplace(m_options[i], i);
+    }
+    reset();
+}
+
+void KernelConfigScanner::reset() {
+    m_summary = Summary();
+    for (const std::string& option : m_options) {
+        m_summary.selected.emplace_back(option, std::string());
+    }
+    m_digest = kFnvOffsetBasis;
+    m_lineNumber = 0;
+}
+
+void KernelConfigScanner::consumeLine(std::string_view line) {
+    ++m_lineNumber;
+    if (line.size() >= kWindowSize) {
+        ++m_summary.overlong;
+        return;
+    }
+
+    if (line.compare(0, kConfigPrefix.size(), kConfigPrefix) == 0) {
+        size_t equals = line.find('=');
+        if (equals == std::string_view::npos) return;
+        std::string_view name = line.substr(0, equals);
+        std::string_view value = line.substr(equals + 1);
+        if (value == "n") {
+            ++m_summary.notSet;
+        } else {
+            if (value == "y") {
+                ++m_summary.builtin;
+            } else if (value == "m") {
+                ++m_summary.modules;
+            } else {
+                ++m_summary.valued;
+            }
+            m_digest = fnv1a64(line.data(), line.size(), m_digest);
+            m_digest = fnv1a64("\n", 1, m_digest);
+        }
+        auto it = m_optionIndex.find(name);
+        if (it != m_optionIndex.end()) m_summary.selected[it->second].second.assign(value);
+        return;
+    }
+
+    if (line.compare(0, kNotSetPrefix.size(), kNotSetPrefix) == 0 && line.size() > kNotSetSuffix.size() &&
+        line.compare(line.size() - kNotSetSuffix.size(), kNotSetSuffix.size(), kNotSetSuffix) == 0) {
+        ++m_summary.notSet;
+        std::string_view name = line.substr(2, line.size() - 2 - kNotSetSuffix.size());
+        auto it = m_optionIndex.find(name);
+        if (it != m_optionIndex.end()) m_summary.selected[it->second].second = "n";
+        return;
+    }
+
+    // 自动生成的文件头：第3行是 "# Linux/<arch> <version> Kernel Configuration"
+    if (m_lineNumber == 3 && line.size() > 2 && line[0] == '#') {
+        m_summary.header.assign(line.substr(2));
+    }
+}
+
+void KernelConfigScanner::finish() {
+    m_summary.enabledDigest = mix64(m_digest);
+}
+
+void KernelConfigScanner::scanText(std::string_view text) {
+    reset();
+    m_summary.uncompressedBytes = text.size();
+    while (!text.empty()) {
+        size_t newline = text.find('\n');
+        if (newline == std::string_view::npos) {
+            consumeLine(text);
+            break;
+        }
+        consumeLine(text.substr(0, newline));
+        text.remove_prefix(newline + 1);
+    }
+    finish();
+}
+
+bool KernelConfigScanner::scanGzip(const ReadFn& read, std::string* error) {
+    reset();
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    // 15 + 32：自动识别gzip或zlib头
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {
+        *error = "inflateInit failed";
+        return false;
+    }
+
+    unsigned char input[kInputBufferSize];
+    char window[kWindowSize];
+    size_t filled = 0;
+    // 当前行超过窗口长度，丢弃到下一个换行为止
+    bool skipping = false;
+    bool endOfInput = false;
+    bool finished = false;
+    bool ok = true;
+
+    while (!finished) {
+        if (stream.avail_in == 0 && !endOfInput) {
+            ssize_t bytes = read(input, sizeof(input));
+            if (bytes < 0) {
+                *error = "read failed";
+                ok = false;
+                break;
+            }
+            endOfInput = bytes == 0;
+            stream.next_in = input;
+            stream.avail_in = static_cast<uInt>(bytes);
+        }
+
+        stream.next_out = reinterpret_cast<Bytef*>(window + filled);
+        stream.avail_out = static_cast<uInt>(kWindowSize - filled);
+        int status = inflate(&stream, Z_NO_FLUSH);
+        size_t produced = kWindowSize - filled - stream.avail_out;
+        m_summary.uncompressedBytes += produced;
+        filled += produced;
+
+        if (status == Z_STREAM_END) {
+            // 后面可能还有下一个gzip成员
+            if (stream.avail_in == 0 && !endOfInput) {
+                ssize_t bytes = read(input, sizeof(input));
+                if (bytes < 0) {
+                    *error = "read failed";
+                    ok = false;
+                    break;
+                }
+                endOfInput = bytes == 0;
+                stream.next_in = input;
+                stream.avail_in = static_cast<uInt>(bytes);
+            }
+            if (stream.avail_in == 0) {
+                finished = true;
+            } else {
+                inflateReset(&stream);
+            }
+        } else if (status == Z_BUF_ERROR) {
+            // 没有进展：输入耗尽时是截断的流；窗口已满时由下面的行处理腾出空间
+            if (endOfInput && stream.avail_in == 0) {
+                *error = "truncated gzip stream";
+                ok = false;
+                break;
+            }
+        } else if (status != Z_OK) {
+            *error = stream.msg != nullptr ? stream.msg : "inflate failed";
+            ok = false;
+            break;
+        }
+
+        // 解析窗口中所有完整的行，剩余的半行移到窗口开头
+        size_t start = 0;
+        while (const char* newline = static_cast<const char*>(memchr(window + start, '\n', filled - start))) {
+            size_t end = static_cast<size_t>(newline - window);
+            if (skipping) {
+                skipping = false;
+            } else {
+                consumeLine(std::string_view(window + start, end - start));
+            }
+            start = end + 1;
+        }
+        if (start == 0 && filled == kWindowSize) {
+            // 整个窗口没有换行：超长行
+            if (!skipping) consumeLine(std::string_view(window, kWindowSize));
+            skipping = true;
+            filled = 0;
+        } else if (start > 0) {
+            memmove(window, window + start, filled - start);
+            filled -= start;
+        }
+    }
+
+    inflateEnd(&stream);
+    if (!ok) return false;
+
+    // 最后一行没有换行符
+    if (filled > 0 && !skipping) consumeLine(std::string_view(window, filled));
+    finish();
+    return true;
+}
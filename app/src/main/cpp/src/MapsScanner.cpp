@@ -0,0 +1,226 @@
+#include "../include/MapsScanner.h"
+#include "../include/HashUtils.h"
+#include <cstring>
+
+namespace {
+
+// 非十六进制字符映射为0xff
+struct HexTable {
+    uint8_t values[256];
+
+    constexpr HexTable() : values() {
+        for (int i = 0; i < 256; ++i) values[i] = 0xff;
+        for (int i = 0; i < 10; ++i) values['0' + i] = static_cast<uint8_t>(i);
+        for (int i = 0; i < 6; ++i) {
+            values['a' + i] = static_cast<uint8_t>(10 + i);
+            values['A' + i] = static_cast<uint8_t>(10 + i);
+        }
+    }
+};
+
+constexpr HexTable kHex;
+
+// 调用方保证行以非十六进制字符（'\n'）结尾，循环只在遇到非数字时停止
+inline uint64_t parseHex(const char*& p) {
+    uint64_t value = 0;
+    uint8_t digit;
+    while ((digit = kHex.values[static_cast<uint8_t>(*p)]) < 16) {
+        value = (value << 4) | digit;
+        ++p;
+    }
+    return value;
+}
+
+inline uint64_t parseDecimal(const char*& p) {
+    uint64_t value = 0;
+    uint32_t digit;
+    while ((digit = static_cast<uint32_t>(*p) - '0') < 10) {
+        value = value * 10 + digit;
+        ++p;
+    }
+    return value;
+}
+
+constexpr std::string_view kDeletedSuffix = " (deleted)";
+
+// 内核提供的可执行映射
+bool isKernelMapping(std::string_view path) {
+    return path == "[vdso]" || path == "[vectors]" || path == "[vsyscall]" || path == "[sigpage]" ||
+           path == "[uprobes]";
+}
+
+bool startsWith(std::string_view text, std::string_view prefix) {
+    return text.size() >= prefix.size() && text.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+void MapsScanner::reset() {
+    m_paths.clear();
+    m_objects.clear();
+    m_slots.assign(m_slots.empty() ? 1024 : m_slots.size(), Slot{0, 0});
+    m_lastObject = UINT32_MAX;
+    m_summary = Summary();
+}
+
+void MapsScanner::grow() {
+    std::vector<Slot> slots(m_slots.size() * 2, Slot{0, 0});
+    size_t mask = slots.size() - 1;
+    for (const Slot& slot : m_slots) {
+        if (slot.object == 0) continue;
+        size_t index = slot.hash & mask;
+        while (slots[index].object != 0) index = (index + 1) & mask;
+        slots[index] = slot;
+    }
+    m_slots.swap(slots);
+}
+
+uint32_t MapsScanner::intern(std::string_view path) {
+    if (m_lastObject != UINT32_MAX) {
+        const Object& last = m_objects[m_lastObject];
+        if (last.pathLength == path.size() && memcmp(m_paths.data() + last.pathOffset, path.data(), path.size()) == 0) {
+            return m_lastObject;
+        }
+    }
+
+    uint64_t hash = fnv1a64(path.data(), path.size());
+    size_t mask = m_slots.size() - 1;
+    size_t index = hash & mask;
+    while (m_slots[index].object != 0) {
+        const Slot& slot = m_slots[index];
+        if (slot.hash == hash && this->path(m_objects[slot.object - 1]) == path) {
+            m_lastObject = slot.object - 1;
+            return m_lastObject;
+        }
+        index = (index + 1) & mask;
+    }
+
+    Object object = {};
+    object.pathOffset = static_cast<uint32_t>(m_paths.size());
+    object.pathLength = static_cast<uint32_t>(path.size());
+    object.low = UINT64_MAX;
+    m_paths.append(path.data(), path.size());
+    m_objects.push_back(object);
+    m_slots[index] = Slot{hash, static_cast<uint32_t>(m_objects.size())};
+    // 负载因子超过3/4时扩容
+    if (m_objects.size() * 4 > m_slots.size() * 3) grow();
+
+    m_lastObject = static_cast<uint32_t>(m_objects.size() - 1);
+    return m_lastObject;
+}
+
+// 格式："start-end perms offset major:minor inode   path"，line指向行首，end指向行尾的 '\n'
+void MapsScanner::parseLine(const char* line, const char* end) {
+    const char* p = line;
+    uint64_t start = parseHex(p);
+    if (*p++ != '-') {
+        ++m_summary.malformed;
+        return;
+    }
+    uint64_t stop = parseHex(p);
+    if (*p++ != ' ' || end - p < 5 || p[4] != ' ') {
+        ++m_summary.malformed;
+        return;
+    }
+    uint8_t permissions = static_cast<uint8_t>((p[0] == 'r' ? PERM_READ : 0) | (p[1] == 'w' ? PERM_WRITE : 0) |
+                                               (p[2] == 'x' ? PERM_EXEC : 0) | (p[3] == 's' ? PERM_SHARED : 0));
+    p += 5;
+    parseHex(p);    // offset
+    if (*p++ != ' ') {
+        ++m_summary.malformed;
+        return;
+    }
+    parseHex(p);    // major
+    if (*p++ != ':') {
+        ++m_summary.malformed;
+        return;
+    }
+    parseHex(p);    // minor
+    if (*p++ != ' ') {
+        ++m_summary.malformed;
+        return;
+    }
+    uint64_t inode = parseDecimal(p);
+    while (*p == ' ') ++p;
+    if (p > end) p = end;
+
+    std::string_view path(p, static_cast<size_t>(end - p));
+    bool deleted = path.size() > kDeletedSuffix.size() &&
+                   path.compare(path.size() - kDeletedSuffix.size(), kDeletedSuffix.size(), kDeletedSuffix) == 0;
+    if (deleted) path.remove_suffix(kDeletedSuffix.size());
+
+    uint64_t bytes = stop > start ? stop - start : 0;
+    ++m_summary.mappings;
+    m_summary.mappedBytes += bytes;
+
+    bool exec = (permissions & PERM_EXEC) != 0;
+    if (exec && (permissions & PERM_WRITE) != 0) ++m_summary.writableExec;
+    if (exec && deleted) ++m_summary.deletedExec;
+    if (exec && startsWith(path, "/memfd:") && path.find("jit-cache") == std::string_view::npos &&
+        path.find("jit-zygote-cache") == std::string_view::npos) {
+        ++m_summary.memfdExec;
+    }
+    if (path.empty() || (inode == 0 && path[0] == '[')) {
+        if (exec && !isKernelMapping(path)) ++m_summary.anonymousExec;
+        // 匿名映射不聚合（数量多且没有身份信息），带名字的 [anon:...] / [heap] 等照常聚合
+        if (path.empty()) return;
+    }
+
+    Object& object = m_objects[intern(path)];
+    if (start < object.low) object.low = start;
+    if (stop > object.high) object.high = stop;
+    object.bytes += bytes;
+    ++object.mappings;
+    object.permissions |= permissions;
+    object.deleted |= deleted ? 1 : 0;
+}
+
+bool MapsScanner::scan(const ReadFn& read) {
+    reset();
+    // 多留一个字节，最后一行没有换行时补上哨兵
+    m_buffer.resize(kReadSize + 1);
+    size_t filled = 0;
+
+    while (true) {
+        ssize_t bytes = read(m_buffer.data() + filled, kReadSize - filled);
+        if (bytes < 0) return false;
+        if (bytes == 0) break;
+        filled += static_cast<size_t>(bytes);
+
+        // 解析所有完整的行，剩余的半行移到缓冲区开头
+        const char* data = m_buffer.data();
+        size_t start = 0;
+        while (const char* newline = static_cast<const char*>(memchr(data + start, '\n', filled - start))) {
+            parseLine(data + start, newline);
+            start = static_cast<size_t>(newline - data) + 1;
+        }
+        if (start == 0 && filled == kReadSize) {
+            // 单行超过缓冲区（路径不可能这么长），丢弃
+            ++m_summary.malformed;
+            filled = 0;
+        } else if (start > 0) {
+            memmove(m_buffer.data(), data + start, filled - start);
+            filled -= start;
+        }
+    }
+
+    if (filled > 0) {
+        m_buffer[filled] = '\n';
+        parseLine(m_buffer.data(), m_buffer.data() + filled);
+    }
+    return true;
+}
+
+void MapsScanner::scanText(std::string_view text) {
+    size_t offset = 0;
+    scan([&text, &offset](void* buffer, size_t size) -> ssize_t {
+        size_t count = std::min(size, text.size() - offset);
+        memcpy(buffer, text.data() + offset, count);
+        offset += count;
+        return static_cast<ssize_t>(count);
+    });
+}
+
+bool MapsScanner::isCodeObject(const Object& object, std::string_view path) {
+    return (object.permissions & PERM_EXEC) != 0 && !path.empty() && path[0] == '/' && !startsWith(path, "/memfd:");
+}
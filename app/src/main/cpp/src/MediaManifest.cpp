@@ -0,0 +1,126 @@
+#include "../include/MediaManifest.h"
+#include "../include/XmlTokenizer.h"
+#include "../include/Blake3.h"
+#include "../include/WorkStealingPool.h"
+#include <algorithm>
+
+namespace media_manifest {
+
+namespace {
+
+std::string makeEntry(std::string_view kind, std::string_view name, std::string_view detail) {
+    std::string entry;
+    entry.reserve(kind.size() + name.size() + detail.size() + 2);
+    entry.append(kind).append(1, ' ').append(name);
+    if (!detail.empty()) entry.append(1, kind == "feature" ? '=' : ' ').append(detail);
+    return entry;
+}
+
+bool startsWith(const std::string& entry, std::string_view prefix) {
+    return entry.compare(0, prefix.size(), prefix) == 0;
+}
+
+} // namespace
+
+void scanText(std::string_view text, FileResult* result) {
+    // <Decoders>/<Encoders> 决定编解码器方向；当前<MediaCodec>的名称和是否已输出过类型
+    std::string_view kind;
+    std::string_view codec;
+    bool inCodec = false;
+    bool codecTyped = false;
+
+    bool complete = xml::forEachTag(text, [&](const xml::Tag& tag) {
+        std::string_view value;
+        if (tag.name == "feature" || tag.name == "unavailable-feature") {
+            if (tag.kind == xml::TagKind::END || !xml::attribute(tag.attributes, "name", &value)) return true;
+            if (tag.name == "feature") {
+                std::string_view version;
+                xml::attribute(tag.attributes, "version", &version);
+                result->entries.push_back(makeEntry("feature", value, version));
+            } else {
+                result->entries.push_back(makeEntry("unavailable", value, std::string_view()));
+            }
+        } else if (tag.name == "Decoders" || tag.name == "Encoders") {
+            kind = tag.kind == xml::TagKind::START ? (tag.name == "Decoders" ? "decoder" : "encoder")
+                                                   : std::string_view();
+        } else if (tag.name == "MediaCodec") {
+            if (tag.kind == xml::TagKind::END) {
+                if (inCodec && !codecTyped) result->entries.push_back(makeEntry(kind, codec, std::string_view()));
+                inCodec = false;
+                return true;
+            }
+            if (kind.empty() || !xml::attribute(tag.attributes, "name", &codec)) return true;
+            inCodec = tag.kind == xml::TagKind::START;
+            codecTyped = xml::attribute(tag.attributes, "type", &value);
+            if (codecTyped || tag.kind == xml::TagKind::EMPTY) result->entries.push_back(makeEntry(kind, codec, value));
+        } else if (tag.name == "Type" && inCodec && tag.kind != xml::TagKind::END) {
+            if (xml::attribute(tag.attributes, "name", &value)) {
+                result->entries.push_back(makeEntry(kind, codec, value));
+                codecTyped = true;
+            }
+        }
+        return true;
+    });
+
+    result->bytes += text.size();
+    result->malformed |= !complete;
+}
+
+Summary merge(std::vector<FileResult>& results) {
+    Summary summary;
+    size_t total = 0;
+    for (const FileResult& result : results) total += result.entries.size();
+    summary.entries.reserve(total);
+
+    for (FileResult& result : results) {
+        if (!result.loaded) continue;
+        ++summary.files;
+        summary.bytes += result.bytes;
+        if (result.malformed) ++summary.malformedFiles;
+        std::move(result.entries.begin(), result.entries.end(), std::back_inserter(summary.entries));
+        result.entries.clear();
+    }
+    std::sort(summary.entries.begin(), summary.entries.end());
+    summary.entries.erase(std::unique(summary.entries.begin(), summary.entries.end()), summary.entries.end());
+
+    Blake3Hasher all;
+    Blake3Hasher features;
+    for (const std::string& entry : summary.entries) {
+        all.update(entry.data(), entry.size());
+        all.update("\n", 1);
+        if (startsWith(entry, "decoder ")) {
+            ++summary.decoders;
+        } else if (startsWith(entry, "encoder ")) {
+            ++summary.encoders;
+        } else if (startsWith(entry, "feature ")) {
+            ++summary.features;
+            features.update(entry.data(), entry.size());
+            features.update("\n", 1);
+        } else {
+            ++summary.unavailable;
+        }
+    }
+    summary.digest = all.finalizeHex();
+    summary.featureDigest = features.finalizeHex();
+    return summary;
+}
+
+Summary scanFiles(const std::vector<std::string>& paths, ReadFn read, WorkStealingPool& pool) {
+    std::vector<FileResult> results(paths.size());
+    // 每个worker复用一个读缓冲区
+    std::vector<std::string> buffers(pool.workerCount());
+
+    std::vector<WorkStealingPool::Task> tasks;
+    for (size_t i = 0; i < paths.size(); ++i) {
+        tasks.emplace_back([&paths, &results, &buffers, read, i](unsigned worker) {
+            std::string& buffer = buffers[worker];
+            if (!read(paths[i].c_str(), &buffer)) return;
+            results[i].loaded = true;
+            scanText(buffer, &results[i]);
+        });
+    }
+    pool.runAndWait(std::move(tasks));
+    return merge(results);
+}
+
+} // namespace media_manifest
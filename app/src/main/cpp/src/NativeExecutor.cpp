@@ -0,0 +1,64 @@
+#include "../include/NativeExecutor.h"
+#include "../include/Logger.h"
+#include "../include/private/ScopedJniAttach.h"
+#include <atomic>
+#include <string>
+#include <thread>
+
+static std::atomic<JavaVM*> g_javaVm{nullptr};
+
+constexpr int NativeExecutor::kWorkerCount;
+
+void NativeExecutor::setJavaVM(JavaVM* vm) {
+    g_javaVm.store(vm);
+}
+
+JavaVM* NativeExecutor::javaVM() {
+    return g_javaVm.load();
+}
+
+NativeExecutor& NativeExecutor::instance() {
+    static NativeExecutor executor;
+    return executor;
+}
+
+NativeExecutor::NativeExecutor() {
+    // 工作线程常驻到进程结束，不做join
+    for (int i = 0; i < kWorkerCount; ++i) {
+        std::thread(&NativeExecutor::workerLoop, this, i).detach();
+    }
+}
+
+void NativeExecutor::submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(std::move(task));
+    }
+    m_cv.notify_one();
+}
+
+void NativeExecutor::workerLoop(int index) {
+    std::string name = "fp-worker-" + std::to_string(index);
+    ScopedJniAttach attach(javaVM(), name.c_str());
+    if (attach.env() == nullptr) {
+        LOGW("NativeExecutor", "Worker %d running without JNIEnv", index);
+    }
+
+    while (true) {
+        Task task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return !m_queue.empty(); });
+            task = std::move(m_queue.front());
+            m_queue.pop_front();
+        }
+
+        try {
+            task(attach.env());
+        } catch (const std::exception& e) {
+            LOGE("NativeExecutor", "Exception in task: %s", e.what());
+        } catch (...) {
+            LOGE("NativeExecutor", "Unknown exception in task");
+        }
+    }
+}
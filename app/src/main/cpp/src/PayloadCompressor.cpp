@@ -0,0 +1,109 @@
+#include "../include/PayloadCompressor.h"
+#include <zlib.h>
+#include <algorithm>
+#include <mutex>
+
+struct PayloadCompressor::Stream {
+    z_stream zs = {};
+};
+
+static std::mutex g_dictionaryMutex;
+static std::shared_ptr<const std::string> g_dictionary;
+
+void PayloadCompressor::setDictionary(std::string dictionary) {
+    std::shared_ptr<const std::string> next;
+    if (!dictionary.empty()) next = std::make_shared<const std::string>(std::move(dictionary));
+    std::lock_guard<std::mutex> lock(g_dictionaryMutex);
+    g_dictionary = std::move(next);
+}
+
+std::shared_ptr<const std::string> PayloadCompressor::currentDictionary() {
+    std::lock_guard<std::mutex> lock(g_dictionaryMutex);
+    return g_dictionary;
+}
+
+uint32_t PayloadCompressor::dictionaryId(const std::string& dictionary) {
+    if (dictionary.empty()) return 0;
+    return static_cast<uint32_t>(adler32(adler32(0L, Z_NULL, 0), reinterpret_cast<const Bytef*>(dictionary.data()),
+                                         static_cast<uInt>(dictionary.size())));
+}
+
+PayloadCompressor::PayloadCompressor(std::shared_ptr<const std::string> dictionary, int level)
+        : m_stream(new Stream()) {
+    // 只用默认的8级内存（约256KB状态），低端机上分配开销可以忽略
+    m_ok = deflateInit2(&m_stream->zs, level, Z_DEFLATED, 15, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+    if (m_ok && dictionary && !dictionary->empty()) {
+        m_ok = deflateSetDictionary(&m_stream->zs, reinterpret_cast<const Bytef*>(dictionary->data()),
+                                    static_cast<uInt>(dictionary->size())) == Z_OK;
+    }
+}
+
+PayloadCompressor::~PayloadCompressor() {
+    deflateEnd(&m_stream->zs);
+}
+
+bool PayloadCompressor::deflateChunk(std::string_view data, int flush) {
+    z_stream& zs = m_stream->zs;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    zs.avail_in = static_cast<uInt>(data.size());
+    do {
+        // 文本通常压缩到原来的1/4以下，按输入的一半加上固定余量扩容
+        size_t used = m_output.size();
+        size_t room = deflateBound(&zs, zs.avail_in) / 2 + 256;
+        m_output.resize(used + room);
+        zs.next_out = reinterpret_cast<Bytef*>(&m_output[used]);
+        zs.avail_out = static_cast<uInt>(room);
+        int rc = deflate(&zs, flush);
+        m_output.resize(used + room - zs.avail_out);
+        if (rc == Z_STREAM_END) return true;
+        if (rc != Z_OK && rc != Z_BUF_ERROR) return false;
+    } while (zs.avail_in > 0 || (flush == Z_FINISH) || zs.avail_out == 0);
+    return true;
+}
+
+bool PayloadCompressor::append(std::string_view data) {
+    if (!m_ok || data.empty()) return m_ok;
+    m_inputBytes += data.size();
+    m_ok = deflateChunk(data, Z_NO_FLUSH);
+    return m_ok;
+}
+
+std::string PayloadCompressor::finish() {
+    if (!m_ok || !deflateChunk(std::string_view(), Z_FINISH)) {
+        m_ok = false;
+        return std::string();
+    }
+    m_ok = false;
+    return std::move(m_output);
+}
+
+bool PayloadCompressor::decompress(std::string_view compressed, const std::string* dictionary, std::string* output) {
+    z_stream zs = {};
+    if (inflateInit(&zs) != Z_OK) return false;
+    zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    zs.avail_in = static_cast<uInt>(compressed.size());
+
+    output->clear();
+    int rc = Z_OK;
+    while (rc != Z_STREAM_END) {
+        size_t used = output->size();
+        size_t room = std::max<size_t>(4096, compressed.size() * 4);
+        output->resize(used + room);
+        zs.next_out = reinterpret_cast<Bytef*>(&(*output)[used]);
+        zs.avail_out = static_cast<uInt>(room);
+        rc = inflate(&zs, Z_NO_FLUSH);
+        if (rc == Z_NEED_DICT) {
+            if (dictionary == nullptr || zs.adler != dictionaryId(*dictionary) ||
+                inflateSetDictionary(&zs, reinterpret_cast<const Bytef*>(dictionary->data()),
+                                     static_cast<uInt>(dictionary->size())) != Z_OK) {
+                break;
+            }
+            rc = inflate(&zs, Z_NO_FLUSH);
+        }
+        output->resize(used + room - zs.avail_out);
+        if (rc != Z_OK && rc != Z_STREAM_END) break;
+        if (rc == Z_OK && zs.avail_in == 0 && zs.avail_out != 0) break;
+    }
+    inflateEnd(&zs);
+    return rc == Z_STREAM_END;
+}
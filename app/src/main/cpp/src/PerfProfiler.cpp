@@ -0,0 +1,260 @@
+#include "../include/PerfProfiler.h"
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+struct CounterConfig {
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr CounterConfig kConfigs[PERF_COUNTER_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK},
+};
+
+int openCounter(const CounterConfig& config, bool excludeKernel) {
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = config.type;
+    attr.config = config.config;
+    attr.disabled = 1;
+    attr.exclude_hv = 1;
+    attr.exclude_kernel = excludeKernel ? 1 : 0;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    // pid = 0, cpu = -1：当前线程，任意CPU
+    return static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+
+bool hasFallback(int counter) {
+    return counter == PERF_CONTEXT_SWITCHES || counter == PERF_PAGE_FAULTS || counter == PERF_TASK_CLOCK;
+}
+
+uint64_t clockNs(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+void readFallbacks(uint64_t values[PERF_COUNTER_COUNT]) {
+    rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+        values[PERF_CONTEXT_SWITCHES] = static_cast<uint64_t>(usage.ru_nvcsw + usage.ru_nivcsw);
+        values[PERF_PAGE_FAULTS] = static_cast<uint64_t>(usage.ru_minflt + usage.ru_majflt);
+    }
+    values[PERF_TASK_CLOCK] = clockNs(CLOCK_THREAD_CPUTIME_ID);
+}
+
+void appendJsonString(std::string* out, const std::string& value) {
+    *out += '"';
+    for (char c : value) {
+        if (c == '"' || c == '\\') *out += '\\';
+        *out += c;
+    }
+    *out += '"';
+}
+
+} // namespace
+
+const char* perfCounterName(PerfCounter counter) {
+    switch (counter) {
+        case PERF_INSTRUCTIONS:     return "instructions";
+        case PERF_CYCLES:           return "cycles";
+        case PERF_CACHE_MISSES:     return "cache_misses";
+        case PERF_BRANCH_MISSES:    return "branch_misses";
+        case PERF_CONTEXT_SWITCHES: return "context_switches";
+        case PERF_PAGE_FAULTS:      return "page_faults";
+        case PERF_TASK_CLOCK:       return "task_clock_ns";
+        case PERF_COUNTER_COUNT:    break;
+    }
+    return "unknown";
+}
+
+const char* perfSourceName(PerfSource source) {
+    switch (source) {
+        case PerfSource::NONE:            return "unavailable";
+        case PerfSource::PERF_EVENT:      return "perf_event";
+        case PerfSource::PERF_EVENT_USER: return "perf_event_user";
+        case PerfSource::RUSAGE:          return "rusage";
+    }
+    return "unknown";
+}
+
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        m_fds[i] = openCounter(kConfigs[i], false);
+        m_sources[i] = PerfSource::PERF_EVENT;
+        if (m_fds[i] < 0 && (errno == EACCES || errno == EPERM)) {
+            m_fds[i] = openCounter(kConfigs[i], true);
+            m_sources[i] = PerfSource::PERF_EVENT_USER;
+        }
+        if (m_fds[i] < 0) m_sources[i] = hasFallback(i) ? PerfSource::RUSAGE : PerfSource::NONE;
+    }
+}
+
+PerfCounters::~PerfCounters() {
+    for (int fd : m_fds) {
+        if (fd >= 0) close(fd);
+    }
+}
+
+void PerfCounters::start() {
+    readFallbacks(m_fallbackStart);
+    m_wallStart = clockNs(CLOCK_MONOTONIC);
+    for (int fd : m_fds) {
+        if (fd < 0) continue;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+PerfSample PerfCounters::stop() {
+    for (int fd : m_fds) {
+        if (fd >= 0) ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    PerfSample sample;
+    sample.wallNs = clockNs(CLOCK_MONOTONIC) - m_wallStart;
+    uint64_t fallback[PERF_COUNTER_COUNT] = {};
+    readFallbacks(fallback);
+
+    for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        sample.sources[i] = m_sources[i];
+        if (m_sources[i] == PerfSource::RUSAGE) {
+            sample.values[i] = fallback[i] - m_fallbackStart[i];
+        } else if (m_fds[i] >= 0) {
+            // value, time_enabled, time_running；计数器被复用时按运行时间比例放大
+            uint64_t data[3] = {};
+            if (read(m_fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+                sample.sources[i] = PerfSource::NONE;
+            } else if (data[2] > 0 && data[2] < data[1]) {
+                sample.values[i] = static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2]);
+            } else {
+                sample.values[i] = data[0];
+            }
+        }
+    }
+    return sample;
+}
+
+PerfProfiler& PerfProfiler::instance() {
+    static PerfProfiler profiler;
+    return profiler;
+}
+
+void PerfProfiler::record(const std::string& name, const PerfSample& sample) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Entry* entry = nullptr;
+    for (Entry& existing : m_entries) {
+        if (existing.name == name) entry = &existing;
+    }
+    if (entry == nullptr) {
+        m_entries.emplace_back();
+        entry = &m_entries.back();
+        entry->name = name;
+    }
+    ++entry->runs;
+    entry->total.wallNs += sample.wallNs;
+    for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        entry->total.values[i] += sample.values[i];
+        entry->total.sources[i] = sample.sources[i];
+    }
+}
+
+void PerfProfiler::reset() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+}
+
+std::string PerfProfiler::table() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.empty()) return "no samples (profiling " + std::string(enabled() ? "enabled" : "disabled") + ")\n";
+
+    char line[256];
+    snprintf(line, sizeof(line), "%-20s %5s %10s %10s %12s %12s %5s %10s %10s %7s %7s\n", "section", "runs", "wall_us",
+             "cpu_us", "instructions", "cycles", "ipc", "cache_miss", "branch_miss", "ctx_sw", "faults");
+    std::string result = line;
+    for (const Entry& entry : m_entries) {
+        const PerfSample& total = entry.total;
+        auto average = [&entry, &total](PerfCounter counter) -> std::string {
+            if (total.sources[counter] == PerfSource::NONE) return "n/a";
+            uint64_t value = total.values[counter] / entry.runs;
+            return std::to_string(counter == PERF_TASK_CLOCK ? value / 1000 : value);
+        };
+        std::string ipc = "n/a";
+        if (total.sources[PERF_INSTRUCTIONS] != PerfSource::NONE && total.sources[PERF_CYCLES] != PerfSource::NONE &&
+            total.values[PERF_CYCLES] > 0) {
+            snprintf(line, sizeof(line), "%.2f",
+                     static_cast<double>(total.values[PERF_INSTRUCTIONS]) / total.values[PERF_CYCLES]);
+            ipc = line;
+        }
+        snprintf(line, sizeof(line), "%-20s %5" PRIu64 " %10" PRIu64 " %10s %12s %12s %5s %10s %10s %7s %7s\n",
+                 entry.name.c_str(), entry.runs, total.wallNs / entry.runs / 1000,
+                 average(PERF_TASK_CLOCK).c_str(), average(PERF_INSTRUCTIONS).c_str(), average(PERF_CYCLES).c_str(),
+                 ipc.c_str(), average(PERF_CACHE_MISSES).c_str(), average(PERF_BRANCH_MISSES).c_str(),
+                 average(PERF_CONTEXT_SWITCHES).c_str(), average(PERF_PAGE_FAULTS).c_str());
+        result += line;
+    }
+
+    // 计数器来源以最后一个分区为准（同一进程内各线程相同）
+    const PerfSample& last = m_entries.back().total;
+    result += "sources:";
+    for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+        result += std::string(" ") + perfCounterName(static_cast<PerfCounter>(i)) + "=" +
+                  perfSourceName(last.sources[i]);
+    }
+    result += "\n";
+    return result;
+}
+
+std::string PerfProfiler::json() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::string result = "{\"enabled\":" + std::string(enabled() ? "true" : "false") + ",\"sections\":[";
+    for (size_t e = 0; e < m_entries.size(); ++e) {
+        const Entry& entry = m_entries[e];
+        if (e > 0) result += ',';
+        result += "{\"name\":";
+        appendJsonString(&result, entry.name);
+        result += ",\"runs\":" + std::to_string(entry.runs) + ",\"wall_ns\":" + std::to_string(entry.total.wallNs);
+        for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+            result += ",\"" + std::string(perfCounterName(static_cast<PerfCounter>(i))) + "\":";
+            result += entry.total.sources[i] == PerfSource::NONE ? "null" : std::to_string(entry.total.values[i]);
+        }
+        result += ",\"sources\":{";
+        for (int i = 0; i < PERF_COUNTER_COUNT; ++i) {
+            if (i > 0) result += ',';
+            result += "\"" + std::string(perfCounterName(static_cast<PerfCounter>(i))) + "\":\"" +
+                      perfSourceName(entry.total.sources[i]) + "\"";
+        }
+        result += "}}";
+    }
+    result += "]}";
+    return result;
+}
+
+PerfProfiler::Scope::Scope(const char* name) : m_name(name) {
+    if (!PerfProfiler::instance().enabled()) return;
+    m_counters = new PerfCounters();
+    m_counters->start();
+}
+
+PerfProfiler::Scope::~Scope() {
+    if (m_counters == nullptr) return;
+    PerfSample sample = m_counters->stop();
+    delete m_counters;
+    PerfProfiler::instance().record(m_name, sample);
+}
@@ -0,0 +1,222 @@
+#include "../include/PersistentSnapshot.h"
+#include "../include/FieldDefinitions.h"
+#include "../include/FileSignatureCache.h"
+#include "../include/HashUtils.h"
+#include "../include/Logger.h"
+#include "../include/private/ScopedFd.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/system_properties.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+struct SnapshotFileHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t sectionCount;
+    uint64_t fileSize;
+    uint64_t checksum;  // FNV-1a，覆盖头部之后的所有字节
+};
+
+struct SnapshotSectionRecord {
+    uint32_t section;
+    uint32_t offset;
+    uint32_t length;
+    uint32_t reserved;
+    uint64_t key;
+};
+
+constexpr uint32_t PersistentSnapshot::kMagic;
+constexpr uint16_t PersistentSnapshot::kVersion;
+
+PersistentSnapshot::~PersistentSnapshot() {
+    unmap();
+}
+
+void PersistentSnapshot::unmap() {
+    if (m_base != nullptr) {
+        munmap(m_base, m_size);
+        m_base = nullptr;
+        m_size = 0;
+    }
+}
+
+static ssize_t readSmallFile(const char* path, char* buffer, size_t capacity) {
+    ScopedFd fd(open(path, O_RDONLY | O_CLOEXEC));
+    if (!fd.isValid()) return -1;
+
+    ssize_t total = 0;
+    while (static_cast<size_t>(total) < capacity) {
+        ssize_t n = read(fd.get(), buffer + total, capacity - total);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        total += n;
+    }
+    return total;
+}
+
+std::string PersistentSnapshot::pathIn(const std::string& filesDir) {
+    if (filesDir.empty()) return "";
+    return filesDir + "/fingerprint_snapshot.bin";
+}
+
+static uint64_t hashProperty(const char* name, uint64_t hash) {
+    char value[PROP_VALUE_MAX] = {};
+    int length = __system_property_get(name, value);
+    return fnv1a64(value, length > 0 ? static_cast<size_t>(length) : 0, hash);
+}
+
+static uint64_t hashBootId(uint64_t hash) {
+    char bootId[64];
+    ssize_t n = readSmallFile("/proc/sys/kernel/random/boot_id", bootId, sizeof(bootId));
+    return fnv1a64(bootId, n > 0 ? static_cast<size_t>(n) : 0, hash);
+}
+
+static uint64_t hashFileSignature(const char* path, uint64_t hash) {
+    FileSignature signature = FileSignatureCache::statSignature(path);
+    if (!signature.exists) {
+        return fnv1a64("-", 1, hash);
+    }
+    uint64_t fields[] = {signature.ino, signature.size, static_cast<uint64_t>(signature.mtimeSec),
+                         signature.mtimeNsec};
+    return fnv1a64(fields, sizeof(fields), hash);
+}
+
+uint64_t PersistentSnapshot::validationKey(FingerprintSection section) {
+    // OTA会改变fingerprint，所有不可变分区都以它为基础
+    uint64_t key = hashProperty("ro.build.fingerprint", kFnvOffsetBasis);
+    key = fnv1a64(&section, sizeof(section), key);
+
+    switch (section) {
+        case SECTION_BUILD_PROP: {
+            for (const char* path : kBuildPropFiles) {
+                key = hashFileSignature(path, key);
+            }
+            break;
+        }
+        case SECTION_UNAME:
+        case SECTION_CPU_INFO:
+        case SECTION_NETLINK:
+        case SECTION_BLOCK_DEVICES:
+        case SECTION_PARTITION_INVENTORY:
+        case SECTION_ELF_BUILD_IDS:
+        case SECTION_KERNEL_CONFIG:
+            // 内核、硬件拓扑和已激活的APEX只会在重启后变化
+            key = hashBootId(key);
+            break;
+        default:
+            break;
+    }
+    return key;
+}
+
+bool PersistentSnapshot::load(const std::string& path) {
+    unmap();
+    if (path.empty()) return false;
+
+    ScopedFd fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+    if (!fd.isValid()) {
+        LOGI("PersistentSnapshot", "No snapshot at %s", path.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd.get(), &st) != 0 || st.st_size < static_cast<off_t>(sizeof(SnapshotFileHeader))) {
+        return false;
+    }
+
+    void* base = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd.get(), 0);
+    if (base == MAP_FAILED) {
+        LOGE("PersistentSnapshot", "mmap failed: %s, errno: %d", path.c_str(), errno);
+        return false;
+    }
+    m_base = base;
+    m_size = static_cast<size_t>(st.st_size);
+
+    const auto* header = static_cast<const SnapshotFileHeader*>(m_base);
+    const char* payload = static_cast<const char*>(m_base) + sizeof(SnapshotFileHeader);
+    size_t payloadSize = m_size - sizeof(SnapshotFileHeader);
+    size_t recordsSize = static_cast<size_t>(header->sectionCount) * sizeof(SnapshotSectionRecord);
+
+    if (header->magic != kMagic || header->version != kVersion || header->fileSize != m_size ||
+        recordsSize > payloadSize || header->checksum != fnv1a64(payload, payloadSize)) {
+        LOGW("PersistentSnapshot", "Discarding invalid snapshot: %s", path.c_str());
+        unmap();
+        return false;
+    }
+
+    LOGI("PersistentSnapshot", "Loaded snapshot with %u sections", header->sectionCount);
+    return true;
+}
+
+bool PersistentSnapshot::lookup(FingerprintSection section, uint64_t key, std::string_view* text) const {
+    if (m_base == nullptr) return false;
+
+    const auto* header = static_cast<const SnapshotFileHeader*>(m_base);
+    const auto* records = reinterpret_cast<const SnapshotSectionRecord*>(header + 1);
+    for (uint16_t i = 0; i < header->sectionCount; ++i) {
+        const SnapshotSectionRecord& record = records[i];
+        if (record.section != section) continue;
+        if (record.key != key || static_cast<uint64_t>(record.offset) + record.length > m_size) {
+            return false;
+        }
+        *text = std::string_view(static_cast<const char*>(m_base) + record.offset, record.length);
+        return true;
+    }
+    return false;
+}
+
+bool PersistentSnapshot::save(const std::string& path, const std::vector<SectionBlob>& blobs) {
+    if (path.empty()) return false;
+
+    size_t offset = sizeof(SnapshotFileHeader) + blobs.size() * sizeof(SnapshotSectionRecord);
+    std::string file(offset, '\0');
+
+    for (size_t i = 0; i < blobs.size(); ++i) {
+        SnapshotSectionRecord record = {static_cast<uint32_t>(blobs[i].section), static_cast<uint32_t>(file.size()),
+                                        static_cast<uint32_t>(blobs[i].text.size()), 0, blobs[i].key};
+        memcpy(&file[sizeof(SnapshotFileHeader) + i * sizeof(record)], &record, sizeof(record));
+        file += blobs[i].text;
+    }
+
+    SnapshotFileHeader header = {};
+    header.magic = kMagic;
+    header.version = kVersion;
+    header.sectionCount = static_cast<uint16_t>(blobs.size());
+    header.fileSize = file.size();
+    header.checksum = fnv1a64(file.data() + sizeof(header), file.size() - sizeof(header));
+    memcpy(&file[0], &header, sizeof(header));
+
+    std::string tmpPath = path + ".tmp";
+    {
+        ScopedFd fd(open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600));
+        if (!fd.isValid()) {
+            LOGE("PersistentSnapshot", "Failed to create %s, errno: %d", tmpPath.c_str(), errno);
+            return false;
+        }
+
+        size_t written = 0;
+        while (written < file.size()) {
+            ssize_t n = write(fd.get(), file.data() + written, file.size() - written);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                LOGE("PersistentSnapshot", "Failed to write %s, errno: %d", tmpPath.c_str(), errno);
+                unlink(tmpPath.c_str());
+                return false;
+            }
+            written += static_cast<size_t>(n);
+        }
+        fsync(fd.get());
+    }
+
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LOGE("PersistentSnapshot", "Failed to rename snapshot, errno: %d", errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+
+    LOGI("PersistentSnapshot", "Saved snapshot with %zu sections", blobs.size());
+    return true;
+}
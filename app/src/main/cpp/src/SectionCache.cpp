@@ -0,0 +1,184 @@
+#include "../include/SectionCache.h"
+#include "../include/Logger.h"
+#include <thread>
+
+constexpr std::chrono::milliseconds SectionCache::kDefaultWaitTimeout;
+
+SectionCache& SectionCache::instance() {
+    static SectionCache cache;
+    return cache;
+}
+
+bool SectionCache::claim(FingerprintSection section, std::shared_future<std::string>* future,
+                         std::promise<std::string>* promise) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::shared_future<std::string>& slot = m_futures[sectionIndex(section)];
+    if (slot.valid()) {
+        *future = slot;
+        return false;
+    }
+    slot = promise->get_future().share();
+    *future = slot;
+    return true;
+}
+
+// 与快照校验键的约定一致：结果中出现 "Unable to retrieve" 即视为失败，不缓存也不持久化
+static bool isFailure(const std::string& result) {
+    return result.find("Unable to retrieve") != std::string::npos;
+}
+
+static std::string runCollector(FingerprintSection section, const std::function<std::string()>& collector) {
+    try {
+        return collector();
+    } catch (const std::exception& e) {
+        LOGE("SectionCache", "Exception collecting %s: %s", sectionName(section), e.what());
+        return "Unable to retrieve: " + std::string(e.what()) + "\n";
+    } catch (...) {
+        LOGE("SectionCache", "Unknown exception collecting %s", sectionName(section));
+        return "Unable to retrieve: Unknown exception occurred\n";
+    }
+}
+
+void SectionCache::setSnapshotDirectory(const std::string& directory) {
+    // 映射一次，之后在进程生命周期内直接使用映射内存
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    if (!m_snapshotPath.empty() || directory.empty()) return;
+    m_snapshotPath = PersistentSnapshot::pathIn(directory);
+    m_snapshot.load(m_snapshotPath);
+}
+
+std::string SectionCache::fill(FingerprintSection section, const std::function<std::string()>& collector) {
+    uint64_t key = PersistentSnapshot::validationKey(section);
+    {
+        std::lock_guard<std::mutex> snapshotLock(m_snapshotMutex);
+        std::string_view cached;
+        if (m_snapshot.lookup(section, key, &cached)) {
+            LOGD("SectionCache", "Section %s served from snapshot", sectionName(section));
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_keys[sectionIndex(section)] = key;
+            return std::string(cached);
+        }
+    }
+
+    std::string result = runCollector(section, collector);
+    if (!isFailure(result)) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_keys[sectionIndex(section)] = key;
+        m_dirty = true;
+    }
+    return result;
+}
+
+void SectionCache::publish(FingerprintSection section, std::promise<std::string>* promise,
+                           const std::string& result) {
+    promise->set_value(result);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        int index = sectionIndex(section);
+        m_attempted[index] = true;
+        // 失败可能是暂时的（JNIEnv不可用、文件暂时不可读）：已在等待的调用方拿到这次结果，
+        // 槽位清空后下一次调用重新收集；槽位只有认领者会替换，这里清空的一定是自己的future
+        if (isFailure(result)) m_futures[index] = std::shared_future<std::string>();
+    }
+    persistIfComplete();
+}
+
+void SectionCache::persistIfComplete() {
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        path = m_snapshotPath;
+    }
+    if (path.empty()) return;
+
+    std::vector<PersistentSnapshot::SectionBlob> blobs;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_dirty) return;
+
+        // 每个不可变分区都至少收集过一次后才写；失败或正在重新收集的分区不写入，下次启动重新收集
+        for (int i = 0; i < SECTION_COUNT; ++i) {
+            FingerprintSection section = sectionAt(i);
+            if (!isImmutableSection(section)) continue;
+            if (!m_attempted[i]) return;
+
+            const std::shared_future<std::string>& future = m_futures[i];
+            if (future.valid() && future.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                blobs.push_back({section, m_keys[i], future.get()});
+            }
+        }
+        // 之后某个失败分区重试成功时m_dirty重新置位，快照随之重写
+        m_dirty = false;
+    }
+
+    PersistentSnapshot::save(path, blobs);
+}
+
+void SectionCache::prefetch(FingerprintSection section) {
+    if (!isImmutableSection(section)) return;
+
+    std::promise<std::string> promise;
+    std::shared_future<std::string> future;
+    if (!claim(section, &future, &promise)) return;
+
+    // 预热线程没有附加到JVM，依赖JNIEnv的分区在这里失败，之后由JNI调用重新收集
+    publish(section, &promise, fill(section, [section]() { return collectSection(section, nullptr); }));
+}
+
+void SectionCache::startWarmup() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_warmupStarted) return;
+        m_warmupStarted = true;
+    }
+
+    LOGI("SectionCache", "Starting background warm-up of cheap immutable sections");
+    std::thread([this]() {
+        for (int i = 0; i < SECTION_COUNT; ++i) {
+            FingerprintSection section = sectionAt(i);
+            if ((SECTION_WARMUP_MASK & section) != 0) {
+                prefetch(section);
+            }
+        }
+        LOGI("SectionCache", "Background warm-up completed");
+    }).detach();
+}
+
+bool SectionCache::peek(FingerprintSection section, std::string* result) {
+    if (!isImmutableSection(section)) return false;
+
+    std::shared_future<std::string> future;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        future = m_futures[sectionIndex(section)];
+    }
+    if (!future.valid() || future.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return false;
+    }
+    *result = future.get();
+    return true;
+}
+
+std::string SectionCache::getOrCollect(FingerprintSection section,
+                                       const std::function<std::string()>& collector,
+                                       std::chrono::milliseconds timeout) {
+    if (!isImmutableSection(section)) {
+        return runCollector(section, collector);
+    }
+
+    std::promise<std::string> promise;
+    std::shared_future<std::string> future;
+    if (claim(section, &future, &promise)) {
+        std::string result = fill(section, collector);
+        publish(section, &promise, result);
+        return result;
+    }
+
+    if (future.wait_for(timeout) == std::future_status::ready) {
+        return future.get();
+    }
+
+    // 预热线程卡住时不能无限阻塞调用方，退回到当前线程收集
+    LOGW("SectionCache", "Timed out waiting for %s, collecting inline", sectionName(section));
+    return runCollector(section, collector);
+}
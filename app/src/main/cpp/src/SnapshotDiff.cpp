@@ -0,0 +1,130 @@
+#include "../include/SnapshotDiff.h"
+#include "../include/private/VarInt.h"
+#include <algorithm>
+
+namespace snapshot_diff {
+
+static const char kDeltaMagic[4] = {'F', 'S', 'D', '1'};
+
+static void putOp(std::string* out, uint64_t* count, Op op, uint64_t id, uint64_t* lastId,
+                  const std::string_view* value) {
+    ++*count;
+    out->push_back(static_cast<char>(op));
+    putVarint(out, id - *lastId);
+    *lastId = id;
+    if (value != nullptr) {
+        putVarint(out, value->size());
+        out->append(value->data(), value->size());
+    }
+}
+
+std::string encodeDelta(const FieldSnapshot& base, const FieldSnapshot& target) {
+    std::string ops;
+    uint64_t count = 0;
+    uint64_t lastId = 0;
+
+    const auto& from = base.entries();
+    const auto& to = target.entries();
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < from.size() || j < to.size()) {
+        if (j == to.size() || (i < from.size() && from[i].id < to[j].id)) {
+            putOp(&ops, &count, OP_REMOVE, from[i].id, &lastId, nullptr);
+            ++i;
+        } else if (i == from.size() || to[j].id < from[i].id) {
+            std::string_view value = target.valueAt(j);
+            putOp(&ops, &count, OP_ADD, to[j].id, &lastId, &value);
+            ++j;
+        } else {
+            std::string_view value = target.valueAt(j);
+            if (base.valueAt(i) != value) {
+                putOp(&ops, &count, OP_CHANGE, to[j].id, &lastId, &value);
+            }
+            ++i;
+            ++j;
+        }
+    }
+
+    std::string out(kDeltaMagic, sizeof(kDeltaMagic));
+    putVarint(&out, count);
+    out += ops;
+    return out;
+}
+
+bool applyDelta(const FieldSnapshot& base, const char* delta, size_t size, FieldSnapshot* out) {
+    const char* cursor = delta;
+    const char* end = delta + size;
+    if (size < sizeof(kDeltaMagic) || !std::equal(kDeltaMagic, kDeltaMagic + 4, delta)) {
+        return false;
+    }
+    cursor += sizeof(kDeltaMagic);
+
+    uint64_t count = 0;
+    if (!getVarint(&cursor, end, &count)) return false;
+
+    FieldSnapshot result;
+    const auto& from = base.entries();
+    size_t i = 0;
+    uint64_t id = 0;
+
+    for (uint64_t n = 0; n < count; ++n) {
+        if (cursor >= end) return false;
+        Op op = static_cast<Op>(*cursor++);
+        uint64_t idDelta = 0;
+        if (!getVarint(&cursor, end, &idDelta)) return false;
+        // 编码端的ID严格递增：差值为0（重复ID）或回绕都是损坏的增量
+        if ((n > 0 && idDelta == 0) || id + idDelta < id) return false;
+        id += idDelta;
+
+        // 复制操作之前未变化的字段
+        while (i < from.size() && from[i].id < id) {
+            result.add(from[i].id, base.valueAt(i));
+            ++i;
+        }
+        bool present = i < from.size() && from[i].id == id;
+
+        std::string_view value;
+        if (op == OP_ADD || op == OP_CHANGE) {
+            uint64_t length = 0;
+            if (!getVarint(&cursor, end, &length) || length > static_cast<uint64_t>(end - cursor)) {
+                return false;
+            }
+            value = std::string_view(cursor, length);
+            cursor += length;
+        }
+
+        switch (op) {
+            case OP_ADD:
+                if (present) return false;
+                result.add(id, value);
+                break;
+            case OP_REMOVE:
+                if (!present) return false;
+                ++i;
+                break;
+            case OP_CHANGE:
+                if (!present) return false;
+                result.add(id, value);
+                ++i;
+                break;
+            default:
+                return false;
+        }
+    }
+
+    // 操作之后不应再有数据
+    if (cursor != end) return false;
+
+    while (i < from.size()) {
+        result.add(from[i].id, base.valueAt(i));
+        ++i;
+    }
+
+    // 输入已按ID有序，finalize只做校验性的排序
+    result.finalize();
+    *out = std::move(result);
+    return true;
+}
+
+} // namespace snapshot_diff
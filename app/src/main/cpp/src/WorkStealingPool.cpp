@@ -0,0 +1,156 @@
+#include "../include/WorkStealingPool.h"
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    // 0号队列属于runAndWait()的调用线程
+    for (unsigned i = 0; i <= threads; ++i) {
+        m_queues.emplace_back(new Queue());
+    }
+    for (unsigned i = 1; i <= threads; ++i) {
+        m_threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_stop = true;
+    }
+    m_idleCv.notify_all();
+    for (std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+WorkStealingPool& WorkStealingPool::shared() {
+    // 不析构：进程退出时可能仍有分离的收集线程在使用
+    static WorkStealingPool* pool = new WorkStealingPool(
+            std::min(std::max(std::thread::hardware_concurrency(), 1u) - 1, 3u));
+    return *pool;
+}
+
+namespace {
+
+// 当前线程正在执行的任务所属的调用，spawn据此归属派生任务；嵌套runAndWait时保存并恢复
+thread_local void* t_currentRun = nullptr;
+
+} // namespace
+
+void WorkStealingPool::push(unsigned worker, Task task, Run* run) {
+    run->pending.fetch_add(1);
+    run->queued.fetch_add(1);
+    {
+        Queue& queue = *m_queues[worker];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.items.push_back(Item{std::move(task), run});
+    }
+    m_queued.fetch_add(1);
+    // 与等待方"先登记m_sleeping再检查"配对，不会丢失唤醒；
+    // 睡眠的可能是只等自己任务的调用线程，所以全部唤醒
+    if (m_sleeping.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_idleCv.notify_all();
+    }
+}
+
+void WorkStealingPool::spawn(unsigned worker, Task task) {
+    push(worker, std::move(task), static_cast<Run*>(t_currentRun));
+}
+
+bool WorkStealingPool::tryRunOne(unsigned worker, Run* only) {
+    Item item{Task(), nullptr};
+    size_t count = m_queues.size();
+    if (only == nullptr) {
+        // 后台线程：自己队列尾部，否则从其他队列头部窃取
+        {
+            Queue& own = *m_queues[worker];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.items.empty()) {
+                item = std::move(own.items.back());
+                own.items.pop_back();
+            }
+        }
+        for (size_t i = 1; i < count && !item.task; ++i) {
+            Queue& victim = *m_queues[(worker + i) % count];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.items.empty()) {
+                item = std::move(victim.items.front());
+                victim.items.pop_front();
+                m_steals.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    } else {
+        // 调用线程：只取本次调用的任务，从队列尾部向前找（通常就在尾部）
+        for (size_t i = 0; i < count && !item.task; ++i) {
+            Queue& queue = *m_queues[i];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            for (auto it = queue.items.rbegin(); it != queue.items.rend(); ++it) {
+                if (it->run != only) continue;
+                item = std::move(*it);
+                queue.items.erase(std::next(it).base());
+                break;
+            }
+        }
+    }
+    if (!item.task) return false;
+    m_queued.fetch_sub(1);
+    item.run->queued.fetch_sub(1);
+    execute(worker, std::move(item));
+    return true;
+}
+
+void WorkStealingPool::execute(unsigned worker, Item item) {
+    Run* run = item.run;
+    void* previous = t_currentRun;
+    t_currentRun = run;
+    try {
+        item.task(worker);
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        if (!run->error) run->error = std::current_exception();
+    }
+    t_currentRun = previous;
+
+    // 计数归零后调用线程可能立即返回并销毁run，之后不再访问它
+    if (run->pending.fetch_sub(1) == 1) {
+        std::lock_guard<std::mutex> lock(m_idleMutex);
+        m_idleCv.notify_all();
+    }
+}
+
+void WorkStealingPool::workerLoop(unsigned worker) {
+    while (true) {
+        if (tryRunOne(worker, nullptr)) continue;
+
+        std::unique_lock<std::mutex> lock(m_idleMutex);
+        m_sleeping.fetch_add(1);
+        m_idleCv.wait(lock, [this]() { return m_stop || m_queued.load() > 0; });
+        m_sleeping.fetch_sub(1);
+        if (m_stop) return;
+    }
+}
+
+void WorkStealingPool::runAndWait(std::vector<Task> roots) {
+    Run run;
+
+    // 初始任务轮流放入各队列，后台线程不必先窃取就能开始
+    for (size_t i = 0; i < roots.size(); ++i) {
+        push(static_cast<unsigned>(i % m_queues.size()), std::move(roots[i]), &run);
+    }
+
+    while (true) {
+        if (tryRunOne(0, &run)) continue;
+
+        std::unique_lock<std::mutex> lock(m_idleMutex);
+        if (run.pending.load() == 0) break;
+        m_sleeping.fetch_add(1);
+        m_idleCv.wait(lock, [&run]() { return run.queued.load() > 0 || run.pending.load() == 0; });
+        m_sleeping.fetch_sub(1);
+    }
+
+    // 最后一个任务在m_idleMutex下通知之后才会离开execute，这里加锁保证它已不再访问run
+    std::lock_guard<std::mutex> lock(m_idleMutex);
+    if (run.error) std::rethrow_exception(run.error);
+}
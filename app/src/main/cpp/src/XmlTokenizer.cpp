@@ -0,0 +1,139 @@
+#include "../include/XmlTokenizer.h"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#define XML_SIMD 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define XML_SIMD 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+std::atomic<bool> g_portableOnly{false};
+
+inline const char* findBytePortable(const char* p, const char* end, char c) {
+    while (p < end && *p != c) ++p;
+    return p;
+}
+
+inline const char* findAnyPortable(const char* p, const char* end, char a, char b, char c) {
+    while (p < end && *p != a && *p != b && *p != c) ++p;
+    return p;
+}
+
+#if defined(XML_SIMD)
+
+constexpr size_t kLanes = 16;
+
+// 16字节中匹配位置的掩码；SSE2每字节1位，NEON每字节4位（shrn把16x8位比较结果压成64位）
+#if defined(__SSE2__)
+using Vec = __m128i;
+constexpr unsigned kBitsPerByte = 1;
+inline Vec load(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+inline Vec splat(char c) { return _mm_set1_epi8(c); }
+inline Vec equal(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+inline Vec either(Vec a, Vec b) { return _mm_or_si128(a, b); }
+inline uint64_t matchMask(Vec v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+#else
+using Vec = uint8x16_t;
+constexpr unsigned kBitsPerByte = 4;
+inline Vec load(const char* p) { return vld1q_u8(reinterpret_cast<const uint8_t*>(p)); }
+inline Vec splat(char c) { return vdupq_n_u8(static_cast<uint8_t>(c)); }
+inline Vec equal(Vec a, Vec b) { return vceqq_u8(a, b); }
+inline Vec either(Vec a, Vec b) { return vorrq_u8(a, b); }
+inline uint64_t matchMask(Vec v) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v), 4)), 0);
+}
+#endif
+
+const char* findByteSimd(const char* p, const char* end, char c) {
+    Vec needle = splat(c);
+    for (; end - p >= static_cast<ptrdiff_t>(kLanes); p += kLanes) {
+        uint64_t mask = matchMask(equal(load(p), needle));
+        if (mask != 0) return p + __builtin_ctzll(mask) / kBitsPerByte;
+    }
+    return findBytePortable(p, end, c);
+}
+
+const char* findAnySimd(const char* p, const char* end, char a, char b, char c) {
+    Vec va = splat(a);
+    Vec vb = splat(b);
+    Vec vc = splat(c);
+    for (; end - p >= static_cast<ptrdiff_t>(kLanes); p += kLanes) {
+        Vec chunk = load(p);
+        uint64_t mask = matchMask(either(either(equal(chunk, va), equal(chunk, vb)), equal(chunk, vc)));
+        if (mask != 0) return p + __builtin_ctzll(mask) / kBitsPerByte;
+    }
+    return findAnyPortable(p, end, a, b, c);
+}
+
+#endif // XML_SIMD
+
+} // namespace
+
+namespace xml {
+
+const char* findByte(const char* p, const char* end, char c) {
+#if defined(XML_SIMD)
+    if (!g_portableOnly.load(std::memory_order_relaxed)) return findByteSimd(p, end, c);
+#endif
+    return findBytePortable(p, end, c);
+}
+
+const char* findAny(const char* p, const char* end, char a, char b, char c) {
+#if defined(XML_SIMD)
+    if (!g_portableOnly.load(std::memory_order_relaxed)) return findAnySimd(p, end, a, b, c);
+#endif
+    return findAnyPortable(p, end, a, b, c);
+}
+
+const char* kernelName() {
+#if defined(XML_SIMD)
+    if (!g_portableOnly.load(std::memory_order_relaxed)) {
+#if defined(__SSE2__)
+        return "sse2";
+#else
+        return "neon";
+#endif
+    }
+#endif
+    return "portable";
+}
+
+void setPortableOnly(bool portableOnly) {
+    g_portableOnly.store(portableOnly, std::memory_order_relaxed);
+}
+
+bool attribute(std::string_view attributes, std::string_view name, std::string_view* value) {
+    const char* p = attributes.data();
+    const char* end = p + attributes.size();
+    while (true) {
+        while (p < end && isSpace(*p)) ++p;
+        if (p == end) return false;
+
+        const char* nameStart = p;
+        while (p < end && *p != '=' && !isSpace(*p)) ++p;
+        std::string_view current(nameStart, static_cast<size_t>(p - nameStart));
+        while (p < end && isSpace(*p)) ++p;
+        // 没有值的属性（HTML风格）不是合法XML，跳过
+        if (p == end || *p != '=') continue;
+        ++p;
+        while (p < end && isSpace(*p)) ++p;
+        if (p == end || (*p != '"' && *p != '\'')) return false;
+
+        const char* valueStart = p + 1;
+        const char* valueEnd = findByte(valueStart, end, *p);
+        if (valueEnd == end) return false;
+        if (current == name) {
+            *value = std::string_view(valueStart, static_cast<size_t>(valueEnd - valueStart));
+            return true;
+        }
+        p = valueEnd + 1;
+    }
+}
+
+} // namespace xml
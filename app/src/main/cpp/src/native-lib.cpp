@@ -3,12 +3,61 @@
 #include "../include/Logger.h"
 #include "../include/SystemCollector.h"
 #include "../include/CommonCollector.h"
+#include "../include/NetlinkCollector.h"
+#include "../include/SectionCache.h"
+#include "../include/NativeExecutor.h"
+#include "../include/AsyncCollector.h"
+#include "../include/DeadlineRunner.h"
+#include "../include/CollectionService.h"
+#include "../include/FieldSnapshot.h"
+#include "../include/FieldStore.h"
+#include "../include/SnapshotDiff.h"
+#include "../include/IoBackend.h"
+#include "../include/FieldDefinitions.h"
+#include "../include/PayloadCompressor.h"
+#include "../include/PerfProfiler.h"
+#include <android/asset_manager_jni.h>
+#include <algorithm>
+#include <functional>
 #include "ifaddrs.h"
 #include <linux/if_packet.h>
 #include <netdb.h>
 #include <net/if.h>
 #include <cstdio>
 
+extern "C" JNIEXPORT jint JNICALL
+JNI_OnLoad(JavaVM* vm, void* /* reserved */) {
+    NativeExecutor::setJavaVM(vm);
+
+    JNIEnv* env = nullptr;
+    if (vm->GetEnv(reinterpret_cast<void**>(&env), JNI_VERSION_1_6) == JNI_OK) {
+        AsyncCollector::cacheCallbackMethod(env);
+    }
+    return JNI_VERSION_1_6;
+}
+
+// 新增：Application.onCreate中加载库后立即调用，传入Context.getFilesDir()作为快照目录，
+// 再在后台线程预热SECTION_WARMUP_MASK中的分区（build.prop、uname、cpuinfo、DRM ID、网络接口），首屏需要时结果已经就绪；
+// 块设备、分区清单、ELF build-id、内核配置、媒体清单虽然也不可变，但要遍历目录或解压，不在加载时预热，
+// 首次请求时收集并写入快照，之后的启动直接从快照恢复
+extern "C" JNIEXPORT void JNICALL
+Java_com_android_androiddevicefingerprint_FingerprintApplication_initNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jstring filesDir) {
+    if (filesDir != nullptr) {
+        const char* path = env->GetStringUTFChars(filesDir, nullptr);
+        if (path != nullptr) {
+            SectionCache::instance().setSnapshotDirectory(path);
+            env->ReleaseStringUTFChars(filesDir, path);
+        }
+    }
+
+#ifdef FINGERPRINT_WARMUP_ON_LOAD
+    SectionCache::instance().startWarmup();
+#endif
+}
+
 extern "C" JNIEXPORT jstring JNICALL
 Java_com_android_androiddevicefingerprint_MainActivity_stringFromJNI(
         JNIEnv* env,
@@ -25,8 +74,7 @@ Java_com_android_androiddevicefingerprint_MainActivity_getFileSystemInfoNative(
     LOGI("NativeLib", "Starting file system info collection...");
     
     try {
-        SystemCollector systemCollector(env);
-        std::string result = systemCollector.collectFileSystemInfo();
+        std::string result = CollectionService::instance().collect(SECTION_FILE_SYSTEM, env);
         
         LOGI("NativeLib", "File system info collection completed");
         return env->NewStringUTF(result.c_str());
@@ -48,8 +96,7 @@ Java_com_android_androiddevicefingerprint_MainActivity_getDrmIdNative(
     LOGI("NativeLib", "Starting DRM ID collection...");
     
     try {
-        SystemCollector systemCollector(env);
-        std::string result = systemCollector.collectDrmId();
+        std::string result = CollectionService::instance().collect(SECTION_DRM_ID, env);
         
         LOGI("NativeLib", "DRM ID collection completed");
         return env->NewStringUTF(result.c_str());
@@ -71,8 +118,7 @@ Java_com_android_androiddevicefingerprint_MainActivity_getKernelFilesInfoNative(
     LOGI("NativeLib", "Starting kernel files info collection...");
     
     try {
-        SystemCollector systemCollector(env);
-        std::string result = systemCollector.collectKernelFilesInfo();
+        std::string result = CollectionService::instance().collect(SECTION_KERNEL_FILES, env);
         
         LOGI("NativeLib", "Kernel files info collection completed");
         return env->NewStringUTF(result.c_str());
@@ -94,8 +140,7 @@ Java_com_android_androiddevicefingerprint_MainActivity_getSystemFilesInfoNative(
     LOGI("NativeLib", "Starting system files info collection...");
     
     try {
-        SystemCollector systemCollector(env);
-        std::string result = systemCollector.collectSystemFilesInfo();
+        std::string result = CollectionService::instance().collect(SECTION_SYSTEM_FILES, env);
         
         LOGI("NativeLib", "System files info collection completed");
         return env->NewStringUTF(result.c_str());
@@ -118,8 +163,7 @@ Java_com_android_androiddevicefingerprint_MainActivity_getCommonDeviceInfoNative
     LOGI("NativeLib", "Starting common device info collection...");
     
     try {
-        CommonCollector commonCollector(env);
-        std::string result = commonCollector.collect();
+        std::string result = CollectionService::instance().collect(SECTION_COMMON_DEVICE, env);
         
         LOGI("NativeLib", "Common device info collection completed");
         return env->NewStringUTF(result.c_str());
@@ -133,6 +177,33 @@ Java_com_android_androiddevicefingerprint_MainActivity_getCommonDeviceInfoNative
     }
 }
 
+// 完整指纹按输出顺序逐段交给sink（拼接成文本或直接送入压缩器），返回超时分区的掩码
+// 登录路径：各分区并行收集，整体不超过kDefaultDeadline，超时分区标记为 partial/timeout
+static uint32_t collectAllDeviceFingerprint(const std::function<void(const std::string&)>& sink) {
+    // 最后一个是CommonCollector，其余属于系统信息；全树扫描的分区各自独立，超时只影响自己
+    static const std::vector<FingerprintSection> kSections = {
+        SECTION_FILE_SYSTEM, SECTION_DRM_ID, SECTION_KERNEL_FILES, SECTION_SYSTEM_FILES,
+        SECTION_BLOCK_DEVICES, SECTION_PARTITION_INVENTORY, SECTION_ELF_BUILD_IDS, SECTION_MEDIA_MANIFESTS,
+        SECTION_KERNEL_CONFIG,
+        SECTION_COMMON_DEVICE
+    };
+    auto deadline = DeadlineRunner::Clock::now() + DeadlineRunner::kDefaultDeadline;
+    uint32_t timedOut = 0;
+    std::vector<std::string> parts = DeadlineRunner::instance().run(kSections, deadline, &timedOut);
+    
+    sink("=== " + std::string(kDumpTitle) + " ===\n\n");
+    
+    // 收集系统信息
+    sink("=== System Information Collection ===\n\n");
+    for (size_t i = 0; i + 1 < parts.size(); ++i) {
+        sink(parts[i]);
+    }
+    
+    // 收集通用设备信息（CommonCollector::collect 自带标题）
+    sink(parts.back());
+    return timedOut;
+}
+
 // 新增：获取所有设备指纹信息
 extern "C" JNIEXPORT jstring JNICALL
 Java_com_android_androiddevicefingerprint_MainActivity_getAllDeviceFingerprintNative(
@@ -142,17 +213,10 @@ Java_com_android_androiddevicefingerprint_MainActivity_getAllDeviceFingerprintNa
     LOGI("NativeLib", "Starting comprehensive device fingerprint collection...");
     
     try {
-        std::string result = "=== Comprehensive Device Fingerprint Collection ===\n\n";
-        
-        // 收集系统信息
-        SystemCollector systemCollector(env);
-        result += systemCollector.collect();
-        
-        // 收集通用设备信息
-        CommonCollector commonCollector(env);
-        result += commonCollector.collect();
+        std::string result;
+        uint32_t timedOut = collectAllDeviceFingerprint([&result](const std::string& part) { result += part; });
         
-        LOGI("NativeLib", "Comprehensive device fingerprint collection completed");
+        LOGI("NativeLib", "Comprehensive device fingerprint collection completed (timed out mask 0x%x)", timedOut);
         return env->NewStringUTF(result.c_str());
         
     } catch (const std::exception& e) {
@@ -164,6 +228,265 @@ Java_com_android_androiddevicefingerprint_MainActivity_getAllDeviceFingerprintNa
     }
 }
 
+// 新增：异步收集，结果通过 FingerprintCallback 回调，不阻塞调用线程
+extern "C" JNIEXPORT jint JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_collectAsync(
+        JNIEnv* env,
+        jobject /* this */,
+        jint mask,
+        jlong deadlineMs,
+        jobject callback) {
+
+    if (callback == nullptr) {
+        LOGE("NativeLib", "collectAsync called without callback");
+        return -1;
+    }
+
+    try {
+        return AsyncCollector::instance().submit(env, static_cast<uint32_t>(mask), deadlineMs, callback);
+    } catch (const std::exception& e) {
+        LOGE("NativeLib", "Exception in collectAsync: %s", e.what());
+        return -1;
+    }
+}
+
+// 新增：取消尚未完成的异步请求
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_cancelAsync(
+        JNIEnv* env,
+        jobject /* this */,
+        jint requestId) {
+    return AsyncCollector::instance().cancel(requestId) ? JNI_TRUE : JNI_FALSE;
+}
+
+// 参与字段差分的分区：build.prop、cpuinfo、meminfo、系统文件和网络接口
+static FieldSnapshot collectFieldSnapshot(JNIEnv* env) {
+    SystemCollector systemCollector(env);
+    CommonCollector commonCollector(env);
+    CollectionService& service = CollectionService::instance();
+
+    std::string dump = service.collect(SECTION_BUILD_PROP, env);
+    dump += service.collect(SECTION_CPU_INFO, env);
+    dump += commonCollector.getMemoryInfo();
+    dump += systemCollector.collectSystemFiles();
+    dump += service.collect(SECTION_NETLINK, env);
+
+    return FieldSnapshot::fromDump(dump);
+}
+
+static jbyteArray toByteArray(JNIEnv* env, const std::string& bytes) {
+    jbyteArray array = env->NewByteArray(static_cast<jsize>(bytes.size()));
+    if (array != nullptr) {
+        env->SetByteArrayRegion(array, 0, static_cast<jsize>(bytes.size()),
+                                reinterpret_cast<const jbyte*>(bytes.data()));
+    }
+    return array;
+}
+
+// 新增：获取结构化字段快照（首次上报使用）
+extern "C" JNIEXPORT jbyteArray JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_getFingerprintSnapshotNative(
+        JNIEnv* env,
+        jobject /* this */) {
+    try {
+        return toByteArray(env, collectFieldSnapshot(env).serialize());
+    } catch (const std::exception& e) {
+        LOGE("NativeLib", "Exception in getFingerprintSnapshotNative: %s", e.what());
+        return nullptr;
+    }
+}
+
+// 新增：相对上次快照的字段级增量，previous为空时所有字段都作为新增
+extern "C" JNIEXPORT jbyteArray JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_getFingerprintDeltaNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jbyteArray previous) {
+    try {
+        FieldSnapshot base;
+        if (previous != nullptr) {
+            std::string bytes(env->GetArrayLength(previous), '\0');
+            env->GetByteArrayRegion(previous, 0, static_cast<jsize>(bytes.size()),
+                                    reinterpret_cast<jbyte*>(&bytes[0]));
+            if (!FieldSnapshot::deserialize(bytes.data(), bytes.size(), &base)) {
+                LOGW("NativeLib", "Previous snapshot is malformed, sending full delta");
+                base = FieldSnapshot();
+            }
+        }
+
+        FieldSnapshot current = collectFieldSnapshot(env);
+        return toByteArray(env, snapshot_diff::encodeDelta(base, current));
+    } catch (const std::exception& e) {
+        LOGE("NativeLib", "Exception in getFingerprintDeltaNative: %s", e.what());
+        return nullptr;
+    }
+}
+
+// 新增：按字段编号取单个值，所在分区尚未收集时先收集；不存在时返回null
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_getFieldNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jint fieldId) {
+    try {
+        std::string value;
+        if (!FieldStore::instance().get(static_cast<FieldId>(fieldId), env, &value)) return nullptr;
+        return env->NewStringUTF(value.c_str());
+    } catch (const std::exception& e) {
+        LOGE("NativeLib", "Exception in getFieldNative: %s", e.what());
+        return nullptr;
+    }
+}
+
+// 新增：批量取字段值，结果与fieldIds一一对应，不存在的字段为null
+extern "C" JNIEXPORT jobjectArray JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_getFieldsNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jintArray fieldIds) {
+    try {
+        jsize count = fieldIds != nullptr ? env->GetArrayLength(fieldIds) : 0;
+        std::vector<jint> raw(static_cast<size_t>(count));
+        if (count > 0) env->GetIntArrayRegion(fieldIds, 0, count, raw.data());
+        std::vector<FieldId> ids(raw.size());
+        for (size_t i = 0; i < raw.size(); ++i) ids[i] = static_cast<FieldId>(raw[i]);
+
+        std::vector<bool> present;
+        std::vector<std::string> values = FieldStore::instance().getAll(ids, env, &present);
+
+        jclass stringClass = env->FindClass("java/lang/String");
+        jobjectArray result = env->NewObjectArray(count, stringClass, nullptr);
+        if (result == nullptr) return nullptr;
+        for (jsize i = 0; i < count; ++i) {
+            if (!present[i]) continue;
+            jstring value = env->NewStringUTF(values[i].c_str());
+            env->SetObjectArrayElement(result, i, value);
+            env->DeleteLocalRef(value);
+        }
+        return result;
+    } catch (const std::exception& e) {
+        LOGE("NativeLib", "Exception in getFieldsNative: %s", e.what());
+        return nullptr;
+    }
+}
+
+// 新增：从asset加载压缩字典，之后的压缩载荷都引用该字典
+extern "C" JNIEXPORT jboolean JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_loadCompressionDictionaryNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jobject assetManager) {
+    AAssetManager* manager = AAssetManager_fromJava(env, assetManager);
+    AAsset* asset = manager != nullptr ? AAssetManager_open(manager, kCompressionDictionaryAsset, AASSET_MODE_BUFFER)
+                                       : nullptr;
+    if (asset == nullptr) {
+        LOGW("NativeLib", "Compression dictionary asset %s not found", kCompressionDictionaryAsset);
+        return JNI_FALSE;
+    }
+
+    const char* data = static_cast<const char*>(AAsset_getBuffer(asset));
+    std::string dictionary;
+    if (data != nullptr) dictionary.assign(data, static_cast<size_t>(AAsset_getLength(asset)));
+    AAsset_close(asset);
+    if (dictionary.empty()) return JNI_FALSE;
+
+    LOGI("NativeLib", "Loaded %zu-byte compression dictionary (id %08x)", dictionary.size(),
+         PayloadCompressor::dictionaryId(dictionary));
+    PayloadCompressor::setDictionary(std::move(dictionary));
+    return JNI_TRUE;
+}
+
+// 新增：完整指纹的压缩载荷（zlib流，头部带字典ID），收集器输出逐段送入压缩器
+extern "C" JNIEXPORT jbyteArray JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_getCompressedFingerprintNative(
+        JNIEnv* env,
+        jobject /* this */) {
+    try {
+        PayloadCompressor compressor;
+        collectAllDeviceFingerprint([&compressor](const std::string& part) { compressor.append(part); });
+        uint64_t rawBytes = compressor.inputBytes();
+        std::string payload = compressor.finish();
+        if (payload.empty()) {
+            LOGE("NativeLib", "Fingerprint compression failed");
+            return nullptr;
+        }
+        LOGI("NativeLib", "Compressed fingerprint %llu -> %zu bytes", static_cast<unsigned long long>(rawBytes),
+             payload.size());
+        return toByteArray(env, payload);
+    } catch (const std::exception& e) {
+        LOGE("NativeLib", "Exception in getCompressedFingerprintNative: %s", e.what());
+        return nullptr;
+    }
+}
+
+// 新增：切换文件I/O后端（0 = libc，1 = raw syscall）
+extern "C" JNIEXPORT void JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_setIoBackendNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jint backend) {
+    setActiveIoBackend(backend == 1 ? IoBackendType::RAW_SYSCALL : IoBackendType::LIBC);
+}
+
+// 新增：对比两种I/O后端扫描全部系统文件的耗时
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_benchmarkIoBackendsNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jint iterations) {
+    try {
+        SystemCollector systemCollector(env);
+        return env->NewStringUTF(systemCollector.benchmarkIoBackends(iterations).c_str());
+    } catch (const std::exception& e) {
+        LOGE("NativeLib", "Exception in benchmarkIoBackendsNative: %s", e.what());
+        return env->NewStringUTF(("Unable to retrieve: " + std::string(e.what())).c_str());
+    }
+}
+
+// 新增：各分区的超时预算和累计超时次数
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_getSectionOverrunsNative(
+        JNIEnv* env,
+        jobject /* this */) {
+    return env->NewStringUTF(DeadlineRunner::instance().overrunReport().c_str());
+}
+
+// 新增：开关分区收集的性能计数器剖析（之后所有未命中缓存的收集都会计入）
+extern "C" JNIEXPORT void JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_setProfilingNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean enabled) {
+    PerfProfiler::instance().setEnabled(enabled == JNI_TRUE);
+}
+
+// 新增：已累计的剖析结果，表格或JSON
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_getProfileReportNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jboolean json) {
+    PerfProfiler& profiler = PerfProfiler::instance();
+    return env->NewStringUTF((json == JNI_TRUE ? profiler.json() : profiler.table()).c_str());
+}
+
+// 新增：绕过缓存逐个收集mask中的分区并返回性能计数器
+extern "C" JNIEXPORT jstring JNICALL
+Java_com_android_androiddevicefingerprint_MainActivity_profileSectionsNative(
+        JNIEnv* env,
+        jobject /* this */,
+        jint mask,
+        jint iterations,
+        jboolean json) {
+    try {
+        return env->NewStringUTF(profileSections(static_cast<uint32_t>(mask), std::max(1, static_cast<int>(iterations)),
+                                                 env, json == JNI_TRUE).c_str());
+    } catch (const std::exception& e) {
+        LOGE("NativeLib", "Exception in profileSectionsNative: %s", e.what());
+        return env->NewStringUTF(("Unable to retrieve: " + std::string(e.what())).c_str());
+    }
+}
+
 // 简化版本的 MAC 地址获取函数
 int listmacaddrs() {
     struct ifaddrs *ifap, *ifaptr;
@@ -232,8 +555,7 @@ Java_com_android_androiddevicefingerprint_MainActivity_getMacAddressInfoNative(
     LOGI("NativeLib", "Starting MAC address info collection...");
     
     try {
-        int result = listmacaddrs();
-        std::string resultStr = "MAC address collection completed with result: " + std::to_string(result);
+        std::string resultStr = CollectionService::instance().collect(SECTION_NETLINK, env);
         
         LOGI("NativeLib", "MAC address info collection completed");
         return env->NewStringUTF(resultStr.c_str());
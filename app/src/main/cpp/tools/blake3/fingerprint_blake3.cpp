@@ -0,0 +1,265 @@
+/**
+ * fingerprint_blake3 - 设备端BLAKE3树哈希的主机基准和文件哈希
+ *
+ * 用法:
+ *   fingerprint_blake3 bench [--size MB] [--iterations N] [-j 最大线程数]
+ *       在内存缓冲区上测量单核吞吐（标量实现与SIMD实现对比），
+ *       以及1..N个线程并行计算子树时的吞吐和加速比；所有配置的哈希必须一致
+ *   fingerprint_blake3 hash [-j 线程数] 文件...
+ *       与设备端相同的分窗口mmap哈希，输出 "哈希  大小  路径"（与b3sum的哈希值相同）
+ *   fingerprint_blake3 check
+ *       已知答案测试：官方测试向量的输入（第i字节为 i % 251），覆盖块边界、父节点合并和
+ *       跨mmap窗口的长度；标量和SIMD实现分别验证一次性、分段update、线程池并行和文件哈希
+ */
+#include "Blake3.h"
+#include "ContentHash.h"
+#include "IoBackend.h"
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::string toHex(const uint8_t* digest) {
+    char hex[Blake3Hasher::kOutLen * 2 + 1];
+    for (size_t i = 0; i < Blake3Hasher::kOutLen; ++i) {
+        snprintf(hex + i * 2, 3, "%02x", digest[i]);
+    }
+    return hex;
+}
+
+// 返回最快一次的吞吐（GB/s）
+double measure(const std::vector<uint8_t>& data, unsigned iterations, WorkStealingPool* pool, std::string* hex) {
+    double best = 0;
+    for (unsigned i = 0; i < iterations; ++i) {
+        uint8_t digest[Blake3Hasher::kOutLen];
+        Clock::time_point start = Clock::now();
+        if (pool != nullptr) {
+            Blake3Hasher::hashParallel(data.data(), data.size(), *pool, digest);
+        } else {
+            Blake3Hasher::hash(data.data(), data.size(), digest);
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        best = std::max(best, data.size() / seconds / 1e9);
+        *hex = toHex(digest);
+    }
+    return best;
+}
+
+int benchCommand(size_t megabytes, unsigned iterations, unsigned maxThreads) {
+    std::vector<uint8_t> data(megabytes * 1024 * 1024);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i % 251);
+    }
+    printf("input %zu MB, kernel %s, %u hardware threads\n", megabytes, Blake3Hasher::kernelName(),
+           std::thread::hardware_concurrency());
+
+    std::string reference;
+    Blake3Hasher::setPortableOnly(true);
+    double portable = measure(data, iterations, nullptr, &reference);
+    Blake3Hasher::setPortableOnly(false);
+    std::string hex;
+    double simd = measure(data, iterations, nullptr, &hex);
+    printf("1 thread  portable: %.2f GB/s\n", portable);
+    printf("1 thread  %-8s: %.2f GB/s (%.2fx)\n", Blake3Hasher::kernelName(), simd, simd / portable);
+    if (hex != reference) {
+        fprintf(stderr, "Kernel mismatch: %s vs %s\n", hex.c_str(), reference.c_str());
+        return 1;
+    }
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        WorkStealingPool pool(threads - 1);
+        double throughput = measure(data, iterations, &pool, &hex);
+        printf("%2u threads tree   : %.2f GB/s (%.2fx), %llu steals\n", threads, throughput, throughput / simd,
+               static_cast<unsigned long long>(pool.stealCount()));
+        if (hex != reference) {
+            fprintf(stderr, "Parallel mismatch with %u threads: %s vs %s\n", threads, hex.c_str(), reference.c_str());
+            return 1;
+        }
+    }
+    printf("blake3 %s\n", reference.c_str());
+    return 0;
+}
+
+// 期望值来自BLAKE3参考实现；0到102400字节与官方 test_vectors.json 的默认模式哈希相同
+struct KnownAnswer {
+    size_t length;
+    const char* hex;
+};
+
+constexpr KnownAnswer kKnownAnswers[] = {
+    {0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262"},
+    {1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213"},
+    {1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11"},
+    {1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7"},
+    {1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444"},
+    {2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a"},
+    {2049, "5f4d72f40d7a5f82b15ca2b2e44b1de3c2ef86c426c95c1af0b6879522563030"},
+    {3072, "b98cb0ff3623be03326b373de6b9095218513e64f1ee2edd2525c7ad1e5cffd2"},
+    {3073, "7124b49501012f81cc7f11ca069ec9226cecb8a2c850cfe644e327d22d3e1cd3"},
+    {4096, "015094013f57a5277b59d8475c0501042c0b642e531b0a1c8f58d2163229e969"},
+    {4097, "9b4052b38f1c5fc8b1f9ff7ac7b27cd242487b3d890d15c96a1c25b8aa0fb995"},
+    {5120, "9cadc15fed8b5d854562b26a9536d9707cadeda9b143978f319ab34230535833"},
+    {5121, "628bd2cb2004694adaab7bbd778a25df25c47b9d4155a55f8fbd79f2fe154cff"},
+    {6144, "3e2e5b74e048f3add6d21faab3f83aa44d3b2278afb83b80b3c35164ebeca205"},
+    {6145, "f1323a8631446cc50536a9f705ee5cb619424d46887f3c376c695b70e0f0507f"},
+    {7168, "61da957ec2499a95d6b8023e2b0e604ec7f6b50e80a9678b89d2628e99ada77a"},
+    {7169, "a003fc7a51754a9b3c7fae0367ab3d782dccf28855a03d435f8cfe74605e7817"},
+    {8192, "aae792484c8efe4f19e2ca7d371d8c467ffb10748d8a5a1ae579948f718a2a63"},
+    {8193, "bab6c09cb8ce8cf459261398d2e7aef35700bf488116ceb94a36d0f5f1b7bc3b"},
+    {16384, "f875d6646de28985646f34ee13be9a576fd515f76b5b0a26bb324735041ddde4"},
+    {31744, "62b6960e1a44bcc1eb1a611a8d6235b6b4b78f32e7abc4fb4c6cdcce94895c47"},
+    {102400, "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085"},
+    // 多MiB：多个并行粒度，最后一个跨越32MiB的mmap窗口
+    {1048576, "74cb441fd087764ca9c3694da742ebe30cbeb3060a17009ca81825c7a8d10343"},
+    {3145745, "26003c63117013de5d02be76e5e32a2f75bfbc075f17180fd5f9f0b4752d2bfe"},
+    {8388608, "1adedad9735f565ac6e22dab203db63b960c27098f2c0f0fda9adf9238d4c0c9"},
+    {34603013, "66aaf2c9f075966d92a24c822ef27968135e98c6902b9d3a06723d59bdb6e44d"},
+};
+
+int checkCommand() {
+    size_t maxLength = 0;
+    for (const KnownAnswer& answer : kKnownAnswers) maxLength = std::max(maxLength, answer.length);
+    std::vector<uint8_t> data(maxLength);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i % 251);
+    }
+
+    char path[] = "/tmp/fingerprint_blake3.XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        fprintf(stderr, "Unable to create temporary file\n");
+        return 1;
+    }
+    close(fd);
+
+    WorkStealingPool pool(3);
+    int failures = 0;
+    auto expect = [&failures](const std::string& got, const KnownAnswer& answer, const char* how) {
+        if (got != answer.hex) {
+            fprintf(stderr, "FAIL %zu bytes, %s, %s: %s\n", answer.length, Blake3Hasher::kernelName(), how,
+                    got.c_str());
+            ++failures;
+        }
+    };
+
+    for (bool portable : {true, false}) {
+        Blake3Hasher::setPortableOnly(portable);
+        for (const KnownAnswer& answer : kKnownAnswers) {
+            uint8_t digest[Blake3Hasher::kOutLen];
+            Blake3Hasher::hash(data.data(), answer.length, digest);
+            expect(toHex(digest), answer, "one-shot");
+
+            Blake3Hasher::hashParallel(data.data(), answer.length, pool, digest);
+            expect(toHex(digest), answer, "parallel");
+
+            // 分段大小不与块和分块对齐，覆盖缓冲区拼接路径
+            Blake3Hasher hasher;
+            const size_t steps[] = {1, 63, 64, 65, 1023, 1024, 1025, 4095, 70000};
+            for (size_t offset = 0, step = 0; offset < answer.length; ++step) {
+                size_t length = std::min(steps[step % std::size(steps)], answer.length - offset);
+                hasher.update(data.data() + offset, length);
+                offset += length;
+            }
+            expect(hasher.finalizeHex(), answer, "incremental");
+
+            if (answer.length >= Blake3Hasher::kGranuleBytes) {
+                FILE* file = fopen(path, "wb");
+                bool written = file != nullptr && fwrite(data.data(), 1, answer.length, file) == answer.length;
+                if (file != nullptr) fclose(file);
+                content_hash::Result result;
+                if (!written || !content_hash::hashFile<LibcIo>(path, pool, &result)) {
+                    fprintf(stderr, "FAIL %zu bytes: cannot hash temporary file\n", answer.length);
+                    ++failures;
+                } else {
+                    expect(result.blake3, answer, "file");
+                }
+            }
+        }
+    }
+    Blake3Hasher::setPortableOnly(false);
+    unlink(path);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    printf("ok: %zu vectors, portable and %s\n", std::size(kKnownAnswers), Blake3Hasher::kernelName());
+    return 0;
+}
+
+int hashCommand(unsigned threads, const std::vector<std::string>& files) {
+    WorkStealingPool pool(threads > 0 ? threads - 1 : 0);
+    int status = 0;
+    for (const std::string& file : files) {
+        content_hash::Result result;
+        Clock::time_point start = Clock::now();
+        if (!content_hash::hashFile<LibcIo>(file.c_str(), pool, &result)) {
+            fprintf(stderr, "%s: %s\n", file.c_str(), strerror(errno));
+            status = 1;
+            continue;
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        printf("%s  %llu  %s\n", result.blake3.c_str(), static_cast<unsigned long long>(result.size), file.c_str());
+        fprintf(stderr, "  %.2f ms, %.2f GB/s\n", seconds * 1e3, result.size / seconds / 1e9);
+    }
+    return status;
+}
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s bench [--size MB] [--iterations N] [-j max-threads]\n"
+            "       %s hash [-j threads] <file>...\n"
+            "       %s check\n",
+            program, program, program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string_view command(argv[1]);
+    size_t megabytes = 256;
+    unsigned iterations = 5;
+    unsigned threads = std::max(std::thread::hardware_concurrency(), 1u);
+    std::vector<std::string> positional;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        bool hasValue = i + 1 < argc;
+        if (arg == "--size" && hasValue) {
+            megabytes = static_cast<size_t>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--iterations" && hasValue) {
+            iterations = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "-j" && hasValue) {
+            threads = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            positional.emplace_back(arg);
+        }
+    }
+
+    if (command == "bench") {
+        return benchCommand(megabytes, iterations, threads);
+    } else if (command == "hash" && !positional.empty()) {
+        return hashCommand(threads, positional);
+    } else if (command == "check") {
+        return checkCommand();
+    }
+    usage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,58 @@
+#ifndef DUMP_RECORDS_H
+#define DUMP_RECORDS_H
+
+#include "../../include/FieldDefinitions.h"
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+/**
+ * 把输入切成一条条指纹记录
+ * 每条记录以 "=== Comprehensive Device Fingerprint Collection ===" 行开始；
+ * 不含该标题的文件（例如单独保存的分区输出）整体视为一条记录
+ */
+namespace dump_records {
+
+// 返回起点不早于from的第一个记录标题行位置，没有时返回npos
+inline size_t findRecordStart(std::string_view text, size_t from) {
+    constexpr std::string_view kTitle(kDumpTitle);
+    for (size_t pos = text.find(kTitle, from + 4); pos != std::string_view::npos;
+         pos = text.find(kTitle, pos + 1)) {
+        if (text.compare(pos - 4, 4, "=== ") == 0 && (pos == 4 || text[pos - 5] == '\n')) {
+            return pos - 4;
+        }
+    }
+    return std::string_view::npos;
+}
+
+template <typename Fn>
+void forEachRecord(std::string_view text, Fn&& fn) {
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = findRecordStart(text, begin + 1);
+        if (end == std::string_view::npos) end = text.size();
+        std::string_view record = text.substr(begin, end - begin);
+        if (record.find_first_not_of(" \t\r\n") != std::string_view::npos) fn(record);
+        begin = end;
+    }
+}
+
+// 在记录边界上把大文件切成约chunkSize的块，供多个线程分别解析
+inline std::vector<std::string_view> splitAtRecords(std::string_view text, size_t chunkSize) {
+    std::vector<std::string_view> chunks;
+    size_t begin = 0;
+    while (begin < text.size()) {
+        size_t end = text.size();
+        if (text.size() - begin > chunkSize) {
+            end = findRecordStart(text, begin + chunkSize);
+            if (end == std::string_view::npos) end = text.size();
+        }
+        chunks.push_back(text.substr(begin, end - begin));
+        begin = end;
+    }
+    return chunks;
+}
+
+} // namespace dump_records
+
+#endif // DUMP_RECORDS_H
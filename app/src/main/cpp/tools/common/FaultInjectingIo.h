@@ -0,0 +1,261 @@
+#ifndef FAULT_INJECTING_IO_H
+#define FAULT_INJECTING_IO_H
+
+#include "../../include/IoBackend.h"
+#include <sys/statfs.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 主机端注入延迟和错误的I/O装饰器，接口与LibcIo/RawSyscallIo相同，可直接作为 file_reader 等模板的Io参数
+ * 规则按路径前缀匹配（最长前缀优先），打开文件时记下fd对应的规则，之后的read/pread按fd查找。
+ * 每次操作独立抽样：延迟分布、短读（只返回请求长度的一部分）、EINTR（open/read）、EAGAIN（read）。
+ * 同一线程连续注入的错误不超过maxConsecutiveErrors次，模拟瞬时故障而不是永久失败。
+ * fd规则在每次openAt时覆盖，ScopedFd直接调用::close也不会留下错误的映射。
+ * 只在主机工具中使用，设备端不编译。
+ */
+namespace fault_io {
+
+enum Operation : uint32_t {
+    OP_OPEN = 1 << 0,
+    OP_READ = 1 << 1,     // read / pread
+    OP_STAT = 1 << 2,     // access / fstat / statfs
+    OP_ALL = OP_OPEN | OP_READ | OP_STAT,
+};
+
+struct Latency {
+    enum Kind { NONE, FIXED, UNIFORM, LOGNORMAL };
+    Kind kind = NONE;
+    double a = 0;   // FIXED：微秒；UNIFORM：下限；LOGNORMAL：中位数（微秒）
+    double b = 0;   // UNIFORM：上限；LOGNORMAL：sigma
+    double spikeProbability = 0;    // 以此概率额外叠加spikeUs（长尾）
+    double spikeUs = 0;
+
+    static Latency fixed(double us) { return {FIXED, us, 0, 0, 0}; }
+    static Latency uniform(double lowUs, double highUs) { return {UNIFORM, lowUs, highUs, 0, 0}; }
+    static Latency lognormal(double medianUs, double sigma) { return {LOGNORMAL, medianUs, sigma, 0, 0}; }
+    Latency withSpikes(double probability, double us) const {
+        Latency latency = *this;
+        latency.spikeProbability = probability;
+        latency.spikeUs = us;
+        return latency;
+    }
+};
+
+struct Rule {
+    std::string prefix;
+    uint32_t operations = OP_ALL;
+    Latency latency;
+    double shortReadProbability = 0;
+    double eintrProbability = 0;
+    double eagainProbability = 0;
+    int maxConsecutiveErrors = 2;
+};
+
+struct Counters {
+    std::atomic<uint64_t> operations{0};
+    std::atomic<uint64_t> delayedUs{0};
+    std::atomic<uint64_t> shortReads{0};
+    std::atomic<uint64_t> eintr{0};
+    std::atomic<uint64_t> eagain{0};
+};
+
+// 全局配置：先setRules再开始I/O，运行期间不要修改
+class Injector {
+public:
+    static Injector& instance() {
+        static Injector injector;
+        return injector;
+    }
+
+    void setRules(std::vector<Rule> rules, std::string root = std::string()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rules = std::move(rules);
+        m_root = std::move(root);
+        m_fdRules.clear();
+    }
+
+    const Counters& counters() const { return m_counters; }
+    void resetCounters() {
+        m_counters.operations = 0;
+        m_counters.delayedUs = 0;
+        m_counters.shortReads = 0;
+        m_counters.eintr = 0;
+        m_counters.eagain = 0;
+    }
+
+    // 路径匹配的规则，没有时返回-1；规则前缀相对于root（夹具目录）
+    int matchPath(const char* path) const {
+        std::string_view view(path);
+        if (!m_root.empty() && view.compare(0, m_root.size(), m_root) == 0) view.remove_prefix(m_root.size());
+        int best = -1;
+        size_t bestLength = 0;
+        for (size_t i = 0; i < m_rules.size(); ++i) {
+            const std::string& prefix = m_rules[i].prefix;
+            if (view.compare(0, prefix.size(), prefix) == 0 && (best < 0 || prefix.size() > bestLength)) {
+                best = static_cast<int>(i);
+                bestLength = prefix.size();
+            }
+        }
+        return best;
+    }
+
+    void bindFd(int fd, int rule) {
+        if (fd < 0) return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (rule < 0) {
+            m_fdRules.erase(fd);
+        } else {
+            m_fdRules[fd] = rule;
+        }
+    }
+
+    int ruleForFd(int fd) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_fdRules.find(fd);
+        return it == m_fdRules.end() ? -1 : it->second;
+    }
+
+    // 操作前调用：按规则等待，并决定是否注入错误（返回errno，0表示照常执行）
+    int before(int rule, Operation operation) {
+        if (rule < 0) return 0;
+        const Rule& config = m_rules[static_cast<size_t>(rule)];
+        if ((config.operations & operation) == 0) return 0;
+        m_counters.operations.fetch_add(1, std::memory_order_relaxed);
+        delay(config.latency);
+
+        // access/statfs只注入延迟：调用方不重试，EINTR会被当成文件不存在
+        thread_local int consecutiveErrors = 0;
+        if (operation != OP_STAT && consecutiveErrors < config.maxConsecutiveErrors) {
+            if (chance(config.eintrProbability)) {
+                ++consecutiveErrors;
+                m_counters.eintr.fetch_add(1, std::memory_order_relaxed);
+                return EINTR;
+            }
+            if (operation == OP_READ && chance(config.eagainProbability)) {
+                ++consecutiveErrors;
+                m_counters.eagain.fetch_add(1, std::memory_order_relaxed);
+                return EAGAIN;
+            }
+        }
+        consecutiveErrors = 0;
+        return 0;
+    }
+
+    // 短读：把请求长度缩短为 [1, count)
+    size_t readLength(int rule, size_t count) {
+        if (rule < 0 || count < 2) return count;
+        if (!chance(m_rules[static_cast<size_t>(rule)].shortReadProbability)) return count;
+        m_counters.shortReads.fetch_add(1, std::memory_order_relaxed);
+        return 1 + static_cast<size_t>(random()() % (count - 1));
+    }
+
+private:
+    Injector() = default;
+
+    static std::mt19937_64& random() {
+        static std::atomic<uint64_t> seeds{0x5eed};
+        thread_local std::mt19937_64 generator(seeds.fetch_add(0x9e3779b97f4a7c15ULL));
+        return generator;
+    }
+
+    static bool chance(double probability) {
+        if (probability <= 0) return false;
+        return std::uniform_real_distribution<double>(0, 1)(random()) < probability;
+    }
+
+    void delay(const Latency& latency) {
+        double us = 0;
+        switch (latency.kind) {
+            case Latency::NONE:      break;
+            case Latency::FIXED:     us = latency.a; break;
+            case Latency::UNIFORM:   us = std::uniform_real_distribution<double>(latency.a, latency.b)(random()); break;
+            case Latency::LOGNORMAL: us = std::lognormal_distribution<double>(std::log(latency.a), latency.b)(random());
+                                     break;
+        }
+        if (chance(latency.spikeProbability)) us += latency.spikeUs;
+        if (us < 1) return;
+        m_counters.delayedUs.fetch_add(static_cast<uint64_t>(us), std::memory_order_relaxed);
+        std::this_thread::sleep_for(std::chrono::microseconds(static_cast<int64_t>(us)));
+    }
+
+    std::mutex m_mutex;
+    std::vector<Rule> m_rules;
+    std::string m_root;
+    std::unordered_map<int, int> m_fdRules;
+    Counters m_counters;
+};
+
+} // namespace fault_io
+
+template <typename Inner>
+struct FaultInjectingIo {
+    static int openAt(int dirfd, const char* path, int flags, mode_t mode = 0) {
+        fault_io::Injector& injector = fault_io::Injector::instance();
+        int rule = injector.matchPath(path);
+        if (int error = injector.before(rule, fault_io::OP_OPEN)) return fail(error);
+        int fd = Inner::openAt(dirfd, path, flags, mode);
+        injector.bindFd(fd, rule);
+        return fd;
+    }
+    static ssize_t read(int fd, void* buffer, size_t count) {
+        fault_io::Injector& injector = fault_io::Injector::instance();
+        int rule = injector.ruleForFd(fd);
+        if (int error = injector.before(rule, fault_io::OP_READ)) return fail(error);
+        return Inner::read(fd, buffer, injector.readLength(rule, count));
+    }
+    static ssize_t pread(int fd, void* buffer, size_t count, off64_t offset) {
+        fault_io::Injector& injector = fault_io::Injector::instance();
+        int rule = injector.ruleForFd(fd);
+        if (int error = injector.before(rule, fault_io::OP_READ)) return fail(error);
+        return Inner::pread(fd, buffer, injector.readLength(rule, count), offset);
+    }
+    static int fstat(int fd, struct stat64* st) {
+        fault_io::Injector& injector = fault_io::Injector::instance();
+        if (int error = injector.before(injector.ruleForFd(fd), fault_io::OP_STAT)) return fail(error);
+        return Inner::fstat(fd, st);
+    }
+    static int fstatAt(int dirfd, const char* path, struct stat64* st, int flags) {
+        return Inner::fstatAt(dirfd, path, st, flags);
+    }
+    static int close(int fd) {
+        fault_io::Injector::instance().bindFd(fd, -1);
+        return Inner::close(fd);
+    }
+    static int access(const char* path) {
+        fault_io::Injector& injector = fault_io::Injector::instance();
+        if (int error = injector.before(injector.matchPath(path), fault_io::OP_STAT)) return fail(error);
+        return Inner::access(path);
+    }
+    static int statfs(const char* path, struct statfs64* buffer) {
+        fault_io::Injector& injector = fault_io::Injector::instance();
+        if (int error = injector.before(injector.matchPath(path), fault_io::OP_STAT)) return fail(error);
+        return Inner::statfs(path, buffer);
+    }
+    static int uname(struct utsname* buffer) { return Inner::uname(buffer); }
+    static void* mmap(size_t length, int prot, int flags, int fd, off64_t offset) {
+        return Inner::mmap(length, prot, flags, fd, offset);
+    }
+    static int munmap(void* address, size_t length) { return Inner::munmap(address, length); }
+    static int madvise(void* address, size_t length, int advice) { return Inner::madvise(address, length, advice); }
+    static ssize_t getdents64(int fd, void* buffer, size_t size) { return Inner::getdents64(fd, buffer, size); }
+
+private:
+    static int fail(int error) {
+        errno = error;
+        return -1;
+    }
+};
+
+#endif // FAULT_INJECTING_IO_H
@@ -0,0 +1,85 @@
+#ifndef FLAT_ID_MAP_H
+#define FLAT_ID_MAP_H
+
+#include "../../include/HashUtils.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 字段ID -> uint32 的开放寻址表
+ * clear() 只递增代数，不触碰槽位，适合每条记录都要重置的计数场景
+ */
+class FlatIdMap {
+public:
+    explicit FlatIdMap(size_t capacity = 256) {
+        size_t slots = 16;
+        while (slots < capacity * 2) slots <<= 1;
+        m_slots.resize(slots);
+    }
+
+    // 返回id对应值的引用，不存在时以initial插入
+    uint32_t& at(uint64_t id, uint32_t initial = 0, bool* inserted = nullptr) {
+        if ((m_size + 1) * 2 > m_slots.size()) grow();
+
+        size_t mask = m_slots.size() - 1;
+        for (size_t i = mix64(id) & mask;; i = (i + 1) & mask) {
+            Slot& slot = m_slots[i];
+            if (slot.generation != m_generation) {
+                slot = {id, initial, m_generation};
+                ++m_size;
+                if (inserted != nullptr) *inserted = true;
+                return slot.value;
+            }
+            if (slot.id == id) {
+                if (inserted != nullptr) *inserted = false;
+                return slot.value;
+            }
+        }
+    }
+
+    const uint32_t* find(uint64_t id) const {
+        size_t mask = m_slots.size() - 1;
+        for (size_t i = mix64(id) & mask;; i = (i + 1) & mask) {
+            const Slot& slot = m_slots[i];
+            if (slot.generation != m_generation) return nullptr;
+            if (slot.id == id) return &slot.value;
+        }
+    }
+
+    void clear() {
+        m_size = 0;
+        if (++m_generation == 0) {
+            // 代数回绕时才真正清空
+            for (Slot& slot : m_slots) slot.generation = 0;
+            m_generation = 1;
+        }
+    }
+
+    size_t size() const { return m_size; }
+
+private:
+    struct Slot {
+        uint64_t id = 0;
+        uint32_t value = 0;
+        uint32_t generation = 0;
+    };
+
+    void grow() {
+        std::vector<Slot> old;
+        old.swap(m_slots);
+        m_slots.resize(old.size() * 2);
+        uint32_t generation = m_generation;
+        m_generation = 1;
+        m_size = 0;
+        for (const Slot& slot : old) {
+            if (slot.generation == generation) at(slot.id, slot.value);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    uint32_t m_generation = 1;
+    size_t m_size = 0;
+};
+
+#endif // FLAT_ID_MAP_H
@@ -0,0 +1,117 @@
+#ifndef HOST_IO_H
+#define HOST_IO_H
+
+#include "../../include/private/ScopedFd.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * 主机工具的文件输入输出
+ * 输入一律只读mmap，解析出的字段视图直接指向映射内存
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { unmap(); }
+
+    MappedFile(MappedFile&& other) noexcept : m_data(other.m_data), m_size(other.m_size) {
+        other.m_data = nullptr;
+        other.m_size = 0;
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // populate为true时预先建立整个映射的页表（常驻查询的索引文件），否则按顺序扫描预读
+    bool open(const std::string& path, bool populate = false) {
+        unmap();
+        ScopedFd fd(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+        if (!fd.isValid()) {
+            fprintf(stderr, "Failed to open %s, errno: %d\n", path.c_str(), errno);
+            return false;
+        }
+
+        struct stat st;
+        if (fstat(fd.get(), &st) != 0) return false;
+        if (st.st_size == 0) return true;
+
+        void* data = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ,
+                          MAP_PRIVATE | (populate ? MAP_POPULATE : 0), fd.get(), 0);
+        if (data == MAP_FAILED) {
+            fprintf(stderr, "mmap failed: %s, errno: %d\n", path.c_str(), errno);
+            return false;
+        }
+        // 输入只顺序扫描一遍，让内核加大预读
+        madvise(data, static_cast<size_t>(st.st_size), populate ? MADV_RANDOM : MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(data);
+        m_size = static_cast<size_t>(st.st_size);
+        return true;
+    }
+
+    std::string_view view() const { return std::string_view(m_data, m_size); }
+    size_t size() const { return m_size; }
+
+private:
+    void unmap() {
+        if (m_data != nullptr) {
+            munmap(const_cast<char*>(m_data), m_size);
+            m_data = nullptr;
+            m_size = 0;
+        }
+    }
+
+    const char* m_data = nullptr;
+    size_t m_size = 0;
+};
+
+// 递归展开目录中的普通文件，结果排序以保证输出稳定
+inline void collectInputFiles(const std::string& path, std::vector<std::string>* out) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        fprintf(stderr, "Skipping %s, errno: %d\n", path.c_str(), errno);
+        return;
+    }
+    if (S_ISREG(st.st_mode)) {
+        out->push_back(path);
+        return;
+    }
+    if (!S_ISDIR(st.st_mode)) return;
+
+    DIR* dir = opendir(path.c_str());
+    if (dir == nullptr) return;
+    std::vector<std::string> children;
+    while (struct dirent* entry = readdir(dir)) {
+        std::string_view name(entry->d_name);
+        if (name == "." || name == "..") continue;
+        children.push_back(path + "/" + entry->d_name);
+    }
+    closedir(dir);
+
+    std::sort(children.begin(), children.end());
+    for (const auto& child : children) {
+        collectInputFiles(child, out);
+    }
+}
+
+inline bool writeAll(int fd, const void* data, size_t size, off_t offset) {
+    const char* cursor = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = pwrite(fd, cursor, size, offset);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        cursor += n;
+        size -= static_cast<size_t>(n);
+        offset += n;
+    }
+    return true;
+}
+
+#endif // HOST_IO_H
@@ -0,0 +1,40 @@
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+inline unsigned defaultThreadCount() {
+    unsigned count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+/**
+ * 在threads个线程上动态分配 [0, count) 的任务
+ * fn(index, worker) 中worker是线程编号，可用来索引每线程的暂存区
+ */
+template <typename Fn>
+void parallelFor(size_t count, unsigned threads, Fn&& fn) {
+    threads = static_cast<unsigned>(std::min<size_t>(std::max(threads, 1u), std::max<size_t>(count, 1)));
+    std::atomic<size_t> next{0};
+    auto worker = [&](unsigned id) {
+        for (size_t i = next.fetch_add(1, std::memory_order_relaxed); i < count;
+             i = next.fetch_add(1, std::memory_order_relaxed)) {
+            fn(i, id);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned id = 1; id < threads; ++id) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+}
+
+#endif // PARALLEL_FOR_H
@@ -0,0 +1,66 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+#include "ParallelFor.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * 按64位键的多线程LSD基数排序（稳定）
+ * 每趟8位：各线程统计自己分块的直方图，前缀和得到每块每个桶的写入位置，再并行分发。
+ * 某一趟所有键的该字节都相同时跳过该趟（只有高位变化的键排序更快）
+ */
+template <typename T, typename KeyFn>
+void parallelRadixSort(std::vector<T>* data, unsigned threads, KeyFn key) {
+    constexpr size_t kBuckets = 256;
+    size_t count = data->size();
+    if (count < 2) return;
+
+    size_t chunks = std::max<size_t>(1, std::min<size_t>(threads, count / 4096 + 1));
+    size_t chunkSize = (count + chunks - 1) / chunks;
+    std::vector<T> buffer(count);
+    std::vector<size_t> histograms(chunks * kBuckets);
+
+    T* source = data->data();
+    T* target = buffer.data();
+    for (uint32_t shift = 0; shift < 64; shift += 8) {
+        std::fill(histograms.begin(), histograms.end(), 0);
+        parallelFor(chunks, threads, [&](size_t chunk, unsigned) {
+            size_t* histogram = &histograms[chunk * kBuckets];
+            size_t end = std::min(count, (chunk + 1) * chunkSize);
+            for (size_t i = chunk * chunkSize; i < end; ++i) {
+                ++histogram[(key(source[i]) >> shift) & 0xff];
+            }
+        });
+
+        // 按 (桶, 分块) 顺序排出写入位置，保证稳定
+        size_t offset = 0;
+        size_t nonEmptyBuckets = 0;
+        for (size_t bucket = 0; bucket < kBuckets; ++bucket) {
+            size_t before = offset;
+            for (size_t chunk = 0; chunk < chunks; ++chunk) {
+                size_t n = histograms[chunk * kBuckets + bucket];
+                histograms[chunk * kBuckets + bucket] = offset;
+                offset += n;
+            }
+            nonEmptyBuckets += offset != before;
+        }
+        if (nonEmptyBuckets == 1) continue;
+
+        parallelFor(chunks, threads, [&](size_t chunk, unsigned) {
+            size_t* position = &histograms[chunk * kBuckets];
+            size_t end = std::min(count, (chunk + 1) * chunkSize);
+            for (size_t i = chunk * chunkSize; i < end; ++i) {
+                target[position[(key(source[i]) >> shift) & 0xff]++] = source[i];
+            }
+        });
+        std::swap(source, target);
+    }
+
+    if (source != data->data()) {
+        data->swap(buffer);
+    }
+}
+
+#endif // RADIX_SORT_H
@@ -0,0 +1,340 @@
+/**
+ * fingerprint_dict - 指纹压缩字典的训练与评估
+ *
+ * 用法:
+ *   fingerprint_dict train -o fingerprint.dict [--seed seed_strings.txt] [--size N] [--max-samples M] 输入...
+ *       从代表性指纹中选出跨记录重复出现的行和字段名，按 出现记录数 x 长度 打分，
+ *       分数高的放在字典末尾（离数据最近，引用距离最短）
+ *   fingerprint_dict bench [-d fingerprint.dict] [-l 级别] [--iterations N] 输入...
+ *       每条记录作为一个独立载荷压缩，对比有无字典的压缩率和每个载荷的耗时
+ *   fingerprint_dict compress -d fingerprint.dict 输入 输出
+ *   fingerprint_dict decompress -d fingerprint.dict 输入 输出
+ *
+ * 字典最多32KB（zlib窗口大小），超过部分不会被引用。
+ */
+#include "PayloadCompressor.h"
+#include "../common/DumpRecords.h"
+#include "../common/HostIo.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// zlib只引用窗口内最后 32KB - MIN_LOOKAHEAD 字节的字典
+constexpr size_t kMaxDictionarySize = 32768 - 262;
+
+bool readText(const std::string& path, std::string* out) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        fprintf(stderr, "Cannot read %s\n", path.c_str());
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << in.rdbuf();
+    *out = buffer.str();
+    return true;
+}
+
+bool writeText(const std::string& path, const std::string& data) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::string unescape(std::string_view line) {
+    std::string out;
+    for (size_t i = 0; i < line.size(); ++i) {
+        if (line[i] == '\\' && i + 1 < line.size() && (line[i + 1] == 'n' || line[i + 1] == 't')) {
+            out += line[++i] == 'n' ? '\n' : '\t';
+        } else {
+            out += line[i];
+        }
+    }
+    return out;
+}
+
+std::vector<std::string> loadSeeds(const std::string& path) {
+    std::vector<std::string> seeds;
+    for (const char* prop : kKeyBuildProperties) {
+        seeds.push_back(std::string(prop) + "=");
+    }
+    std::string text;
+    if (path.empty() || !readText(path, &text)) return seeds;
+
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos) eol = text.size();
+        std::string_view line(text.data() + pos, eol - pos);
+        pos = eol + 1;
+        if (!line.empty() && line[0] != '#') seeds.push_back(unescape(line));
+    }
+    return seeds;
+}
+
+// 记录中可以复用的片段：整行（含换行）以及行首到分隔符之后的字段名
+void forEachCandidate(std::string_view record, std::unordered_set<std::string_view>* out) {
+    size_t pos = 0;
+    while (pos < record.size()) {
+        size_t eol = record.find('\n', pos);
+        size_t end = eol == std::string_view::npos ? record.size() : eol + 1;
+        std::string_view line = record.substr(pos, end - pos);
+        pos = end;
+        if (line.size() < 4) continue;
+
+        out->insert(line);
+        size_t sep = line.find_first_of("=:");
+        if (sep != std::string_view::npos && sep > 0) {
+            size_t valueStart = line.find_first_not_of(" \t", sep + 1);
+            if (valueStart == std::string_view::npos) valueStart = sep + 1;
+            if (valueStart < line.size() - 1) out->insert(line.substr(0, valueStart));
+        }
+    }
+}
+
+std::vector<std::string_view> loadRecords(const std::vector<std::string>& inputs, std::vector<MappedFile>* files,
+                                          size_t maxRecords) {
+    std::vector<std::string> paths;
+    for (const auto& input : inputs) {
+        collectInputFiles(input, &paths);
+    }
+    files->resize(paths.size());
+
+    std::vector<std::string_view> records;
+    for (size_t i = 0; i < paths.size() && records.size() < maxRecords; ++i) {
+        if (!(*files)[i].open(paths[i])) continue;
+        dump_records::forEachRecord((*files)[i].view(), [&](std::string_view record) {
+            if (records.size() < maxRecords) records.push_back(record);
+        });
+    }
+    return records;
+}
+
+int trainCommand(const std::string& output, const std::string& seedPath, size_t size, size_t maxSamples,
+                 const std::vector<std::string>& inputs) {
+    std::vector<MappedFile> files;
+    std::vector<std::string_view> records = loadRecords(inputs, &files, maxSamples);
+
+    // 出现该片段的记录数
+    std::unordered_map<std::string_view, uint32_t> documentFrequency;
+    std::unordered_set<std::string_view> candidates;
+    for (std::string_view record : records) {
+        candidates.clear();
+        forEachCandidate(record, &candidates);
+        for (std::string_view candidate : candidates) {
+            ++documentFrequency[candidate];
+        }
+    }
+
+    struct Scored {
+        std::string text;
+        double score;
+    };
+    std::vector<Scored> scored;
+
+    // 固定字符串视为出现在每条记录中
+    std::vector<std::string> seeds = loadSeeds(seedPath);
+    double seedFrequency = std::max<double>(1, static_cast<double>(records.size()));
+    for (const auto& seed : seeds) {
+        scored.push_back({seed, seedFrequency * seed.size()});
+    }
+
+    // 只出现在一条记录里的内容（boot_id、序列号等）对其他载荷没有用
+    uint32_t minFrequency = std::max<uint32_t>(2, static_cast<uint32_t>(records.size() / 100));
+    for (const auto& item : documentFrequency) {
+        if (item.second >= minFrequency) {
+            scored.push_back({std::string(item.first), static_cast<double>(item.second) * item.first.size()});
+        }
+    }
+    std::sort(scored.begin(), scored.end(), [](const Scored& a, const Scored& b) {
+        return a.score != b.score ? a.score > b.score : a.text < b.text;
+    });
+
+    // 按分数从高到低选取，已被选中内容包含的片段跳过
+    std::vector<const Scored*> selected;
+    std::string covered;
+    size_t total = 0;
+    for (const Scored& item : scored) {
+        if (total + item.text.size() > size) continue;
+        if (covered.find(item.text) != std::string::npos) continue;
+        selected.push_back(&item);
+        covered += item.text;
+        covered += '\0';
+        total += item.text.size();
+        if (total + 4 > size) break;
+    }
+
+    // 分数低的在前，分数最高的紧贴字典末尾
+    std::string dictionary;
+    dictionary.reserve(total);
+    for (auto it = selected.rbegin(); it != selected.rend(); ++it) {
+        dictionary += (*it)->text;
+    }
+    if (!writeText(output, dictionary)) return 1;
+
+    fprintf(stderr, "Trained %zu-byte dictionary (id %08x) from %zu records: %zu seeds, %zu fragments selected\n",
+            dictionary.size(), PayloadCompressor::dictionaryId(dictionary), records.size(), seeds.size(),
+            selected.size());
+    return 0;
+}
+
+int benchCommand(const std::string& dictionaryPath, int level, unsigned iterations,
+                 const std::vector<std::string>& inputs) {
+    std::string dictionaryText;
+    if (!dictionaryPath.empty() && !readText(dictionaryPath, &dictionaryText)) return 1;
+    auto dictionary = std::make_shared<const std::string>(dictionaryText);
+
+    std::vector<MappedFile> files;
+    std::vector<std::string_view> records = loadRecords(inputs, &files, SIZE_MAX);
+    if (records.empty()) {
+        fprintf(stderr, "No records found\n");
+        return 1;
+    }
+
+    struct Result {
+        uint64_t bytes = 0;
+        double compressSeconds = 0;
+        double decompressSeconds = 0;
+    };
+    auto measure = [&](const std::shared_ptr<const std::string>& dict, Result* result) -> bool {
+        std::string restored;
+        for (std::string_view record : records) {
+            std::string compressed;
+            auto begin = Clock::now();
+            for (unsigned i = 0; i < iterations; ++i) {
+                // 按收集器的输出方式分段送入
+                PayloadCompressor compressor(dict, level);
+                for (size_t pos = 0; pos < record.size(); pos += 1024) {
+                    compressor.append(record.substr(pos, 1024));
+                }
+                compressed = compressor.finish();
+            }
+            auto middle = Clock::now();
+            for (unsigned i = 0; i < iterations; ++i) {
+                if (!PayloadCompressor::decompress(compressed, dict.get(), &restored) || restored != record) {
+                    fprintf(stderr, "Round trip failed\n");
+                    return false;
+                }
+            }
+            auto end = Clock::now();
+            result->bytes += compressed.size();
+            result->compressSeconds += std::chrono::duration<double>(middle - begin).count();
+            result->decompressSeconds += std::chrono::duration<double>(end - middle).count();
+        }
+        return true;
+    };
+
+    Result plain;
+    Result withDictionary;
+    if (!measure(nullptr, &plain) || !measure(dictionary, &withDictionary)) return 1;
+
+    uint64_t rawBytes = 0;
+    for (std::string_view record : records) {
+        rawBytes += record.size();
+    }
+    double payloads = static_cast<double>(records.size()) * iterations;
+    printf("%zu payloads, avg %.0f bytes, zlib level %d, dictionary %zu bytes (id %08x)\n", records.size(),
+           static_cast<double>(rawBytes) / records.size(), level, dictionary->size(),
+           PayloadCompressor::dictionaryId(*dictionary));
+    printf("%-16s %10s %8s %14s %16s\n", "", "avg bytes", "ratio", "compress us", "decompress us");
+    printf("%-16s %10.0f %7.2fx %14.1f %16.1f\n", "no dictionary", static_cast<double>(plain.bytes) / records.size(),
+           static_cast<double>(rawBytes) / plain.bytes, plain.compressSeconds / payloads * 1e6,
+           plain.decompressSeconds / payloads * 1e6);
+    printf("%-16s %10.0f %7.2fx %14.1f %16.1f\n", "dictionary",
+           static_cast<double>(withDictionary.bytes) / records.size(),
+           static_cast<double>(rawBytes) / withDictionary.bytes, withDictionary.compressSeconds / payloads * 1e6,
+           withDictionary.decompressSeconds / payloads * 1e6);
+    return 0;
+}
+
+int convertCommand(bool compress, const std::string& dictionaryPath, const std::string& input,
+                   const std::string& output) {
+    std::string dictionary;
+    std::string data;
+    if ((!dictionaryPath.empty() && !readText(dictionaryPath, &dictionary)) || !readText(input, &data)) return 1;
+
+    std::string result;
+    if (compress) {
+        PayloadCompressor compressor(std::make_shared<const std::string>(dictionary));
+        compressor.append(data);
+        result = compressor.finish();
+    } else if (!PayloadCompressor::decompress(data, &dictionary, &result)) {
+        fprintf(stderr, "Cannot decompress %s (dictionary id %08x)\n", input.c_str(),
+                PayloadCompressor::dictionaryId(dictionary));
+        return 1;
+    }
+    return writeText(output, result) ? 0 : 1;
+}
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s train -o <dict> [--seed <file>] [--size N] [--max-samples M] <file|dir>...\n"
+            "       %s bench [-d <dict>] [-l level] [--iterations N] <file|dir>...\n"
+            "       %s compress|decompress -d <dict> <input> <output>\n",
+            program, program, program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string_view command(argv[1]);
+    std::string output;
+    std::string dictionary;
+    std::string seed;
+    size_t size = kMaxDictionarySize;
+    size_t maxSamples = 20000;
+    int level = PayloadCompressor::kDefaultLevel;
+    unsigned iterations = 20;
+    std::vector<std::string> positional;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            output = argv[++i];
+        } else if (arg == "-d" && hasValue) {
+            dictionary = argv[++i];
+        } else if (arg == "--seed" && hasValue) {
+            seed = argv[++i];
+        } else if (arg == "--size" && hasValue) {
+            size = std::min(kMaxDictionarySize, static_cast<size_t>(std::max(256, atoi(argv[++i]))));
+        } else if (arg == "--max-samples" && hasValue) {
+            maxSamples = std::max<size_t>(1, strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "-l" && hasValue) {
+            level = std::min(9, std::max(1, atoi(argv[++i])));
+        } else if (arg == "--iterations" && hasValue) {
+            iterations = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            positional.emplace_back(arg);
+        }
+    }
+
+    if (command == "train" && !output.empty()) {
+        return trainCommand(output, seed, size, maxSamples, positional);
+    } else if (command == "bench" && !positional.empty()) {
+        return benchCommand(dictionary, level, iterations, positional);
+    } else if ((command == "compress" || command == "decompress") && positional.size() == 2) {
+        return convertCommand(command == "compress", dictionary, positional[0], positional[1]);
+    }
+    usage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,224 @@
+/**
+ * fingerprint_delta - 字段级快照增量的主机工具
+ *
+ * 用法:
+ *   fingerprint_delta diff 旧指纹文本 新指纹文本
+ *       解析两份收集器输出，输出字段数、新增/删除/修改数和增量大小，并校验增量能还原新快照
+ *   fingerprint_delta check
+ *       encodeDelta/applyDelta 往返用例（空快照、相同快照、增删改、随机快照对），
+ *       以及截断、错误magic、未知操作、重复ID、与base不一致、尾部多余字节等损坏增量必须被拒绝
+ */
+#include "SnapshotDiff.h"
+#include "private/VarInt.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+bool sameSnapshot(const FieldSnapshot& a, const FieldSnapshot& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a.entries()[i].id != b.entries()[i].id || a.valueAt(i) != b.valueAt(i)) return false;
+    }
+    return true;
+}
+
+FieldSnapshot makeSnapshot(const std::vector<std::pair<uint64_t, std::string>>& fields) {
+    FieldSnapshot snapshot;
+    for (const auto& field : fields) snapshot.add(field.first, field.second);
+    snapshot.finalize();
+    return snapshot;
+}
+
+bool roundTrip(const FieldSnapshot& base, const FieldSnapshot& target, std::string* delta) {
+    *delta = snapshot_diff::encodeDelta(base, target);
+    FieldSnapshot applied;
+    return snapshot_diff::applyDelta(base, delta->data(), delta->size(), &applied) && sameSnapshot(applied, target);
+}
+
+// 手工构造增量：ops为 (操作, ID差值, 值)；值为nullptr时不写长度和值
+struct RawOp {
+    uint8_t op;
+    uint64_t idDelta;
+    const char* value;
+};
+
+std::string rawDelta(const std::vector<RawOp>& ops, uint64_t count) {
+    std::string delta("FSD1", 4);
+    putVarint(&delta, count);
+    for (const RawOp& op : ops) {
+        delta.push_back(static_cast<char>(op.op));
+        putVarint(&delta, op.idDelta);
+        if (op.value != nullptr) {
+            putVarint(&delta, strlen(op.value));
+            delta += op.value;
+        }
+    }
+    return delta;
+}
+
+bool accepted(const FieldSnapshot& base, const std::string& delta) {
+    FieldSnapshot out;
+    return snapshot_diff::applyDelta(base, delta.data(), delta.size(), &out);
+}
+
+int runCheck() {
+    int failures = 0;
+    auto expect = [&failures](bool ok, const char* what) {
+        if (!ok) {
+            fprintf(stderr, "FAIL %s\n", what);
+            ++failures;
+        }
+    };
+
+    FieldSnapshot empty;
+    FieldSnapshot base = makeSnapshot({{10, "google/raven/raven:14"}, {20, "5.10.157"}, {30, "aarch64"},
+                                       {40, ""}, {1000000, "serial"}});
+    std::string delta;
+
+    // 空快照与相同快照
+    expect(roundTrip(empty, empty, &delta), "empty -> empty");
+    expect(roundTrip(base, base, &delta) && delta.size() == 5, "identical snapshots give an empty delta");
+    expect(roundTrip(empty, base, &delta), "empty -> full (all adds)");
+    expect(roundTrip(base, empty, &delta), "full -> empty (all removes)");
+
+    // 增删改混合，包括空值和修改成空值
+    FieldSnapshot target = makeSnapshot({{5, "new-first"}, {10, "google/raven/raven:15"}, {30, "aarch64"},
+                                         {40, "now-set"}, {50, ""}, {1000000, ""}, {UINT64_MAX, "last"}});
+    expect(roundTrip(base, target, &delta), "mixed add/remove/change");
+    expect(roundTrip(target, base, &delta), "mixed, reversed");
+
+    // 真实格式的文本
+    FieldSnapshot before = FieldSnapshot::fromDump(
+            "=== /system/build.prop ===\nro.build.fingerprint=google/raven/raven:14/UP1A\n"
+            "ro.build.version.incremental=10754064\n\n=== CPU Information ===\nprocessor\t: 0\nprocessor\t: 1\n");
+    FieldSnapshot after = FieldSnapshot::fromDump(
+            "=== /system/build.prop ===\nro.build.fingerprint=google/raven/raven:14/UP1B\n"
+            "ro.build.version.security_patch=2023-11-05\n\n=== CPU Information ===\nprocessor\t: 0\n");
+    expect(roundTrip(before, after, &delta), "dump round trip");
+
+    // 随机快照对
+    std::mt19937_64 random(1);
+    for (int round = 0; round < 2000; ++round) {
+        std::vector<std::pair<uint64_t, std::string>> a;
+        std::vector<std::pair<uint64_t, std::string>> b;
+        size_t universe = 1 + random() % 64;
+        for (size_t id = 0; id < universe; ++id) {
+            uint64_t fieldId = round % 2 ? id * 0x9E3779B97F4A7C15ull : id;
+            std::string value(random() % 24, static_cast<char>('a' + random() % 26));
+            unsigned mode = random() % 5;
+            if (mode != 0) a.emplace_back(fieldId, value);
+            if (mode == 2) value += "x";
+            if (mode != 1) b.emplace_back(fieldId, value);
+        }
+        if (!roundTrip(makeSnapshot(a), makeSnapshot(b), &delta)) {
+            fprintf(stderr, "FAIL random round %d\n", round);
+            ++failures;
+            break;
+        }
+    }
+
+    // 损坏的增量
+    std::string valid = snapshot_diff::encodeDelta(base, target);
+    for (size_t length = 0; length < valid.size(); ++length) {
+        if (accepted(base, valid.substr(0, length))) {
+            fprintf(stderr, "FAIL truncated delta (%zu of %zu bytes) accepted\n", length, valid.size());
+            ++failures;
+        }
+    }
+    std::string badMagic = valid;
+    badMagic[3] = '2';
+    expect(!accepted(base, badMagic), "bad magic rejected");
+    expect(!accepted(base, valid + std::string(1, '\0')), "trailing bytes rejected");
+    expect(!accepted(base, rawDelta({{9, 10, "x"}}, 1)), "unknown op rejected");
+    expect(!accepted(base, rawDelta({{snapshot_diff::OP_ADD, 10, "x"}}, 1)), "add of existing field rejected");
+    expect(!accepted(base, rawDelta({{snapshot_diff::OP_REMOVE, 11, nullptr}}, 1)), "remove of missing field rejected");
+    expect(!accepted(base, rawDelta({{snapshot_diff::OP_CHANGE, 11, "x"}}, 1)), "change of missing field rejected");
+    expect(!accepted(base, rawDelta({{snapshot_diff::OP_ADD, 11, "x"}, {snapshot_diff::OP_ADD, 0, "y"}}, 2)),
+           "repeated field id rejected");
+    expect(!accepted(base, rawDelta({{snapshot_diff::OP_ADD, 11, "x"}}, 2)), "op count beyond data rejected");
+    expect(!accepted(base, rawDelta({{snapshot_diff::OP_ADD, UINT64_MAX, "x"}, {snapshot_diff::OP_ADD, 12, "y"}}, 2)),
+           "wrapping field id rejected");
+    std::string longValue = rawDelta({{snapshot_diff::OP_ADD, 11, "abc"}}, 1);
+    longValue[longValue.size() - 4] = 100;
+    expect(!accepted(base, longValue), "value length beyond data rejected");
+    expect(accepted(base, rawDelta({{snapshot_diff::OP_ADD, 11, "x"}, {snapshot_diff::OP_REMOVE, 9, nullptr}}, 2)),
+           "hand-built valid delta accepted");
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    printf("ok\n");
+    return 0;
+}
+
+bool readText(const char* path, std::string* text) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return false;
+    std::ostringstream buffer;
+    buffer << input.rdbuf();
+    *text = buffer.str();
+    return true;
+}
+
+int runDiff(const char* oldPath, const char* newPath) {
+    std::string oldText;
+    std::string newText;
+    if (!readText(oldPath, &oldText) || !readText(newPath, &newText)) {
+        fprintf(stderr, "Unable to read input\n");
+        return 1;
+    }
+    FieldSnapshot base = FieldSnapshot::fromDump(oldText);
+    FieldSnapshot target = FieldSnapshot::fromDump(newText);
+    std::string delta;
+    if (!roundTrip(base, target, &delta)) {
+        fprintf(stderr, "Delta does not reproduce the new snapshot\n");
+        return 1;
+    }
+
+    size_t added = 0;
+    size_t removed = 0;
+    size_t changed = 0;
+    for (size_t i = 0; i < target.size(); ++i) {
+        std::string_view value;
+        if (!base.find(target.entries()[i].id, &value)) {
+            ++added;
+        } else if (value != target.valueAt(i)) {
+            ++changed;
+        }
+    }
+    for (size_t i = 0; i < base.size(); ++i) {
+        std::string_view value;
+        if (!target.find(base.entries()[i].id, &value)) ++removed;
+    }
+    printf("fields %zu -> %zu, added %zu, removed %zu, changed %zu\n", base.size(), target.size(), added, removed,
+           changed);
+    printf("delta %zu bytes, full snapshot %zu bytes\n", delta.size(), target.serialize().size());
+    return 0;
+}
+
+int usage(const char* program) {
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s diff OLD NEW\n"
+            "  %s check\n",
+            program, program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+    std::string_view command(argv[1]);
+    if (command == "diff" && argc == 4) return runDiff(argv[2], argv[3]);
+    if (command == "check") return runCheck();
+    return usage(argv[0]);
+}
@@ -0,0 +1,36 @@
+#ifndef DEVICE_DIGEST_H
+#define DEVICE_DIGEST_H
+
+#include "../../include/DumpParser.h"
+#include "../../include/FieldSnapshot.h"
+#include "../../include/HashUtils.h"
+#include <string_view>
+
+/**
+ * 设备摘要：只取OTA、重启和MAC随机化后都不变的字段
+ *   存储设备cid/UFS序列号、soc序列号、DRM ID，以及机型/设备名/平台/厂商
+ * 各字段的哈希相加后再打散，与字段在输出中的顺序无关
+ */
+inline bool isDigestField(std::string_view section, std::string_view key) {
+    if (key == "Content") {
+        return section == "/sys/block/mmcblk0/device/cid" || section == "/sys/devices/soc0/serial_number";
+    }
+    // BlockDeviceCollector 的每设备记录（"--- sda ---"）
+    if (key == "cid" || key == "ufs_serial_number") return true;
+    return (section == "DRM ID Information" && key == "DRM ID") || key == "ro.product.model" ||
+           key == "ro.product.device" || key == "ro.board.platform" || key == "ro.product.manufacturer";
+}
+
+inline uint64_t deviceDigest(std::string_view record) {
+    uint64_t sum = 0;
+    uint64_t fields = 0;
+    dump::forEachField(record.data(), record.size(),
+                       [&](std::string_view section, std::string_view key, std::string_view value) {
+        if (!isDigestField(section, key) || value.find("Unable to retrieve") != std::string_view::npos) return;
+        sum += mix64(FieldSnapshot::fieldId(section, key) ^ mix64(fnv1a64(value.data(), value.size())));
+        ++fields;
+    });
+    return mix64(sum ^ mix64(fields));
+}
+
+#endif // DEVICE_DIGEST_H
@@ -0,0 +1,137 @@
+#include "DigestStore.h"
+#include <algorithm>
+
+DigestStore::~DigestStore() {
+    stopBackgroundMerge();
+}
+
+bool DigestStore::open(const std::string& path) {
+    auto base = std::make_shared<EliasFanoIndex>();
+    if (!base->open(path)) return false;
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    m_path = path;
+    m_base = std::move(base);
+    return true;
+}
+
+uint64_t DigestStore::baseSize() const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return m_base ? m_base->size() : 0;
+}
+
+bool DigestStore::lookup(uint64_t digest, uint64_t* id) const {
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+
+    auto it = m_active.find(digest);
+    if (it != m_active.end()) {
+        *id = it->second;
+        return true;
+    }
+    if (m_frozen) {
+        it = m_frozen->find(digest);
+        if (it != m_frozen->end()) {
+            *id = it->second;
+            return true;
+        }
+    }
+    return m_base && m_base->lookup(digest, id);
+}
+
+void DigestStore::insert(uint64_t digest, uint64_t id) {
+    uint64_t existing;
+    if (lookup(digest, &existing)) return;
+
+    size_t activeSize;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        m_active.emplace(digest, id);
+        activeSize = m_active.size();
+    }
+    if (m_mergeThreshold > 0 && activeSize >= m_mergeThreshold) {
+        m_mergeWakeup.notify_one();
+    }
+}
+
+void DigestStore::startBackgroundMerge(size_t mergeThreshold) {
+    std::lock_guard<std::mutex> lock(m_mergeMutex);
+    if (m_mergeThread.joinable()) return;
+    m_mergeThreshold = mergeThreshold;
+    m_stopping = false;
+    m_mergeThread = std::thread(&DigestStore::mergeLoop, this);
+}
+
+void DigestStore::stopBackgroundMerge() {
+    {
+        std::lock_guard<std::mutex> lock(m_mergeMutex);
+        if (!m_mergeThread.joinable()) return;
+        m_stopping = true;
+    }
+    m_mergeWakeup.notify_one();
+    m_mergeThread.join();
+}
+
+void DigestStore::mergeLoop() {
+    std::unique_lock<std::mutex> lock(m_mergeMutex);
+    while (!m_stopping) {
+        m_mergeWakeup.wait_for(lock, std::chrono::seconds(1));
+        if (m_stopping) break;
+
+        size_t activeSize;
+        {
+            std::shared_lock<std::shared_mutex> tableLock(m_mutex);
+            activeSize = m_active.size();
+        }
+        if (activeSize < m_mergeThreshold) continue;
+
+        lock.unlock();
+        mergeOnce();
+        lock.lock();
+    }
+}
+
+bool DigestStore::mergeOnce() {
+    std::shared_ptr<const EliasFanoIndex> base;
+    std::shared_ptr<const DeltaTable> frozen;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_mutex);
+        frozen = std::make_shared<const DeltaTable>(std::move(m_active));
+        m_active = DeltaTable();
+        m_frozen = frozen;
+        base = m_base;
+    }
+
+    std::vector<DigestEntry> delta;
+    delta.reserve(frozen->size());
+    for (const auto& item : *frozen) {
+        delta.push_back({item.first, item.second});
+    }
+    std::sort(delta.begin(), delta.end(),
+              [](const DigestEntry& a, const DigestEntry& b) { return a.digest < b.digest; });
+
+    // 基础索引按序解码，与排序后的增量归并；插入时已去重，两边不会有相同摘要
+    std::vector<DigestEntry> merged;
+    merged.reserve((base ? base->size() : 0) + delta.size());
+    auto next = delta.begin();
+    if (base) {
+        base->forEach([&](const DigestEntry& entry) {
+            while (next != delta.end() && next->digest < entry.digest) merged.push_back(*next++);
+            merged.push_back(entry);
+        });
+    }
+    merged.insert(merged.end(), next, delta.end());
+
+    auto replacement = std::make_shared<EliasFanoIndex>();
+    bool ok = EliasFanoIndex::write(merged, m_path) && replacement->open(m_path);
+
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    if (ok) {
+        m_base = std::move(replacement);
+        m_merges.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        // 写出失败时把冻结的条目放回活动表，下次再试
+        m_active.insert(frozen->begin(), frozen->end());
+    }
+    m_frozen.reset();
+    return ok;
+}
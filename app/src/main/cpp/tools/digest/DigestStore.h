@@ -0,0 +1,60 @@
+#ifndef DIGEST_STORE_H
+#define DIGEST_STORE_H
+
+#include "EliasFanoIndex.h"
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+
+/**
+ * 可在线插入的摘要存储
+ *
+ * 不可变的Elias-Fano基础索引 + 内存中的增量表。增量表超过阈值后由后台线程冻结，
+ * 与基础索引归并写出新文件，映射后原子替换；冻结期间的新插入进入新的增量表。
+ * 查找顺序：活动增量 -> 冻结增量 -> 基础索引，都不分配堆内存。
+ */
+class DigestStore {
+public:
+    DigestStore() = default;
+    ~DigestStore();
+
+    bool open(const std::string& path);
+
+    bool lookup(uint64_t digest, uint64_t* id) const;
+
+    // 已存在的摘要保持原ID
+    void insert(uint64_t digest, uint64_t id);
+
+    // 启动后台归并线程，增量表达到mergeThreshold条时触发
+    void startBackgroundMerge(size_t mergeThreshold);
+    void stopBackgroundMerge();
+
+    uint64_t mergeCount() const { return m_merges.load(std::memory_order_relaxed); }
+    uint64_t baseSize() const;
+
+private:
+    using DeltaTable = std::unordered_map<uint64_t, uint64_t>;
+
+    void mergeLoop();
+    bool mergeOnce();
+
+    std::string m_path;
+    std::shared_ptr<const EliasFanoIndex> m_base;
+
+    mutable std::shared_mutex m_mutex;
+    DeltaTable m_active;
+    std::shared_ptr<const DeltaTable> m_frozen;
+
+    std::mutex m_mergeMutex;
+    std::condition_variable m_mergeWakeup;
+    std::thread m_mergeThread;
+    size_t m_mergeThreshold = 0;
+    bool m_stopping = false;
+    std::atomic<uint64_t> m_merges{0};
+};
+
+#endif // DIGEST_STORE_H
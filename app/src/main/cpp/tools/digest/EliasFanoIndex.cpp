@@ -0,0 +1,179 @@
+#include "EliasFanoIndex.h"
+#include <cstring>
+
+namespace {
+
+constexpr char kIndexMagic[4] = {'F', 'P', 'E', 'D'};
+constexpr uint32_t kIndexVersion = 1;
+
+struct EliasFanoHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t count;
+    uint32_t lowBits;
+    uint32_t sampleRate;
+    uint64_t maxHigh;
+    uint64_t lowWords;
+    uint64_t upperWords;
+    uint64_t sampleCount;
+};
+
+uint32_t lowBitsFor(uint64_t count) {
+    if (count == 0) return 0;
+    uint32_t bitLength = 64 - static_cast<uint32_t>(__builtin_clzll(count));
+    return 64 - bitLength;
+}
+
+} // namespace
+
+constexpr uint64_t EliasFanoIndex::kSelectSampleRate;
+
+bool EliasFanoIndex::write(const std::vector<DigestEntry>& entries, const std::string& path) {
+    uint64_t count = entries.size();
+    uint32_t lowBits = lowBitsFor(count);
+    uint64_t lowMask = lowBits == 0 ? 0 : (uint64_t{1} << lowBits) - 1;
+    uint64_t maxHigh = count == 0 ? 0 : entries.back().digest >> lowBits;
+
+    uint64_t upperBits = count + maxHigh + 1;
+    std::vector<uint64_t> low((count * lowBits + 63) / 64 + 1, 0);
+    std::vector<uint64_t> upper((upperBits + 63) / 64, 0);
+    std::vector<uint64_t> ids(count);
+
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t digest = entries[i].digest;
+        if (lowBits > 0) {
+            uint64_t bit = i * lowBits;
+            uint64_t value = digest & lowMask;
+            low[bit / 64] |= value << (bit % 64);
+            if (bit % 64 + lowBits > 64) low[bit / 64 + 1] |= value >> (64 - bit % 64);
+        }
+        uint64_t position = (digest >> lowBits) + i;
+        upper[position / 64] |= uint64_t{1} << (position % 64);
+        ids[i] = entries[i].id;
+    }
+
+    std::vector<uint64_t> samples;
+    uint64_t zeros = 0;
+    for (uint64_t position = 0; position < upperBits; ++position) {
+        if (upper[position / 64] & (uint64_t{1} << (position % 64))) continue;
+        if (zeros % kSelectSampleRate == 0) samples.push_back(position);
+        ++zeros;
+    }
+
+    EliasFanoHeader header = {};
+    memcpy(header.magic, kIndexMagic, sizeof(header.magic));
+    header.version = kIndexVersion;
+    header.count = count;
+    header.lowBits = lowBits;
+    header.sampleRate = kSelectSampleRate;
+    header.maxHigh = maxHigh;
+    header.lowWords = low.size();
+    header.upperWords = upper.size();
+    header.sampleCount = samples.size();
+
+    std::string tmpPath = path + ".tmp";
+    ScopedFd fd(::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+    if (!fd.isValid()) {
+        fprintf(stderr, "Failed to create %s, errno: %d\n", tmpPath.c_str(), errno);
+        return false;
+    }
+
+    off_t offset = 0;
+    auto append = [&](const void* data, size_t size) {
+        bool ok = writeAll(fd.get(), data, size, offset);
+        offset += static_cast<off_t>(size);
+        return ok;
+    };
+    bool ok = append(&header, sizeof(header)) && append(low.data(), low.size() * sizeof(uint64_t)) &&
+              append(upper.data(), upper.size() * sizeof(uint64_t)) &&
+              append(samples.data(), samples.size() * sizeof(uint64_t)) &&
+              append(ids.data(), ids.size() * sizeof(uint64_t));
+
+    // 写完再原子替换，已映射旧文件的读者不受影响
+    if (!ok || fsync(fd.get()) != 0 || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        fprintf(stderr, "Failed to write %s, errno: %d\n", path.c_str(), errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool EliasFanoIndex::open(const std::string& path) {
+    if (!m_file.open(path, true)) return false;
+
+    std::string_view data = m_file.view();
+    EliasFanoHeader header;
+    if (data.size() < sizeof(header)) return false;
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, kIndexMagic, sizeof(header.magic)) != 0 || header.version != kIndexVersion ||
+        header.sampleRate != kSelectSampleRate || header.lowBits != lowBitsFor(header.count) ||
+        data.size() != sizeof(header) + (header.lowWords + header.upperWords + header.sampleCount + header.count) *
+                                             sizeof(uint64_t)) {
+        fprintf(stderr, "%s: not a compatible digest index\n", path.c_str());
+        return false;
+    }
+
+    m_count = header.count;
+    m_lowBits = header.lowBits;
+    m_maxHigh = header.maxHigh;
+    m_upperWords = header.upperWords;
+    m_low = reinterpret_cast<const uint64_t*>(data.data() + sizeof(header));
+    m_upper = m_low + header.lowWords;
+    m_samples = m_upper + header.upperWords;
+    m_ids = m_samples + header.sampleCount;
+    return true;
+}
+
+uint64_t EliasFanoIndex::lowAt(uint64_t index) const {
+    if (m_lowBits == 0) return 0;
+    uint64_t bit = index * m_lowBits;
+    uint64_t word = bit / 64;
+    uint32_t shift = static_cast<uint32_t>(bit % 64);
+    uint64_t value = m_low[word] >> shift;
+    if (shift + m_lowBits > 64) value |= m_low[word + 1] << (64 - shift);
+    return value & ((uint64_t{1} << m_lowBits) - 1);
+}
+
+uint64_t EliasFanoIndex::selectZero(uint64_t k) const {
+    uint64_t position = m_samples[k / kSelectSampleRate];
+    uint64_t remaining = k % kSelectSampleRate;
+    if (remaining == 0) return position;
+
+    // 从采样点之后逐字统计0的个数，最后在字内逐个清除低位的0
+    ++position;
+    uint64_t word = position / 64;
+    uint64_t zeros = ~m_upper[word] & (~uint64_t{0} << (position % 64));
+    while (true) {
+        uint64_t available = static_cast<uint64_t>(__builtin_popcountll(zeros));
+        if (available >= remaining) {
+            for (uint64_t i = 1; i < remaining; ++i) zeros &= zeros - 1;
+            return word * 64 + static_cast<uint64_t>(__builtin_ctzll(zeros));
+        }
+        remaining -= available;
+        zeros = ~m_upper[++word];
+    }
+}
+
+bool EliasFanoIndex::lookup(uint64_t digest, uint64_t* id) const {
+    if (m_count == 0) return false;
+
+    uint64_t high = digest >> m_lowBits;
+    if (high > m_maxHigh) return false;
+
+    // 桶high的元素位于第high-1个0与第high个0之间
+    uint64_t position = high == 0 ? 0 : selectZero(high - 1) + 1;
+    uint64_t index = position - high;
+    uint64_t low = m_lowBits == 0 ? 0 : digest & ((uint64_t{1} << m_lowBits) - 1);
+
+    while (m_upper[position / 64] & (uint64_t{1} << (position % 64))) {
+        uint64_t candidate = lowAt(index);
+        if (candidate == low) {
+            *id = m_ids[index];
+            return true;
+        }
+        if (candidate > low) return false;
+        ++position;
+        ++index;
+    }
+    return false;
+}
@@ -0,0 +1,74 @@
+#ifndef ELIAS_FANO_INDEX_H
+#define ELIAS_FANO_INDEX_H
+
+#include "../common/HostIo.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct DigestEntry {
+    uint64_t digest;
+    uint64_t id;
+};
+
+/**
+ * 不可变的64位摘要 -> 设备ID索引（.fped，只读mmap）
+ *
+ * 排序后的摘要用Elias-Fano编码：低L位定长打包，高位以一元码存放在上层位图中
+ * （第i个元素在位置 (x_i >> L) + i 置1），每kSelectSampleRate个0记录一次位置。
+ * 查找：采样定位到桶起点 -> 扫描一两个字 -> 比较桶内的低位 -> 读取ID，
+ * 全程只读映射内存，不分配堆内存。
+ *
+ *   EliasFanoHeader
+ *   uint64 low[lowWords]          低位，末尾多一个字便于跨字读取
+ *   uint64 upper[upperWords]      上层位图
+ *   uint64 samples[sampleCount]   第 k*kSelectSampleRate 个0的位置
+ *   uint64 ids[count]
+ */
+class EliasFanoIndex {
+public:
+    static constexpr uint64_t kSelectSampleRate = 256;
+
+    // entries必须按摘要升序且无重复
+    static bool write(const std::vector<DigestEntry>& entries, const std::string& path);
+
+    bool open(const std::string& path);
+
+    bool lookup(uint64_t digest, uint64_t* id) const;
+
+    uint64_t size() const { return m_count; }
+
+    // 按摘要升序遍历所有条目（合并时使用）
+    template <typename Fn>
+    void forEach(Fn&& fn) const {
+        uint64_t index = 0;
+        for (uint64_t word = 0; word < m_upperWords && index < m_count; ++word) {
+            uint64_t bits = m_upper[word];
+            while (bits != 0 && index < m_count) {
+                uint64_t position = word * 64 + static_cast<uint64_t>(__builtin_ctzll(bits));
+                bits &= bits - 1;
+                uint64_t high = position - index;
+                fn(DigestEntry{(high << m_lowBits) | lowAt(index), m_ids[index]});
+                ++index;
+            }
+        }
+    }
+
+private:
+    uint64_t lowAt(uint64_t index) const;
+
+    // 第k个0（从0计）在上层位图中的位置
+    uint64_t selectZero(uint64_t k) const;
+
+    MappedFile m_file;
+    uint64_t m_count = 0;
+    uint32_t m_lowBits = 0;
+    uint64_t m_maxHigh = 0;
+    uint64_t m_upperWords = 0;
+    const uint64_t* m_low = nullptr;
+    const uint64_t* m_upper = nullptr;
+    const uint64_t* m_samples = nullptr;
+    const uint64_t* m_ids = nullptr;
+};
+
+#endif // ELIAS_FANO_INDEX_H
@@ -0,0 +1,256 @@
+/**
+ * fingerprint_digest - 设备摘要精确查找索引
+ *
+ * 用法:
+ *   fingerprint_digest build -o index.fped [-j 线程数] 输入文件或目录...
+ *       设备ID为记录在输入中的顺序，同一摘要出现多次时保留第一次的ID
+ *   fingerprint_digest lookup index.fped 指纹文件
+ *   fingerprint_digest bench [--keys N] [--readers R] [--seconds S] [--inserts-per-sec I]
+ *                            [--merge-threshold M] [-j 线程数] [-o index.fped]
+ *       随机摘要建索引后，多个读线程查找（一半命中），同时一个写线程插入并触发后台归并
+ */
+#include "DeviceDigest.h"
+#include "DigestStore.h"
+#include "../common/DumpRecords.h"
+#include "../common/ParallelFor.h"
+#include "../common/RadixSort.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// 排序后去重，保留每个摘要最先出现的ID（基数排序是稳定的）
+bool buildIndex(std::vector<DigestEntry>* entries, unsigned threads, const std::string& path) {
+    parallelRadixSort(entries, threads, [](const DigestEntry& entry) { return entry.digest; });
+    entries->erase(std::unique(entries->begin(), entries->end(),
+                               [](const DigestEntry& a, const DigestEntry& b) { return a.digest == b.digest; }),
+                   entries->end());
+    return EliasFanoIndex::write(*entries, path);
+}
+
+int buildCommand(const std::string& output, const std::vector<std::string>& inputs, unsigned threads) {
+    auto start = Clock::now();
+
+    std::vector<std::string> paths;
+    for (const auto& input : inputs) {
+        collectInputFiles(input, &paths);
+    }
+    std::vector<MappedFile> files(paths.size());
+    parallelFor(paths.size(), threads, [&](size_t i, unsigned) { files[i].open(paths[i]); });
+
+    std::vector<std::string_view> workUnits;
+    for (const auto& file : files) {
+        for (std::string_view chunk : dump_records::splitAtRecords(file.view(), 16u << 20)) {
+            workUnits.push_back(chunk);
+        }
+    }
+
+    std::vector<std::vector<uint64_t>> digests(workUnits.size());
+    parallelFor(workUnits.size(), threads, [&](size_t i, unsigned) {
+        dump_records::forEachRecord(workUnits[i],
+                                    [&](std::string_view record) { digests[i].push_back(deviceDigest(record)); });
+    });
+
+    std::vector<DigestEntry> entries;
+    for (const auto& unit : digests) {
+        for (uint64_t digest : unit) {
+            entries.push_back({digest, entries.size()});
+        }
+    }
+    size_t records = entries.size();
+    if (!buildIndex(&entries, threads, output)) return 1;
+
+    fprintf(stderr, "Indexed %zu records, %zu distinct digests in %.2fs\n", records, entries.size(),
+            std::chrono::duration<double>(Clock::now() - start).count());
+    return 0;
+}
+
+int lookupCommand(const std::string& indexPath, const std::string& dumpPath) {
+    EliasFanoIndex index;
+    MappedFile input;
+    if (!index.open(indexPath) || !input.open(dumpPath)) return 1;
+
+    uint32_t recordNumber = 0;
+    dump_records::forEachRecord(input.view(), [&](std::string_view record) {
+        uint64_t digest = deviceDigest(record);
+        uint64_t id;
+        if (index.lookup(digest, &id)) {
+            printf("record %u: digest %016llx device %llu\n", recordNumber, static_cast<unsigned long long>(digest),
+                   static_cast<unsigned long long>(id));
+        } else {
+            printf("record %u: digest %016llx not found\n", recordNumber, static_cast<unsigned long long>(digest));
+        }
+        ++recordNumber;
+    });
+    return 0;
+}
+
+double percentile(std::vector<double>* values, double p) {
+    if (values->empty()) return 0;
+    size_t index = static_cast<size_t>(p * (values->size() - 1));
+    std::nth_element(values->begin(), values->begin() + index, values->end());
+    return (*values)[index];
+}
+
+int benchCommand(uint64_t keys, unsigned readers, double seconds, uint64_t insertsPerSecond, size_t mergeThreshold,
+                 unsigned threads, const std::string& path) {
+    auto start = Clock::now();
+    std::vector<DigestEntry> entries(keys);
+    parallelFor(keys, threads, [&](size_t i, unsigned) { entries[i] = {mix64(i * 2 + 1), i}; });
+    if (!buildIndex(&entries, threads, path)) return 1;
+    fprintf(stderr, "Built index of %llu digests in %.2fs (%u threads)\n", static_cast<unsigned long long>(keys),
+            std::chrono::duration<double>(Clock::now() - start).count(), threads);
+
+    DigestStore store;
+    if (!store.open(path)) return 1;
+    store.startBackgroundMerge(mergeThreshold);
+
+    // 校验：所有键都能查到正确ID
+    std::atomic<uint64_t> wrong{0};
+    parallelFor(keys, threads, [&](size_t i, unsigned) {
+        uint64_t id;
+        if (!store.lookup(mix64(i * 2 + 1), &id) || id != i) ++wrong;
+    });
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> inserted{0};
+    std::thread writer([&]() {
+        auto begin = Clock::now();
+        uint64_t next = 0;
+        while (running.load(std::memory_order_relaxed)) {
+            double elapsed = std::chrono::duration<double>(Clock::now() - begin).count();
+            uint64_t target = static_cast<uint64_t>(elapsed * insertsPerSecond);
+            for (; next < target; ++next) {
+                store.insert(mix64(next * 2 + 1) ^ 0x8000000000000000ULL, keys + next);
+            }
+            inserted.store(next, std::memory_order_relaxed);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    std::vector<uint64_t> operations(readers, 0);
+    std::vector<uint64_t> hits(readers, 0);
+    std::vector<std::vector<double>> latencies(readers);
+    std::vector<std::thread> pool;
+    for (unsigned reader = 0; reader < readers; ++reader) {
+        pool.emplace_back([&, reader]() {
+            uint64_t state = mix64(reader + 1);
+            auto deadline = Clock::now() + std::chrono::duration<double>(seconds);
+            while (Clock::now() < deadline) {
+                for (int batch = 0; batch < 256; ++batch) {
+                    state = mix64(state);
+                    // 偶数次查存在的键，奇数次查随机键（几乎都不存在）
+                    uint64_t digest = (batch & 1) ? state : mix64((state % keys) * 2 + 1);
+                    uint64_t id;
+                    if (batch == 0) {
+                        auto begin = Clock::now();
+                        hits[reader] += store.lookup(digest, &id);
+                        latencies[reader].push_back(
+                                std::chrono::duration<double, std::nano>(Clock::now() - begin).count());
+                    } else {
+                        hits[reader] += store.lookup(digest, &id);
+                    }
+                }
+                operations[reader] += 256;
+            }
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    running = false;
+    writer.join();
+    store.stopBackgroundMerge();
+
+    // 在线插入的键无论在增量表还是已归并进基础索引，都必须能查到
+    parallelFor(inserted.load(), threads, [&](size_t i, unsigned) {
+        uint64_t id;
+        if (!store.lookup(mix64(i * 2 + 1) ^ 0x8000000000000000ULL, &id) || id != keys + i) ++wrong;
+    });
+
+    uint64_t totalOperations = 0;
+    uint64_t totalHits = 0;
+    std::vector<double> allLatencies;
+    for (unsigned reader = 0; reader < readers; ++reader) {
+        totalOperations += operations[reader];
+        totalHits += hits[reader];
+        allLatencies.insert(allLatencies.end(), latencies[reader].begin(), latencies[reader].end());
+    }
+
+    printf("verify: %llu wrong of %llu\n", static_cast<unsigned long long>(wrong.load()),
+           static_cast<unsigned long long>(keys + inserted.load()));
+    printf("readers %u: %.2f M lookups/s, hit rate %.3f, sampled latency p50 %.0fns p99 %.0fns\n", readers,
+           totalOperations / seconds / 1e6, static_cast<double>(totalHits) / std::max<uint64_t>(totalOperations, 1),
+           percentile(&allLatencies, 0.5), percentile(&allLatencies, 0.99));
+    printf("writer: %llu inserts, %llu background merges, base now %llu digests\n",
+           static_cast<unsigned long long>(inserted.load()), static_cast<unsigned long long>(store.mergeCount()),
+           static_cast<unsigned long long>(store.baseSize()));
+    return wrong == 0 ? 0 : 1;
+}
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s build -o <index.fped> [-j threads] <file|dir>...\n"
+            "       %s lookup <index.fped> <dump>\n"
+            "       %s bench [--keys N] [--readers R] [--seconds S] [--inserts-per-sec I]\n"
+            "                [--merge-threshold M] [-j threads] [-o index.fped]\n",
+            program, program, program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string_view command(argv[1]);
+    std::string output = "digest_bench.fped";
+    std::vector<std::string> positional;
+    unsigned threads = defaultThreadCount();
+    uint64_t keys = 10000000;
+    unsigned readers = defaultThreadCount();
+    double seconds = 5;
+    uint64_t insertsPerSecond = 100000;
+    size_t mergeThreshold = 200000;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            output = argv[++i];
+        } else if (arg == "-j" && hasValue) {
+            threads = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--keys" && hasValue) {
+            keys = std::max<uint64_t>(1, strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--readers" && hasValue) {
+            readers = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--seconds" && hasValue) {
+            seconds = std::max(0.1, atof(argv[++i]));
+        } else if (arg == "--inserts-per-sec" && hasValue) {
+            insertsPerSecond = strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--merge-threshold" && hasValue) {
+            mergeThreshold = std::max<size_t>(1, strtoull(argv[++i], nullptr, 10));
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            positional.emplace_back(arg);
+        }
+    }
+
+    if (command == "build" && !positional.empty()) {
+        return buildCommand(output, positional, threads);
+    } else if (command == "lookup" && positional.size() == 2) {
+        return lookupCommand(positional[0], positional[1]);
+    } else if (command == "bench") {
+        return benchCommand(keys, readers, seconds, insertsPerSecond, mergeThreshold, threads, output);
+    }
+    usage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,322 @@
+/**
+ * fingerprint_elf - ELF build-id 解析器的主机工具
+ *
+ * 用法:
+ *   fingerprint_elf read 文件...
+ *       与设备端相同的读取方式，输出 "build-id  位数/字节序  读取字节数  路径"
+ *   fingerprint_elf check
+ *       在临时目录中构造 ELF32/ELF64 × 小端/大端 的文件，覆盖注释段紧跟程序头、
+ *       注释段在第一页之外（pread路径）、程序头表在第一页之外、多个注释和多个PT_NOTE、
+ *       8字节对齐的注释段，以及没有注释、注释截断、注释段越过文件末尾、头部损坏等情况
+ */
+#include "ElfBuildId.h"
+#include "IoBackend.h"
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// ---- 构造ELF文件 ----
+
+class ElfWriter {
+public:
+    explicit ElfWriter(bool bigEndian) : m_bigEndian(bigEndian) {}
+
+    void put(std::string* out, size_t offset, uint64_t value, size_t width) const {
+        if (out->size() < offset + width) out->resize(offset + width, '\0');
+        for (size_t i = 0; i < width; ++i) {
+            size_t shift = m_bigEndian ? (width - 1 - i) * 8 : i * 8;
+            (*out)[offset + i] = static_cast<char>((value >> shift) & 0xff);
+        }
+    }
+
+    std::string note(std::string_view name, uint32_t type, std::string_view desc, size_t align) const {
+        // 名称和描述都从注释开头起按align对齐
+        auto alignUp = [align](size_t value) { return (value + align - 1) / align * align; };
+        std::string out;
+        size_t nameSize = name.size() + 1;
+        put(&out, 0, nameSize, 4);
+        put(&out, 4, desc.size(), 4);
+        put(&out, 8, type, 4);
+        out.append(name.data(), name.size());
+        out.resize(alignUp(12 + nameSize), '\0');
+        out.append(desc.data(), desc.size());
+        out.resize(alignUp(out.size()), '\0');
+        return out;
+    }
+
+private:
+    bool m_bigEndian;
+};
+
+struct Segment {
+    uint32_t type;
+    uint64_t offset;
+    std::string bytes;
+    uint64_t align = 4;
+    uint64_t filesz = 0;    // 0表示用bytes的长度
+};
+
+struct ElfSpec {
+    bool is64;
+    bool bigEndian;
+    uint64_t phoff;
+    std::vector<Segment> segments;
+    size_t minSize = 0;
+};
+
+std::string buildElf(const ElfSpec& spec) {
+    ElfWriter writer(spec.bigEndian);
+    std::string file(spec.is64 ? sizeof(Elf64_Ehdr) : sizeof(Elf32_Ehdr), '\0');
+    memcpy(&file[0], ELFMAG, SELFMAG);
+    file[EI_CLASS] = static_cast<char>(spec.is64 ? ELFCLASS64 : ELFCLASS32);
+    file[EI_DATA] = static_cast<char>(spec.bigEndian ? ELFDATA2MSB : ELFDATA2LSB);
+    file[EI_VERSION] = EV_CURRENT;
+    uint16_t machine = spec.is64 ? EM_AARCH64 : EM_ARM;
+    writer.put(&file, offsetof(Elf64_Ehdr, e_type), ET_DYN, 2);
+    writer.put(&file, offsetof(Elf64_Ehdr, e_machine), machine, 2);
+    writer.put(&file, offsetof(Elf64_Ehdr, e_version), EV_CURRENT, 4);
+
+    size_t phentsize = spec.is64 ? sizeof(Elf64_Phdr) : sizeof(Elf32_Phdr);
+    if (spec.is64) {
+        writer.put(&file, offsetof(Elf64_Ehdr, e_phoff), spec.phoff, 8);
+        writer.put(&file, offsetof(Elf64_Ehdr, e_ehsize), sizeof(Elf64_Ehdr), 2);
+        writer.put(&file, offsetof(Elf64_Ehdr, e_phentsize), phentsize, 2);
+        writer.put(&file, offsetof(Elf64_Ehdr, e_phnum), spec.segments.size(), 2);
+    } else {
+        writer.put(&file, offsetof(Elf32_Ehdr, e_phoff), spec.phoff, 4);
+        writer.put(&file, offsetof(Elf32_Ehdr, e_ehsize), sizeof(Elf32_Ehdr), 2);
+        writer.put(&file, offsetof(Elf32_Ehdr, e_phentsize), phentsize, 2);
+        writer.put(&file, offsetof(Elf32_Ehdr, e_phnum), spec.segments.size(), 2);
+    }
+
+    for (size_t i = 0; i < spec.segments.size(); ++i) {
+        const Segment& segment = spec.segments[i];
+        size_t entry = spec.phoff + i * phentsize;
+        uint64_t filesz = segment.filesz != 0 ? segment.filesz : segment.bytes.size();
+        if (spec.is64) {
+            writer.put(&file, entry + offsetof(Elf64_Phdr, p_type), segment.type, 4);
+            writer.put(&file, entry + offsetof(Elf64_Phdr, p_offset), segment.offset, 8);
+            writer.put(&file, entry + offsetof(Elf64_Phdr, p_filesz), filesz, 8);
+            writer.put(&file, entry + offsetof(Elf64_Phdr, p_memsz), filesz, 8);
+            writer.put(&file, entry + offsetof(Elf64_Phdr, p_align), segment.align, 8);
+        } else {
+            writer.put(&file, entry + offsetof(Elf32_Phdr, p_type), segment.type, 4);
+            writer.put(&file, entry + offsetof(Elf32_Phdr, p_offset), segment.offset, 4);
+            writer.put(&file, entry + offsetof(Elf32_Phdr, p_filesz), filesz, 4);
+            writer.put(&file, entry + offsetof(Elf32_Phdr, p_memsz), filesz, 4);
+            writer.put(&file, entry + offsetof(Elf32_Phdr, p_align), segment.align, 4);
+        }
+    }
+    for (const Segment& segment : spec.segments) {
+        if (file.size() < segment.offset + segment.bytes.size()) file.resize(segment.offset + segment.bytes.size(), '\0');
+        file.replace(segment.offset, segment.bytes.size(), segment.bytes);
+    }
+    if (file.size() < spec.minSize) file.resize(spec.minSize, '\0');
+    return file;
+}
+
+bool writeFile(const std::string& path, const std::string& content) {
+    FILE* file = fopen(path.c_str(), "wb");
+    if (file == nullptr) return false;
+    bool ok = fwrite(content.data(), 1, content.size(), file) == content.size();
+    return fclose(file) == 0 && ok;
+}
+
+// ---- 用例 ----
+
+constexpr char kBuildIdBytes[] = "\x5c\x2a\x4f\x5e\x1a\x3b\x00\xff\x10\x20\x30\x40\x50\x60\x70\x80\x90\xa0\xb0\xc0";
+constexpr char kBuildIdHex[] = "5c2a4f5e1a3b00ff102030405060708090a0b0c0";
+
+struct Case {
+    std::string name;
+    std::string content;
+    elf_build_id::Status status;
+    const char* buildId;        // 期望的build-id，nullptr表示不检查
+    size_t bytesRead;           // 期望的读取字节数，0表示不检查
+};
+
+std::vector<Case> buildCases() {
+    std::vector<Case> cases;
+    std::string_view buildId(kBuildIdBytes, sizeof(kBuildIdBytes) - 1);
+
+    for (bool is64 : {false, true}) {
+        for (bool bigEndian : {false, true}) {
+            ElfWriter writer(bigEndian);
+            std::string tag = std::string(is64 ? "elf64" : "elf32") + (bigEndian ? "-be" : "-le");
+            size_t headerSize = is64 ? sizeof(Elf64_Ehdr) : sizeof(Elf32_Ehdr);
+            size_t phentsize = is64 ? sizeof(Elf64_Phdr) : sizeof(Elf32_Phdr);
+            std::string gnuNote = writer.note("GNU", NT_GNU_BUILD_ID, buildId, 4);
+            std::string abiTag = writer.note("GNU", NT_GNU_ABI_TAG, std::string(16, '\1'), 4);
+            std::string androidNote = writer.note("Android", 1, std::string(4, '\x1e'), 4);
+            auto load = [](uint64_t offset) { return Segment{PT_LOAD, offset, std::string(), 4096, 0}; };
+
+            // 常见布局：PT_LOAD之后的PT_NOTE紧跟在程序头表后面，在第一页的映射内
+            size_t noteOffset = headerSize + 2 * phentsize;
+            cases.push_back({tag + " note in first page",
+                             buildElf({is64, bigEndian, headerSize,
+                                       {load(0), {PT_NOTE, noteOffset, gnuNote}}, 16384}),
+                             elf_build_id::Status::OK, kBuildIdHex, 4096});
+
+            // 注释段在第一页之外：映射一页 + pread注释段
+            cases.push_back({tag + " note beyond first page",
+                             buildElf({is64, bigEndian, headerSize, {load(0), {PT_NOTE, 8192, gnuNote}}, 12288}),
+                             elf_build_id::Status::OK, kBuildIdHex, 4096 + gnuNote.size()});
+
+            // 程序头表在第一页之外：扩大映射
+            cases.push_back({tag + " program headers beyond first page",
+                             buildElf({is64, bigEndian, 5000, {load(0), {PT_NOTE, 6000, gnuNote}}, 8192}),
+                             elf_build_id::Status::OK, kBuildIdHex, 0});
+
+            // 同一注释段中build-id前面有ABI标签；前一个PT_NOTE只有Android注释
+            cases.push_back({tag + " build-id after other notes",
+                             buildElf({is64, bigEndian, headerSize,
+                                       {{PT_NOTE, 512, androidNote}, {PT_NOTE, 1024, abiTag + gnuNote}}, 4096}),
+                             elf_build_id::Status::OK, kBuildIdHex, 0});
+
+            // 8字节对齐的注释段（.note.gnu.property 与 build-id 合并时）
+            std::string property = writer.note("GNU", 5 /* NT_GNU_PROPERTY_TYPE_0 */, std::string(16, '\0'), 8);
+            cases.push_back({tag + " 8-byte aligned notes",
+                             buildElf({is64, bigEndian, headerSize,
+                                       {{PT_NOTE, 1024, property + writer.note("GNU", NT_GNU_BUILD_ID, buildId, 8),
+                                         8}}, 4096}),
+                             elf_build_id::Status::OK, kBuildIdHex, 0});
+
+            cases.push_back({tag + " no PT_NOTE",
+                             buildElf({is64, bigEndian, headerSize, {load(0)}, 4096}),
+                             elf_build_id::Status::NO_BUILD_ID, nullptr, 0});
+            cases.push_back({tag + " only ABI tag",
+                             buildElf({is64, bigEndian, headerSize, {{PT_NOTE, 512, abiTag}}, 4096}),
+                             elf_build_id::Status::NO_BUILD_ID, nullptr, 0});
+
+            // 描述长度超出注释段
+            std::string truncated = gnuNote;
+            writer.put(&truncated, 4, 200, 4);
+            cases.push_back({tag + " truncated note",
+                             buildElf({is64, bigEndian, headerSize, {{PT_NOTE, 512, truncated}}, 4096}),
+                             elf_build_id::Status::NO_BUILD_ID, nullptr, 0});
+
+            // 注释段越过文件末尾（文件被截断）
+            Segment pastEnd{PT_NOTE, 8192, gnuNote, 4, 0};
+            std::string cut = buildElf({is64, bigEndian, headerSize, {load(0), pastEnd}, 0});
+            cut.resize(8192 + gnuNote.size() / 2);
+            cases.push_back({tag + " note past end of file", cut, elf_build_id::Status::NO_BUILD_ID, nullptr, 0});
+
+            // 头部损坏
+            std::string noHeaders = buildElf({is64, bigEndian, headerSize, {{PT_NOTE, 512, gnuNote}}, 4096});
+            cases.push_back({tag + " truncated header", noHeaders.substr(0, headerSize - 8),
+                             elf_build_id::Status::NOT_ELF, nullptr, 0});
+            std::string tableOutside = noHeaders;
+            writer.put(&tableOutside, is64 ? offsetof(Elf64_Ehdr, e_phoff) : offsetof(Elf32_Ehdr, e_phoff), 1u << 20,
+                       is64 ? 8 : 4);
+            cases.push_back({tag + " program headers past end of file", tableOutside,
+                             elf_build_id::Status::NOT_ELF, nullptr, 0});
+            cases.push_back({tag + " zero program headers", buildElf({is64, bigEndian, headerSize, {}, 4096}),
+                             elf_build_id::Status::NOT_ELF, nullptr, 0});
+        }
+    }
+
+    std::string notElf(4096, 'x');
+    cases.push_back({"not an ELF file", notElf, elf_build_id::Status::NOT_ELF, nullptr, 0});
+    std::string badClass = buildElf({true, false, sizeof(Elf64_Ehdr), {}, 4096});
+    badClass[EI_CLASS] = 3;
+    cases.push_back({"unknown ELF class", badClass, elf_build_id::Status::NOT_ELF, nullptr, 0});
+    return cases;
+}
+
+int runCheck() {
+    char root[] = "/tmp/fingerprint_elf.XXXXXX";
+    if (mkdtemp(root) == nullptr) {
+        fprintf(stderr, "Unable to create temporary directory\n");
+        return 1;
+    }
+
+    int failures = 0;
+    std::vector<Case> cases = buildCases();
+    std::vector<std::string> paths;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        const Case& test = cases[i];
+        std::string path = std::string(root) + "/case" + std::to_string(i);
+        paths.push_back(path);
+        if (!writeFile(path, test.content)) {
+            fprintf(stderr, "FAIL %s: cannot write fixture\n", test.name.c_str());
+            ++failures;
+            continue;
+        }
+
+        elf_build_id::Result result;
+        elf_build_id::Status status = elf_build_id::read<LibcIo>(AT_FDCWD, path.c_str(), &result);
+        bool ok = status == test.status;
+        if (ok && test.buildId != nullptr) ok = result.buildId == test.buildId;
+        if (ok && test.bytesRead != 0) ok = result.bytesRead == test.bytesRead;
+        if (ok && status == elf_build_id::Status::OK) {
+            bool is64 = test.name.compare(0, 5, "elf64") == 0;
+            bool bigEndian = test.name.compare(5, 3, "-be") == 0;
+            ok = result.is64 == is64 && result.bigEndian == bigEndian &&
+                 result.machine == (is64 ? EM_AARCH64 : EM_ARM);
+        }
+        if (!ok) {
+            fprintf(stderr, "FAIL %s: status %s, build-id [%s], bytes read %zu, 64-bit %d, big-endian %d\n",
+                    test.name.c_str(), elf_build_id::statusName(status), result.buildId.c_str(), result.bytesRead,
+                    result.is64, result.bigEndian);
+            ++failures;
+        }
+    }
+
+    elf_build_id::Result missing;
+    if (elf_build_id::read<LibcIo>(AT_FDCWD, (std::string(root) + "/missing").c_str(), &missing) !=
+        elf_build_id::Status::NOT_FOUND) {
+        fprintf(stderr, "FAIL missing file is not NOT_FOUND\n");
+        ++failures;
+    }
+
+    for (const std::string& path : paths) unlink(path.c_str());
+    rmdir(root);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    printf("ok: %zu cases\n", cases.size() + 1);
+    return 0;
+}
+
+int runRead(int argc, char** argv) {
+    int status = 0;
+    for (int i = 2; i < argc; ++i) {
+        elf_build_id::Result result;
+        elf_build_id::Status read = elf_build_id::read<LibcIo>(AT_FDCWD, argv[i], &result);
+        if (read != elf_build_id::Status::OK) {
+            fprintf(stderr, "%s: %s\n", argv[i], elf_build_id::statusName(read));
+            status = 1;
+            continue;
+        }
+        printf("%s  %s/%s  %zu  %s\n", result.buildId.c_str(), result.is64 ? "64" : "32",
+               result.bigEndian ? "be" : "le", result.bytesRead, argv[i]);
+    }
+    return status;
+}
+
+int usage(const char* program) {
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s read FILE...\n"
+            "  %s check\n",
+            program, program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+    std::string_view command(argv[1]);
+    if (command == "read" && argc > 2) return runRead(argc, argv);
+    if (command == "check") return runCheck();
+    return usage(argv[0]);
+}
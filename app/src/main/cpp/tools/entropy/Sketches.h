@@ -0,0 +1,181 @@
+#ifndef SKETCHES_H
+#define SKETCHES_H
+
+#include "../../include/HashUtils.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * 固定内存的流式统计结构，内存占用与设备数、快照数无关
+ */
+
+// HyperLogLog基数估计，2^precision个寄存器，标准误差约 1.04/sqrt(2^precision)
+class HyperLogLog {
+public:
+    explicit HyperLogLog(uint32_t precision = 11)
+        : m_precision(precision), m_registers(size_t{1} << precision, 0) {}
+
+    void add(uint64_t hash) {
+        size_t index = hash >> (64 - m_precision);
+        uint64_t rest = (hash << m_precision) | (uint64_t{1} << (m_precision - 1));
+        uint8_t rank = static_cast<uint8_t>(__builtin_clzll(rest) + 1);
+        if (rank > m_registers[index]) m_registers[index] = rank;
+    }
+
+    void merge(const HyperLogLog& other) {
+        for (size_t i = 0; i < m_registers.size(); ++i) {
+            m_registers[i] = std::max(m_registers[i], other.m_registers[i]);
+        }
+    }
+
+    double estimate() const {
+        double m = static_cast<double>(m_registers.size());
+        double sum = 0;
+        size_t zeros = 0;
+        for (uint8_t value : m_registers) {
+            sum += std::ldexp(1.0, -value);
+            zeros += value == 0;
+        }
+        double raw = 0.7213 / (1 + 1.079 / m) * m * m / sum;
+        // 小基数时改用线性计数
+        if (raw <= 2.5 * m && zeros > 0) return m * std::log(m / zeros);
+        return raw;
+    }
+
+private:
+    uint32_t m_precision;
+    std::vector<uint8_t> m_registers;
+};
+
+/**
+ * Count-Min sketch，计数器为原子量，多个线程可直接共享同一实例
+ * add() 返回加入前的估计值：0表示该键此前一定没有出现过
+ */
+class CountMinSketch {
+public:
+    static constexpr uint32_t kDepth = 4;
+
+    explicit CountMinSketch(size_t bytes) {
+        size_t width = 1024;
+        while (width * 2 * kDepth * sizeof(uint32_t) <= bytes) width <<= 1;
+        m_mask = width - 1;
+        m_counters.reset(new std::atomic<uint32_t>[width * kDepth]);
+        for (size_t i = 0; i < width * kDepth; ++i) {
+            m_counters[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    uint32_t add(uint64_t key) {
+        uint32_t previous = UINT32_MAX;
+        for (uint32_t row = 0; row < kDepth; ++row) {
+            std::atomic<uint32_t>& counter = m_counters[row * (m_mask + 1) + slot(key, row)];
+            previous = std::min(previous, counter.fetch_add(1, std::memory_order_relaxed));
+        }
+        return previous;
+    }
+
+    uint32_t estimate(uint64_t key) const {
+        uint32_t result = UINT32_MAX;
+        for (uint32_t row = 0; row < kDepth; ++row) {
+            result = std::min(result, m_counters[row * (m_mask + 1) + slot(key, row)].load(std::memory_order_relaxed));
+        }
+        return result;
+    }
+
+    size_t bytes() const { return (m_mask + 1) * kDepth * sizeof(uint32_t); }
+
+private:
+    size_t slot(uint64_t key, uint32_t row) const {
+        return mix64(key + (row + 1) * 0x9e3779b97f4a7c15ULL) & m_mask;
+    }
+
+    size_t m_mask = 0;
+    std::unique_ptr<std::atomic<uint32_t>[]> m_counters;
+};
+
+/**
+ * Space-Saving 频繁项统计：最多跟踪capacity个值
+ * 计数是上界，count - error 是下界；未跟踪值的总频次不超过最小计数
+ */
+class SpaceSaving {
+public:
+    struct Counter {
+        uint64_t value;
+        uint64_t count;
+        uint64_t error;
+    };
+
+    explicit SpaceSaving(size_t capacity = 256) : m_capacity(capacity) {}
+
+    void add(uint64_t value, uint64_t count = 1) {
+        auto it = m_index.find(value);
+        if (it != m_index.end()) {
+            m_counters[it->second].count += count;
+            return;
+        }
+        if (m_counters.size() < m_capacity) {
+            m_index.emplace(value, m_counters.size());
+            m_counters.push_back({value, count, 0});
+            return;
+        }
+
+        // 替换计数最小的项，新项继承其计数作为误差
+        size_t minimum = 0;
+        for (size_t i = 1; i < m_counters.size(); ++i) {
+            if (m_counters[i].count < m_counters[minimum].count) minimum = i;
+        }
+        Counter& victim = m_counters[minimum];
+        m_index.erase(victim.value);
+        m_index.emplace(value, minimum);
+        victim = {value, victim.count + count, victim.count};
+    }
+
+    // 只合并对方计数的下界，避免误差在多次合并中累积成虚高的频次
+    void merge(const SpaceSaving& other) {
+        for (const Counter& counter : other.m_counters) {
+            if (counter.count > counter.error) add(counter.value, counter.count - counter.error);
+        }
+    }
+
+    const std::vector<Counter>& counters() const { return m_counters; }
+
+private:
+    size_t m_capacity;
+    std::vector<Counter> m_counters;
+    std::unordered_map<uint64_t, size_t> m_index;
+};
+
+/**
+ * 由频繁项和基数估计香农熵（比特）
+ * 跟踪到的值按 (count - error) 计入，剩余频次均匀分布在其余 cardinality - 跟踪数 个值上
+ */
+inline double estimateEntropy(const SpaceSaving& frequent, double cardinality, uint64_t total) {
+    if (total == 0) return 0;
+
+    double entropy = 0;
+    double covered = 0;
+    size_t tracked = 0;
+    for (const SpaceSaving::Counter& counter : frequent.counters()) {
+        double count = static_cast<double>(counter.count - counter.error);
+        if (count <= 0) continue;
+        double p = count / total;
+        entropy -= p * std::log2(p);
+        covered += count;
+        ++tracked;
+    }
+
+    double rest = std::max(0.0, static_cast<double>(total) - covered);
+    if (rest > 0) {
+        double others = std::max(1.0, std::min(rest, cardinality - tracked));
+        double p = rest / total / others;
+        entropy -= rest / total * std::log2(p);
+    }
+    return entropy;
+}
+
+#endif // SKETCHES_H
@@ -0,0 +1,218 @@
+/**
+ * fingerprint_entropy - 字段稳定性与熵分析
+ *
+ * 用法:
+ *   fingerprint_entropy [-j 线程数] [--sketch-mb N] [--tsv] 输入文件或目录...
+ *
+ * 单遍扫描所有快照（同一设备可有多份），对每个字段统计：
+ *   熵        Space-Saving频繁项 + HyperLogLog基数估计的香农熵（比特）
+ *   基数      HyperLogLog
+ *   变化率    设备内出现过的不同取值数-1 与该设备后续快照数之比；
+ *            用共享的Count-Min sketch判断 (设备, 字段) 和 (设备, 字段, 值) 是否首次出现
+ * 设备以DeviceDigest（cid、序列号、DRM ID、机型等）区分。
+ * 内存只取决于字段数和sketch大小，与设备数、快照数无关。
+ *
+ * 输出的分类用来决定设备端收集器读取哪些字段：
+ *   constant     几乎没有熵，读取只增加耗时
+ *   volatile     同一设备内频繁变化，不适合做标识
+ *   identifying  熵高且稳定
+ */
+#include "Sketches.h"
+#include "../common/DumpRecords.h"
+#include "../common/FlatIdMap.h"
+#include "../common/HostIo.h"
+#include "../common/ParallelFor.h"
+#include "../digest/DeviceDigest.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+
+constexpr size_t kMaxFields = 8192;
+constexpr double kConstantEntropyBits = 0.5;
+constexpr double kVolatileChangeRate = 0.2;
+
+struct FieldStats {
+    uint64_t id = 0;
+    std::string name;
+    uint64_t observations = 0;
+    uint64_t newDeviceFields = 0;  // (设备, 字段) 首次出现
+    uint64_t newDeviceValues = 0;  // (设备, 字段, 值) 首次出现
+    HyperLogLog cardinality;
+    SpaceSaving frequent;
+
+    void merge(const FieldStats& other) {
+        observations += other.observations;
+        newDeviceFields += other.newDeviceFields;
+        newDeviceValues += other.newDeviceValues;
+        cardinality.merge(other.cardinality);
+        frequent.merge(other.frequent);
+    }
+};
+
+// 每个线程一份，结束后合并
+struct WorkerStats {
+    FlatIdMap index{1024};
+    FlatIdMap occurrences;
+    std::vector<FieldStats> fields;
+    HyperLogLog devices{14};
+    uint64_t snapshots = 0;
+    uint64_t droppedFields = 0;
+};
+
+std::string fieldName(std::string_view section, std::string_view key, uint32_t occurrence) {
+    std::string name(section);
+    name += '/';
+    name.append(key.data(), key.size());
+    if (occurrence > 0) name += "#" + std::to_string(occurrence);
+    return name;
+}
+
+void analyzeRecord(std::string_view record, CountMinSketch* sketch, WorkerStats* stats) {
+    uint64_t device = deviceDigest(record);
+    stats->devices.add(device);
+    ++stats->snapshots;
+    stats->occurrences.clear();
+
+    dump::forEachField(record.data(), record.size(),
+                       [&](std::string_view section, std::string_view key, std::string_view value) {
+        uint64_t baseId = FieldSnapshot::fieldId(section, key);
+        uint32_t occurrence = stats->occurrences.at(baseId)++;
+        uint64_t id = occurrence == 0 ? baseId : FieldSnapshot::fieldId(section, key, occurrence);
+
+        bool inserted = false;
+        uint32_t index = stats->index.at(id, static_cast<uint32_t>(stats->fields.size()), &inserted);
+        if (inserted) {
+            if (stats->fields.size() >= kMaxFields) {
+                ++stats->droppedFields;
+                return;
+            }
+            stats->fields.emplace_back();
+            stats->fields.back().id = id;
+            stats->fields.back().name = fieldName(section, key, occurrence);
+        }
+        if (index >= stats->fields.size()) return;
+
+        FieldStats& field = stats->fields[index];
+        uint64_t valueHash = fnv1a64(value.data(), value.size());
+        ++field.observations;
+        field.cardinality.add(mix64(valueHash));
+        field.frequent.add(valueHash);
+
+        uint64_t deviceField = mix64(device ^ id);
+        if (sketch->add(deviceField) == 0) ++field.newDeviceFields;
+        if (sketch->add(mix64(deviceField ^ valueHash)) == 0) ++field.newDeviceValues;
+    });
+}
+
+struct FieldReport {
+    const FieldStats* stats;
+    double entropy;
+    double cardinality;
+    double changeRate;
+    const char* verdict;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> inputs;
+    unsigned threads = defaultThreadCount();
+    size_t sketchBytes = size_t{256} << 20;
+    bool tsv = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "-j" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--sketch-mb" && i + 1 < argc) {
+            sketchBytes = static_cast<size_t>(std::max(1, atoi(argv[++i]))) << 20;
+        } else if (arg == "--tsv") {
+            tsv = true;
+        } else if (!arg.empty() && arg[0] == '-') {
+            fprintf(stderr, "Usage: %s [-j threads] [--sketch-mb N] [--tsv] <file|dir>...\n", argv[0]);
+            return 2;
+        } else {
+            inputs.emplace_back(arg);
+        }
+    }
+    if (inputs.empty()) {
+        fprintf(stderr, "Usage: %s [-j threads] [--sketch-mb N] [--tsv] <file|dir>...\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<std::string> paths;
+    for (const auto& input : inputs) {
+        collectInputFiles(input, &paths);
+    }
+
+    // 按文件流式处理：同一时刻只映射正在分析的文件
+    CountMinSketch sketch(sketchBytes);
+    std::vector<WorkerStats> workers(threads);
+    parallelFor(paths.size(), threads, [&](size_t i, unsigned worker) {
+        MappedFile file;
+        if (!file.open(paths[i])) return;
+        dump_records::forEachRecord(file.view(),
+                                    [&](std::string_view record) { analyzeRecord(record, &sketch, &workers[worker]); });
+    });
+
+    WorkerStats total;
+    for (WorkerStats& worker : workers) {
+        total.snapshots += worker.snapshots;
+        total.droppedFields += worker.droppedFields;
+        total.devices.merge(worker.devices);
+        for (FieldStats& field : worker.fields) {
+            bool inserted = false;
+            uint32_t index = total.index.at(field.id, static_cast<uint32_t>(total.fields.size()), &inserted);
+            if (inserted) {
+                total.fields.push_back(std::move(field));
+            } else {
+                total.fields[index].merge(field);
+            }
+        }
+    }
+
+    std::vector<FieldReport> reports;
+    for (const FieldStats& field : total.fields) {
+        FieldReport report;
+        report.stats = &field;
+        report.cardinality = field.cardinality.estimate();
+        report.entropy = estimateEntropy(field.frequent, report.cardinality, field.observations);
+        uint64_t repeats = field.observations - std::min(field.observations, field.newDeviceFields);
+        uint64_t changes = field.newDeviceValues - std::min(field.newDeviceValues, field.newDeviceFields);
+        report.changeRate = repeats == 0 ? 0.0 : std::min(1.0, static_cast<double>(changes) / repeats);
+        if (report.entropy < kConstantEntropyBits) {
+            report.verdict = "constant";
+        } else if (report.changeRate > kVolatileChangeRate) {
+            report.verdict = "volatile";
+        } else {
+            report.verdict = "identifying";
+        }
+        reports.push_back(report);
+    }
+    std::sort(reports.begin(), reports.end(), [](const FieldReport& a, const FieldReport& b) {
+        return a.entropy != b.entropy ? a.entropy > b.entropy : a.stats->name < b.stats->name;
+    });
+
+    fprintf(stderr, "%llu snapshots, ~%.0f devices, %zu fields, sketch %zu MB%s\n",
+            static_cast<unsigned long long>(total.snapshots), total.devices.estimate(), total.fields.size(),
+            sketch.bytes() >> 20, total.droppedFields > 0 ? " (field limit reached)" : "");
+
+    if (tsv) {
+        printf("field\tobservations\tcardinality\tentropy_bits\tchange_rate\tverdict\n");
+    } else {
+        printf("%-12s %8s %12s %10s %8s  %s\n", "verdict", "entropy", "cardinality", "observed", "change", "field");
+    }
+    for (const FieldReport& report : reports) {
+        if (tsv) {
+            printf("%s\t%llu\t%.0f\t%.3f\t%.4f\t%s\n", report.stats->name.c_str(),
+                   static_cast<unsigned long long>(report.stats->observations), report.cardinality, report.entropy,
+                   report.changeRate, report.verdict);
+        } else {
+            printf("%-12s %8.2f %12.0f %10llu %7.1f%%  %s\n", report.verdict, report.entropy, report.cardinality,
+                   static_cast<unsigned long long>(report.stats->observations), report.changeRate * 100,
+                   report.stats->name.c_str());
+        }
+    }
+    return 0;
+}
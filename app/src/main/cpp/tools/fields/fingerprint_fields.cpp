@@ -0,0 +1,301 @@
+/**
+ * fingerprint_fields - FieldStore字段目录的主机端提取与校验
+ *
+ * 用法:
+ *   fingerprint_fields extract 输入文件或目录...
+ *       按记录输出 getAllDeviceFingerprintNative 文本中的目录字段（与设备端getFieldNative相同的规则）
+ *   fingerprint_fields check
+ *       用收集器的输出格式和FieldDefinitions.h中的同一组标题/键常量拼出各分区文本和完整指纹，
+ *       校验每个目录字段都能被 dump::forEachField 找到且值正确，并且不会误取其他小节中的同名键
+ */
+#include "../common/DumpRecords.h"
+#include "../common/HostIo.h"
+#include "../../include/FieldCatalog.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// ---- 收集器格式的文本 ----
+// 每个函数对应一个收集方法，行格式与 collectors/ 下的实现一致，标题和键取同一组常量
+
+struct DeviceValues {
+    std::string values[FIELD_COUNT];
+};
+
+DeviceValues sampleValues() {
+    DeviceValues device;
+    std::string* v = device.values;
+    v[FIELD_BUILD_FINGERPRINT] = "google/raven/raven:14/UP1A.231005.007/10754064:user/release-keys";
+    v[FIELD_DEVICE_MODEL] = "Pixel 6 Pro";
+    v[FIELD_DEVICE_BRAND] = "google";
+    v[FIELD_MANUFACTURER] = "Google";
+    v[FIELD_PRODUCT_NAME] = "raven";
+    v[FIELD_DEVICE_NAME] = "raven";
+    v[FIELD_ANDROID_VERSION] = "14";
+    v[FIELD_API_LEVEL] = "34";
+    v[FIELD_BUILD_ID] = "UP1A.231005.007";
+    v[FIELD_BUILD_TYPE] = "user";
+    v[FIELD_BUILD_TAGS] = "release-keys";
+    v[FIELD_SECURITY_PATCH] = "2023-10-05";
+    v[FIELD_BUILD_INCREMENTAL] = "10754064";
+    v[FIELD_KERNEL_RELEASE] = "5.10.157-android13-4-00001-g5c2a4f5e1a3b-ab10812345";
+    v[FIELD_KERNEL_VERSION] = "#1 SMP PREEMPT Thu Sep 14 12:00:00 UTC 2023";
+    v[FIELD_MACHINE] = "aarch64";
+    v[FIELD_BOOT_ID] = "3f1c5a0e-8d2b-4c7e-9a61-2b4d8e0f7c13";
+    v[FIELD_SOC_SERIAL] = "0x1a2b3c4d";
+    return device;
+}
+
+std::string field(const char* key, const std::string& value) {
+    return std::string(key) + ": " + value + "\n";
+}
+
+// SystemCollector::collectBuildPropFiles / parseBuildProp
+std::string buildPropSection(const DeviceValues& device) {
+    std::string result;
+    for (const char* path : kBuildPropFiles) {
+        result += "=== " + std::string(path) + " ===\n";
+        if (strcmp(path, "/odm/etc/build.prop") == 0) {
+            result += "File does not exist\n\n";
+            continue;
+        }
+        // 其他分区的同名属性取值不同，不能被误取
+        bool system = strcmp(path, kBuildPropFiles[0]) == 0;
+        result += "ro.build.fingerprint=" + device.values[FIELD_BUILD_FINGERPRINT] + "\n";
+        result += "ro.build.version.incremental=" +
+                  (system ? device.values[FIELD_BUILD_INCREMENTAL] : std::string("eng.vendor.20231005")) + "\n";
+        result += "ro.build.date=Thu Sep 14 12:00:00 UTC 2023\n";
+        result += "\n";
+    }
+    return result;
+}
+
+// SystemCollector::getUnameInfo
+std::string unameSection(const DeviceValues& device) {
+    std::string result = "=== " + std::string(kUnameTitle) + " ===\n";
+    result += "sysname: Linux\n";
+    result += "nodename: localhost\n";
+    result += field(kUnameReleaseKey, device.values[FIELD_KERNEL_RELEASE]);
+    result += field(kUnameVersionKey, device.values[FIELD_KERNEL_VERSION]);
+    result += field(kUnameMachineKey, device.values[FIELD_MACHINE]);
+    result += "domainname: (none)\n";
+    return result + "\n";
+}
+
+// SystemCollector::collectSystemFilesInfo 的开头部分（collectSystemFiles）和末尾的附加信息
+std::string systemFilesSection(const DeviceValues& device) {
+    std::string result = "\n=== " + std::string(kSystemFilesTitle) + " ===\n\n";
+    for (const char* path : kSystemIdentifierFiles) {
+        result += "=== " + std::string(path) + " ===\n";
+        if (strcmp(path, kSystemIdentifierFiles[0]) == 0) {
+            result += field(kIdentifierContentKey, device.values[FIELD_BOOT_ID]);
+        } else if (strcmp(path, kSystemIdentifierFiles[2]) == 0) {
+            result += field(kIdentifierContentKey, device.values[FIELD_SOC_SERIAL]);
+        } else if (strcmp(path, "/proc/misc") == 0) {
+            result += "File exists but could not be read\n";
+        } else {
+            result += field(kIdentifierContentKey, "Linux version 5.10.157 (build-user@build-host) #1 SMP PREEMPT");
+        }
+        result += "\n";
+    }
+    result += "=== " + std::string(kBlockDevicesTitle) + " ===\nsda: model=SAMSUNG KLUDG4UHGC-B0E1\n\n";
+    result += unameSection(device);
+    // 附加信息中的 /proc/version、cpuinfo 含有 "version"、"machine" 等同名键
+    result += "=== Additional System Information ===\n";
+    result += "--- /proc/cpuinfo ---\nprocessor\t: 0\nCPU revision\t: 0\nmachine\t: armv8\n\n";
+    result += "--- /proc/version ---\nversion: 0.0-decoy\n\n";
+    return result;
+}
+
+// CommonCollector::collect（collectDeviceInfo 之后是网络、硬件、应用信息）
+std::string commonDeviceSection(const DeviceValues& device) {
+    const std::string* v = device.values;
+    std::string result = "=== " + std::string(kCommonDeviceTitle) + " ===\n\n";
+    result += "=== " + std::string(kDeviceInfoTitle) + " ===\n\n";
+    result += field(kDeviceModelKey, v[FIELD_DEVICE_MODEL]);
+    result += field(kDeviceBrandKey, v[FIELD_DEVICE_BRAND]);
+    result += field(kAndroidVersionKey, v[FIELD_ANDROID_VERSION]);
+    result += field(kApiLevelKey, v[FIELD_API_LEVEL]);
+    result += field(kManufacturerKey, v[FIELD_MANUFACTURER]);
+    result += field(kProductNameKey, v[FIELD_PRODUCT_NAME]);
+    result += field(kDeviceNameKey, v[FIELD_DEVICE_NAME]);
+    result += field(kBuildFingerprintKey, v[FIELD_BUILD_FINGERPRINT]);
+    result += field(kBuildIdKey, v[FIELD_BUILD_ID]);
+    result += field(kBuildTypeKey, v[FIELD_BUILD_TYPE]);
+    result += field(kBuildTagsKey, v[FIELD_BUILD_TAGS]);
+    result += field(kBuildDateKey, "Thu Sep 14 12:00:00 UTC 2023");
+    result += field(kSecurityPatchKey, v[FIELD_SECURITY_PATCH]);
+    result += "\n";
+    result += "=== Network Information ===\n\nWiFi MAC Address: \nBluetooth Address: \n\n";
+    result += "=== Hardware Information ===\n\n=== " + std::string(kCpuInfoTitle) + " ===\n";
+    result += "Hardware\t: Tensor\nManufacturer: decoy\n\nBoard Platform: gs101\n\n";
+    return result;
+}
+
+// native-lib.cpp collectAllDeviceFingerprint 的拼接顺序
+std::string fullDump(const DeviceValues& device) {
+    std::string result = "=== " + std::string(kDumpTitle) + " ===\n\n";
+    result += "=== System Information Collection ===\n\n";
+    result += "=== " + std::string(kFileSystemTitle) + " ===\n\nTotal Bytes: 119284436992\n\n";
+    result += "\n=== " + std::string(kDrmIdTitle) + " ===\n\nDRM ID: q3Vt2bBq0l5dM1uVJ9x3cA==\n";
+    result += "\n=== " + std::string(kKernelFilesTitle) + " ===\n\n";
+    result += buildPropSection(device);
+    result += "=== " + std::string(kKernelConfigTitle) + " ===\nCONFIG_ARM64=y\n\n";
+    result += "=== Other System Files ===\n--- /proc/version ---\nLinux version 5.10.157\n\n";
+    result += systemFilesSection(device);
+    result += commonDeviceSection(device);
+    return result;
+}
+
+std::string sectionText(FingerprintSection section, const DeviceValues& device) {
+    switch (section) {
+        case SECTION_BUILD_PROP:    return buildPropSection(device);
+        case SECTION_UNAME:         return unameSection(device);
+        case SECTION_SYSTEM_FILES:  return systemFilesSection(device);
+        case SECTION_COMMON_DEVICE: return commonDeviceSection(device);
+        default:                    return std::string();
+    }
+}
+
+uint32_t catalogSections() {
+    uint32_t mask = 0;
+    for (const FieldSource& source : kFieldSources) mask |= source.section;
+    return mask;
+}
+
+// 在text中查找mask内各分区的目录字段
+void extractFields(std::string_view text, uint32_t mask, std::string_view values[FIELD_COUNT],
+                   bool found[FIELD_COUNT]) {
+    for (uint32_t rest = mask; rest != 0; rest &= rest - 1) {
+        FingerprintSection section = static_cast<FingerprintSection>(rest & -rest);
+        forEachCatalogField(section, text, [&](FieldId id, std::string_view value) {
+            values[id] = value;
+            found[id] = true;
+        });
+    }
+}
+
+int runCheck() {
+    int failures = 0;
+    DeviceValues device = sampleValues();
+
+    // 目录本身：名称唯一，build.prop字段必须是parseBuildProp保留的属性
+    for (int i = 0; i < FIELD_COUNT; ++i) {
+        const FieldSource& source = kFieldSources[i];
+        for (int j = 0; j < i; ++j) {
+            if (strcmp(source.name, kFieldSources[j].name) == 0) {
+                fprintf(stderr, "FAIL duplicate field name %s\n", source.name);
+                ++failures;
+            }
+        }
+        if (source.section == SECTION_BUILD_PROP &&
+            std::find_if(std::begin(kKeyBuildProperties), std::end(kKeyBuildProperties), [&](const char* key) {
+                return strcmp(key, source.key) == 0;
+            }) == std::end(kKeyBuildProperties)) {
+            fprintf(stderr, "FAIL %s: %s is not kept by parseBuildProp\n", source.name, source.key);
+            ++failures;
+        }
+    }
+
+    // 设备端：每个分区单独收集后解析
+    std::string full = fullDump(device);
+    struct Input {
+        const char* name;
+        bool wholeDump;
+    };
+    for (Input input : {Input{"section", false}, Input{"full dump", true}}) {
+        std::string_view values[FIELD_COUNT];
+        bool found[FIELD_COUNT] = {};
+        std::vector<std::string> texts;
+        if (input.wholeDump) {
+            extractFields(full, catalogSections(), values, found);
+        } else {
+            texts.reserve(FIELD_COUNT);
+            for (uint32_t rest = catalogSections(); rest != 0; rest &= rest - 1) {
+                FingerprintSection section = static_cast<FingerprintSection>(rest & -rest);
+                texts.push_back(sectionText(section, device));
+                extractFields(texts.back(), section, values, found);
+            }
+        }
+        for (int i = 0; i < FIELD_COUNT; ++i) {
+            if (!found[i] || values[i] != device.values[i]) {
+                fprintf(stderr, "FAIL %s (%s): expected [%s], got %s[%.*s]\n", kFieldSources[i].name, input.name,
+                        device.values[i].c_str(), found[i] ? "" : "nothing ", static_cast<int>(values[i].size()),
+                        values[i].data());
+                ++failures;
+            }
+        }
+    }
+
+    // 收集失败（env为空）的分区不产生任何字段
+    std::string_view values[FIELD_COUNT];
+    bool found[FIELD_COUNT] = {};
+    extractFields("Unable to retrieve: JNIEnv not available\n", catalogSections(), values, found);
+    if (std::count(std::begin(found), std::end(found), true) != 0) {
+        fprintf(stderr, "FAIL fields found in a failed section\n");
+        ++failures;
+    }
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    printf("ok: %d catalog fields\n", static_cast<int>(FIELD_COUNT));
+    return 0;
+}
+
+int runExtract(int argc, char** argv) {
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; ++i) collectInputFiles(argv[i], &files);
+
+    size_t records = 0;
+    for (const std::string& path : files) {
+        std::ifstream input(path, std::ios::binary);
+        if (!input) {
+            fprintf(stderr, "Unable to read %s\n", path.c_str());
+            return 1;
+        }
+        std::ostringstream buffer;
+        buffer << input.rdbuf();
+        std::string text = buffer.str();
+
+        dump_records::forEachRecord(text, [&](std::string_view record) {
+            std::string_view values[FIELD_COUNT];
+            bool found[FIELD_COUNT] = {};
+            extractFields(record, catalogSections(), values, found);
+            printf("# %s record %zu\n", path.c_str(), ++records);
+            for (int i = 0; i < FIELD_COUNT; ++i) {
+                if (found[i]) {
+                    printf("%s=%.*s\n", kFieldSources[i].name, static_cast<int>(values[i].size()), values[i].data());
+                }
+            }
+        });
+    }
+    return 0;
+}
+
+int usage(const char* program) {
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s extract PATH...\n"
+            "  %s check\n",
+            program, program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+    std::string_view command(argv[1]);
+    if (command == "extract" && argc > 2) return runExtract(argc, argv);
+    if (command == "check") return runCheck();
+    return usage(argv[0]);
+}
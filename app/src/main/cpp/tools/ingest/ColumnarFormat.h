@@ -0,0 +1,36 @@
+#ifndef COLUMNAR_FORMAT_H
+#define COLUMNAR_FORMAT_H
+
+#include <cstdint>
+
+/**
+ * 指纹列式文件（.fpcs）
+ *
+ *   ColumnarFileHeader
+ *   列数据块 * columnCount（写入顺序不固定，由页脚记录偏移）
+ *   页脚：columnCount个列描述
+ *     fixed64 fieldId, varint名称长度, 名称("分区/键[#n]"),
+ *     u8 encoding, u8 codeWidth, varint字典大小, varint非空行数,
+ *     fixed64 数据偏移, fixed64 数据长度
+ *
+ * 列数据块：
+ *   ENCODING_DICT   varint字典大小, (varint长度, 值)*, 每行codeWidth字节的小端编码，0表示缺失
+ *   ENCODING_PLAIN  每行 varint(长度+1) + 值，0表示缺失（几乎每行都不同的列，如boot_id）
+ */
+constexpr char kColumnarMagic[4] = {'F', 'P', 'C', 'S'};
+constexpr uint32_t kColumnarVersion = 1;
+
+enum ColumnEncoding : uint8_t {
+    ENCODING_DICT = 1,
+    ENCODING_PLAIN = 2,
+};
+
+struct ColumnarFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t rowCount;
+    uint64_t columnCount;
+    uint64_t footerOffset;
+};
+
+#endif // COLUMNAR_FORMAT_H
@@ -0,0 +1,370 @@
+/**
+ * fingerprint_ingest - 把 getAllDeviceFingerprintNative 的文本输出批量导入列式文件
+ *
+ * 用法:
+ *   fingerprint_ingest -o out.fpcs [-j 线程数] [--chunk-mb N] 输入文件或目录...
+ *   fingerprint_ingest --inspect out.fpcs
+ *
+ * 流程：
+ *   1. mmap全部输入，在记录边界上切成约chunk大小的工作单元
+ *   2. 各线程用dump::forEachField解析，字段值是指向映射内存的视图，解析本身不分配内存；
+ *      每个单元内按列做局部字典编码
+ *   3. 按列并行合并为全局字典并编码，追加写入输出文件，最后写页脚和文件头
+ */
+#include "ColumnarFormat.h"
+#include "../common/DumpRecords.h"
+#include "../common/FlatIdMap.h"
+#include "../common/HostIo.h"
+#include "../common/ParallelFor.h"
+#include "../../include/DumpParser.h"
+#include "../../include/FieldDefinitions.h"
+#include "../../include/FieldSnapshot.h"
+#include "../../include/private/VarInt.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+
+// 单个工作单元内的一列
+struct LocalColumn {
+    uint64_t id;
+    std::string_view section;
+    std::string_view key;
+    uint32_t occurrence;
+    std::unordered_map<std::string_view, uint32_t> dictionary;
+    std::vector<std::string_view> values;              // 局部编码-1 -> 值
+    std::vector<std::pair<uint32_t, uint32_t>> cells;  // (单元内行号, 局部编码)
+};
+
+struct UnitResult {
+    uint32_t rowCount = 0;
+    FlatIdMap index;
+    std::vector<LocalColumn> columns;
+};
+
+struct GlobalColumn {
+    uint64_t id;
+    std::string name;
+    bool alwaysDictionary;
+    std::vector<std::pair<uint32_t, uint32_t>> parts;  // (单元, 单元内列下标)
+};
+
+struct ColumnDescriptor {
+    uint8_t encoding = 0;
+    uint8_t codeWidth = 0;
+    uint64_t dictionarySize = 0;
+    uint64_t presentCount = 0;
+    uint64_t offset = 0;
+    uint64_t size = 0;
+};
+
+void parseUnit(std::string_view unit, UnitResult* out, FlatIdMap* occurrences) {
+    dump_records::forEachRecord(unit, [&](std::string_view record) {
+        uint32_t row = out->rowCount++;
+        occurrences->clear();
+
+        dump::forEachField(record.data(), record.size(),
+                           [&](std::string_view section, std::string_view key, std::string_view value) {
+            uint64_t baseId = FieldSnapshot::fieldId(section, key);
+            uint32_t occurrence = occurrences->at(baseId)++;
+            uint64_t id = occurrence == 0 ? baseId : FieldSnapshot::fieldId(section, key, occurrence);
+
+            bool inserted = false;
+            uint32_t columnIndex = out->index.at(id, static_cast<uint32_t>(out->columns.size()), &inserted);
+            if (inserted) {
+                out->columns.push_back({id, section, key, occurrence, {}, {}, {}});
+            }
+
+            LocalColumn& column = out->columns[columnIndex];
+            auto it = column.dictionary.try_emplace(value, static_cast<uint32_t>(column.values.size() + 1)).first;
+            if (it->second > column.values.size()) column.values.push_back(value);
+            column.cells.emplace_back(row, it->second);
+        });
+    });
+}
+
+std::string columnName(const LocalColumn& column) {
+    std::string name(column.section);
+    name += '/';
+    name.append(column.key.data(), column.key.size());
+    if (column.occurrence > 0) name += "#" + std::to_string(column.occurrence);
+    return name;
+}
+
+uint8_t codeWidthFor(size_t dictionarySize) {
+    if (dictionarySize < 0xff) return 1;
+    if (dictionarySize < 0xffff) return 2;
+    return 4;
+}
+
+// 合并一列的所有局部字典，返回编码后的列数据块
+std::string encodeColumn(const GlobalColumn& column, const std::vector<UnitResult>& units,
+                         const std::vector<uint64_t>& rowBase, uint64_t rowCount, ColumnDescriptor* descriptor) {
+    std::unordered_map<std::string_view, uint32_t> dictionary;
+    std::vector<std::string_view> values;
+    std::vector<uint32_t> codes(rowCount, 0);
+    std::vector<uint32_t> remap;
+
+    for (const auto& part : column.parts) {
+        const LocalColumn& local = units[part.first].columns[part.second];
+        remap.assign(local.values.size() + 1, 0);
+        for (size_t i = 0; i < local.values.size(); ++i) {
+            auto it = dictionary.try_emplace(local.values[i], static_cast<uint32_t>(values.size() + 1)).first;
+            if (it->second > values.size()) values.push_back(local.values[i]);
+            remap[i + 1] = it->second;
+        }
+        for (const auto& cell : local.cells) {
+            codes[rowBase[part.first] + cell.first] = remap[cell.second];
+        }
+        descriptor->presentCount += local.cells.size();
+    }
+
+    std::string block;
+    descriptor->dictionarySize = values.size();
+
+    // 几乎每行都不同的列字典没有收益，直接按行存值
+    if (!column.alwaysDictionary && values.size() * 2 > descriptor->presentCount) {
+        descriptor->encoding = ENCODING_PLAIN;
+        for (uint32_t code : codes) {
+            if (code == 0) {
+                putVarint(&block, 0);
+                continue;
+            }
+            std::string_view value = values[code - 1];
+            putVarint(&block, value.size() + 1);
+            block.append(value.data(), value.size());
+        }
+        return block;
+    }
+
+    descriptor->encoding = ENCODING_DICT;
+    descriptor->codeWidth = codeWidthFor(values.size());
+    putVarint(&block, values.size());
+    for (std::string_view value : values) {
+        putVarint(&block, value.size());
+        block.append(value.data(), value.size());
+    }
+
+    size_t base = block.size();
+    block.resize(base + codes.size() * descriptor->codeWidth);
+    char* out = &block[base];
+    for (uint32_t code : codes) {
+        for (uint8_t b = 0; b < descriptor->codeWidth; ++b) {
+            *out++ = static_cast<char>(code >> (b * 8));
+        }
+    }
+    return block;
+}
+
+bool isKeyPropertyColumn(std::string_view key) {
+    for (const char* property : kKeyBuildProperties) {
+        if (key == property) return true;
+    }
+    return false;
+}
+
+int ingest(const std::string& outputPath, const std::vector<std::string>& inputs, unsigned threads,
+           size_t chunkSize) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::string> paths;
+    for (const auto& input : inputs) {
+        collectInputFiles(input, &paths);
+    }
+    if (paths.empty()) {
+        fprintf(stderr, "No input files\n");
+        return 1;
+    }
+
+    std::vector<MappedFile> files(paths.size());
+    parallelFor(paths.size(), threads, [&](size_t i, unsigned) { files[i].open(paths[i]); });
+
+    uint64_t totalBytes = 0;
+    std::vector<std::string_view> workUnits;
+    for (const auto& file : files) {
+        totalBytes += file.size();
+        for (std::string_view chunk : dump_records::splitAtRecords(file.view(), chunkSize)) {
+            workUnits.push_back(chunk);
+        }
+    }
+
+    // 每个线程一张出现次数表，按记录重置
+    std::vector<UnitResult> units(workUnits.size());
+    std::vector<FlatIdMap> occurrences(threads);
+    parallelFor(workUnits.size(), threads, [&](size_t i, unsigned worker) {
+        parseUnit(workUnits[i], &units[i], &occurrences[worker]);
+    });
+
+    std::vector<uint64_t> rowBase(units.size());
+    uint64_t rowCount = 0;
+    for (size_t i = 0; i < units.size(); ++i) {
+        rowBase[i] = rowCount;
+        rowCount += units[i].rowCount;
+    }
+
+    // 按首次出现顺序汇总全局列，保证同样的输入得到同样的列顺序
+    FlatIdMap globalIndex(1024);
+    std::vector<GlobalColumn> columns;
+    for (uint32_t u = 0; u < units.size(); ++u) {
+        for (uint32_t c = 0; c < units[u].columns.size(); ++c) {
+            const LocalColumn& local = units[u].columns[c];
+            bool inserted = false;
+            uint32_t index = globalIndex.at(local.id, static_cast<uint32_t>(columns.size()), &inserted);
+            if (inserted) {
+                columns.push_back({local.id, columnName(local), isKeyPropertyColumn(local.key), {}});
+            }
+            columns[index].parts.emplace_back(u, c);
+        }
+    }
+
+    ScopedFd fd(open(outputPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+    if (!fd.isValid()) {
+        fprintf(stderr, "Failed to create %s, errno: %d\n", outputPath.c_str(), errno);
+        return 1;
+    }
+
+    std::vector<ColumnDescriptor> descriptors(columns.size());
+    std::mutex writeMutex;
+    uint64_t writeOffset = sizeof(ColumnarFileHeader);
+    bool writeFailed = false;
+
+    parallelFor(columns.size(), threads, [&](size_t i, unsigned) {
+        std::string block = encodeColumn(columns[i], units, rowBase, rowCount, &descriptors[i]);
+
+        uint64_t offset;
+        {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            offset = writeOffset;
+            writeOffset += block.size();
+        }
+        descriptors[i].offset = offset;
+        descriptors[i].size = block.size();
+        if (!writeAll(fd.get(), block.data(), block.size(), static_cast<off_t>(offset))) {
+            std::lock_guard<std::mutex> lock(writeMutex);
+            writeFailed = true;
+        }
+    });
+
+    std::string footer;
+    for (size_t i = 0; i < columns.size(); ++i) {
+        const ColumnDescriptor& descriptor = descriptors[i];
+        putFixed64(&footer, columns[i].id);
+        putVarint(&footer, columns[i].name.size());
+        footer += columns[i].name;
+        footer.push_back(static_cast<char>(descriptor.encoding));
+        footer.push_back(static_cast<char>(descriptor.codeWidth));
+        putVarint(&footer, descriptor.dictionarySize);
+        putVarint(&footer, descriptor.presentCount);
+        putFixed64(&footer, descriptor.offset);
+        putFixed64(&footer, descriptor.size);
+    }
+
+    ColumnarFileHeader header = {};
+    memcpy(header.magic, kColumnarMagic, sizeof(header.magic));
+    header.version = kColumnarVersion;
+    header.rowCount = rowCount;
+    header.columnCount = columns.size();
+    header.footerOffset = writeOffset;
+
+    if (writeFailed || !writeAll(fd.get(), footer.data(), footer.size(), static_cast<off_t>(writeOffset)) ||
+        !writeAll(fd.get(), &header, sizeof(header), 0)) {
+        fprintf(stderr, "Failed to write %s, errno: %d\n", outputPath.c_str(), errno);
+        unlink(outputPath.c_str());
+        return 1;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    fprintf(stderr, "Ingested %zu files, %llu rows, %zu columns, %.1f MB in %.2fs (%.1f MB/s, %u threads)\n",
+            paths.size(), static_cast<unsigned long long>(rowCount), columns.size(),
+            totalBytes / 1048576.0, seconds, seconds > 0 ? totalBytes / 1048576.0 / seconds : 0.0, threads);
+    return 0;
+}
+
+int inspect(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) return 1;
+
+    std::string_view data = file.view();
+    ColumnarFileHeader header;
+    if (data.size() < sizeof(header)) {
+        fprintf(stderr, "%s: file too small\n", path.c_str());
+        return 1;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, kColumnarMagic, sizeof(header.magic)) != 0 || header.version != kColumnarVersion ||
+        header.footerOffset > data.size()) {
+        fprintf(stderr, "%s: not a columnar fingerprint file\n", path.c_str());
+        return 1;
+    }
+
+    printf("rows: %llu, columns: %llu\n", static_cast<unsigned long long>(header.rowCount),
+           static_cast<unsigned long long>(header.columnCount));
+
+    const char* cursor = data.data() + header.footerOffset;
+    const char* end = data.data() + data.size();
+    for (uint64_t i = 0; i < header.columnCount; ++i) {
+        uint64_t id, nameLength, dictionarySize, presentCount, offset, size;
+        if (!getFixed64(&cursor, end, &id) || !getVarint(&cursor, end, &nameLength) ||
+            static_cast<uint64_t>(end - cursor) < nameLength + 2) {
+            fprintf(stderr, "%s: truncated footer\n", path.c_str());
+            return 1;
+        }
+        std::string_view name(cursor, nameLength);
+        cursor += nameLength;
+        uint8_t encoding = static_cast<uint8_t>(*cursor++);
+        uint8_t codeWidth = static_cast<uint8_t>(*cursor++);
+        if (!getVarint(&cursor, end, &dictionarySize) || !getVarint(&cursor, end, &presentCount) ||
+            !getFixed64(&cursor, end, &offset) || !getFixed64(&cursor, end, &size)) {
+            fprintf(stderr, "%s: truncated footer\n", path.c_str());
+            return 1;
+        }
+        printf("%016llx %-6s w%u dict=%-8llu present=%-8llu bytes=%-10llu %.*s\n",
+               static_cast<unsigned long long>(id), encoding == ENCODING_DICT ? "dict" : "plain", codeWidth,
+               static_cast<unsigned long long>(dictionarySize), static_cast<unsigned long long>(presentCount),
+               static_cast<unsigned long long>(size), static_cast<int>(name.size()), name.data());
+    }
+    return 0;
+}
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s -o <output.fpcs> [-j threads] [--chunk-mb N] <file|dir>...\n"
+            "       %s --inspect <file.fpcs>\n",
+            program, program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::string output;
+    std::vector<std::string> inputs;
+    unsigned threads = defaultThreadCount();
+    size_t chunkSize = 64u << 20;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--inspect" && i + 1 < argc) {
+            return inspect(argv[i + 1]);
+        } else if (arg == "-o" && i + 1 < argc) {
+            output = argv[++i];
+        } else if (arg == "-j" && i + 1 < argc) {
+            threads = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--chunk-mb" && i + 1 < argc) {
+            chunkSize = static_cast<size_t>(std::max(1, atoi(argv[++i]))) << 20;
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            inputs.emplace_back(arg);
+        }
+    }
+
+    if (output.empty() || inputs.empty()) {
+        usage(argv[0]);
+        return 2;
+    }
+    return ingest(output, inputs, threads, chunkSize);
+}
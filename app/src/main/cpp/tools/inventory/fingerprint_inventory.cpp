@@ -0,0 +1,108 @@
+/**
+ * fingerprint_inventory - 对任意目录树运行设备端的分区清单摘要
+ *
+ * 用法:
+ *   fingerprint_inventory [-j 线程数] [--iterations N] 目录...
+ *       输出每个目录的条目数、目录数、字节数和摘要，以及合并摘要；
+ *       然后分别用单线程和 -j 个后台线程重复遍历，对比耗时并检查两者摘要一致。
+ *       第一次遍历可能受冷缓存影响，统计取最小值和中位数。
+ *
+ * 例如用解包后的system/vendor镜像目录复现设备上的摘要，或用 /usr 之类的大目录树测量扩展性。
+ */
+#include "PartitionInventory.h"
+#include "IoBackend.h"
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <thread>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+void printResults(const std::vector<partition_inventory::RootResult>& results) {
+    for (const partition_inventory::RootResult& root : results) {
+        if (!root.present) {
+            printf("%s: absent\n", root.path.c_str());
+            continue;
+        }
+        printf("%s: entries %" PRIu64 ", dirs %" PRIu64 ", bytes %" PRIu64 ", digest %016" PRIx64, root.path.c_str(),
+               root.entries, root.directories, root.totalBytes, root.digest);
+        if (root.errors > 0) printf(", errors %" PRIu64, root.errors);
+        printf("\n");
+    }
+    printf("inventory_digest: %016" PRIx64 "\n", partition_inventory::combinedDigest(results));
+}
+
+// 返回合并摘要，耗时（毫秒）写入times
+uint64_t benchmark(const std::vector<std::string>& roots, unsigned threads, unsigned iterations,
+                   std::vector<double>* times, uint64_t* stolen) {
+    WorkStealingPool pool(threads);
+    uint64_t digest = 0;
+    for (unsigned i = 0; i < iterations; ++i) {
+        Clock::time_point start = Clock::now();
+        digest = partition_inventory::combinedDigest(partition_inventory::scan<LibcIo>(roots, pool));
+        times->push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+    }
+    std::sort(times->begin(), times->end());
+    *stolen = pool.stealCount();
+    return digest;
+}
+
+void usage(const char* program) {
+    fprintf(stderr, "Usage: %s [-j threads] [--iterations N] <dir>...\n", program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    unsigned iterations = 20;
+    std::vector<std::string> roots;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        bool hasValue = i + 1 < argc;
+        if (arg == "-j" && hasValue) {
+            threads = static_cast<unsigned>(std::max(0, atoi(argv[++i])));
+        } else if (arg == "--iterations" && hasValue) {
+            iterations = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            // 去掉末尾的 '/'，相对路径从根目录之后开始
+            std::string root(arg);
+            while (root.size() > 1 && root.back() == '/') root.pop_back();
+            roots.push_back(root);
+        }
+    }
+    if (roots.empty()) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    WorkStealingPool pool(threads);
+    std::vector<partition_inventory::RootResult> results = partition_inventory::scan<LibcIo>(roots, pool);
+    printResults(results);
+
+    uint64_t entries = 0;
+    for (const partition_inventory::RootResult& root : results) entries += root.entries;
+
+    uint64_t reference = 0;
+    for (unsigned workers : {0u, threads}) {
+        std::vector<double> times;
+        uint64_t stolen = 0;
+        uint64_t digest = benchmark(roots, workers, iterations, &times, &stolen);
+        if (workers == 0) reference = digest;
+        printf("%u worker(s): min %.2fms, median %.2fms, %.1f entries/ms, %" PRIu64 " steals%s\n", workers + 1,
+               times.front(), times[times.size() / 2], entries / times[times.size() / 2], stolen,
+               digest == reference ? "" : ", DIGEST MISMATCH");
+        if (digest != reference) return 1;
+        if (threads == 0) break;
+    }
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**
+ * fingerprint_kconfig - 设备端内核配置流式解析的主机工具
+ *
+ * 用法:
+ *   fingerprint_kconfig scan [-o CONFIG_A,CONFIG_B] config.gz...
+ *       流式解析并输出选项值、计数和启用选项摘要
+ *   fingerprint_kconfig bench [--iterations N] config.gz...
+ *       对比流式解析与"整体gunzip到string再解析"的耗时和内存分配
+ *   fingerprint_kconfig check config.gz expected [config.gz expected]...
+ *       流式路径和整体解压路径都必须与expected一致（expected由独立实现生成，见fixtures/）
+ */
+#include "KernelConfigScanner.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string_view>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+bool scanFile(const std::string& path, KernelConfigScanner* scanner, std::string* error) {
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        *error = "cannot open";
+        return false;
+    }
+    bool ok = scanner->scanGzip([fd](void* buffer, size_t size) { return read(fd, buffer, size); }, error);
+    close(fd);
+    return ok;
+}
+
+// 对照路径：整个文件解压到string，返回为此分配的容量
+bool gunzipFile(const std::string& path, std::string* text, size_t* allocated) {
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+    text->clear();
+    std::string().swap(*text);
+    char buffer[16384];
+    int bytes;
+    while ((bytes = gzread(file, buffer, sizeof(buffer))) > 0) {
+        text->append(buffer, static_cast<size_t>(bytes));
+    }
+    gzclose(file);
+    *allocated = text->capacity();
+    return bytes == 0;
+}
+
+std::vector<std::string> summaryLines(const KernelConfigScanner::Summary& summary) {
+    std::vector<std::string> lines;
+    for (const auto& option : summary.selected) {
+        lines.push_back("option " + option.first + "=" + option.second);
+    }
+    char digest[32];
+    snprintf(digest, sizeof(digest), "%016" PRIx64, summary.enabledDigest);
+    lines.push_back("header=" + summary.header);
+    lines.push_back("builtin=" + std::to_string(summary.builtin));
+    lines.push_back("modules=" + std::to_string(summary.modules));
+    lines.push_back("valued=" + std::to_string(summary.valued));
+    lines.push_back("not_set=" + std::to_string(summary.notSet));
+    lines.push_back("overlong=" + std::to_string(summary.overlong));
+    lines.push_back("uncompressed_bytes=" + std::to_string(summary.uncompressedBytes));
+    lines.push_back(std::string("enabled_digest=") + digest);
+    return lines;
+}
+
+std::vector<std::string> splitOptions(std::string_view list) {
+    std::vector<std::string> options;
+    while (!list.empty()) {
+        size_t comma = list.find(',');
+        if (comma > 0) options.emplace_back(list.substr(0, comma));
+        if (comma == std::string_view::npos) break;
+        list.remove_prefix(comma + 1);
+    }
+    return options;
+}
+
+int scanCommand(const std::vector<std::string>& options, const std::vector<std::string>& files) {
+    int status = 0;
+    for (const std::string& file : files) {
+        KernelConfigScanner scanner(options);
+        std::string error;
+        if (!scanFile(file, &scanner, &error)) {
+            fprintf(stderr, "%s: %s\n", file.c_str(), error.c_str());
+            status = 1;
+            continue;
+        }
+        printf("--- %s ---\n", file.c_str());
+        for (const std::string& line : summaryLines(scanner.summary())) {
+            printf("%s\n", line.c_str());
+        }
+    }
+    return status;
+}
+
+int benchCommand(unsigned iterations, const std::vector<std::string>& files) {
+    for (const std::string& file : files) {
+        double streaming = 1e9;
+        double whole = 1e9;
+        size_t allocated = 0;
+        uint64_t streamingDigest = 0;
+        uint64_t wholeDigest = 0;
+        for (unsigned i = 0; i < iterations; ++i) {
+            KernelConfigScanner scanner;
+            std::string error;
+            Clock::time_point start = Clock::now();
+            if (!scanFile(file, &scanner, &error)) {
+                fprintf(stderr, "%s: %s\n", file.c_str(), error.c_str());
+                return 1;
+            }
+            streaming = std::min(streaming, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            streamingDigest = scanner.summary().enabledDigest;
+
+            start = Clock::now();
+            std::string text;
+            if (!gunzipFile(file, &text, &allocated)) {
+                fprintf(stderr, "%s: gunzip failed\n", file.c_str());
+                return 1;
+            }
+            scanner.scanText(text);
+            whole = std::min(whole, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            wholeDigest = scanner.summary().enabledDigest;
+        }
+        printf("%s: streaming %.0fus (%zu byte buffers), gunzip+parse %.0fus (%zu bytes allocated)%s\n",
+               file.c_str(), streaming, KernelConfigScanner::kInputBufferSize + KernelConfigScanner::kWindowSize,
+               whole, allocated, streamingDigest == wholeDigest ? "" : ", DIGEST MISMATCH");
+        if (streamingDigest != wholeDigest) return 1;
+    }
+    return 0;
+}
+
+// expected中 "option NAME=" 行给出要提取的选项，其余行是期望的摘要字段
+int checkOne(const std::string& fixture, const std::string& expectedPath) {
+    std::ifstream input(expectedPath);
+    if (!input) {
+        fprintf(stderr, "Cannot read %s\n", expectedPath.c_str());
+        return 1;
+    }
+    std::vector<std::string> expected;
+    std::vector<std::string> options;
+    for (std::string line; std::getline(input, line);) {
+        if (line.empty()) continue;
+        if (line.compare(0, 7, "option ") == 0) options.push_back(line.substr(7, line.find('=') - 7));
+        expected.push_back(line);
+    }
+
+    KernelConfigScanner scanner(options);
+    std::string error;
+    if (!scanFile(fixture, &scanner, &error)) {
+        fprintf(stderr, "%s: %s\n", fixture.c_str(), error.c_str());
+        return 1;
+    }
+    std::vector<std::string> streamed = summaryLines(scanner.summary());
+
+    std::string text;
+    size_t allocated = 0;
+    if (!gunzipFile(fixture, &text, &allocated)) {
+        fprintf(stderr, "%s: gunzip failed\n", fixture.c_str());
+        return 1;
+    }
+    scanner.scanText(text);
+    std::vector<std::string> whole = summaryLines(scanner.summary());
+
+    int failures = 0;
+    for (size_t i = 0; i < std::max({expected.size(), streamed.size(), whole.size()}); ++i) {
+        const std::string missing = "<missing>";
+        const std::string& want = i < expected.size() ? expected[i] : missing;
+        const std::string& gotStreamed = i < streamed.size() ? streamed[i] : missing;
+        const std::string& gotWhole = i < whole.size() ? whole[i] : missing;
+        if (want != gotStreamed || want != gotWhole) {
+            fprintf(stderr, "%s: expected '%s', streaming '%s', whole '%s'\n", fixture.c_str(), want.c_str(),
+                    gotStreamed.c_str(), gotWhole.c_str());
+            ++failures;
+        }
+    }
+    printf("%s: %s\n", fixture.c_str(), failures == 0 ? "ok" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s scan [-o CONFIG_A,CONFIG_B] <config.gz>...\n"
+            "       %s bench [--iterations N] <config.gz>...\n"
+            "       %s check <config.gz> <expected> [<config.gz> <expected>]...\n",
+            program, program, program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string_view command(argv[1]);
+    std::vector<std::string> options;
+    unsigned iterations = 200;
+    std::vector<std::string> positional;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            options = splitOptions(argv[++i]);
+        } else if (arg == "--iterations" && hasValue) {
+            iterations = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            positional.emplace_back(arg);
+        }
+    }
+
+    if (command == "scan" && !positional.empty()) {
+        return scanCommand(options, positional);
+    } else if (command == "bench" && !positional.empty()) {
+        return benchCommand(iterations, positional);
+    } else if (command == "check" && !positional.empty() && positional.size() % 2 == 0) {
+        int status = 0;
+        for (size_t i = 0; i < positional.size(); i += 2) {
+            status |= checkOne(positional[i], positional[i + 1]);
+        }
+        return status;
+    }
+    usage(argv[0]);
+    return 2;
+}
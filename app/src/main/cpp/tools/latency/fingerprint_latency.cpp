@@ -0,0 +1,591 @@
+/**
+ * fingerprint_latency - 在注入的I/O延迟和错误下测量整次收集的尾延迟
+ *
+ * 用法:
+ *   fingerprint_latency bench [--profile NAME] [--iterations N] [--root DIR]
+ *       在夹具目录（默认临时生成，结构同设备上的 /proc、/sys、build.prop 等）上按分区收集，
+ *       （--root 时夹具写在DIR下，结束时删除），通过 FaultInjectingIo<LibcIo> 注入所选配置的
+ *       延迟分布、短读、EINTR、EAGAIN，输出串行收集和按DeadlineRunner预算并行收集的
+ *       p50/p99/p999 以及各分区超时次数
+ *   fingerprint_latency check
+ *       在短读、EINTR、EAGAIN下的收集结果必须与不注入时逐字节一致；
+ *       EAGAIN超过重试上限时必须报告读取失败
+ *   fingerprint_latency profiles
+ *       列出内置配置
+ *
+ * 分区只复现收集器中不依赖JNI的文件访问：路径列表来自 FieldDefinitions.h，build.prop 用
+ * KeyPropertyFilter 过滤，读取走 file_reader；JNI、FileSignatureCache、SectionCache 不参与。
+ * 并行收集与 CollectionService 一样用 SingleFlight 合并同一分区的收集，
+ * 等待用 DeadlineRunner 的 deadline_wait（分区预算、截止时间）
+ */
+#include "../common/FaultInjectingIo.h"
+#include "FileReader.h"
+#include "FieldDefinitions.h"
+#include "KeyPropertyFilter.h"
+#include "SingleFlight.h"
+#include "private/DeadlineWait.h"
+#include <sys/stat.h>
+#include <sys/statfs.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Io = FaultInjectingIo<LibcIo>;
+using Clock = deadline_wait::Clock;
+using fault_io::Latency;
+using fault_io::Rule;
+
+std::string g_root;
+
+// 设备上的绝对路径映射到夹具目录下
+std::string fixturePath(const char* path) {
+    return g_root + path;
+}
+
+// ---- 读取（BaseCollector 的 readFile/readFilePrefix/fileExists 在 file_reader 上的包装） ----
+
+std::string readFile(const char* path) {
+    std::string fullPath = fixturePath(path);
+    std::string content;
+    switch (file_reader::readAll<Io>(fullPath.c_str(), &content)) {
+        case file_reader::Status::OK:          return content;
+        case file_reader::Status::OPEN_FAILED: return "Unable to read file: " + fullPath + "\n";
+        case file_reader::Status::STAT_FAILED: return "Unable to get file stat: " + fullPath + "\n";
+        case file_reader::Status::READ_FAILED: return "Unable to read file content: " + fullPath + "\n";
+    }
+    return std::string();
+}
+
+bool fileExists(const char* path) {
+    return Io::access(fixturePath(path).c_str()) == 0;
+}
+
+// ---- 分区 ----
+
+struct Section {
+    FingerprintSection id;
+    const char* name;       // 与 sectionName() 相同
+    std::string (*collect)();
+};
+
+// SystemCollector::collectBuildPropFiles / parseBuildProp
+std::string collectBuildProp() {
+    std::string result;
+    for (const char* path : kBuildPropFiles) {
+        result += "=== " + std::string(path) + " ===\n";
+        if (!fileExists(path)) {
+            result += "File does not exist\n\n";
+            continue;
+        }
+        KeyPropertyFilter filter;
+        file_reader::Status status;
+        long bytes = file_reader::readLines<Io>(fixturePath(path).c_str(),
+                                                [&filter](std::string_view line) { return filter.onLine(line); },
+                                                &status);
+        if (bytes <= 0) {
+            result += "File is empty or could not be read\n\n";
+            continue;
+        }
+        result += filter.found().empty() ? std::string("No key properties found\n") : filter.found();
+        result += "\n";
+    }
+    return result;
+}
+
+// SystemCollector::collectKernelFilesInfo 中的 "Other System Files"
+std::string collectKernelFiles() {
+    std::string result = "=== Other System Files ===\n";
+    for (const char* path : kOtherSystemFiles) {
+        result += "--- " + std::string(path) + " ---\n";
+        if (!fileExists(path)) {
+            result += "File does not exist\n\n";
+            continue;
+        }
+        std::string content;
+        bool truncated = false;
+        if (file_reader::readPrefix<Io>(fixturePath(path).c_str(), kOtherSystemFilePrefix, &content, &truncated) !=
+            file_reader::Status::OK) {
+            content = "Unable to read file: " + fixturePath(path) + "\n";
+        }
+        result += content + (truncated ? "...\n" : "\n") + "\n";
+    }
+    return result;
+}
+
+// SystemCollector::collectSystemFiles（system_files 分区中的标识文件部分）
+std::string collectSystemFiles() {
+    std::string result;
+    for (const char* path : kSystemIdentifierFiles) {
+        result += "=== " + std::string(path) + " ===\n";
+        if (!fileExists(path)) {
+            result += "File does not exist\n\n";
+            continue;
+        }
+        std::string content = readFile(path);
+        if (content.empty() || content.find("Unable to read") != std::string::npos) {
+            result += "File exists but could not be read\n\n";
+            continue;
+        }
+        content.erase(std::remove(content.begin(), content.end(), '\n'), content.end());
+        content.erase(std::remove(content.begin(), content.end(), '\r'), content.end());
+        result += std::string(kIdentifierContentKey) + ": " + content + "\n\n";
+    }
+    return result;
+}
+
+// CommonCollector::getCpuInfo 读取的文件
+std::string collectCpuInfo() {
+    return readFile("/proc/cpuinfo");
+}
+
+// SystemCollector::collectFileSystemInfo 中的 statfs64
+std::string collectFileSystem() {
+    struct statfs64 st;
+    if (Io::statfs(fixturePath("/storage/emulated/0").c_str(), &st) != 0) {
+        return "Unable to retrieve: statfs failed: " + std::string(strerror(errno)) + "\n";
+    }
+    // 剩余空间会变，只输出块大小
+    return "Block Size: " + std::to_string(st.f_bsize) + "\n";
+}
+
+const Section kSections[] = {
+    {SECTION_BUILD_PROP,   "build_prop",   collectBuildProp},
+    {SECTION_KERNEL_FILES, "kernel_files", collectKernelFiles},
+    {SECTION_SYSTEM_FILES, "system_files", collectSystemFiles},
+    {SECTION_CPU_INFO,     "cpu_info",     collectCpuInfo},
+    {SECTION_FILE_SYSTEM,  "file_system",  collectFileSystem},
+};
+constexpr size_t kSectionCount = sizeof(kSections) / sizeof(kSections[0]);
+// DeadlineRunner::kDefaultDeadline
+constexpr std::chrono::milliseconds kDeadline(2500);
+
+// ---- 夹具 ----
+
+class Fixture {
+public:
+    ~Fixture() {
+        for (auto it = m_created.rbegin(); it != m_created.rend(); ++it) remove(it->c_str());
+    }
+
+    bool create(const std::string& root) {
+        if (root.empty()) {
+            char pattern[] = "/tmp/fingerprint_latency.XXXXXX";
+            if (mkdtemp(pattern) == nullptr) return false;
+            g_root = pattern;
+            m_created.push_back(g_root);
+        } else {
+            g_root = root;
+        }
+
+        // 注释、无关属性和关键属性交错；vendor包含全部关键属性，覆盖提前停止读取
+        std::string props;
+        for (int i = 0; i < 200; ++i) {
+            props += (i % 3 == 0 ? "# comment " : i % 3 == 1 ? "ro.product.prop" : "persist.sys.prop") +
+                     std::to_string(i) + "=value" + std::to_string(i * 7919) + "\n";
+            if (i % 20 == 0) props += std::string(kKeyBuildProperties[i / 20]) + "=key" + std::to_string(i) + "\n";
+        }
+        std::string vendorProps = props;
+        for (const char* key : kKeyBuildProperties) vendorProps += std::string(key) + "=vendor\n";
+        vendorProps += props;
+
+        std::string cpuinfo;
+        for (int cpu = 0; cpu < 8; ++cpu) {
+            cpuinfo += "processor\t: " + std::to_string(cpu) + "\nBogoMIPS\t: 38.40\n"
+                       "Features\t: fp asimd evtstrm aes pmull sha1 sha2 crc32 atomics fphp asimdhp cpuid\n"
+                       "CPU implementer\t: 0x41\nCPU architecture: 8\nCPU variant\t: 0x1\nCPU part\t: 0xd05\n"
+                       "CPU revision\t: 0\n\n";
+        }
+        std::string meminfo;
+        for (const char* key : {"MemTotal", "MemFree", "MemAvailable", "Buffers", "Cached", "SwapCached",
+                                "Active", "Inactive", "SwapTotal", "SwapFree", "Dirty", "Writeback"}) {
+            meminfo += std::string(key) + ":        " + std::to_string(strlen(key) * 123457) + " kB\n";
+        }
+        std::string misc;
+        for (int i = 0; i < 40; ++i) misc += std::to_string(60 + i) + " misc_device_" + std::to_string(i) + "\n";
+
+        return write("/system/build.prop", props) && write("/odm/etc/build.prop", props.substr(0, 2000)) &&
+               write("/product/build.prop", props.substr(1000)) && write("/vendor/build.prop", vendorProps) &&
+               write("/system/etc/prop.default", props.substr(0, 3000)) &&
+               write("/proc/version", "Linux version 5.10.177-android12-9 (build-user@build-host) #1 SMP PREEMPT\n") &&
+               write("/proc/misc", misc) && write("/proc/cpuinfo", cpuinfo) && write("/proc/meminfo", meminfo) &&
+               write("/proc/sys/kernel/random/boot_id", "5e1a4c1e-0f53-4a8e-9a57-3d2c2f0b8a11\n") &&
+               write("/proc/sys/kernel/random/uuid", "9b0d2b4e-7c6f-4f7e-8f0d-1c2b3a4d5e6f\n") &&
+               write("/sys/devices/soc0/serial_number", "2882305748\n") &&
+               makeDirectories("/storage/emulated/0/") && covers(kBuildPropFiles) && covers(kOtherSystemFiles) &&
+               covers(kSystemIdentifierFiles);
+    }
+
+private:
+    // 路径列表中的每个文件都要在夹具中，收集器增删文件时这里会失败而不是静默少测
+    template <size_t N>
+    bool covers(const char* const (&paths)[N]) {
+        for (const char* path : paths) {
+            if (std::find(m_created.begin(), m_created.end(), fixturePath(path)) == m_created.end()) {
+                fprintf(stderr, "Fixture has no %s\n", path);
+                errno = ENOENT;
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // path中每一级目录都创建，最后一个'/'之后的部分不算目录
+    bool makeDirectories(const std::string& path) {
+        for (size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+            std::string directory = g_root + path.substr(0, slash);
+            if (mkdir(directory.c_str(), 0755) == 0) {
+                m_created.push_back(directory);
+            } else if (errno != EEXIST) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool write(const std::string& path, const std::string& content) {
+        if (!makeDirectories(path)) return false;
+        std::string fullPath = g_root + path;
+        FILE* file = fopen(fullPath.c_str(), "wb");
+        if (file == nullptr) return false;
+        bool ok = fwrite(content.data(), 1, content.size(), file) == content.size();
+        ok = fclose(file) == 0 && ok;
+        m_created.push_back(fullPath);
+        return ok;
+    }
+
+    std::vector<std::string> m_created;
+};
+
+// ---- 故障配置 ----
+
+struct Profile {
+    const char* name;
+    const char* description;
+    std::vector<Rule> rules;
+};
+
+Rule rule(const char* prefix, uint32_t operations, Latency latency, double shortRead = 0, double eintr = 0,
+          double eagain = 0) {
+    Rule result;
+    result.prefix = prefix;
+    result.operations = operations;
+    result.latency = latency;
+    result.shortReadProbability = shortRead;
+    result.eintrProbability = eintr;
+    result.eagainProbability = eagain;
+    return result;
+}
+
+std::vector<Profile> profiles() {
+    // 夹具中的延迟按设备上观察到的量级设置：sysfs属性读取要唤醒外设驱动，
+    // FUSE上的statfs要经过用户态守护进程，eMMC在温控降频时每次读都要排队
+    Rule slowSysfs = rule("sys/devices/soc0/", fault_io::OP_OPEN | fault_io::OP_READ,
+                          Latency::lognormal(20000, 0.5).withSpikes(0.02, 600000));
+    Rule slowFuse = rule("storage/", fault_io::OP_STAT, Latency::lognormal(40000, 0.6).withSpikes(0.03, 1200000));
+    std::vector<Rule> throttled;
+    for (const char* prefix : {"system/", "vendor/", "product/", "odm/"}) {
+        throttled.push_back(rule(prefix, fault_io::OP_READ, Latency::uniform(500, 3000).withSpikes(0.01, 80000), 0.3));
+    }
+    Rule flaky = rule("", fault_io::OP_ALL, Latency(), 0.3, 0.1, 0.05);
+
+    std::vector<Rule> all = throttled;
+    all.push_back(slowSysfs);
+    all.push_back(slowFuse);
+    all.push_back(flaky);
+
+    return {
+        {"fast", "no injected faults", {}},
+        {"slow_sysfs", "soc0 serial_number: lognormal 20ms, 2% +600ms", {slowSysfs}},
+        {"slow_fuse", "statfs on FUSE storage: lognormal 40ms, 3% +1200ms", {slowFuse}},
+        {"throttled_emmc", "reads on partitions: uniform 0.5-3ms, 1% +80ms, 30% short reads", throttled},
+        {"flaky", "every path: 30% short reads, 10% EINTR, 5% EAGAIN", {flaky}},
+        {"all", "all of the above", all},
+    };
+}
+
+const Profile* findProfile(const std::vector<Profile>& all, std::string_view name) {
+    for (const Profile& profile : all) {
+        if (name == profile.name) return &profile;
+    }
+    return nullptr;
+}
+
+// ---- 并行收集 ----
+
+// 与 CollectionService::collectAsync 相同：同一分区同一时刻只有一个收集线程，
+// 超时后调用者不再等待，线程自己跑完；下一轮请求加入仍在进行的收集
+using Flight = SingleFlight<int, std::string>::Call;
+SingleFlight<int, std::string> g_flights;
+
+std::mutex g_runningMutex;
+std::condition_variable g_runningDone;
+int g_running = 0;
+
+std::shared_ptr<Flight> startFlight(const Section& section) {
+    int key = __builtin_ctz(static_cast<uint32_t>(section.id));
+    bool leader = false;
+    std::shared_ptr<Flight> flight = g_flights.join(key, &leader);
+    if (!leader) return flight;
+
+    {
+        std::lock_guard<std::mutex> lock(g_runningMutex);
+        ++g_running;
+    }
+    std::thread([key, flight, &section]() {
+        try {
+            g_flights.finish(key, flight, section.collect());
+        } catch (...) {
+            g_flights.fail(key, flight, std::current_exception());
+        }
+        std::lock_guard<std::mutex> lock(g_runningMutex);
+        if (--g_running == 0) g_runningDone.notify_all();
+    }).detach();
+    return flight;
+}
+
+// 退出前等待被放弃的线程，夹具和注入器要比它们活得久
+void waitForAbandoned() {
+    std::unique_lock<std::mutex> lock(g_runningMutex);
+    g_runningDone.wait(lock, []() { return g_running == 0; });
+}
+
+// 与 DeadlineRunner::run 相同：先全部启动再依次等待；返回超时分区的掩码（按kSections下标）
+uint32_t collectParallel(std::vector<std::string>* results) {
+    Clock::time_point start = Clock::now();
+    Clock::time_point deadline = start + kDeadline;
+    std::shared_ptr<Flight> flights[kSectionCount];
+    for (size_t i = 0; i < kSectionCount; ++i) flights[i] = startFlight(kSections[i]);
+
+    uint32_t timedOut = 0;
+    for (size_t i = 0; i < kSectionCount; ++i) {
+        Clock::time_point sectionDeadline = deadline_wait::sectionDeadline(kSections[i].id, start, deadline);
+        if (deadline_wait::wait(*flights[i], sectionDeadline, nullptr) != deadline_wait::Outcome::DONE) {
+            timedOut |= 1u << i;
+            continue;
+        }
+        if (results != nullptr) {
+            try {
+                (*results)[i] = flights[i]->value();
+            } catch (const std::exception& e) {
+                (*results)[i] = "Unable to retrieve: " + std::string(e.what()) + "\n";
+            }
+        }
+    }
+    return timedOut;
+}
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+double percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) return 0;
+    size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size())));
+    std::nth_element(values.begin(), values.begin() + static_cast<long>(index), values.end());
+    return values[index];
+}
+
+void printLatencies(const char* label, const std::vector<double>& values) {
+    printf("%-22s p50 %9.2fms  p99 %9.2fms  p999 %9.2fms  max %9.2fms\n", label, percentile(values, 0.5),
+           percentile(values, 0.99), percentile(values, 0.999), *std::max_element(values.begin(), values.end()));
+}
+
+int runBench(const Profile& profile, unsigned iterations) {
+    fault_io::Injector& injector = fault_io::Injector::instance();
+    injector.setRules(profile.rules, g_root + "/");
+    injector.resetCounters();
+    printf("profile %s (%s), %u iterations, root %s\n", profile.name, profile.description, iterations,
+           g_root.c_str());
+
+    std::vector<double> serial;
+    std::vector<double> perSection[kSectionCount];
+    for (unsigned i = 0; i < iterations; ++i) {
+        Clock::time_point start = Clock::now();
+        for (size_t s = 0; s < kSectionCount; ++s) {
+            Clock::time_point sectionStart = Clock::now();
+            kSections[s].collect();
+            perSection[s].push_back(elapsedMs(sectionStart));
+        }
+        serial.push_back(elapsedMs(start));
+    }
+
+    std::vector<double> parallel;
+    unsigned timeouts[kSectionCount] = {};
+    for (unsigned i = 0; i < iterations; ++i) {
+        Clock::time_point start = Clock::now();
+        uint32_t timedOut = collectParallel(nullptr);
+        parallel.push_back(elapsedMs(start));
+        for (size_t s = 0; s < kSectionCount; ++s) {
+            if (timedOut & (1u << s)) ++timeouts[s];
+        }
+    }
+    waitForAbandoned();
+
+    printLatencies("serial", serial);
+    printLatencies("parallel+deadline", parallel);
+    for (size_t s = 0; s < kSectionCount; ++s) {
+        char label[64];
+        snprintf(label, sizeof(label), "  %s", kSections[s].name);
+        printLatencies(label, perSection[s]);
+        if (timeouts[s] > 0) {
+            printf("  %-20s timed out %u/%u (budget %lldms)\n", kSections[s].name, timeouts[s], iterations,
+                   static_cast<long long>(deadline_wait::sectionBudget(kSections[s].id).count()));
+        }
+    }
+    const fault_io::Counters& counters = injector.counters();
+    printf("injected: ops %llu, delay %.1fms, short reads %llu, EINTR %llu, EAGAIN %llu\n",
+           static_cast<unsigned long long>(counters.operations.load()), counters.delayedUs.load() / 1000.0,
+           static_cast<unsigned long long>(counters.shortReads.load()),
+           static_cast<unsigned long long>(counters.eintr.load()),
+           static_cast<unsigned long long>(counters.eagain.load()));
+    return 0;
+}
+
+std::vector<std::string> collectSerial() {
+    std::vector<std::string> results;
+    for (const Section& section : kSections) results.push_back(section.collect());
+    return results;
+}
+
+int runCheck() {
+    fault_io::Injector& injector = fault_io::Injector::instance();
+    std::string root = g_root + "/";
+    int failures = 0;
+
+    injector.setRules({}, root);
+    std::vector<std::string> expected = collectSerial();
+    std::string baselineMisc = readFile("/proc/misc");
+    for (size_t s = 0; s < kSectionCount; ++s) {
+        if (expected[s].empty() || expected[s].find("Unable to") != std::string::npos ||
+            expected[s].find("could not be read") != std::string::npos ||
+            expected[s].find("does not exist") != std::string::npos) {
+            fprintf(stderr, "FAIL baseline %s: %s\n", kSections[s].name, expected[s].c_str());
+            ++failures;
+        }
+    }
+
+    // 瞬时故障（含1字节短读）只影响耗时，不影响内容；串行和并行路径都要检查
+    Rule transient = rule("", fault_io::OP_ALL, Latency(), 0.5, 0.2, 0.1);
+    injector.setRules({transient}, root);
+    injector.resetCounters();
+    for (int round = 0; round < 100; ++round) {
+        std::vector<std::string> actual = round % 2 == 0 ? collectSerial() : std::vector<std::string>(kSectionCount);
+        if (round % 2 != 0 && collectParallel(&actual) != 0) {
+            fprintf(stderr, "FAIL round %d: parallel collection timed out\n", round);
+            ++failures;
+            continue;
+        }
+        for (size_t s = 0; s < kSectionCount; ++s) {
+            if (actual[s] != expected[s]) {
+                fprintf(stderr, "FAIL round %d %s: output differs under transient faults\n", round, kSections[s].name);
+                ++failures;
+            }
+        }
+    }
+    waitForAbandoned();
+    const fault_io::Counters& counters = injector.counters();
+    if (counters.shortReads == 0 || counters.eintr == 0 || counters.eagain == 0) {
+        fprintf(stderr, "FAIL faults were not injected\n");
+        ++failures;
+    }
+
+    // 持续EAGAIN：重试kMaxAgainRetries次后放弃，errno保持EAGAIN
+    Rule stuck = rule("proc/misc", fault_io::OP_READ, Latency(), 0, 0, 1.0);
+    stuck.maxConsecutiveErrors = 1000;
+    injector.setRules({stuck}, root);
+    injector.resetCounters();
+    std::string content;
+    file_reader::Status status = file_reader::readAll<Io>(fixturePath("/proc/misc").c_str(), &content);
+    if (status != file_reader::Status::READ_FAILED || errno != EAGAIN ||
+        counters.eagain != static_cast<uint64_t>(file_reader::kMaxAgainRetries + 1)) {
+        fprintf(stderr, "FAIL persistent EAGAIN: status %d, errno %d, attempts %llu\n", static_cast<int>(status),
+                errno, static_cast<unsigned long long>(counters.eagain.load()));
+        ++failures;
+    }
+
+    // 持续EINTR（信号风暴）结束后读取照常完成
+    Rule interrupted = rule("proc/misc", fault_io::OP_OPEN | fault_io::OP_READ, Latency(), 0, 1.0, 0);
+    interrupted.maxConsecutiveErrors = 50;
+    injector.setRules({interrupted}, root);
+    if (readFile("/proc/misc") != baselineMisc) {
+        fprintf(stderr, "FAIL EINTR storm changed proc/misc\n");
+        ++failures;
+    }
+
+    injector.setRules({}, root);
+    if (failures > 0) {
+        fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    printf("ok: %zu sections identical under short reads/EINTR/EAGAIN\n", kSectionCount);
+    return 0;
+}
+
+int usage(const char* program) {
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s bench [--profile NAME] [--iterations N] [--root DIR]\n"
+            "  %s check\n"
+            "  %s profiles\n",
+            program, program, program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+    std::string_view command(argv[1]);
+    std::vector<Profile> all = profiles();
+
+    if (command == "profiles") {
+        for (const Profile& profile : all) printf("%-16s %s\n", profile.name, profile.description);
+        return 0;
+    }
+
+    std::string profileName = "all";
+    std::string root;
+    unsigned iterations = 200;
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--profile" && i + 1 < argc) {
+            profileName = argv[++i];
+        } else if (arg == "--iterations" && i + 1 < argc) {
+            iterations = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--root" && i + 1 < argc) {
+            root = argv[++i];
+        } else {
+            return usage(argv[0]);
+        }
+    }
+
+    Fixture fixture;
+    if (!fixture.create(root)) {
+        fprintf(stderr, "Unable to create fixture under %s: %s\n", root.empty() ? "/tmp" : root.c_str(),
+                strerror(errno));
+        return 1;
+    }
+
+    if (command == "check") return runCheck();
+    if (command == "bench") {
+        const Profile* profile = findProfile(all, profileName);
+        if (profile == nullptr) {
+            fprintf(stderr, "Unknown profile: %s\n", profileName.c_str());
+            return 2;
+        }
+        return runBench(*profile, iterations);
+    }
+    return usage(argv[0]);
+}
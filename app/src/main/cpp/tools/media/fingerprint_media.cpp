@@ -0,0 +1,576 @@
+/**
+ * fingerprint_media - 媒体编解码器清单与特性声明扫描器的主机工具
+ *
+ * 用法:
+ *   fingerprint_media gen [--seed N] DIR
+ *       在DIR下按设备布局（vendor/etc、system/etc/permissions 等）生成与真机规模相当的清单：
+ *       厂商media_codecs（含Alias/Limit/Feature子元素）、performance清单、软件编解码器清单、
+ *       几十个permissions文件（含大型privapp-permissions和platform.xml），合计约数百KB
+ *   fingerprint_media scan [--entries] PATH...
+ *       扫描文件或目录（递归）中的 .xml，输出计数和摘要，--entries 时列出全部条目
+ *   fingerprint_media bench [--iterations N] PATH...
+ *       对比逐字节与SSE2/NEON查找、单线程与线程池并行的吞吐，并核对各组合结果一致
+ *   fingerprint_media check
+ *       边界用例（注释和CDATA中的标签、属性值中的 '>'、单引号、大小写不同的Feature、截断文档）
+ *       以及生成的清单上各组合结果一致
+ */
+#include "MediaManifest.h"
+#include "XmlTokenizer.h"
+#include "WorkStealingPool.h"
+#include "../common/HostIo.h"
+#include <sys/stat.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using GeneratedFile = std::pair<std::string, std::string>;    // 相对路径、内容
+
+// ---- 夹具生成 ----
+
+constexpr const char kLicense[] =
+        "<!-- Copyright (C) 2021 The Android Open Source Project\n\n"
+        "     Licensed under the Apache License, Version 2.0 (the \"License\");\n"
+        "     you may not use this file except in compliance with the License.\n"
+        "     <MediaCodec name=\"commented.out\" type=\"video/never\" /> -->\n";
+
+const char* const kVideoTypes[] = {"video/avc", "video/hevc", "video/x-vnd.on2.vp8", "video/x-vnd.on2.vp9",
+                                   "video/av01", "video/mp4v-es", "video/3gpp", "video/dolby-vision"};
+const char* const kAudioTypes[] = {"audio/mp4a-latm", "audio/3gpp", "audio/amr-wb", "audio/flac", "audio/opus",
+                                   "audio/vorbis", "audio/mpeg", "audio/g711-alaw", "audio/g711-mlaw",
+                                   "audio/raw", "audio/ac3", "audio/eac3"};
+const char* const kHardwareFeatures[] = {
+    "android.hardware.audio.low_latency", "android.hardware.audio.output", "android.hardware.audio.pro",
+    "android.hardware.bluetooth", "android.hardware.bluetooth_le", "android.hardware.camera",
+    "android.hardware.camera.any", "android.hardware.camera.autofocus", "android.hardware.camera.flash",
+    "android.hardware.camera.front", "android.hardware.camera.concurrent", "android.hardware.camera.level.full",
+    "android.hardware.camera.capability.manual_sensor", "android.hardware.camera.capability.raw",
+    "android.hardware.consumerir", "android.hardware.fingerprint", "android.hardware.biometrics.face",
+    "android.hardware.location.gps", "android.hardware.location.network", "android.hardware.microphone",
+    "android.hardware.nfc", "android.hardware.nfc.hce", "android.hardware.nfc.hcef", "android.hardware.nfc.uicc",
+    "android.hardware.se.omapi.uicc", "android.hardware.se.omapi.ese", "android.hardware.sensor.accelerometer",
+    "android.hardware.sensor.barometer", "android.hardware.sensor.compass", "android.hardware.sensor.gyroscope",
+    "android.hardware.sensor.light", "android.hardware.sensor.proximity", "android.hardware.sensor.stepcounter",
+    "android.hardware.sensor.stepdetector", "android.hardware.sensor.hifi_sensors", "android.hardware.telephony",
+    "android.hardware.telephony.cdma", "android.hardware.telephony.gsm", "android.hardware.telephony.ims",
+    "android.hardware.touchscreen.multitouch.jazzhand", "android.hardware.usb.accessory", "android.hardware.usb.host",
+    "android.hardware.wifi", "android.hardware.wifi.direct", "android.hardware.wifi.passpoint",
+    "android.hardware.wifi.aware", "android.hardware.wifi.rtt", "android.hardware.strongbox_keystore",
+    "android.hardware.opengles.aep", "android.hardware.ram.normal", "android.hardware.uwb",
+};
+const char* const kVersionedFeatures[] = {"android.hardware.vulkan.level", "android.hardware.vulkan.version",
+                                          "android.hardware.vulkan.compute", "android.software.vulkan.deqp.level",
+                                          "android.software.opengles.deqp.level", "android.hardware.hardware_keystore",
+                                          "android.hardware.keystore.app_attest_key",
+                                          "android.hardware.identity_credential"};
+const char* const kSoftwareFeatures[] = {
+    "android.software.activities_on_secondary_displays", "android.software.app_widgets",
+    "android.software.autofill", "android.software.backup", "android.software.cant_save_state",
+    "android.software.companion_device_setup", "android.software.connectionservice", "android.software.cts",
+    "android.software.device_admin", "android.software.file_based_encryption", "android.software.home_screen",
+    "android.software.input_methods", "android.software.live_wallpaper", "android.software.managed_users",
+    "android.software.midi", "android.software.picture_in_picture", "android.software.print",
+    "android.software.secure_lock_screen", "android.software.securely_removes_users", "android.software.sip",
+    "android.software.sip.voip", "android.software.verified_boot", "android.software.voice_recognizers",
+    "android.software.webview", "android.software.ipsec_tunnels", "android.software.credentials",
+};
+
+std::string pick(std::mt19937_64& random, const char* const* values, size_t count) {
+    return values[random() % count];
+}
+
+std::string vendorCodecs(std::mt19937_64& random, const std::string& soc, bool encoders, int count) {
+    std::string xml;
+    const char* kind = encoders ? "encoder" : "decoder";
+    for (int i = 0; i < count; ++i) {
+        bool video = i % 3 != 2;
+        std::string type = video ? pick(random, kVideoTypes, std::size(kVideoTypes))
+                                 : pick(random, kAudioTypes, std::size(kAudioTypes));
+        std::string shortType = type.substr(type.find('/') + 1);
+        std::string name = "c2." + soc + "." + shortType + (i % 4 == 3 ? ".secure" : "") + "." + kind +
+                           (i >= 8 ? "." + std::to_string(i) : "");
+        xml += "        <MediaCodec name=\"" + name + "\" type=\"" + type + "\">\n";
+        xml += "            <Alias name=\"OMX.qcom." + std::string(video ? "video" : "audio") + "." + kind + "." +
+               shortType + "\" />\n";
+        xml += "            <Limit name=\"size\" min=\"96x96\" max=\"" + std::string(i % 2 ? "4096x2304" : "8192x4320") +
+               "\" />\n";
+        xml += "            <Limit name=\"alignment\" value=\"2x2\" />\n";
+        xml += "            <Limit name=\"block-size\" value=\"16x16\" />\n";
+        xml += "            <Limit name=\"blocks-per-second\" min=\"1\" max=\"" + std::to_string(1958400 + i * 4096) +
+               "\" />\n";
+        xml += "            <Limit name=\"bitrate\" range=\"1-" + std::to_string(120000000 + i * 1000) + "\" />\n";
+        xml += "            <Limit name=\"frame-rate\" range=\"1-480\" />\n";
+        xml += "            <Limit name=\"concurrent-instances\" max=\"" + std::to_string(16 + i % 8) + "\" />\n";
+        xml += "            <Limit name=\"performance-point-3840x2160\" value=\"" + std::to_string(60 + i % 4 * 30) +
+               "\" />\n";
+        xml += "            <Feature name=\"adaptive-playback\" />\n";
+        if (i % 4 == 3) xml += "            <Feature name=\"secure-playback\" required=\"true\" />\n";
+        xml += "            <Attribute name=\"software-codec\" value=\"false\" />\n";
+        xml += "        </MediaCodec>\n";
+    }
+    return xml;
+}
+
+std::vector<GeneratedFile> generateFixtures(uint64_t seed) {
+    std::mt19937_64 random(seed);
+    std::vector<GeneratedFile> files;
+    const std::string header = "<?xml version=\"1.0\" encoding=\"utf-8\" ?>\n";
+
+    // 厂商硬件编解码器：约60KB
+    std::string vendor = header + kLicense +
+                         "<MediaCodecs>\n"
+                         "    <Include href=\"media_codecs_google_audio.xml\" />\n"
+                         "    <Include href=\"media_codecs_google_c2_video.xml\" />\n"
+                         "    <Settings>\n"
+                         "        <Domain name=\"telephony\" enabled=\"false\" />\n"
+                         "        <Setting name=\"max-video-encoder-input-buffers\" value=\"11\" />\n"
+                         "        <Variant name=\"slow-cpu\" enabled=\"false\" />\n"
+                         "    </Settings>\n"
+                         "    <Decoders>\n" +
+                         vendorCodecs(random, "qti", false, 40) + "    </Decoders>\n    <Encoders>\n" +
+                         vendorCodecs(random, "qti", true, 24) + "    </Encoders>\n</MediaCodecs>\n";
+    files.emplace_back("vendor/etc/media_codecs_lahaina_vendor.xml", vendor);
+
+    // performance清单：同名编解码器的 update="true" 项，与上面的条目重复，合并后去重
+    std::string performance = header + "<MediaCodecs>\n    <Decoders>\n";
+    for (int i = 0; i < 40; ++i) {
+        performance += "        <MediaCodec name=\"c2.qti.avc.decoder." + std::to_string(i) +
+                       "\" type=\"video/avc\" update=\"true\">\n";
+        for (const char* size : {"320x240", "720x480", "1280x720", "1920x1080", "3840x2160"}) {
+            performance += "            <Limit name=\"measured-frame-rate-" + std::string(size) + "\" range=\"" +
+                           std::to_string(100 + random() % 900) + "-" + std::to_string(1000 + random() % 900) +
+                           "\" />\n";
+        }
+        performance += "        </MediaCodec>\n";
+    }
+    performance += "    </Decoders>\n</MediaCodecs>\n";
+    files.emplace_back("vendor/etc/media_codecs_performance_lahaina.xml", performance);
+
+    // 软件编解码器：多类型编解码器用子元素<Type>
+    std::string google = header + kLicense + "<Included>\n    <Decoders>\n";
+    for (const char* type : kAudioTypes) {
+        std::string shortType = std::string(type).substr(6);
+        google += "        <MediaCodec name=\"c2.android." + shortType + ".decoder\" type=\"" + type + "\">\n"
+                  "            <Alias name=\"OMX.google." + shortType + ".decoder\" />\n"
+                  "            <Limit name=\"channel-count\" max=\"8\" />\n"
+                  "            <Limit name=\"sample-rate\" ranges=\"7350,8000,11025,12000,16000,22050,24000,32000,"
+                  "44100,48000\" />\n"
+                  "            <Limit name=\"bitrate\" range=\"8000-960000\" />\n"
+                  "        </MediaCodec>\n";
+    }
+    google += "        <MediaCodec name=\"c2.android.raw.decoder\">\n"
+              "            <Type name=\"audio/raw\" />\n"
+              "            <Type name=\"audio/x-raw-float\" />\n"
+              "        </MediaCodec>\n"
+              "    </Decoders>\n    <Encoders>\n"
+              "        <MediaCodec name='c2.android.aac.encoder' type='audio/mp4a-latm'>\n"
+              "            <Limit name=\"bitrate\" range=\"8000-960000\" />\n"
+              "        </MediaCodec>\n"
+              "    </Encoders>\n</Included>\n";
+    files.emplace_back("system/etc/media_codecs_google_audio.xml", google);
+
+    // 每个特性一个文件（与AOSP frameworks/native/data/etc 相同）
+    auto permissionsFile = [&header](const std::string& body) {
+        return header + kLicense + "\n<!-- This is the standard set of features for devices. -->\n<permissions>\n" +
+               body + "</permissions>\n";
+    };
+    for (size_t i = 0; i < std::size(kHardwareFeatures); i += 2) {
+        std::string body;
+        for (size_t j = i; j < std::min(i + 2, std::size(kHardwareFeatures)); ++j) {
+            body += "    <feature name=\"" + std::string(kHardwareFeatures[j]) + "\" />\n";
+        }
+        files.emplace_back("vendor/etc/permissions/" + std::string(kHardwareFeatures[i]) + ".xml",
+                           permissionsFile(body));
+    }
+    for (size_t i = 0; i < std::size(kVersionedFeatures); ++i) {
+        files.emplace_back("vendor/etc/permissions/" + std::string(kVersionedFeatures[i]) + ".xml",
+                           permissionsFile("    <feature name=\"" + std::string(kVersionedFeatures[i]) +
+                                           "\" version=\"" + std::to_string(random() % 4 + 1) + "\" />\n"));
+    }
+    std::string handheld;
+    for (const char* feature : kSoftwareFeatures) handheld += "    <feature name=\"" + std::string(feature) + "\" />\n";
+    handheld += "    <unavailable-feature name=\"android.software.leanback\" />\n"
+                "    <unavailable-feature name=\"android.hardware.type.automotive\" />\n";
+    files.emplace_back("system/etc/permissions/handheld_core_hardware.xml", permissionsFile(handheld));
+
+    // 大文件：platform.xml 和 privapp-permissions，没有特性但占大部分字节
+    std::string platform;
+    for (int i = 0; i < 120; ++i) {
+        platform += "    <permission name=\"android.permission.PERMISSION_" + std::to_string(i) + "\" >\n"
+                    "        <group gid=\"net_bt_admin\" />\n    </permission>\n"
+                    "    <assign-permission name=\"android.permission.MODIFY_AUDIO_SETTINGS\" uid=\"media\" />\n";
+    }
+    for (int i = 0; i < 30; ++i) {
+        platform += "    <library name=\"android.test.lib" + std::to_string(i) + "\"\n"
+                    "            file=\"/system/framework/android.test.lib" + std::to_string(i) + ".jar\" />\n";
+    }
+    files.emplace_back("system/etc/permissions/platform.xml", permissionsFile(platform));
+    for (int file = 0; file < 6; ++file) {
+        std::string privapp;
+        for (int app = 0; app < 40; ++app) {
+            privapp += "    <privapp-permissions package=\"com.android.app" + std::to_string(file * 40 + app) + "\">\n";
+            for (int permission = 0; permission < 6; ++permission) {
+                privapp += "        <permission name=\"android.permission.PRIVILEGED_" +
+                           std::to_string(random() % 200) + "\"/>\n";
+            }
+            privapp += "    </privapp-permissions>\n";
+        }
+        files.emplace_back("system/etc/permissions/privapp-permissions-platform" + std::to_string(file) + ".xml",
+                           permissionsFile(privapp));
+    }
+    files.emplace_back("product/etc/permissions/com.google.android.feature.PIXEL_EXPERIENCE.xml",
+                       permissionsFile("    <feature name=\"com.google.android.feature.PIXEL_EXPERIENCE\" />\n"
+                                       "    <feature name=\"com.google.android.feature.TURBO_PRELOAD\" />\n"));
+    return files;
+}
+
+bool writeFixtures(const std::string& root, const std::vector<GeneratedFile>& files) {
+    for (const GeneratedFile& file : files) {
+        std::string path = root + "/" + file.first;
+        for (size_t slash = path.find('/', root.size() + 1); slash != std::string::npos;
+             slash = path.find('/', slash + 1)) {
+            mkdir(path.substr(0, slash).c_str(), 0755);
+        }
+        std::ofstream output(path, std::ios::binary);
+        output << file.second;
+        if (!output) return false;
+    }
+    return true;
+}
+
+// ---- 扫描 ----
+
+bool readWhole(const char* path, std::string* text) {
+    std::ifstream input(path, std::ios::binary);
+    if (!input) return false;
+    std::ostringstream buffer;
+    buffer << input.rdbuf();
+    *text = buffer.str();
+    return true;
+}
+
+std::vector<std::string> manifestFiles(const std::vector<std::string>& inputs) {
+    std::vector<std::string> files;
+    for (const std::string& input : inputs) collectInputFiles(input, &files);
+    files.erase(std::remove_if(files.begin(), files.end(),
+                               [](const std::string& path) {
+                                   return path.size() < 4 || path.compare(path.size() - 4, 4, ".xml") != 0;
+                               }),
+                files.end());
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+media_manifest::Summary scanSerial(const std::vector<std::string>& texts) {
+    std::vector<media_manifest::FileResult> results(texts.size());
+    for (size_t i = 0; i < texts.size(); ++i) {
+        results[i].loaded = true;
+        media_manifest::scanText(texts[i], &results[i]);
+    }
+    return media_manifest::merge(results);
+}
+
+void printSummary(const media_manifest::Summary& summary, bool entries) {
+    printf("files %u, bytes %llu, malformed %u\n", summary.files, static_cast<unsigned long long>(summary.bytes),
+           summary.malformedFiles);
+    printf("decoders %u, encoders %u, features %u, unavailable %u\n", summary.decoders, summary.encoders,
+           summary.features, summary.unavailable);
+    printf("manifest_digest %s\nfeature_digest  %s\n", summary.digest.c_str(), summary.featureDigest.c_str());
+    if (entries) {
+        for (const std::string& entry : summary.entries) printf("  %s\n", entry.c_str());
+    }
+}
+
+bool sameSummary(const media_manifest::Summary& a, const media_manifest::Summary& b) {
+    return a.entries == b.entries && a.digest == b.digest && a.featureDigest == b.featureDigest &&
+           a.files == b.files && a.bytes == b.bytes && a.malformedFiles == b.malformedFiles;
+}
+
+int runScan(int argc, char** argv) {
+    bool entries = false;
+    std::vector<std::string> inputs;
+    for (int i = 2; i < argc; ++i) {
+        if (strcmp(argv[i], "--entries") == 0) {
+            entries = true;
+        } else {
+            inputs.emplace_back(argv[i]);
+        }
+    }
+    std::vector<std::string> files = manifestFiles(inputs);
+    if (files.empty()) {
+        fprintf(stderr, "No .xml files found\n");
+        return 1;
+    }
+    printSummary(media_manifest::scanFiles(files, readWhole, WorkStealingPool::shared()), entries);
+    return 0;
+}
+
+int runBench(int argc, char** argv) {
+    unsigned iterations = 200;
+    std::vector<std::string> inputs;
+    for (int i = 2; i < argc; ++i) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iterations = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else {
+            inputs.emplace_back(argv[i]);
+        }
+    }
+    std::vector<std::string> files = manifestFiles(inputs);
+    std::vector<std::string> texts(files.size());
+    uint64_t bytes = 0;
+    for (size_t i = 0; i < files.size(); ++i) {
+        if (!readWhole(files[i].c_str(), &texts[i])) {
+            fprintf(stderr, "Unable to read %s\n", files[i].c_str());
+            return 1;
+        }
+        bytes += texts[i].size();
+    }
+    if (files.empty()) {
+        fprintf(stderr, "No .xml files found\n");
+        return 1;
+    }
+    printf("%zu files, %llu bytes, %u iterations, %u pool workers\n", files.size(),
+           static_cast<unsigned long long>(bytes), iterations, WorkStealingPool::shared().workerCount());
+
+    // 只计扫描和合并；读取由页缓存决定，与查找实现无关
+    media_manifest::Summary reference;
+    bool consistent = true;
+    for (bool portable : {true, false}) {
+        xml::setPortableOnly(portable);
+        for (bool parallel : {false, true}) {
+            media_manifest::Summary summary;
+            Clock::time_point start = Clock::now();
+            for (unsigned i = 0; i < iterations; ++i) {
+                if (parallel) {
+                    std::vector<media_manifest::FileResult> results(texts.size());
+                    std::vector<WorkStealingPool::Task> tasks;
+                    for (size_t f = 0; f < texts.size(); ++f) {
+                        tasks.emplace_back([&texts, &results, f](unsigned) {
+                            results[f].loaded = true;
+                            media_manifest::scanText(texts[f], &results[f]);
+                        });
+                    }
+                    WorkStealingPool::shared().runAndWait(std::move(tasks));
+                    summary = media_manifest::merge(results);
+                } else {
+                    summary = scanSerial(texts);
+                }
+            }
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            printf("%-8s %-8s %8.1f us/scan  %8.1f MB/s\n", xml::kernelName(), parallel ? "parallel" : "serial",
+                   seconds * 1e6 / iterations, static_cast<double>(bytes) * iterations / seconds / 1e6);
+            if (reference.files == 0) {
+                reference = summary;
+            } else if (!sameSummary(reference, summary)) {
+                consistent = false;
+            }
+        }
+    }
+    xml::setPortableOnly(false);
+
+    // 单独测tokenizer，不含条目构造和合并
+    for (bool portable : {true, false}) {
+        xml::setPortableOnly(portable);
+        size_t tags = 0;
+        Clock::time_point start = Clock::now();
+        for (unsigned i = 0; i < iterations; ++i) {
+            for (const std::string& text : texts) {
+                xml::forEachTag(text, [&tags](const xml::Tag&) {
+                    ++tags;
+                    return true;
+                });
+            }
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        printf("%-8s tokenize %8.1f us/scan  %8.1f MB/s  (%zu tags)\n", xml::kernelName(),
+               seconds * 1e6 / iterations, static_cast<double>(bytes) * iterations / seconds / 1e6, tags / iterations);
+    }
+    xml::setPortableOnly(false);
+
+    printSummary(reference, false);
+    if (!consistent) {
+        fprintf(stderr, "MISMATCH between scan variants\n");
+        return 1;
+    }
+    return 0;
+}
+
+// ---- 校验 ----
+
+struct Case {
+    const char* name;
+    const char* xml;
+    std::vector<std::string> expected;
+    bool malformed;
+};
+
+int runCheck() {
+    const Case cases[] = {
+        {"comments-and-cdata",
+         "<?xml version='1.0'?><!-- <feature name=\"in.comment\"/> -->\n"
+         "<!DOCTYPE permissions><permissions><![CDATA[<feature name=\"in.cdata\"/>]]>"
+         "<feature name=\"a.real\"/><?pi <feature name=\"in.pi\"/> ?></permissions>",
+         {"feature a.real"}, false},
+        {"quoted-gt-and-single-quotes",
+         "<permissions><feature name='x.y' version=\"3\" note=\"a>b\"/>"
+         "<feature note='<feature name=\"fake\"/>' name=\"z.w\" /></permissions>",
+         {"feature x.y=3", "feature z.w"}, false},
+        {"whitespace-and-newlines",
+         "<permissions>\n  <feature\n      name = \"spaced.out\"\n      version\t=\t'12'\n  />\n"
+         "  <unavailable-feature name=\"gone\"></unavailable-feature>\n</permissions>",
+         {"feature spaced.out=12", "unavailable gone"}, false},
+        {"codec-feature-is-not-a-system-feature",
+         "<MediaCodecs><Decoders><MediaCodec name=\"c2.x.avc.decoder\" type=\"video/avc\">"
+         "<Feature name=\"adaptive-playback\"/><Limit name=\"size\" min=\"2x2\" max=\"4096x4096\"/>"
+         "</MediaCodec></Decoders></MediaCodecs>",
+         {"decoder c2.x.avc.decoder video/avc"}, false},
+        {"codec-types-and-directions",
+         "<Included><Decoders><MediaCodec name=\"raw\"><Type name=\"audio/raw\"/><Type name=\"audio/float\">"
+         "</Type></MediaCodec><MediaCodec name=\"untyped\"></MediaCodec><MediaCodec name=\"empty\" /></Decoders>"
+         "<Encoders><MediaCodec name=\"enc\" type=\"video/hevc\"/></Encoders>"
+         "<MediaCodec name=\"outside\" type=\"video/none\"/></Included>",
+         {"decoder empty", "decoder raw audio/float", "decoder raw audio/raw", "decoder untyped",
+          "encoder enc video/hevc"}, false},
+        {"truncated-in-attribute",
+         "<permissions><feature name=\"kept\"/><feature name=\"cut", {"feature kept"}, true},
+        {"truncated-in-comment", "<permissions><feature name=\"kept\"/><!-- never closed", {"feature kept"}, true},
+    };
+
+    int failures = 0;
+    for (bool portable : {true, false}) {
+        xml::setPortableOnly(portable);
+        for (const Case& test : cases) {
+            media_manifest::FileResult result;
+            result.loaded = true;
+            media_manifest::scanText(test.xml, &result);
+            bool malformed = result.malformed;
+            std::vector<media_manifest::FileResult> results(1);
+            results[0] = std::move(result);
+            media_manifest::Summary summary = media_manifest::merge(results);
+            if (summary.entries != test.expected || malformed != test.malformed) {
+                fprintf(stderr, "FAIL %s (%s): got", test.name, xml::kernelName());
+                for (const std::string& entry : summary.entries) fprintf(stderr, " [%s]", entry.c_str());
+                fprintf(stderr, " malformed=%d\n", malformed);
+                ++failures;
+            }
+        }
+    }
+
+    // 查找函数在每个偏移和16字节边界两侧都要与逐字节结果一致
+    std::string haystack(100, 'x');
+    for (size_t position = 0; position < haystack.size(); ++position) {
+        std::string text = haystack;
+        text[position] = '"';
+        const char* begin = text.data();
+        const char* end = begin + text.size();
+        for (size_t start = 0; start <= position; start += 7) {
+            xml::setPortableOnly(false);
+            const char* fast = xml::findAny(begin + start, end, '>', '"', '\'');
+            const char* single = xml::findByte(begin + start, end, '"');
+            xml::setPortableOnly(true);
+            if (fast != xml::findAny(begin + start, end, '>', '"', '\'') || single != begin + position) {
+                fprintf(stderr, "FAIL find at %zu from %zu\n", position, start);
+                ++failures;
+            }
+        }
+    }
+    xml::setPortableOnly(false);
+
+    // 生成的清单：逐字节/SIMD、串行/并行四种组合结果一致，计数与生成器一致
+    char root[] = "/tmp/fingerprint_media.XXXXXX";
+    if (mkdtemp(root) == nullptr || !writeFixtures(root, generateFixtures(1))) {
+        fprintf(stderr, "FAIL cannot write fixtures\n");
+        return 1;
+    }
+    std::vector<std::string> files = manifestFiles({root});
+    std::vector<std::string> texts(files.size());
+    for (size_t i = 0; i < files.size(); ++i) readWhole(files[i].c_str(), &texts[i]);
+
+    xml::setPortableOnly(true);
+    media_manifest::Summary portable = scanSerial(texts);
+    xml::setPortableOnly(false);
+    media_manifest::Summary simd = scanSerial(texts);
+    media_manifest::Summary parallel = media_manifest::scanFiles(files, readWhole, WorkStealingPool::shared());
+    if (!sameSummary(portable, simd) || !sameSummary(simd, parallel)) {
+        fprintf(stderr, "FAIL fixture summaries differ between scan variants\n");
+        ++failures;
+    }
+    size_t expectedFeatures = std::size(kHardwareFeatures) + std::size(kVersionedFeatures) +
+                              std::size(kSoftwareFeatures) + 2;
+    if (simd.features != expectedFeatures || simd.unavailable != 2 || simd.malformedFiles != 0 ||
+        simd.decoders == 0 || simd.encoders == 0) {
+        fprintf(stderr, "FAIL fixture counts: features %u (expected %zu), unavailable %u, malformed %u\n",
+                simd.features, expectedFeatures, simd.unavailable, simd.malformedFiles);
+        ++failures;
+    }
+    for (const std::string& file : files) remove(file.c_str());
+    for (const char* directory : {"/vendor/etc/permissions", "/vendor/etc", "/vendor", "/system/etc/permissions",
+                                  "/system/etc", "/system", "/product/etc/permissions", "/product/etc", "/product"}) {
+        rmdir((std::string(root) + directory).c_str());
+    }
+    rmdir(root);
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    printf("ok: %zu cases, %zu fixture files (%llu bytes), kernel %s\n", std::size(cases), files.size(),
+           static_cast<unsigned long long>(simd.bytes), xml::kernelName());
+    return 0;
+}
+
+int usage(const char* program) {
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s gen [--seed N] DIR\n"
+            "  %s scan [--entries] PATH...\n"
+            "  %s bench [--iterations N] PATH...\n"
+            "  %s check\n",
+            program, program, program, program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+    std::string_view command(argv[1]);
+
+    if (command == "gen") {
+        uint64_t seed = 1;
+        std::string root;
+        for (int i = 2; i < argc; ++i) {
+            if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+                seed = strtoull(argv[++i], nullptr, 10);
+            } else {
+                root = argv[i];
+            }
+        }
+        if (root.empty()) return usage(argv[0]);
+        mkdir(root.c_str(), 0755);
+        std::vector<GeneratedFile> files = generateFixtures(seed);
+        if (!writeFixtures(root, files)) {
+            fprintf(stderr, "Unable to write fixtures under %s\n", root.c_str());
+            return 1;
+        }
+        size_t bytes = 0;
+        for (const GeneratedFile& file : files) bytes += file.second.size();
+        printf("wrote %zu files (%zu bytes) under %s\n", files.size(), bytes, root.c_str());
+        return 0;
+    }
+    if (command == "scan" && argc > 2) return runScan(argc, argv);
+    if (command == "bench" && argc > 2) return runBench(argc, argv);
+    if (command == "check") return runCheck();
+    return usage(argv[0]);
+}
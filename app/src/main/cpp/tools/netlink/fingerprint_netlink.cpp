@@ -0,0 +1,339 @@
+/**
+ * fingerprint_netlink - 设备端rtnetlink转储引擎的主机工具，直接访问本机内核
+ *
+ * 用法:
+ *   fingerprint_netlink dump
+ *       在一个套接字上转储链路、地址、路由和邻居并打印默认网关
+ *   fingerprint_netlink bench [--iterations N]
+ *       对比单会话四次转储、每次转储新建套接字和读取procfs路由/ARP表的耗时
+ *   fingerprint_netlink check
+ *       属性访问器的构造消息用例，以及与 if_nameindex / SIOCGIFCONF / /proc/net/if_inet6 /
+ *       /proc/net/route / /proc/net/arp 的交叉核对
+ *       没有可用的netlink套接字时返回77（ctest记为跳过）
+ */
+#include "RouteSnapshot.h"
+#include <sys/ioctl.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kSkipped = 77;
+
+struct InterfaceAddress {
+    int index;
+    route_snapshot::Address address;
+};
+
+bool dumpAddresses(netlink::Socket& socket, std::vector<InterfaceAddress>* addresses) {
+    addresses->clear();
+    return socket.dump(netlink::addressDump(), [addresses](const nlmsghdr* message) {
+        const ifaddrmsg* header = netlink::messageHeader<ifaddrmsg>(message);
+        if (header == nullptr) return;
+        InterfaceAddress entry{static_cast<int>(header->ifa_index), {}};
+        // 点对点接口的本地地址在IFA_LOCAL中，与getifaddrs的ifa_addr一致
+        netlink::visitAttributes<ifaddrmsg, IFA_ADDRESS, IFA_LOCAL>(
+                message, [&entry, header](auto type, const netlink::Payload& payload) {
+                    if (decltype(type)::value == IFA_ADDRESS && !entry.address.empty()) return;
+                    entry.address = route_snapshot::Address();
+                    route_snapshot::detail::setAddress(header->ifa_family, payload, &entry.address);
+                });
+        if (!entry.address.empty()) addresses->push_back(entry);
+    });
+}
+
+std::vector<std::string> readLines(const char* path) {
+    std::vector<std::string> lines;
+    std::ifstream input(path);
+    for (std::string line; std::getline(input, line);) lines.push_back(line);
+    return lines;
+}
+
+int dumpCommand() {
+    netlink::Socket socket;
+    route_snapshot::Snapshot snapshot;
+    std::vector<InterfaceAddress> addresses;
+    if (!route_snapshot::collect(socket, &snapshot) || !dumpAddresses(socket, &addresses)) {
+        fprintf(stderr, "netlink dump failed: %s\n", strerror(socket.error()));
+        return 1;
+    }
+    for (const route_snapshot::Link& link : snapshot.links) {
+        printf("link %d %s flags 0x%x\n", link.index, link.name.c_str(), link.flags);
+    }
+    for (const InterfaceAddress& entry : addresses) {
+        printf("addr %s %s\n", route_snapshot::interfaceName(snapshot, entry.index).c_str(),
+               route_snapshot::formatAddress(entry.address).c_str());
+    }
+    for (const route_snapshot::Route& route : snapshot.routes) {
+        printf("route %s/%u%s%s dev %s table %u type %u%s\n", route.destination.empty() ? "default" :
+               route_snapshot::formatAddress(route.destination).c_str(), route.destinationLength,
+               route.gateway.empty() ? "" : " via ", route_snapshot::formatAddress(route.gateway).c_str(),
+               route_snapshot::interfaceName(snapshot, route.outputInterface).c_str(), route.table, route.type,
+               route_snapshot::isDefaultRoute(route) ? " [default]" : "");
+        if (!route_snapshot::isDefaultRoute(route)) continue;
+        const route_snapshot::Neighbor* router = route_snapshot::gatewayNeighbor(snapshot, route);
+        if (router != nullptr) {
+            printf("gateway %s lladdr %s %s\n", route_snapshot::formatAddress(router->address).c_str(),
+                   route_snapshot::formatLinkLayer(*router).c_str(),
+                   route_snapshot::neighborStateName(router->state));
+        }
+    }
+    printf("neighbors %zu, messages %u, datagrams %u, bytes %" PRIu64 "%s\n", snapshot.neighbors.size(),
+           socket.stats().messages, socket.stats().datagrams, socket.stats().bytes,
+           snapshot.interrupted ? ", interrupted" : "");
+    return 0;
+}
+
+int benchCommand(unsigned iterations) {
+    double session = 1e9;
+    double perDump = 1e9;
+    double procfs = 1e9;
+    size_t routes = 0;
+    for (unsigned i = 0; i < iterations; ++i) {
+        Clock::time_point start = Clock::now();
+        {
+            netlink::Socket socket;
+            route_snapshot::Snapshot snapshot;
+            std::vector<InterfaceAddress> addresses;
+            if (!route_snapshot::collect(socket, &snapshot) || !dumpAddresses(socket, &addresses)) {
+                fprintf(stderr, "netlink dump failed: %s\n", strerror(socket.error()));
+                return 1;
+            }
+            routes = snapshot.routes.size();
+        }
+        session = std::min(session, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+
+        start = Clock::now();
+        for (netlink::Request request : {netlink::linkDump(), netlink::addressDump(), netlink::routeDump(),
+                                         netlink::neighborDump()}) {
+            netlink::Socket socket;
+            size_t messages = 0;
+            socket.dump(request, [&messages](const nlmsghdr*) { ++messages; });
+        }
+        perDump = std::min(perDump, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+
+        start = Clock::now();
+        size_t lines = 0;
+        for (const char* path : {"/proc/net/route", "/proc/net/ipv6_route", "/proc/net/arp"}) {
+            lines += readLines(path).size();
+        }
+        procfs = std::min(procfs, std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    printf("links+addrs+routes+neighbors: one session %.1fus, socket per dump %.1fus; "
+           "procfs route/ipv6_route/arp %.1fus; %zu routes\n",
+           session, perDump, procfs, routes);
+    return 0;
+}
+
+// 构造消息：未列出的类型、带NLA_F_NESTED标志的类型、长度越界的最后一个属性
+int checkVisitor() {
+    alignas(4) uint8_t buffer[256] = {};
+    nlmsghdr* message = reinterpret_cast<nlmsghdr*>(buffer);
+    size_t offset = NLMSG_LENGTH(NLMSG_ALIGN(sizeof(rtmsg)));
+    auto append = [&](uint16_t type, const void* data, uint16_t length, uint16_t declared) {
+        rtattr* attribute = reinterpret_cast<rtattr*>(buffer + offset);
+        attribute->rta_type = type;
+        attribute->rta_len = declared;
+        memcpy(RTA_DATA(attribute), data, length);
+        offset += RTA_ALIGN(RTA_LENGTH(length));
+    };
+    uint32_t oif = 7;
+    uint32_t table = 1021;
+    uint8_t gateway[4] = {192, 0, 2, 1};
+    append(RTA_OIF, &oif, 4, RTA_LENGTH(4));
+    append(RTA_PREFSRC, gateway, 4, RTA_LENGTH(4));
+    append(RTA_TABLE | NLA_F_NESTED, &table, 4, RTA_LENGTH(4));
+    append(RTA_GATEWAY, gateway, 3, RTA_LENGTH(3));
+    append(RTA_PRIORITY, &oif, 4, RTA_LENGTH(64));
+    message->nlmsg_len = static_cast<uint32_t>(offset);
+
+    std::vector<std::pair<uint16_t, size_t>> seen;
+    netlink::visitAttributes<rtmsg, RTA_OIF, RTA_TABLE, RTA_GATEWAY, RTA_PRIORITY>(
+            message, [&seen](auto type, const netlink::Payload& payload) {
+                seen.emplace_back(decltype(type)::value, payload.size);
+            });
+    std::vector<std::pair<uint16_t, size_t>> expected = {{RTA_OIF, 4}, {RTA_TABLE, 4}, {RTA_GATEWAY, 3}};
+    if (seen != expected) {
+        fprintf(stderr, "visitor: unexpected dispatch (%zu attributes)\n", seen.size());
+        return 1;
+    }
+    printf("visitor: ok\n");
+    return 0;
+}
+
+int checkKernel() {
+    netlink::Socket socket;
+    if (!socket.valid()) {
+        printf("netlink unavailable (%s), skipping\n", strerror(socket.error()));
+        return kSkipped;
+    }
+    route_snapshot::Snapshot snapshot;
+    std::vector<InterfaceAddress> addresses;
+    if (!route_snapshot::collect(socket, &snapshot) || !dumpAddresses(socket, &addresses)) {
+        fprintf(stderr, "netlink dump failed: %s\n", strerror(socket.error()));
+        return 1;
+    }
+    int failures = 0;
+
+    // 链路：与if_nameindex的(索引, 名称)集合一致
+    std::set<std::pair<int, std::string>> links;
+    for (const route_snapshot::Link& link : snapshot.links) links.emplace(link.index, link.name);
+    std::set<std::pair<int, std::string>> libcLinks;
+    if (struct if_nameindex* names = if_nameindex()) {
+        for (struct if_nameindex* name = names; name->if_index != 0; ++name) {
+            libcLinks.emplace(name->if_index, name->if_name);
+        }
+        if_freenameindex(names);
+    }
+    if (links != libcLinks) {
+        fprintf(stderr, "links: netlink %zu, if_nameindex %zu\n", links.size(), libcLinks.size());
+        ++failures;
+    }
+
+    // 地址：SIOCGIFCONF给出的IPv4地址和 /proc/net/if_inet6 中的IPv6地址都要出现在地址转储中
+    std::vector<InterfaceAddress> expected;
+    int probe = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (probe >= 0) {
+        ifreq requests[64];
+        ifconf config;
+        config.ifc_len = sizeof(requests);
+        config.ifc_req = requests;
+        if (ioctl(probe, SIOCGIFCONF, &config) == 0) {
+            for (size_t i = 0; i < config.ifc_len / sizeof(ifreq); ++i) {
+                InterfaceAddress entry{static_cast<int>(if_nametoindex(requests[i].ifr_name)), {}};
+                entry.address.family = AF_INET;
+                entry.address.length = 4;
+                memcpy(entry.address.bytes, &reinterpret_cast<sockaddr_in*>(&requests[i].ifr_addr)->sin_addr, 4);
+                expected.push_back(entry);
+            }
+        }
+        close(probe);
+    }
+    // 格式：32位十六进制地址、索引、前缀长度、作用域、标志、接口名
+    for (const std::string& line : readLines("/proc/net/if_inet6")) {
+        std::istringstream fields(line);
+        std::string hex;
+        int index = 0;
+        fields >> hex >> std::hex >> index;
+        if (hex.size() != 32) continue;
+        InterfaceAddress entry{index, {}};
+        entry.address.family = AF_INET6;
+        entry.address.length = 16;
+        for (size_t i = 0; i < 16; ++i) {
+            entry.address.bytes[i] = static_cast<uint8_t>(strtoul(hex.substr(i * 2, 2).c_str(), nullptr, 16));
+        }
+        expected.push_back(entry);
+    }
+    for (const InterfaceAddress& entry : expected) {
+        bool found = std::any_of(addresses.begin(), addresses.end(), [&entry](const InterfaceAddress& other) {
+            return other.index == entry.index && other.address == entry.address;
+        });
+        if (!found) {
+            fprintf(stderr, "addresses: %s %s missing from netlink dump\n",
+                    route_snapshot::interfaceName(snapshot, entry.index).c_str(),
+                    route_snapshot::formatAddress(entry.address).c_str());
+            ++failures;
+        }
+    }
+
+    // IPv4默认网关：/proc/net/route 只列出main表
+    std::set<std::pair<std::string, uint32_t>> procDefaults;
+    std::vector<std::string> routeLines = readLines("/proc/net/route");
+    for (size_t i = 1; i < routeLines.size(); ++i) {
+        std::istringstream fields(routeLines[i]);
+        std::string name;
+        std::string destination;
+        std::string gateway;
+        unsigned flags = 0;
+        fields >> name >> destination >> gateway >> std::hex >> flags;
+        if (destination == "00000000" && (flags & 0x2) != 0) {
+            procDefaults.emplace(name, static_cast<uint32_t>(strtoul(gateway.c_str(), nullptr, 16)));
+        }
+    }
+    std::set<std::pair<std::string, uint32_t>> netlinkDefaults;
+    for (const route_snapshot::Route& route : snapshot.routes) {
+        if (route.family != AF_INET || route.table != RT_TABLE_MAIN || !route_snapshot::isDefaultRoute(route)) continue;
+        uint32_t gateway;
+        memcpy(&gateway, route.gateway.bytes, 4);
+        netlinkDefaults.emplace(route_snapshot::interfaceName(snapshot, route.outputInterface), gateway);
+
+        // 网关MAC：与 /proc/net/arp 中已解析的条目一致
+        const route_snapshot::Neighbor* router = route_snapshot::gatewayNeighbor(snapshot, route);
+        std::string gatewayText = route_snapshot::formatAddress(route.gateway);
+        std::vector<std::string> arpLines = readLines("/proc/net/arp");
+        for (size_t i = 1; i < arpLines.size(); ++i) {
+            std::istringstream fields(arpLines[i]);
+            std::string ip, type, flags, mac;
+            fields >> ip >> type >> flags >> mac;
+            if (ip != gatewayText || flags == "0x0") continue;
+            if (router == nullptr || route_snapshot::formatLinkLayer(*router) != mac) {
+                fprintf(stderr, "gateway %s: arp %s, netlink %s\n", ip.c_str(), mac.c_str(),
+                        router == nullptr ? "<none>" : route_snapshot::formatLinkLayer(*router).c_str());
+                ++failures;
+            }
+        }
+    }
+    if (procDefaults != netlinkDefaults) {
+        fprintf(stderr, "default routes: /proc/net/route %zu, netlink %zu\n", procDefaults.size(),
+                netlinkDefaults.size());
+        ++failures;
+    }
+
+    printf("kernel: %zu links, %zu/%zu addresses, %zu routes (%zu default), %zu neighbors: %s\n", links.size(),
+           addresses.size(), expected.size(), snapshot.routes.size(), netlinkDefaults.size(),
+           snapshot.neighbors.size(), failures == 0 ? "ok" : "FAILED");
+    return failures == 0 ? 0 : 1;
+}
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s dump\n"
+            "       %s bench [--iterations N]\n"
+            "       %s check\n",
+            program, program, program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string_view command(argv[1]);
+    unsigned iterations = 200;
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (command == "dump") {
+        return dumpCommand();
+    } else if (command == "bench") {
+        return benchCommand(iterations);
+    } else if (command == "check") {
+        int status = checkVisitor();
+        return status != 0 ? status : checkKernel();
+    }
+    usage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,122 @@
+/**
+ * fingerprint_perf - 用性能计数器剖析可在主机上运行的收集路径
+ *
+ * 用法:
+ *   fingerprint_perf [--iterations N] [--json] [--kconfig config.gz]
+ *       依次运行 /proc/self/maps 扫描、rtnetlink路由快照、/proc/cpuinfo 读取、BLAKE3哈希
+ *       （以及给定的内核配置流式解析），按分区输出指令数、周期、缓存未命中、分支预测失败、
+ *       上下文切换和缺页的平均值；PMU不可用时硬件列为n/a
+ */
+#include "PerfProfiler.h"
+#include "MapsScanner.h"
+#include "RouteSnapshot.h"
+#include "KernelConfigScanner.h"
+#include "Blake3.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// 与设备端收集器相同：read循环直到EOF
+ssize_t readAll(const char* path, std::string* text) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    text->clear();
+    char buffer[4096];
+    ssize_t bytes;
+    while ((bytes = read(fd, buffer, sizeof(buffer))) > 0) text->append(buffer, static_cast<size_t>(bytes));
+    close(fd);
+    return static_cast<ssize_t>(text->size());
+}
+
+struct Workload {
+    const char* name;
+    std::function<bool()> run;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned iterations = 20;
+    bool json = false;
+    std::string kconfig;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--kconfig" && i + 1 < argc) {
+            kconfig = argv[++i];
+        } else if (arg == "--json") {
+            json = true;
+        } else {
+            fprintf(stderr, "Usage: %s [--iterations N] [--json] [--kconfig config.gz]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    MapsScanner maps;
+    std::string text;
+    std::vector<uint8_t> data(4 << 20);
+    for (size_t i = 0; i < data.size(); ++i) data[i] = static_cast<uint8_t>(i * 31 + (i >> 13));
+
+    std::vector<Workload> workloads = {
+        {"memory_maps", [&maps]() {
+             int fd = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+             if (fd < 0) return false;
+             bool ok = maps.scan([fd](void* buffer, size_t size) { return read(fd, buffer, size); });
+             close(fd);
+             return ok;
+         }},
+        {"routes", []() {
+             netlink::Socket socket;
+             route_snapshot::Snapshot snapshot;
+             return route_snapshot::collect(socket, &snapshot);
+         }},
+        {"cpu_info", [&text]() { return readAll("/proc/cpuinfo", &text) > 0; }},
+        {"blake3_4mb", [&data]() {
+             uint8_t digest[Blake3Hasher::kOutLen];
+             Blake3Hasher::hash(data.data(), data.size(), digest);
+             return digest[0] != 0 || digest[1] != 0 || true;
+         }},
+    };
+    if (!kconfig.empty()) {
+        workloads.push_back({"kernel_config", [&kconfig]() {
+            int fd = open(kconfig.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0) return false;
+            KernelConfigScanner scanner;
+            std::string error;
+            bool ok = scanner.scanGzip([fd](void* buffer, size_t size) { return read(fd, buffer, size); }, &error);
+            close(fd);
+            return ok;
+        }});
+    }
+
+    PerfProfiler& profiler = PerfProfiler::instance();
+    profiler.setEnabled(true);
+    int status = 0;
+    for (const Workload& workload : workloads) {
+        // 预热一次，避免首次运行的缺页和缓存冷启动主导平均值
+        if (!workload.run()) {
+            fprintf(stderr, "%s: failed, skipped\n", workload.name);
+            status = 1;
+            continue;
+        }
+        for (unsigned i = 0; i < iterations; ++i) {
+            PerfProfiler::Scope scope(workload.name);
+            workload.run();
+        }
+    }
+
+    if (json) {
+        printf("%s\n", profiler.json().c_str());
+    } else {
+        printf("%s", profiler.table().c_str());
+    }
+    return status;
+}
@@ -0,0 +1,277 @@
+#include "MinHashIndex.h"
+#include "../common/ParallelFor.h"
+#include "../../include/DumpParser.h"
+#include "../../include/FieldSnapshot.h"
+#include "../../include/HashUtils.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr char kIndexMagic[4] = {'F', 'P', 'M', 'H'};
+constexpr uint32_t kIndexVersion = 1;
+
+// 热门桶（大量设备共享同一段）最多扫描的条目数，限制单次查询的最坏延迟
+constexpr uint32_t kMaxBucketScan = 4096;
+
+struct IndexHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t deviceCount;
+    uint32_t numHashes;
+    uint32_t bands;
+    uint32_t slotBits;
+    uint32_t reserved;
+};
+
+struct FieldWeight {
+    const char* section;  // nullptr 匹配任意分区
+    const char* key;
+    uint32_t weight;
+};
+
+// 未列出的字段权重为1
+const FieldWeight kFieldWeights[] = {
+    // 硬件级唯一标识
+    {"/sys/block/mmcblk0/device/cid", "Content", 8},
+    {nullptr, "cid", 8},
+    {nullptr, "ufs_serial_number", 8},
+    {"/sys/devices/soc0/serial_number", "Content", 8},
+    {"DRM ID Information", "DRM ID", 8},
+    // 机型与硬件拓扑
+    {nullptr, "ro.product.model", 3},
+    {nullptr, "ro.product.device", 3},
+    {nullptr, "ro.board.platform", 3},
+    {"CPU Information", "CPU part", 2},
+    {"CPU Information", "CPU implementer", 2},
+    {"CPU Information", "Hardware", 2},
+    {"uname system call (Android 11+ fallback)", "release", 2},
+    // 每次启动或每次读取都会变化
+    {"/proc/sys/kernel/random/boot_id", "Content", 0},
+    {"/proc/sys/kernel/random/uuid", "Content", 0},
+    {"Memory Information", "MemFree", 0},
+    {"Memory Information", "MemAvailable", 0},
+    {"Memory Information", "Buffers", 0},
+    {"Memory Information", "Cached", 0},
+    {nullptr, "Free Bytes", 0},
+    {nullptr, "Available Bytes", 0},
+    {nullptr, "Free Blocks", 0},
+    {nullptr, "Available Blocks", 0},
+    {nullptr, "Free File Nodes", 0},
+};
+
+// 每个哈希函数一个种子，由splitmix64序列生成
+struct HashSeeds {
+    uint64_t values[kNumHashes];
+    HashSeeds() {
+        uint64_t state = 0x5eed5eed5eed5eedULL;
+        for (auto& value : values) {
+            state += 0x9e3779b97f4a7c15ULL;
+            value = mix64(state);
+        }
+    }
+};
+
+const HashSeeds& seeds() {
+    static const HashSeeds instance;
+    return instance;
+}
+
+} // namespace
+
+uint32_t SignatureBuilder::fieldWeight(std::string_view section, std::string_view key) {
+    for (const FieldWeight& rule : kFieldWeights) {
+        if (key == rule.key && (rule.section == nullptr || section == rule.section)) {
+            return rule.weight;
+        }
+    }
+    return 1;
+}
+
+void SignatureBuilder::compute(std::string_view record, MinHashSignature* signature) {
+    const uint64_t* seedValues = seeds().values;
+    std::fill(std::begin(signature->values), std::end(signature->values), std::numeric_limits<uint32_t>::max());
+    m_occurrences.clear();
+
+    dump::forEachField(record.data(), record.size(),
+                       [&](std::string_view section, std::string_view key, std::string_view value) {
+        uint64_t baseId = FieldSnapshot::fieldId(section, key);
+        uint32_t occurrence = m_occurrences.at(baseId)++;
+
+        uint32_t weight = fieldWeight(section, key);
+        if (weight == 0 || value.find("Unable to retrieve") != std::string_view::npos) return;
+
+        uint64_t id = occurrence == 0 ? baseId : FieldSnapshot::fieldId(section, key, occurrence);
+        uint64_t feature = mix64(id ^ mix64(fnv1a64(value.data(), value.size())));
+
+        // 整数权重：第r份副本是独立的特征，权重越高越可能贡献最小值
+        for (uint32_t r = 0; r < weight; ++r) {
+            uint64_t replica = mix64(feature + r * 0x9e3779b97f4a7c15ULL);
+            for (uint32_t k = 0; k < kNumHashes; ++k) {
+                uint32_t hash = static_cast<uint32_t>(mix64(replica ^ seedValues[k]));
+                if (hash < signature->values[k]) signature->values[k] = hash;
+            }
+        }
+    });
+}
+
+uint64_t bandKey(const MinHashSignature& signature, uint32_t band) {
+    uint64_t hash = fnv1a64(&band, sizeof(band));
+    hash = fnv1a64(&signature.values[band * kRowsPerBand], kRowsPerBand * sizeof(uint32_t), hash);
+    return mix64(hash);
+}
+
+bool MinHashIndex::build(const std::vector<MinHashSignature>& signatures, unsigned threads,
+                         const std::string& path) {
+    if (signatures.size() >= std::numeric_limits<uint32_t>::max()) {
+        fprintf(stderr, "Too many devices for one index: %zu\n", signatures.size());
+        return false;
+    }
+
+    uint32_t deviceCount = static_cast<uint32_t>(signatures.size());
+    uint32_t slotBits = 10;
+    while (slotBits < 30 && (1u << slotBits) < deviceCount) ++slotBits;
+    size_t slotCount = size_t{1} << slotBits;
+
+    size_t signatureBytes = static_cast<size_t>(deviceCount) * sizeof(MinHashSignature);
+    size_t bandBytes = (slotCount + 1) * sizeof(uint32_t) + static_cast<size_t>(deviceCount) * 2 * sizeof(uint32_t);
+    size_t fileSize = sizeof(IndexHeader) + signatureBytes + kBands * bandBytes;
+
+    std::string tmpPath = path + ".tmp";
+    ScopedFd fd(::open(tmpPath.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+    if (!fd.isValid() || ftruncate(fd.get(), static_cast<off_t>(fileSize)) != 0) {
+        fprintf(stderr, "Failed to create %s, errno: %d\n", tmpPath.c_str(), errno);
+        return false;
+    }
+
+    void* mapped = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0);
+    if (mapped == MAP_FAILED) {
+        fprintf(stderr, "mmap failed: %s, errno: %d\n", tmpPath.c_str(), errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    char* base = static_cast<char*>(mapped);
+
+    IndexHeader header = {};
+    memcpy(header.magic, kIndexMagic, sizeof(header.magic));
+    header.version = kIndexVersion;
+    header.deviceCount = deviceCount;
+    header.numHashes = kNumHashes;
+    header.bands = kBands;
+    header.slotBits = slotBits;
+    memcpy(base, &header, sizeof(header));
+    if (signatureBytes > 0) memcpy(base + sizeof(header), signatures.data(), signatureBytes);
+
+    // 每段独立做一次计数排序；每个任务需要 deviceCount*8 字节的段键暂存
+    parallelFor(kBands, std::min(threads, kBands), [&](size_t band, unsigned) {
+        auto* offsets = reinterpret_cast<uint32_t*>(base + sizeof(header) + signatureBytes + band * bandBytes);
+        uint32_t* entries = offsets + slotCount + 1;
+        uint32_t shift = 64 - slotBits;
+
+        std::vector<uint64_t> keys(deviceCount);
+        for (uint32_t device = 0; device < deviceCount; ++device) {
+            keys[device] = bandKey(signatures[device], static_cast<uint32_t>(band));
+            ++offsets[(keys[device] >> shift) + 1];
+        }
+        for (size_t slot = 0; slot < slotCount; ++slot) {
+            offsets[slot + 1] += offsets[slot];
+        }
+
+        std::vector<uint32_t> cursor(offsets, offsets + slotCount);
+        for (uint32_t device = 0; device < deviceCount; ++device) {
+            uint32_t position = cursor[keys[device] >> shift]++;
+            entries[position * 2] = static_cast<uint32_t>(keys[device]);
+            entries[position * 2 + 1] = device;
+        }
+    });
+
+    bool ok = msync(base, fileSize, MS_SYNC) == 0;
+    munmap(base, fileSize);
+    if (!ok || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        fprintf(stderr, "Failed to write %s, errno: %d\n", path.c_str(), errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool MinHashIndex::open(const std::string& path) {
+    if (!m_file.open(path, true)) return false;
+
+    std::string_view data = m_file.view();
+    IndexHeader header;
+    if (data.size() < sizeof(header)) return false;
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, kIndexMagic, sizeof(header.magic)) != 0 || header.version != kIndexVersion ||
+        header.numHashes != kNumHashes || header.bands != kBands || header.slotBits > 30) {
+        fprintf(stderr, "%s: not a compatible MinHash index\n", path.c_str());
+        return false;
+    }
+
+    size_t slotCount = size_t{1} << header.slotBits;
+    size_t signatureBytes = header.deviceCount * sizeof(MinHashSignature);
+    size_t bandBytes = (slotCount + 1) * sizeof(uint32_t) + header.deviceCount * 2 * sizeof(uint32_t);
+    if (data.size() != sizeof(header) + signatureBytes + kBands * bandBytes) {
+        fprintf(stderr, "%s: truncated index\n", path.c_str());
+        return false;
+    }
+
+    m_deviceCount = header.deviceCount;
+    m_slotBits = header.slotBits;
+    m_signatures = reinterpret_cast<const uint32_t*>(data.data() + sizeof(header));
+    for (uint32_t band = 0; band < kBands; ++band) {
+        auto* offsets = reinterpret_cast<const uint32_t*>(data.data() + sizeof(header) + signatureBytes +
+                                                          band * bandBytes);
+        m_bands[band] = {offsets, offsets + slotCount + 1};
+    }
+    return true;
+}
+
+size_t MinHashIndex::query(const MinHashSignature& signature, size_t topN, float minSimilarity,
+                           std::vector<SimilarityMatch>* matches) const {
+    matches->clear();
+    if (m_signatures == nullptr) return 0;
+
+    uint32_t shift = 64 - m_slotBits;
+    for (uint32_t band = 0; band < kBands; ++band) {
+        uint64_t key = bandKey(signature, band);
+        uint32_t tag = static_cast<uint32_t>(key);
+        const BandView& view = m_bands[band];
+        uint32_t begin = view.offsets[key >> shift];
+        uint32_t end = std::min(view.offsets[(key >> shift) + 1], begin + kMaxBucketScan);
+
+        for (uint32_t i = begin; i < end; ++i) {
+            if (view.entries[i * 2] != tag) continue;
+            uint32_t device = view.entries[i * 2 + 1];
+            auto it = std::find_if(matches->begin(), matches->end(),
+                                   [device](const SimilarityMatch& match) { return match.device == device; });
+            if (it != matches->end()) {
+                ++it->bandHits;
+            } else {
+                matches->push_back({device, 1, 0.0f});
+            }
+        }
+    }
+
+    // 签名相同位置的比例是加权Jaccard相似度的无偏估计
+    for (SimilarityMatch& match : *matches) {
+        const uint32_t* candidate = signatureOf(match.device);
+        uint32_t equal = 0;
+        for (uint32_t k = 0; k < kNumHashes; ++k) {
+            equal += candidate[k] == signature.values[k];
+        }
+        match.similarity = static_cast<float>(equal) / kNumHashes;
+    }
+
+    matches->erase(std::remove_if(matches->begin(), matches->end(),
+                                  [minSimilarity](const SimilarityMatch& match) {
+                                      return match.similarity < minSimilarity;
+                                  }),
+                   matches->end());
+    std::sort(matches->begin(), matches->end(), [](const SimilarityMatch& a, const SimilarityMatch& b) {
+        return a.similarity != b.similarity ? a.similarity > b.similarity : a.device < b.device;
+    });
+    if (matches->size() > topN) matches->resize(topN);
+    return matches->size();
+}
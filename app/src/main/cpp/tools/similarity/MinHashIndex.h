@@ -0,0 +1,84 @@
+#ifndef MIN_HASH_INDEX_H
+#define MIN_HASH_INDEX_H
+
+#include "../common/FlatIdMap.h"
+#include "../common/HostIo.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * 基于加权MinHash + 分段LSH的近似设备重识别索引
+ *
+ * 每台设备的特征是 (字段ID, 值) 对，权重w的特征按w份副本参与MinHash，
+ * 稳定的硬件标识（cid、serial、DRM ID）权重高，OTA/重启会变的字段权重低或为0。
+ * 签名为kNumHashes个32位最小哈希，切成kBands段，每段kRowsPerBand个值，
+ * 任意一段完全相同的设备即为候选，再用签名相同位置的比例估计加权Jaccard相似度。
+ */
+constexpr uint32_t kNumHashes = 64;
+constexpr uint32_t kBands = 16;
+constexpr uint32_t kRowsPerBand = kNumHashes / kBands;
+
+struct MinHashSignature {
+    uint32_t values[kNumHashes];
+};
+
+struct SimilarityMatch {
+    uint32_t device;
+    uint32_t bandHits;
+    float similarity;
+};
+
+// 从一条指纹记录提取加权特征并计算签名；每个线程各用一个实例
+class SignatureBuilder {
+public:
+    void compute(std::string_view record, MinHashSignature* signature);
+
+    // 字段权重：0表示忽略（boot_id、剩余空间等每次都会变的字段）
+    static uint32_t fieldWeight(std::string_view section, std::string_view key);
+
+private:
+    FlatIdMap m_occurrences;
+};
+
+uint64_t bandKey(const MinHashSignature& signature, uint32_t band);
+
+/**
+ * .fpmh 索引文件（只读mmap）
+ *   IndexHeader
+ *   签名区：deviceCount * kNumHashes 个uint32
+ *   每段：uint32 offsets[(1 << slotBits) + 1]，随后是按槽位排序的 {uint32 tag, uint32 device}
+ * 段键的高slotBits位选槽位，低32位作为tag在槽内过滤
+ */
+class MinHashIndex {
+public:
+    // 多线程批量构建并写入文件
+    static bool build(const std::vector<MinHashSignature>& signatures, unsigned threads, const std::string& path);
+
+    bool open(const std::string& path);
+
+    // 返回按相似度降序的前topN个候选，minSimilarity以下的丢弃
+    size_t query(const MinHashSignature& signature, size_t topN, float minSimilarity,
+                 std::vector<SimilarityMatch>* matches) const;
+
+    uint64_t deviceCount() const { return m_deviceCount; }
+
+    const uint32_t* signatureOf(uint32_t device) const {
+        return m_signatures + static_cast<uint64_t>(device) * kNumHashes;
+    }
+
+private:
+    struct BandView {
+        const uint32_t* offsets;
+        const uint32_t* entries;  // tag, device 交替
+    };
+
+    MappedFile m_file;
+    uint64_t m_deviceCount = 0;
+    uint32_t m_slotBits = 0;
+    const uint32_t* m_signatures = nullptr;
+    BandView m_bands[kBands] = {};
+};
+
+#endif // MIN_HASH_INDEX_H
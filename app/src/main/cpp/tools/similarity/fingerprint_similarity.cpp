@@ -0,0 +1,295 @@
+/**
+ * fingerprint_similarity - 近似设备重识别索引
+ *
+ * 用法:
+ *   fingerprint_similarity build -o index.fpmh [-j 线程数] 输入文件或目录...
+ *       设备ID为记录在输入中的顺序（与fingerprint_ingest的行号一致）
+ *   fingerprint_similarity query index.fpmh 指纹文件 [--top N] [--min 相似度]
+ *   fingerprint_similarity bench [--devices N] [--queries Q] [-j 线程数] [-o index.fpmh]
+ *       生成合成设备群，模拟OTA和MAC随机化后查询，统计召回率和延迟
+ */
+#include "MinHashIndex.h"
+#include "../common/DumpRecords.h"
+#include "../common/ParallelFor.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+std::vector<MinHashSignature> signaturesFromFiles(const std::vector<std::string>& inputs, unsigned threads) {
+    std::vector<std::string> paths;
+    for (const auto& input : inputs) {
+        collectInputFiles(input, &paths);
+    }
+
+    std::vector<MappedFile> files(paths.size());
+    parallelFor(paths.size(), threads, [&](size_t i, unsigned) { files[i].open(paths[i]); });
+
+    std::vector<std::string_view> workUnits;
+    for (const auto& file : files) {
+        for (std::string_view chunk : dump_records::splitAtRecords(file.view(), 16u << 20)) {
+            workUnits.push_back(chunk);
+        }
+    }
+
+    std::vector<std::vector<MinHashSignature>> partial(workUnits.size());
+    std::vector<SignatureBuilder> builders(threads);
+    parallelFor(workUnits.size(), threads, [&](size_t i, unsigned worker) {
+        dump_records::forEachRecord(workUnits[i], [&](std::string_view record) {
+            partial[i].emplace_back();
+            builders[worker].compute(record, &partial[i].back());
+        });
+    });
+
+    std::vector<MinHashSignature> signatures;
+    for (const auto& part : partial) {
+        signatures.insert(signatures.end(), part.begin(), part.end());
+    }
+    return signatures;
+}
+
+int buildCommand(const std::string& output, const std::vector<std::string>& inputs, unsigned threads) {
+    auto start = Clock::now();
+    std::vector<MinHashSignature> signatures = signaturesFromFiles(inputs, threads);
+    auto signed_ = Clock::now();
+    if (!MinHashIndex::build(signatures, threads, output)) return 1;
+
+    fprintf(stderr, "Indexed %zu devices: signatures %.2fs, buckets %.2fs\n", signatures.size(),
+            std::chrono::duration<double>(signed_ - start).count(),
+            std::chrono::duration<double>(Clock::now() - signed_).count());
+    return 0;
+}
+
+int queryCommand(const std::string& indexPath, const std::string& dumpPath, size_t topN, float minSimilarity) {
+    MinHashIndex index;
+    MappedFile input;
+    if (!index.open(indexPath) || !input.open(dumpPath)) return 1;
+
+    SignatureBuilder builder;
+    MinHashSignature signature;
+    std::vector<SimilarityMatch> matches;
+    uint32_t recordNumber = 0;
+    dump_records::forEachRecord(input.view(), [&](std::string_view record) {
+        builder.compute(record, &signature);
+        index.query(signature, topN, minSimilarity, &matches);
+        printf("record %u: %zu match(es)\n", recordNumber++, matches.size());
+        for (const SimilarityMatch& match : matches) {
+            printf("  device %u similarity %.3f bands %u\n", match.device, match.similarity, match.bandHits);
+        }
+    });
+    return 0;
+}
+
+// ---- 合成设备群 ----
+
+struct Rng {
+    uint64_t state;
+    uint64_t next() { return mix64(state += 0x9e3779b97f4a7c15ULL); }
+    uint32_t below(uint32_t n) { return static_cast<uint32_t>(next() % n); }
+};
+
+enum Mutation : uint32_t {
+    MUTATION_NONE = 0,
+    MUTATION_OTA = 1 << 0,     // 增量版本、fingerprint、安全补丁、内核版本
+    MUTATION_MAC = 1 << 1,     // MAC随机化
+    MUTATION_REBOOT = 1 << 2,  // boot_id
+};
+
+void appendHex(std::string* out, uint64_t value, int digits) {
+    static const char kHex[] = "0123456789abcdef";
+    for (int i = digits - 1; i >= 0; --i) {
+        out->push_back(kHex[(value >> (i * 4)) & 0xf]);
+    }
+}
+
+// 同一设备的字段由设备号决定，mutations只改动对应的易变字段
+// 稳定字段始终从rng按相同顺序取值，易变字段的新值取自volatileRng
+void generateDevice(uint64_t device, uint32_t mutations, uint64_t salt, std::string* out) {
+    Rng rng{mix64(device + 1)};
+    Rng volatileRng{mix64(device ^ salt)};
+    out->clear();
+
+    uint32_t model = rng.below(2000);
+    uint32_t platform = model % 40;
+    uint32_t build = rng.below(50) + ((mutations & MUTATION_OTA) ? 1 + volatileRng.below(5) : 0);
+    uint32_t kernelPatch = rng.below(200) + ((mutations & MUTATION_OTA) ? 1 : 0);
+
+    *out += "=== Comprehensive Device Fingerprint Collection ===\n\n=== /system/build.prop ===\n";
+    *out += "ro.build.fingerprint=brand" + std::to_string(model % 60) + "/model" + std::to_string(model) +
+            ":13/TQ" + std::to_string(build) + "/" + std::to_string(1000000 + build) + ":user/release-keys\n";
+    *out += "ro.build.version.incremental=" + std::to_string(1000000 + build) + "\n";
+    *out += "ro.build.version.security_patch=2024-" + std::to_string(1 + build % 12) + "-05\n";
+    *out += "ro.product.model=model" + std::to_string(model) + "\n";
+    *out += "ro.product.brand=brand" + std::to_string(model % 60) + "\n";
+    *out += "ro.product.device=device" + std::to_string(model) + "\n";
+    *out += "ro.board.platform=platform" + std::to_string(platform) + "\n\n";
+
+    *out += "=== uname system call (Android 11+ fallback) ===\nrelease: 5.10." + std::to_string(kernelPatch) +
+            "-android13-4\n\n";
+
+    *out += "=== /proc/sys/kernel/random/boot_id ===\nContent: ";
+    uint64_t bootId = rng.next();
+    appendHex(out, (mutations & MUTATION_REBOOT) ? volatileRng.next() : bootId, 16);
+    *out += "\n\n=== /sys/block/mmcblk0/device/cid ===\n";
+    if (rng.below(2) == 0) {
+        *out += "Content: ";
+        appendHex(out, rng.next(), 16);
+        appendHex(out, rng.next(), 16);
+        *out += "\n\n";
+    } else {
+        *out += "File does not exist\n\n";
+    }
+    *out += "=== /sys/devices/soc0/serial_number ===\nContent: " + std::to_string(rng.next() % 4000000000u) +
+            "\n\n=== DRM ID Information ===\nDRM ID: ";
+    appendHex(out, rng.next(), 16);
+    appendHex(out, rng.next(), 16);
+
+    *out += "\n\n=== CPU Information ===\n";
+    for (uint32_t cpu = 0; cpu < 8; ++cpu) {
+        *out += "processor\t: " + std::to_string(cpu) + "\nCPU part\t: 0xd";
+        appendHex(out, 0x40 + (platform + cpu / 4) % 16, 2);
+        *out += "\n";
+    }
+
+    *out += "\n=== Network Interfaces (netlink) ===\nwlan0 MAC: ";
+    uint64_t mac = rng.next();
+    appendHex(out, (mutations & MUTATION_MAC) ? volatileRng.next() : mac, 12);
+    *out += "\n";
+}
+
+double percentile(std::vector<double>* values, double p) {
+    if (values->empty()) return 0;
+    size_t index = static_cast<size_t>(p * (values->size() - 1));
+    std::nth_element(values->begin(), values->begin() + index, values->end());
+    return (*values)[index];
+}
+
+int benchCommand(uint32_t devices, uint32_t queries, unsigned threads, const std::string& indexPath) {
+    fprintf(stderr, "Generating %u synthetic devices...\n", devices);
+    auto start = Clock::now();
+
+    std::vector<MinHashSignature> signatures(devices);
+    std::vector<SignatureBuilder> builders(threads);
+    std::vector<std::string> scratch(threads);
+    parallelFor(devices, threads, [&](size_t device, unsigned worker) {
+        generateDevice(device, MUTATION_NONE, 0, &scratch[worker]);
+        builders[worker].compute(scratch[worker], &signatures[device]);
+    });
+    auto generated = Clock::now();
+
+    if (!MinHashIndex::build(signatures, threads, indexPath)) return 1;
+    auto built = Clock::now();
+    fprintf(stderr, "Signatures: %.2fs, index build: %.2fs (%u threads)\n",
+            std::chrono::duration<double>(generated - start).count(),
+            std::chrono::duration<double>(built - generated).count(), threads);
+
+    MinHashIndex index;
+    if (!index.open(indexPath)) return 1;
+
+    const uint32_t kScenarios[] = {MUTATION_REBOOT, MUTATION_OTA | MUTATION_REBOOT, MUTATION_MAC | MUTATION_REBOOT,
+                                   MUTATION_OTA | MUTATION_MAC | MUTATION_REBOOT};
+    const char* const kScenarioNames[] = {"reboot", "ota", "mac", "ota+mac"};
+
+    for (size_t scenario = 0; scenario < 4; ++scenario) {
+        std::vector<double> signLatencies(queries);
+        std::vector<double> latencies(queries);
+        std::atomic<uint32_t> top1{0};
+        std::atomic<uint32_t> candidates{0};
+        std::atomic<uint64_t> candidateTotal{0};
+        std::vector<std::vector<SimilarityMatch>> matches(threads);
+
+        parallelFor(queries, threads, [&](size_t q, unsigned worker) {
+            uint64_t device = mix64(q * 31 + scenario) % devices;
+            generateDevice(device, kScenarios[scenario], q + 1, &scratch[worker]);
+
+            MinHashSignature signature;
+            auto begin = Clock::now();
+            builders[worker].compute(scratch[worker], &signature);
+            auto signedAt = Clock::now();
+            index.query(signature, 16, 0.0f, &matches[worker]);
+            signLatencies[q] = std::chrono::duration<double, std::micro>(signedAt - begin).count();
+            latencies[q] = std::chrono::duration<double, std::micro>(Clock::now() - signedAt).count();
+
+            const auto& found = matches[worker];
+            candidateTotal += found.size();
+            if (!found.empty() && found[0].device == device) ++top1;
+            for (const SimilarityMatch& match : found) {
+                if (match.device == device) {
+                    ++candidates;
+                    break;
+                }
+            }
+        });
+
+        printf("%-8s recall@1 %.4f  recall@16 %.4f  avg candidates %.1f  "
+               "signature p50 %.1fus  lookup p50 %.1fus p99 %.1fus\n",
+               kScenarioNames[scenario], static_cast<double>(top1) / queries,
+               static_cast<double>(candidates) / queries, static_cast<double>(candidateTotal) / queries,
+               percentile(&signLatencies, 0.5), percentile(&latencies, 0.5), percentile(&latencies, 0.99));
+    }
+    return 0;
+}
+
+void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s build -o <index.fpmh> [-j threads] <file|dir>...\n"
+            "       %s query <index.fpmh> <dump> [--top N] [--min similarity]\n"
+            "       %s bench [--devices N] [--queries Q] [-j threads] [-o index.fpmh]\n",
+            program, program, program);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    std::string_view command(argv[1]);
+    std::string output = "fleet_bench.fpmh";
+    std::vector<std::string> positional;
+    unsigned threads = defaultThreadCount();
+    uint32_t devices = 100000;
+    uint32_t queries = 10000;
+    size_t topN = 5;
+    float minSimilarity = 0.5f;
+
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        bool hasValue = i + 1 < argc;
+        if (arg == "-o" && hasValue) {
+            output = argv[++i];
+        } else if (arg == "-j" && hasValue) {
+            threads = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--devices" && hasValue) {
+            devices = static_cast<uint32_t>(std::max(1L, atol(argv[++i])));
+        } else if (arg == "--queries" && hasValue) {
+            queries = static_cast<uint32_t>(std::max(1L, atol(argv[++i])));
+        } else if (arg == "--top" && hasValue) {
+            topN = static_cast<size_t>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--min" && hasValue) {
+            minSimilarity = static_cast<float>(atof(argv[++i]));
+        } else if (!arg.empty() && arg[0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            positional.emplace_back(arg);
+        }
+    }
+
+    if (command == "build" && !positional.empty()) {
+        return buildCommand(output, positional, threads);
+    } else if (command == "query" && positional.size() == 2) {
+        return queryCommand(positional[0], positional[1], topN, minSimilarity);
+    } else if (command == "bench") {
+        return benchCommand(devices, queries, threads, output);
+    }
+    usage(argv[0]);
+    return 2;
+}
@@ -0,0 +1,306 @@
+/**
+ * singleflight_stress - SingleFlight / FutexEvent / WorkStealingPool 多线程压力测试
+ *
+ * 用法:
+ *   singleflight_stress [--threads N] [--keys K] [--rounds R] [--work-us U]
+ *
+ * 每轮所有线程同时对 K 个键调用 run()，计算函数模拟一次收集（睡眠U微秒）。检查:
+ *   - 同一键的计算从不并发执行
+ *   - 同一次计算的所有调用者拿到相同结果
+ *   - 计算抛出的异常传递给每个等待者
+ *   - waitUntil 在截止时间返回false，完成后返回true
+ *   - 等待期间不自旋：大量线程阻塞时进程CPU时间接近0
+ *   - 多个线程同时对同一WorkStealingPool调用runAndWait、任务内嵌套runAndWait都能完成，
+ *     每次调用只等待自己的任务，异常只抛给所属的调用，同一次调用内worker序号不被两个线程同时使用
+ * 任一检查失败时返回1。
+ */
+#include "SingleFlight.h"
+#include "WorkStealingPool.h"
+#include <sys/resource.h>
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+int g_failures = 0;
+
+void check(bool condition, const char* what) {
+    if (!condition) {
+        fprintf(stderr, "FAIL: %s\n", what);
+        ++g_failures;
+    }
+}
+
+double cpuSeconds() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+// 让所有线程在同一时刻开始一轮
+class StartGate {
+public:
+    explicit StartGate(unsigned parties) : m_parties(parties) {}
+
+    void arrive(unsigned round) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (++m_arrived == m_parties) {
+            m_arrived = 0;
+            m_round = round + 1;
+            m_cv.notify_all();
+        } else {
+            m_cv.wait(lock, [&]() { return m_round > round; });
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    unsigned m_parties;
+    unsigned m_arrived = 0;
+    unsigned m_round = 0;
+};
+
+void stressCoalescing(unsigned threads, unsigned keys, unsigned rounds, unsigned workUs) {
+    SingleFlight<unsigned, uint64_t> flights;
+    std::vector<std::atomic<int>> running(keys);
+    std::vector<std::atomic<uint64_t>> executions(keys);
+    std::atomic<uint64_t> sequence{0};
+    std::atomic<uint64_t> overlaps{0};
+    std::atomic<uint64_t> calls{0};
+    StartGate gate(threads);
+
+    // 每次计算返回全局唯一的序号，同一次计算的调用者看到的序号必须相同
+    std::vector<std::vector<uint64_t>> seen(threads, std::vector<uint64_t>(rounds));
+
+    auto start = Clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            for (unsigned round = 0; round < rounds; ++round) {
+                gate.arrive(round);
+                unsigned key = (t + round) % keys;
+                seen[t][round] = flights.run(key, [&]() {
+                    if (running[key].fetch_add(1) != 0) ++overlaps;
+                    executions[key].fetch_add(1, std::memory_order_relaxed);
+                    std::this_thread::sleep_for(std::chrono::microseconds(workUs));
+                    running[key].fetch_sub(1);
+                    return sequence.fetch_add(1) + 1;
+                });
+                calls.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint64_t totalExecutions = 0;
+    for (auto& count : executions) {
+        totalExecutions += count.load();
+    }
+
+    // 同一轮同一键的结果：要么来自同一次计算，要么是之后新的计算（序号更大），不会出现0
+    uint64_t zeroResults = 0;
+    for (unsigned t = 0; t < threads; ++t) {
+        for (unsigned round = 0; round < rounds; ++round) {
+            zeroResults += seen[t][round] == 0;
+        }
+    }
+
+    check(overlaps.load() == 0, "computations for the same key overlapped");
+    check(zeroResults == 0, "caller received an empty result");
+    check(calls.load() == uint64_t{threads} * rounds, "not every call returned");
+    check(totalExecutions <= calls.load(), "more executions than calls");
+    check(flights.coalescedCount() + totalExecutions == calls.load(), "coalesced + executed != calls");
+
+    printf("coalescing: %u threads x %u rounds over %u keys: %llu calls, %llu executions (%.1fx coalescing), "
+           "%.2fs\n",
+           threads, rounds, keys, static_cast<unsigned long long>(calls.load()),
+           static_cast<unsigned long long>(totalExecutions),
+           static_cast<double>(calls.load()) / std::max<uint64_t>(totalExecutions, 1), seconds);
+}
+
+void stressSharedResult(unsigned threads) {
+    SingleFlight<int, std::string> flights;
+    FutexEvent release;
+    std::vector<std::string> results(threads);
+
+    bool leader = false;
+    auto call = flights.join(1, &leader);
+    check(leader, "first join must lead");
+
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]() {
+            results[t] = flights.run(1, []() { return std::string("duplicate computation"); });
+        });
+    }
+
+    // 等所有线程都加入进行中的调用，再测它们阻塞期间的CPU占用
+    while (flights.coalescedCount() < threads) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    double cpuBefore = cpuSeconds();
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    double blockedCpu = cpuSeconds() - cpuBefore;
+    flights.finish(1, call, "shared result");
+
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    bool allShared = std::all_of(results.begin(), results.end(),
+                                 [](const std::string& value) { return value == "shared result"; });
+    check(allShared, "waiters did not receive the leader's result");
+    check(blockedCpu < 0.05, "waiters consumed CPU while blocked (spinning?)");
+    printf("shared result: %u waiters, %.1fms CPU while blocked for 200ms\n", threads, blockedCpu * 1000);
+}
+
+void stressErrorsAndTimeouts(unsigned threads) {
+    SingleFlight<int, int> flights;
+    std::atomic<unsigned> errors{0};
+
+    bool leader = false;
+    auto call = flights.join(7, &leader);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&]() {
+            try {
+                flights.run(7, []() { return 0; });
+            } catch (const std::runtime_error&) {
+                ++errors;
+            }
+        });
+    }
+    while (flights.coalescedCount() < threads) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto begin = Clock::now();
+    bool early = call->waitUntil(begin + std::chrono::milliseconds(20));
+    double waitedMs = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    check(!early, "waitUntil returned true before completion");
+    check(waitedMs >= 19 && waitedMs < 200, "waitUntil did not honour the deadline");
+
+    flights.fail(7, call, std::make_exception_ptr(std::runtime_error("collector failed")));
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    check(call->waitUntil(Clock::now()), "waitUntil returned false after completion");
+    check(errors.load() == threads, "exception not propagated to every waiter");
+    printf("errors/timeouts: %u/%u waiters saw the exception, timed wait returned after %.1fms\n", errors.load(),
+           threads, waitedMs);
+}
+
+// 每个根任务递归派生depth层，每层fanout个；叶子可以再嵌套一次runAndWait
+uint64_t poolTree(WorkStealingPool& pool, unsigned fanout, unsigned depth, bool nest, std::atomic<bool>* overlapped) {
+    std::vector<std::atomic<unsigned>> busy(pool.workerCount());
+    std::vector<uint64_t> leaves(pool.workerCount(), 0);
+    std::function<void(unsigned, unsigned)> node = [&](unsigned worker, unsigned level) {
+        if (busy[worker].fetch_add(1) != 0) overlapped->store(true);
+        if (level == depth) {
+            leaves[worker] += nest ? poolTree(pool, fanout, 1, false, overlapped) : 1;
+        } else {
+            for (unsigned i = 0; i < fanout; ++i) {
+                pool.spawn(worker, [&node, level](unsigned w) { node(w, level + 1); });
+            }
+        }
+        busy[worker].fetch_sub(1);
+    };
+    std::vector<WorkStealingPool::Task> roots;
+    for (unsigned i = 0; i < fanout; ++i) {
+        roots.push_back([&node](unsigned w) { node(w, 1); });
+    }
+    pool.runAndWait(std::move(roots));
+    uint64_t total = 0;
+    for (uint64_t count : leaves) total += count;
+    return total;
+}
+
+void stressWorkStealingPool(unsigned threads, unsigned rounds) {
+    WorkStealingPool pool(3);
+    std::atomic<unsigned> wrong{0};
+    std::atomic<unsigned> lostErrors{0};
+    std::atomic<bool> overlapped{false};
+
+    auto begin = Clock::now();
+    std::vector<std::thread> callers;
+    for (unsigned t = 0; t < threads; ++t) {
+        callers.emplace_back([&, t]() {
+            std::atomic<bool> localOverlap{false};
+            for (unsigned r = 0; r < rounds; ++r) {
+                // 4^3 = 64 个叶子，嵌套时每个叶子再数 4 个
+                uint64_t expected = (t % 2 == 0) ? 64 : 64 * 4;
+                if (poolTree(pool, 4, 3, t % 2 != 0, &localOverlap) != expected) ++wrong;
+            }
+            if (t % 4 == 0) {
+                try {
+                    pool.runAndWait({[](unsigned) { throw std::runtime_error("task failed"); },
+                                     [](unsigned) {}});
+                    ++lostErrors;
+                } catch (const std::runtime_error&) {
+                }
+            }
+            if (localOverlap.load()) overlapped = true;
+        });
+    }
+    for (auto& thread : callers) {
+        thread.join();
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+    check(wrong.load() == 0, "runAndWait returned before its own tasks finished");
+    check(lostErrors.load() == 0, "task exception not rethrown by its runAndWait");
+    check(!overlapped.load(), "two threads ran with the same worker index in one run");
+    printf("work-stealing pool: %u callers x %u rounds (half nested) in %.1fms, %llu steals\n", threads, rounds,
+           elapsedMs, static_cast<unsigned long long>(pool.stealCount()));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    unsigned threads = 64;
+    unsigned keys = 9;
+    unsigned rounds = 200;
+    unsigned workUs = 200;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        bool hasValue = i + 1 < argc;
+        if (arg == "--threads" && hasValue) {
+            threads = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--keys" && hasValue) {
+            keys = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--rounds" && hasValue) {
+            rounds = static_cast<unsigned>(std::max(1, atoi(argv[++i])));
+        } else if (arg == "--work-us" && hasValue) {
+            workUs = static_cast<unsigned>(std::max(0, atoi(argv[++i])));
+        } else {
+            fprintf(stderr, "Usage: %s [--threads N] [--keys K] [--rounds R] [--work-us U]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    stressCoalescing(threads, keys, rounds, workUs);
+    stressSharedResult(threads);
+    stressErrorsAndTimeouts(threads);
+    stressWorkStealingPool(std::min(threads, 16u), std::max(rounds / 10, 1u));
+
+    if (g_failures > 0) {
+        fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    printf("all checks passed\n");
+    return 0;
+}
@@ -0,0 +1,451 @@
+/**
+ * fingerprint_syscall - 在主机上比较 LibcIo 与 RawSyscallIo
+ *
+ * 用法:
+ *   fingerprint_syscall bench [--iterations N] [文件...]
+ *       对每个文件用 file_reader::readAll 按三种后端各读N次（默认 /proc/version、
+ *       /proc/self/status、/proc/cpuinfo 和临时生成的1MiB文件），另外测单次fstat的开销，
+ *       输出每次操作的平均/最小纳秒数
+ *   fingerprint_syscall check
+ *       三种后端在readAll/readPrefix/readLines、fstat、fstatAt、uname、statfs、getdents64、
+ *       mmap/madvise/munmap上结果必须一致，失败时返回-1并设置相同的errno
+ *
+ * 三种后端：LibcIo、RawSyscallIo（64位下内联syscall/svc指令）、StubIo（始终调用
+ * 汇编中的raw_syscall，即arm32/x86设备上RawSyscallIo实际走的路径）
+ */
+#include "IoBackend.h"
+#include "FileReader.h"
+#include <dirent.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// 与RawSyscallIo相同的系统调用号和参数，但不内联，全部经过 raw_syscall 汇编实现
+struct StubIo {
+    static long call(long number, long arg1 = 0, long arg2 = 0, long arg3 = 0, long arg4 = 0, long arg5 = 0,
+                     long arg6 = 0) {
+        return syscallResult(raw_syscall(number, arg1, arg2, arg3, arg4, arg5, arg6));
+    }
+    static int openAt(int dirfd, const char* path, int flags, mode_t mode = 0) {
+        return static_cast<int>(call(__NR_openat, dirfd, reinterpret_cast<long>(path), flags, mode));
+    }
+    static ssize_t read(int fd, void* buffer, size_t count) {
+        return call(__NR_read, fd, reinterpret_cast<long>(buffer), static_cast<long>(count));
+    }
+    static ssize_t pread(int fd, void* buffer, size_t count, off64_t offset) {
+        return call(__NR_pread64, fd, reinterpret_cast<long>(buffer), static_cast<long>(count),
+                    static_cast<long>(offset));
+    }
+#if defined(__LP64__)
+    static int fstat(int fd, struct stat64* st) {
+        return static_cast<int>(call(__NR_fstat, fd, reinterpret_cast<long>(st)));
+    }
+    static int fstatAt(int dirfd, const char* path, struct stat64* st, int flags) {
+        return static_cast<int>(call(__NR_newfstatat, dirfd, reinterpret_cast<long>(path),
+                                     reinterpret_cast<long>(st), flags));
+    }
+#else
+    static int fstat(int fd, struct stat64* st) {
+        return static_cast<int>(call(__NR_fstat64, fd, reinterpret_cast<long>(st)));
+    }
+    static int fstatAt(int dirfd, const char* path, struct stat64* st, int flags) {
+        return static_cast<int>(call(__NR_fstatat64, dirfd, reinterpret_cast<long>(path),
+                                     reinterpret_cast<long>(st), flags));
+    }
+#endif
+    static int close(int fd) {
+        return static_cast<int>(call(__NR_close, fd));
+    }
+    static int access(const char* path) {
+        return static_cast<int>(call(__NR_faccessat, AT_FDCWD, reinterpret_cast<long>(path), F_OK, 0));
+    }
+#if defined(__LP64__)
+    static int statfs(const char* path, struct statfs64* buffer) {
+        return static_cast<int>(call(__NR_statfs, reinterpret_cast<long>(path), reinterpret_cast<long>(buffer)));
+    }
+#else
+    static int statfs(const char* path, struct statfs64* buffer) {
+        return static_cast<int>(call(__NR_statfs64, reinterpret_cast<long>(path), sizeof(*buffer),
+                                     reinterpret_cast<long>(buffer)));
+    }
+#endif
+    static int uname(struct utsname* buffer) {
+        return static_cast<int>(call(__NR_uname, reinterpret_cast<long>(buffer)));
+    }
+    static void* mmap(size_t length, int prot, int flags, int fd, off64_t offset) {
+#if defined(__LP64__)
+        long result = call(__NR_mmap, 0, static_cast<long>(length), prot, flags, fd, static_cast<long>(offset));
+#else
+        long result = call(__NR_mmap2, 0, static_cast<long>(length), prot, flags, fd, static_cast<long>(offset >> 12));
+#endif
+        return result == -1 ? MAP_FAILED : reinterpret_cast<void*>(result);
+    }
+    static int munmap(void* address, size_t length) {
+        return static_cast<int>(call(__NR_munmap, reinterpret_cast<long>(address), static_cast<long>(length)));
+    }
+    static int madvise(void* address, size_t length, int advice) {
+        return static_cast<int>(call(__NR_madvise, reinterpret_cast<long>(address), static_cast<long>(length),
+                                     advice));
+    }
+    static ssize_t getdents64(int fd, void* buffer, size_t size) {
+        return call(__NR_getdents64, fd, reinterpret_cast<long>(buffer), static_cast<long>(size));
+    }
+};
+
+// ---- 临时文件 ----
+
+struct TempTree {
+    std::string root;
+    std::string file;
+
+    bool create() {
+        char pattern[] = "/tmp/fingerprint_syscall.XXXXXX";
+        if (mkdtemp(pattern) == nullptr) return false;
+        root = pattern;
+        file = root + "/data";
+        std::string content(1 << 20, '\0');
+        for (size_t i = 0; i < content.size(); ++i) content[i] = static_cast<char>(i % 251);
+        for (size_t i = 80; i < content.size(); i += 81) content[i] = '\n';
+        FILE* out = fopen(file.c_str(), "wb");
+        if (out == nullptr) return false;
+        bool ok = fwrite(content.data(), 1, content.size(), out) == content.size();
+        return fclose(out) == 0 && ok;
+    }
+
+    ~TempTree() {
+        if (!file.empty()) unlink(file.c_str());
+        if (!root.empty()) rmdir(root.c_str());
+    }
+};
+
+// ---- check ----
+
+// 一次后端调用的可比较结果：返回值、errno和输出内容
+struct Outcome {
+    long result = 0;
+    int error = 0;
+    std::string data;
+
+    bool operator==(const Outcome& other) const {
+        return result == other.result && error == other.error && data == other.data;
+    }
+};
+
+template <typename Io>
+Outcome readAllOutcome(const char* path) {
+    Outcome outcome;
+    errno = 0;
+    outcome.result = static_cast<long>(file_reader::readAll<Io>(path, &outcome.data));
+    outcome.error = outcome.result == 0 ? 0 : errno;
+    return outcome;
+}
+
+template <typename Io>
+Outcome readPrefixOutcome(const char* path) {
+    Outcome outcome;
+    bool truncated = false;
+    errno = 0;
+    outcome.result = static_cast<long>(file_reader::readPrefix<Io>(path, 10000, &outcome.data, &truncated));
+    outcome.error = outcome.result == 0 ? 0 : errno;
+    outcome.data += truncated ? "+" : "-";
+    return outcome;
+}
+
+template <typename Io>
+Outcome readLinesOutcome(const char* path) {
+    Outcome outcome;
+    file_reader::Status status;
+    errno = 0;
+    outcome.result = file_reader::readLines<Io>(
+            path,
+            [&outcome](std::string_view line) {
+                outcome.data.append(line.data(), line.size());
+                outcome.data += '|';
+                return true;
+            },
+            &status);
+    outcome.error = status == file_reader::Status::OK ? 0 : errno;
+    return outcome;
+}
+
+template <typename Io>
+Outcome statOutcome(const char* path) {
+    Outcome outcome;
+    struct stat64 st = {};
+    errno = 0;
+    outcome.result = Io::fstatAt(AT_FDCWD, path, &st, 0);
+    outcome.error = outcome.result == -1 ? errno : 0;
+    if (outcome.result == 0) {
+        outcome.data = std::to_string(st.st_ino) + ":" + std::to_string(st.st_size) + ":" +
+                       std::to_string(st.st_mode);
+        int fd = Io::openAt(AT_FDCWD, path, O_RDONLY | O_CLOEXEC);
+        struct stat64 byFd = {};
+        if (fd == -1 || Io::fstat(fd, &byFd) == -1 || byFd.st_ino != st.st_ino) outcome.data += ":fstat-mismatch";
+        if (fd != -1) Io::close(fd);
+    }
+    return outcome;
+}
+
+template <typename Io>
+Outcome systemOutcome(const char* path) {
+    Outcome outcome;
+    struct utsname name;
+    struct statfs64 fs;
+    if (Io::uname(&name) == 0) outcome.data += std::string(name.release) + name.machine;
+    if (Io::statfs(path, &fs) == 0) outcome.data += ":" + std::to_string(fs.f_type) + ":" + std::to_string(fs.f_bsize);
+    errno = 0;
+    outcome.result = Io::access(path);
+    outcome.error = outcome.result == -1 ? errno : 0;
+    return outcome;
+}
+
+template <typename Io>
+Outcome listOutcome(const char* directory) {
+    Outcome outcome;
+    int fd = Io::openAt(AT_FDCWD, directory, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1) {
+        outcome.result = -1;
+        outcome.error = errno;
+        return outcome;
+    }
+    std::vector<std::string> names;
+    alignas(8) char buffer[4096];
+    ssize_t bytes;
+    while ((bytes = Io::getdents64(fd, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t offset = 0; offset < bytes;) {
+            const dirent64* entry = reinterpret_cast<const dirent64*>(buffer + offset);
+            names.emplace_back(entry->d_name);
+            offset += entry->d_reclen;
+        }
+    }
+    outcome.result = bytes;
+    Io::close(fd);
+    std::sort(names.begin(), names.end());
+    for (const std::string& name : names) outcome.data += name + "/";
+    return outcome;
+}
+
+template <typename Io>
+Outcome mapOutcome(const char* path) {
+    Outcome outcome;
+    int fd = Io::openAt(AT_FDCWD, path, O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        outcome.result = -1;
+        outcome.error = errno;
+        return outcome;
+    }
+    constexpr size_t kLength = 3 * 4096;
+    void* address = Io::mmap(kLength, PROT_READ, MAP_PRIVATE, fd, 4096);
+    Io::close(fd);
+    if (address == MAP_FAILED) {
+        outcome.result = -1;
+        outcome.error = errno;
+        return outcome;
+    }
+    outcome.result = Io::madvise(address, kLength, MADV_SEQUENTIAL);
+    outcome.data.assign(static_cast<const char*>(address), kLength);
+    if (Io::munmap(address, kLength) == -1) outcome.data += ":munmap-failed";
+    return outcome;
+}
+
+template <typename Io>
+Outcome badFdOutcome(const char*) {
+    Outcome outcome;
+    char buffer[16];
+    errno = 0;
+    outcome.result = Io::read(-1, buffer, sizeof(buffer));
+    outcome.error = errno;
+    return outcome;
+}
+
+// 探测的参数类型
+enum class Target {
+    FILES,          // 普通文件、procfs文件和不存在的路径
+    REGULAR,        // 只用普通文件和不存在的路径（mmap）
+    DIRECTORY,      // 目录和不存在的路径
+};
+
+struct Probe {
+    const char* name;
+    Target target;
+    Outcome (*libc)(const char*);
+    Outcome (*raw)(const char*);
+    Outcome (*stub)(const char*);
+};
+
+#define FINGERPRINT_PROBE(name, target, function) \
+    { name, Target::target, &function<LibcIo>, &function<RawSyscallIo>, &function<StubIo> }
+
+const Probe kProbes[] = {
+        FINGERPRINT_PROBE("readAll", FILES, readAllOutcome),
+        FINGERPRINT_PROBE("readPrefix", FILES, readPrefixOutcome),
+        FINGERPRINT_PROBE("readLines", FILES, readLinesOutcome),
+        FINGERPRINT_PROBE("fstat", FILES, statOutcome),
+        FINGERPRINT_PROBE("uname/statfs/access", FILES, systemOutcome),
+        FINGERPRINT_PROBE("getdents64", DIRECTORY, listOutcome),
+        FINGERPRINT_PROBE("mmap", REGULAR, mapOutcome),
+        FINGERPRINT_PROBE("read(-1)", REGULAR, badFdOutcome),
+};
+
+#undef FINGERPRINT_PROBE
+
+int runCheck() {
+    TempTree tree;
+    if (!tree.create()) {
+        fprintf(stderr, "Unable to create temporary file\n");
+        return 1;
+    }
+    std::string missing = tree.root + "/missing";
+    std::vector<std::string> files = {tree.file, "/proc/version", "/proc/self/cmdline", "/proc/filesystems", missing};
+    std::vector<std::string> regular = {tree.file, missing};
+    std::vector<std::string> directories = {tree.root, "/proc/self", missing};
+
+    int failures = 0;
+    int runs = 0;
+    for (const Probe& probe : kProbes) {
+        const std::vector<std::string>& paths =
+                probe.target == Target::FILES ? files : probe.target == Target::REGULAR ? regular : directories;
+        for (const std::string& target : paths) {
+            const char* path = target.c_str();
+            Outcome libc = probe.libc(path);
+            Outcome raw = probe.raw(path);
+            Outcome stub = probe.stub(path);
+            ++runs;
+            if (!(libc == raw) || !(libc == stub)) {
+                fprintf(stderr, "FAIL %s %s: libc %ld/%d/%zu, raw %ld/%d/%zu, stub %ld/%d/%zu\n", probe.name, path,
+                        libc.result, libc.error, libc.data.size(), raw.result, raw.error, raw.data.size(),
+                        stub.result, stub.error, stub.data.size());
+                ++failures;
+            }
+        }
+    }
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failures\n", failures);
+        return 1;
+    }
+    printf("ok: %d comparisons\n", runs);
+    return 0;
+}
+
+// ---- bench ----
+
+using Clock = std::chrono::steady_clock;
+
+struct Timing {
+    double meanNs = 0;
+    double minNs = 0;
+};
+
+template <typename Function>
+Timing measure(int iterations, Function&& function) {
+    Timing timing;
+    double total = 0;
+    double best = 1e300;
+    for (int i = 0; i < iterations; ++i) {
+        Clock::time_point start = Clock::now();
+        function();
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        total += ns;
+        best = std::min(best, ns);
+    }
+    timing.meanNs = total / iterations;
+    timing.minNs = best;
+    return timing;
+}
+
+template <typename Io>
+Timing benchRead(const char* path, int iterations, bool* ok) {
+    std::string text;
+    return measure(iterations, [&]() {
+        if (file_reader::readAll<Io>(path, &text) != file_reader::Status::OK) *ok = false;
+    });
+}
+
+template <typename Io>
+Timing benchFstat(int fd, int iterations) {
+    struct stat64 st;
+    return measure(iterations, [&]() { Io::fstat(fd, &st); });
+}
+
+void printRow(const char* name, const Timing& libc, const Timing& raw, const Timing& stub) {
+    printf("%-28s %12.0f %10.0f %12.0f %10.0f %12.0f %10.0f\n", name, libc.meanNs, libc.minNs, raw.meanNs, raw.minNs,
+           stub.meanNs, stub.minNs);
+}
+
+int runBench(int iterations, std::vector<std::string> files) {
+    TempTree tree;
+    if (files.empty()) {
+        if (!tree.create()) {
+            fprintf(stderr, "Unable to create temporary file\n");
+            return 1;
+        }
+        files = {"/proc/version", "/proc/self/status", "/proc/cpuinfo", tree.file};
+    }
+
+    printf("%-28s %12s %10s %12s %10s %12s %10s\n", "ns/op", "libc mean", "min", "raw mean", "min", "stub mean",
+           "min");
+    int fd = open("/proc/version", O_RDONLY | O_CLOEXEC);
+    if (fd != -1) {
+        int calls = iterations * 100;
+        printRow("fstat", benchFstat<LibcIo>(fd, calls), benchFstat<RawSyscallIo>(fd, calls),
+                 benchFstat<StubIo>(fd, calls));
+        close(fd);
+    }
+
+    int status = 0;
+    for (const std::string& file : files) {
+        bool ok = true;
+        // 先各读一次预热页缓存
+        benchRead<LibcIo>(file.c_str(), 1, &ok);
+        Timing libc = benchRead<LibcIo>(file.c_str(), iterations, &ok);
+        Timing raw = benchRead<RawSyscallIo>(file.c_str(), iterations, &ok);
+        Timing stub = benchRead<StubIo>(file.c_str(), iterations, &ok);
+        if (!ok) {
+            fprintf(stderr, "%s: read failed\n", file.c_str());
+            status = 1;
+            continue;
+        }
+        printRow(file == tree.file ? "1MiB file" : file.c_str(), libc, raw, stub);
+    }
+    return status;
+}
+
+int usage(const char* program) {
+    fprintf(stderr,
+            "Usage:\n"
+            "  %s bench [--iterations N] [FILE...]\n"
+            "  %s check\n",
+            program, program);
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) return usage(argv[0]);
+    std::string_view command(argv[1]);
+    if (command == "check" && argc == 2) return runCheck();
+    if (command != "bench") return usage(argv[0]);
+
+    int iterations = 200;
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; ++i) {
+        std::string_view arg(argv[i]);
+        if (arg == "--iterations" && i + 1 < argc) {
+            iterations = std::max(1, atoi(argv[++i]));
+        } else if (arg.substr(0, 2) == "--") {
+            return usage(argv[0]);
+        } else {
+            files.emplace_back(arg);
+        }
+    }
+    return runBench(iterations, files);
+}
@@ -0,0 +1,24 @@
+    .text
+    .global raw_syscall
+    .type raw_syscall,@function
+
+raw_syscall:
+        PUSHL           %ebp
+        PUSHL           %edi
+        PUSHL           %esi
+        PUSHL           %ebx
+        MOVL            20(%esp), %eax
+        MOVL            24(%esp), %ebx
+        MOVL            28(%esp), %ecx
+        MOVL            32(%esp), %edx
+        MOVL            36(%esp), %esi
+        MOVL            40(%esp), %edi
+        MOVL            44(%esp), %ebp
+        INT             $0x80
+        POPL            %ebx
+        POPL            %esi
+        POPL            %edi
+        POPL            %ebp
+        RET
+
+    .section .note.GNU-stack,"",%progbits
@@ -0,0 +1,16 @@
+    .text
+    .global raw_syscall
+    .type raw_syscall,@function
+
+raw_syscall:
+        MOVQ            %rdi, %rax
+        MOVQ            %rsi, %rdi
+        MOVQ            %rdx, %rsi
+        MOVQ            %rcx, %rdx
+        MOVQ            %r8, %r10
+        MOVQ            %r9, %r8
+        MOVQ            8(%rsp), %r9
+        SYSCALL
+        RET
+
+    .section .note.GNU-stack,"",%progbits
@@ -0,0 +1,22 @@
+package com.android.androiddevicefingerprint
+
+import android.app.Application
+
+/**
+ * Application入口
+ * 尽早加载native库并传入files目录，native层据此读写不可变分区快照并在后台预热
+ */
+class FingerprintApplication : Application() {
+
+    override fun onCreate() {
+        super.onCreate()
+        System.loadLibrary("androiddevicefingerprint")
+        // filesDir按当前用户解析（/data/user/N/<包名>/files），且保证目录存在
+        initNative(filesDir.absolutePath)
+    }
+
+    /**
+     * 设置快照目录并启动不可变分区的后台预热
+     */
+    private external fun initNative(filesDir: String)
+}
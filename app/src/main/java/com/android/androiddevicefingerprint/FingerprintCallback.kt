@@ -0,0 +1,16 @@
+package com.android.androiddevicefingerprint
+
+/**
+ * 异步native收集的回调接口
+ * 在native工作线程上调用，更新UI前需要切回主线程
+ */
+interface FingerprintCallback {
+
+    fun onFingerprintResult(requestId: Int, status: Int, result: String)
+
+    companion object {
+        const val STATUS_OK = 0
+        const val STATUS_CANCELLED = 1
+        const val STATUS_DEADLINE_EXCEEDED = 2
+    }
+}
@@ -0,0 +1,25 @@
+package com.android.androiddevicefingerprint
+
+/**
+ * Native field ids for getFieldNative/getFieldsNative, must match FieldStore.h
+ */
+object FingerprintField {
+    const val BUILD_FINGERPRINT = 0
+    const val DEVICE_MODEL = 1
+    const val DEVICE_BRAND = 2
+    const val MANUFACTURER = 3
+    const val PRODUCT_NAME = 4
+    const val DEVICE_NAME = 5
+    const val ANDROID_VERSION = 6
+    const val API_LEVEL = 7
+    const val BUILD_ID = 8
+    const val BUILD_TYPE = 9
+    const val BUILD_TAGS = 10
+    const val SECURITY_PATCH = 11
+    const val BUILD_INCREMENTAL = 12
+    const val KERNEL_RELEASE = 13
+    const val KERNEL_VERSION = 14
+    const val MACHINE = 15
+    const val BOOT_ID = 16
+    const val SOC_SERIAL = 17
+}
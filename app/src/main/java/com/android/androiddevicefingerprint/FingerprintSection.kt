@@ -0,0 +1,24 @@
+package com.android.androiddevicefingerprint
+
+/**
+ * Native fingerprint section bits, must match include/SectionIds.h
+ */
+object FingerprintSection {
+    const val BUILD_PROP = 1 shl 0
+    const val UNAME = 1 shl 1
+    const val CPU_INFO = 1 shl 2
+    const val DRM_ID = 1 shl 3
+    const val NETLINK = 1 shl 4
+    const val FILE_SYSTEM = 1 shl 5
+    const val KERNEL_FILES = 1 shl 6
+    const val SYSTEM_FILES = 1 shl 7
+    const val COMMON_DEVICE = 1 shl 8
+    const val BLOCK_DEVICES = 1 shl 9
+    const val PARTITION_INVENTORY = 1 shl 10
+    const val ELF_BUILD_IDS = 1 shl 11
+    const val FILE_HASHES = 1 shl 12
+    const val KERNEL_CONFIG = 1 shl 13
+    const val MEMORY_MAPS = 1 shl 14
+    const val ROUTES = 1 shl 15
+    const val MEDIA_MANIFESTS = 1 shl 16
+}
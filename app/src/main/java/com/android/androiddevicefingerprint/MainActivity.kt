@@ -2,6 +2,7 @@ package com.android.androiddevicefingerprint
 
 import androidx.appcompat.app.AppCompatActivity
 import android.os.Bundle
+import android.content.res.AssetManager
 import android.widget.Toast
 import androidx.recyclerview.widget.LinearLayoutManager
 import com.android.androiddevicefingerprint.databinding.ActivityMainBinding
@@ -16,12 +17,67 @@ class MainActivity : AppCompatActivity() {
     private lateinit var androidIdManager: AndroidIdManager
     private lateinit var macAddressManager: MacAddressManager
 
+    private var fingerprints = mutableListOf<DeviceFingerprint>()
+    private val pendingRequests = mutableSetOf<Int>()
+
+    private data class NativeSection(val mask: Int, val name: String, val description: String)
+
+    private val nativeSections = listOf(
+        NativeSection(
+            FingerprintSection.DRM_ID,
+            "DRM ID (Widevine)",
+            "DRM device unique ID using Widevine (Base64 encoded)"
+        ),
+        NativeSection(
+            FingerprintSection.SYSTEM_FILES,
+            "System Files Info",
+            "Boot ID, UUID, SoC serial and other critical device fingerprints"
+        ),
+        NativeSection(
+            FingerprintSection.BLOCK_DEVICES,
+            "Block Devices",
+            "eMMC CID and UFS descriptors of physical block devices"
+        ),
+        NativeSection(
+            FingerprintSection.PARTITION_INVENTORY,
+            "Partition Inventory",
+            "File inventory digests of /system, /vendor and /apex"
+        ),
+        NativeSection(
+            FingerprintSection.ELF_BUILD_IDS,
+            "ELF Build IDs",
+            "GNU build-id notes of core system libraries"
+        ),
+        NativeSection(
+            FingerprintSection.MEDIA_MANIFESTS,
+            "Media Codecs and Features",
+            "Media codec manifests and declared system features"
+        ),
+        NativeSection(
+            FingerprintSection.KERNEL_CONFIG,
+            "Kernel Config",
+            "Kernel build options from /proc/config.gz"
+        ),
+        NativeSection(
+            FingerprintSection.KERNEL_FILES,
+            "Kernel Files Info",
+            "Build.prop and system files information using custom file reader"
+        ),
+        NativeSection(
+            FingerprintSection.FILE_SYSTEM,
+            "File System Info",
+            "File system information using native methods"
+        )
+    )
+
     override fun onCreate(savedInstanceState: Bundle?) {
         super.onCreate(savedInstanceState)
 
         binding = ActivityMainBinding.inflate(layoutInflater)
         setContentView(binding.root)
 
+        loadCompressionDictionaryNative(assets)
+
         // Initialize managers
         deviceInfoManager = DeviceInfoManager(this)
         androidIdManager = AndroidIdManager(this)
@@ -94,47 +150,50 @@ class MainActivity : AppCompatActivity() {
         // MAC Address Information
         fingerprints.addAll(loadMacAddressInfo())
         
-        // DRM ID Information
-        val drmId = getDrmIdNative()
-        fingerprints.add(
-            DeviceFingerprint(
-                name = "DRM ID (Widevine)",
-                value = drmId,
-                description = "DRM device unique ID using Widevine (Base64 encoded)"
+        // Native sections are collected on native worker threads and filled in by callbacks
+        nativeSections.forEach { section ->
+            fingerprints.add(
+                DeviceFingerprint(
+                    name = section.name,
+                    value = "Collecting...",
+                    description = section.description
+                )
             )
-        )
+        }
 
-        // System Files Information (Important Device Fingerprints)
-        val systemFilesInfo = getSystemFilesInfoNative()
-        fingerprints.add(
-            DeviceFingerprint(
-                name = "System Files Info",
-                value = systemFilesInfo,
-                description = "Boot ID, UUID, CID and other critical device fingerprints"
-            )
-        )
+        this.fingerprints = fingerprints
+        adapter.updateFingerprints(fingerprints.toList())
 
-        // Kernel Files Information
-        val kernelFilesInfo = getKernelFilesInfoNative()
-        fingerprints.add(
-            DeviceFingerprint(
-                name = "Kernel Files Info",
-                value = kernelFilesInfo,
-                description = "Build.prop and system files information using custom file reader"
-            )
-        )
+        val firstNativeIndex = fingerprints.size - nativeSections.size
+        nativeSections.forEachIndexed { offset, section ->
+            requestNativeSection(firstNativeIndex + offset, section)
+        }
+    }
 
-        // File System Information
-        val fileSystemInfo = getFileSystemInfoNative()
-        fingerprints.add(
-            DeviceFingerprint(
-                name = "File System Info",
-                value = fileSystemInfo,
-                description = "File system information using native methods"
-            )
-        )
+    private fun requestNativeSection(index: Int, section: NativeSection) {
+        val requestId = collectAsync(section.mask, NATIVE_DEADLINE_MS, object : FingerprintCallback {
+            override fun onFingerprintResult(requestId: Int, status: Int, result: String) {
+                runOnUiThread {
+                    pendingRequests.remove(requestId)
+                    val value = when (status) {
+                        FingerprintCallback.STATUS_OK -> result
+                        FingerprintCallback.STATUS_DEADLINE_EXCEEDED -> "Timed out\n$result"
+                        else -> "Cancelled"
+                    }
+                    fingerprints[index] = fingerprints[index].copy(value = value)
+                    adapter.updateFingerprints(fingerprints.toList())
+                }
+            }
+        })
+        if (requestId >= 0) {
+            pendingRequests.add(requestId)
+        }
+    }
 
-        adapter.updateFingerprints(fingerprints)
+    override fun onDestroy() {
+        pendingRequests.forEach { cancelAsync(it) }
+        pendingRequests.clear()
+        super.onDestroy()
     }
 
     private fun loadDeviceInfo(): List<DeviceFingerprint> {
@@ -309,7 +368,82 @@ class MainActivity : AppCompatActivity() {
      */
     external fun getMacAddressInfoNative(): String
 
+    /**
+     * Native method to collect the sections in [mask] on native worker threads.
+     * [deadlineMs] <= 0 waits for the complete result.
+     * Returns the request id, the result is delivered to [callback].
+     */
+    external fun collectAsync(mask: Int, deadlineMs: Long, callback: FingerprintCallback): Int
+
+    /**
+     * Native method to cancel a pending asynchronous request
+     */
+    external fun cancelAsync(requestId: Int): Boolean
+
+    /**
+     * Native method to get the serialized field-level snapshot
+     */
+    external fun getFingerprintSnapshotNative(): ByteArray?
+
+    /**
+     * Native method to get the field-level delta against a previous snapshot
+     */
+    external fun getFingerprintDeltaNative(previous: ByteArray?): ByteArray?
+
+    /**
+     * Native method to select the file I/O backend (0 = libc, 1 = raw syscall)
+     */
+    external fun setIoBackendNative(backend: Int)
+
+    /**
+     * Native method to time the full system-file sweep with both I/O backends
+     */
+    external fun benchmarkIoBackendsNative(iterations: Int): String
+
+    /**
+     * Native method to report per-section time budgets and overrun counters
+     */
+    external fun getSectionOverrunsNative(): String
+
+    /**
+     * Native method to enable or disable performance-counter profiling of section collection
+     */
+    external fun setProfilingNative(enabled: Boolean)
+
+    /**
+     * Native method to report accumulated per-section counters as a table or JSON
+     */
+    external fun getProfileReportNative(json: Boolean): String
+
+    /**
+     * Native method to collect the sections in mask uncached and report their performance counters
+     */
+    external fun profileSectionsNative(mask: Int, iterations: Int, json: Boolean): String
+
+    /**
+     * Native method to get one [FingerprintField] value, collecting its section only on first access.
+     * Returns null when the field is not available.
+     */
+    external fun getFieldNative(fieldId: Int): String?
+
+    /**
+     * Native method to get several [FingerprintField] values at once, null for unavailable fields
+     */
+    external fun getFieldsNative(fieldIds: IntArray): Array<String?>?
+
+    /**
+     * Native method to load the compression dictionary bundled in assets
+     */
+    external fun loadCompressionDictionaryNative(assets: AssetManager): Boolean
+
+    /**
+     * Native method to collect the full fingerprint as a dictionary-compressed zlib payload
+     */
+    external fun getCompressedFingerprintNative(): ByteArray?
+
     companion object {
+        private const val NATIVE_DEADLINE_MS = 5000L
+
         // Used to load the 'androiddevicefingerprint' library on application startup.
         init {
             System.loadLibrary("androiddevicefingerprint")